@@ -0,0 +1,430 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+#include <SAMRAI_config.h>
+
+// Headers for major SAMRAI objects
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellVariable.h>
+#include <NodeData.h>
+#include <NodeVariable.h>
+#include <Patch.h>
+#include <SideData.h>
+#include <SideVariable.h>
+#include <VariableDatabase.h>
+#include <tbox/Array.h>
+#include <tbox/MemoryDatabase.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/LEInteractor.h>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Micro-benchmark for LEInteractor::interpolate() and LEInteractor::spread().
+//
+// For every combination of the kernel functions, kernel implementations,
+// spread modes, data centerings, patch sizes, and numbers of Lagrangian points
+// per grid cell listed in the input file, this program interpolates and
+// spreads a vector-valued quantity between a single patch and a set of randomly
+// placed points and reports
+//
+// - the best and mean wall clock times over several repetitions,
+// - the number of points processed per second,
+// - an estimate of the number of bytes moved to and from main memory, and
+// - the resulting bandwidth as a fraction of the bandwidth measured by a STREAM
+//   triad loop at startup.
+//
+// The estimate of the number of bytes moved is the compulsory traffic of each
+// operation: every position and every Lagrangian value is read or written once
+// and every value of the Eulerian patch data (including ghost cells) is read
+// once (interpolation) or read and written once (spreading). Kernels whose
+// stencils do not fit in cache move more data than this, so a bandwidth
+// fraction well above 1 indicates that the operation is compute bound and a
+// value near 1 indicates that it is memory bound.
+//
+// Results are printed to pout and written, in JSON format, to the file
+// specified by json_file_name. The benchmark only uses a single patch and a
+// single process and does not need to be run with an MPI launcher.
+
+namespace
+{
+struct BenchmarkResult
+{
+    std::string operation;
+    std::string kernel;
+    std::string kernel_implementation;
+    std::string spread_mode;
+    std::string centering;
+    int patch_size;
+    double points_per_cell;
+    int n_points;
+    int n_repetitions;
+    double best_time;
+    double mean_time;
+    double bytes_moved;
+};
+
+// Measure the bandwidth (in bytes per second) of the STREAM triad kernel
+// a = b + s * c.
+double
+measure_stream_triad_bandwidth(const int n_values, const int n_repetitions)
+{
+    std::vector<double> a(n_values, 0.0), b(n_values, 1.0), c(n_values, 2.0);
+    double best_time = std::numeric_limits<double>::max();
+    for (int rep = 0; rep < n_repetitions; ++rep)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const double s = 1.0 + rep;
+        for (int k = 0; k < n_values; ++k) a[k] = b[k] + s * c[k];
+        const auto stop = std::chrono::steady_clock::now();
+        best_time = std::min(best_time, std::chrono::duration<double>(stop - start).count());
+    }
+    // Prevent the compiler from optimizing away the loop.
+    if (a[n_values / 2] < 0.0) pout << a[n_values / 2] << "\n";
+    return 3.0 * sizeof(double) * n_values / best_time;
+}
+
+// Time a function over several repetitions. The setup function is called
+// before each repetition and is not timed.
+template <class Setup, class Function>
+std::pair<double, double>
+time_function(const int n_repetitions, Setup setup, Function f)
+{
+    // Warm up caches and any one-time initialization.
+    setup();
+    f();
+    double best_time = std::numeric_limits<double>::max();
+    double total_time = 0.0;
+    for (int rep = 0; rep < n_repetitions; ++rep)
+    {
+        setup();
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop = std::chrono::steady_clock::now();
+        const double time = std::chrono::duration<double>(stop - start).count();
+        best_time = std::min(best_time, time);
+        total_time += time;
+    }
+    return std::make_pair(best_time, total_time / n_repetitions);
+}
+
+template <class T>
+std::vector<T>
+get_array_with_default(Pointer<Database> db, const std::string& key, const std::vector<T>& default_value);
+
+template <>
+std::vector<std::string>
+get_array_with_default(Pointer<Database> db, const std::string& key, const std::vector<std::string>& default_value)
+{
+    if (!db->keyExists(key)) return default_value;
+    const Array<std::string> values = db->getStringArray(key);
+    std::vector<std::string> result;
+    for (int k = 0; k < values.getSize(); ++k) result.push_back(values[k]);
+    return result;
+}
+
+template <>
+std::vector<int>
+get_array_with_default(Pointer<Database> db, const std::string& key, const std::vector<int>& default_value)
+{
+    if (!db->keyExists(key)) return default_value;
+    const Array<int> values = db->getIntegerArray(key);
+    std::vector<int> result;
+    for (int k = 0; k < values.getSize(); ++k) result.push_back(values[k]);
+    return result;
+}
+
+template <>
+std::vector<double>
+get_array_with_default(Pointer<Database> db, const std::string& key, const std::vector<double>& default_value)
+{
+    if (!db->keyExists(key)) return default_value;
+    const Array<double> values = db->getDoubleArray(key);
+    std::vector<double> result;
+    for (int k = 0; k < values.getSize(); ++k) result.push_back(values[k]);
+    return result;
+}
+
+void
+write_json(const std::string& file_name,
+           const double stream_bandwidth,
+           const std::vector<BenchmarkResult>& results)
+{
+    std::ofstream json(file_name);
+    json << std::setprecision(8);
+    json << "{\n";
+    json << "  \"benchmark\": \"lei_bench\",\n";
+    json << "  \"ndim\": " << NDIM << ",\n";
+    json << "  \"stream_triad_bandwidth\": " << stream_bandwidth << ",\n";
+    json << "  \"results\": [\n";
+    for (std::size_t k = 0; k < results.size(); ++k)
+    {
+        const BenchmarkResult& r = results[k];
+        const double bandwidth = r.bytes_moved / r.best_time;
+        json << "    {\n";
+        json << "      \"operation\": \"" << r.operation << "\",\n";
+        json << "      \"kernel\": \"" << r.kernel << "\",\n";
+        json << "      \"kernel_implementation\": \"" << r.kernel_implementation << "\",\n";
+        json << "      \"spread_mode\": \"" << r.spread_mode << "\",\n";
+        json << "      \"centering\": \"" << r.centering << "\",\n";
+        json << "      \"patch_size\": " << r.patch_size << ",\n";
+        json << "      \"points_per_cell\": " << r.points_per_cell << ",\n";
+        json << "      \"n_points\": " << r.n_points << ",\n";
+        json << "      \"n_repetitions\": " << r.n_repetitions << ",\n";
+        json << "      \"best_time\": " << r.best_time << ",\n";
+        json << "      \"mean_time\": " << r.mean_time << ",\n";
+        json << "      \"points_per_second\": " << r.n_points / r.best_time << ",\n";
+        json << "      \"bytes_moved\": " << r.bytes_moved << ",\n";
+        json << "      \"bandwidth\": " << bandwidth << ",\n";
+        json << "      \"bandwidth_fraction\": " << bandwidth / stream_bandwidth << "\n";
+        json << "    }" << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n";
+    json << "}\n";
+    return;
+}
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    {
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "lei_bench.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+        if (input_db->keyExists("LEInteractor"))
+        {
+            LEInteractor::setFromDatabase(app_initializer->getComponentDatabase("LEInteractor"));
+        }
+
+        if (IBTK_MPI::getNodes() != 1)
+        {
+            TBOX_ERROR("lei_bench: this benchmark must be run on a single process" << std::endl);
+        }
+
+        const std::vector<std::string> kernels = get_array_with_default<std::string>(input_db, "kernels", { "IB_4" });
+        const std::vector<std::string> kernel_implementations =
+            get_array_with_default<std::string>(input_db, "kernel_implementations", { "FORTRAN", "TEMPLATED" });
+        const std::vector<std::string> spread_modes =
+            get_array_with_default<std::string>(input_db, "spread_modes", { "SERIAL" });
+        const std::vector<std::string> centerings =
+            get_array_with_default<std::string>(input_db, "centerings", { "CELL", "SIDE" });
+        const std::vector<int> patch_sizes =
+            get_array_with_default<int>(input_db, "patch_sizes", NDIM == 2 ? std::vector<int>{ 64, 256 } :
+                                                                             std::vector<int>{ 16, 64 });
+        const std::vector<double> points_per_cell_values =
+            get_array_with_default<double>(input_db, "points_per_cell", { 0.5, 2.0 });
+        const int n_repetitions = input_db->getIntegerWithDefault("n_repetitions", 10);
+        const int stream_array_size = input_db->getIntegerWithDefault("stream_array_size", 1 << 24);
+        const std::string json_file_name =
+            input_db->getStringWithDefault("json_file_name", "lei_bench_" + std::to_string(NDIM) + "d.json");
+
+        // Determine the reference memory bandwidth.
+        const double stream_bandwidth = measure_stream_triad_bandwidth(stream_array_size, n_repetitions);
+        pout << "lei_bench: STREAM triad bandwidth = " << stream_bandwidth / 1.0e9 << " GB/s\n";
+
+        // Register the variables with the largest ghost width required by any
+        // of the kernels.
+        int ghost_width = 0;
+        for (const std::string& kernel : kernels)
+        {
+            ghost_width = std::max(ghost_width, LEInteractor::getMinimumGhostWidth(kernel));
+        }
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("lei_bench");
+        Pointer<CellVariable<NDIM, double> > q_cc_var = new CellVariable<NDIM, double>("q_cc", NDIM);
+        Pointer<NodeVariable<NDIM, double> > q_nc_var = new NodeVariable<NDIM, double>("q_nc", NDIM);
+        Pointer<SideVariable<NDIM, double> > q_sc_var = new SideVariable<NDIM, double>("q_sc");
+        const int q_cc_idx = var_db->registerVariableAndContext(q_cc_var, ctx, IntVector<NDIM>(ghost_width));
+        const int q_nc_idx = var_db->registerVariableAndContext(q_nc_var, ctx, IntVector<NDIM>(ghost_width));
+        const int q_sc_idx = var_db->registerVariableAndContext(q_sc_var, ctx, IntVector<NDIM>(ghost_width));
+
+        std::vector<BenchmarkResult> results;
+        for (const int patch_size : patch_sizes)
+        {
+            // Set up a single patch covering the unit square or cube.
+            const Box<NDIM> patch_box(Index<NDIM>(0), Index<NDIM>(patch_size - 1));
+            Pointer<Patch<NDIM> > patch = new Patch<NDIM>(patch_box, var_db->getPatchDescriptor());
+            Array<Array<bool> > touches_bdry(NDIM);
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                touches_bdry[d].resizeArray(2);
+                touches_bdry[d][0] = false;
+                touches_bdry[d][1] = false;
+            }
+            double dx[NDIM], x_lower[NDIM], x_upper[NDIM];
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                dx[d] = 1.0 / patch_size;
+                x_lower[d] = 0.0;
+                x_upper[d] = 1.0;
+            }
+            patch->setPatchGeometry(
+                new CartesianPatchGeometry<NDIM>(IntVector<NDIM>(1), touches_bdry, touches_bdry, dx, x_lower, x_upper));
+            patch->allocatePatchData(q_cc_idx);
+            patch->allocatePatchData(q_nc_idx);
+            patch->allocatePatchData(q_sc_idx);
+            Pointer<CellData<NDIM, double> > q_cc_data = patch->getPatchData(q_cc_idx);
+            Pointer<NodeData<NDIM, double> > q_nc_data = patch->getPatchData(q_nc_idx);
+            Pointer<SideData<NDIM, double> > q_sc_data = patch->getPatchData(q_sc_idx);
+
+            for (const double points_per_cell : points_per_cell_values)
+            {
+                // Place the points randomly in the interior of the patch.
+                const int n_points = std::max(1, static_cast<int>(points_per_cell * patch_box.size()));
+                std::mt19937 std_seq(42u);
+                std::uniform_real_distribution<double> distribution(0.0, 1.0);
+                std::vector<double> X_data(NDIM * n_points);
+                for (double& X : X_data) X = distribution(std_seq);
+                std::vector<double> Q_data(NDIM * n_points);
+                for (double& Q : Q_data) Q = distribution(std_seq);
+
+                for (const std::string& centering : centerings)
+                {
+                    double n_eulerian_values = 0.0;
+                    if (centering == "CELL")
+                    {
+                        n_eulerian_values = q_cc_data->getArrayData().getBox().size() * q_cc_data->getDepth();
+                    }
+                    else if (centering == "NODE")
+                    {
+                        n_eulerian_values = q_nc_data->getArrayData().getBox().size() * q_nc_data->getDepth();
+                    }
+                    else if (centering == "SIDE")
+                    {
+                        for (unsigned int axis = 0; axis < NDIM; ++axis)
+                        {
+                            n_eulerian_values += q_sc_data->getArrayData(axis).getBox().size();
+                        }
+                    }
+                    else
+                    {
+                        TBOX_ERROR("lei_bench: unknown centering " << centering << "\n"
+                                                                   << "  valid choices are: CELL, NODE, SIDE"
+                                                                   << std::endl);
+                    }
+                    const double lagrangian_bytes = 2.0 * NDIM * n_points * sizeof(double);
+                    const double eulerian_bytes = n_eulerian_values * sizeof(double);
+
+                    for (const std::string& kernel : kernels)
+                    {
+                        for (const std::string& kernel_implementation : kernel_implementations)
+                        {
+                            for (const std::string& spread_mode : spread_modes)
+                            {
+                                Pointer<Database> lei_db = new MemoryDatabase("LEInteractor");
+                                lei_db->putString("kernel_implementation", kernel_implementation);
+                                lei_db->putString("spread_mode", spread_mode);
+                                LEInteractor::setFromDatabase(lei_db);
+
+                                BenchmarkResult result;
+                                result.kernel = kernel;
+                                result.kernel_implementation = kernel_implementation;
+                                result.spread_mode = spread_mode;
+                                result.centering = centering;
+                                result.patch_size = patch_size;
+                                result.points_per_cell = points_per_cell;
+                                result.n_points = n_points;
+                                result.n_repetitions = n_repetitions;
+
+                                // Interpolation does not depend on the spread
+                                // mode, so only time it once.
+                                if (spread_mode == spread_modes.front())
+                                {
+                                    const auto no_setup = []() {};
+                                    const auto interpolate = [&]() {
+                                        if (centering == "CELL")
+                                            LEInteractor::interpolate(
+                                                Q_data, NDIM, X_data, NDIM, q_cc_data, patch, patch_box, kernel);
+                                        if (centering == "NODE")
+                                            LEInteractor::interpolate(
+                                                Q_data, NDIM, X_data, NDIM, q_nc_data, patch, patch_box, kernel);
+                                        if (centering == "SIDE")
+                                            LEInteractor::interpolate(
+                                                Q_data, NDIM, X_data, NDIM, q_sc_data, patch, patch_box, kernel);
+                                    };
+                                    const std::pair<double, double> times =
+                                        time_function(n_repetitions, no_setup, interpolate);
+                                    result.operation = "interpolate";
+                                    result.best_time = times.first;
+                                    result.mean_time = times.second;
+                                    result.bytes_moved = lagrangian_bytes + eulerian_bytes;
+                                    results.push_back(result);
+                                }
+
+                                const auto zero = [&]() {
+                                    q_cc_data->fillAll(0.0);
+                                    q_nc_data->fillAll(0.0);
+                                    q_sc_data->fillAll(0.0);
+                                };
+                                const auto spread = [&]() {
+                                    if (centering == "CELL")
+                                        LEInteractor::spread(
+                                            q_cc_data, Q_data, NDIM, X_data, NDIM, patch, patch_box, kernel);
+                                    if (centering == "NODE")
+                                        LEInteractor::spread(
+                                            q_nc_data, Q_data, NDIM, X_data, NDIM, patch, patch_box, kernel);
+                                    if (centering == "SIDE")
+                                        LEInteractor::spread(
+                                            q_sc_data, Q_data, NDIM, X_data, NDIM, patch, patch_box, kernel);
+                                };
+                                const std::pair<double, double> times = time_function(n_repetitions, zero, spread);
+                                result.operation = "spread";
+                                result.best_time = times.first;
+                                result.mean_time = times.second;
+                                result.bytes_moved = lagrangian_bytes + 2.0 * eulerian_bytes;
+                                results.push_back(result);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Print a summary and write the results to disk.
+        pout << std::left << std::setw(12) << "operation" << std::setw(14) << "kernel" << std::setw(11) << "impl"
+             << std::setw(15) << "spread_mode" << std::setw(10) << "centering" << std::right << std::setw(8)
+             << "size" << std::setw(8) << "ppc" << std::setw(14) << "points/s" << std::setw(10) << "BW frac"
+             << "\n";
+        for (const BenchmarkResult& r : results)
+        {
+            pout << std::left << std::setw(12) << r.operation << std::setw(14) << r.kernel << std::setw(11)
+                 << r.kernel_implementation << std::setw(15) << r.spread_mode << std::setw(10) << r.centering
+                 << std::right << std::setw(8) << r.patch_size << std::setw(8) << r.points_per_cell << std::setw(14)
+                 << std::setprecision(4) << r.n_points / r.best_time << std::setw(10)
+                 << r.bytes_moved / r.best_time / stream_bandwidth << "\n";
+        }
+        write_json(json_file_name, stream_bandwidth, results);
+        pout << "lei_bench: wrote results to " << json_file_name << "\n";
+    }
+} // main
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBTK_BoundingBoxBins
+#define included_IBTK_BoundingBoxBins
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibtk/config.h>
+
+#include "ibtk/libmesh_utilities.h"
+
+#include <array>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class BoundingBoxBins is a spatial index that finds the bounding
+ * boxes in a fixed collection of boxes that intersect a given query box.
+ *
+ * The boxes are sorted into a uniform grid of bins whose width is comparable
+ * to the average box size in each coordinate direction, so that the cost of a
+ * query is proportional to the number of bins it covers plus the number of
+ * boxes stored in those bins rather than to the total number of boxes. Only
+ * the first NDIM coordinates of the boxes are considered.
+ *
+ * This class is used by FEDataManager to associate elements with Cartesian
+ * grid patches.
+ */
+class BoundingBoxBins
+{
+public:
+    /*!
+     * \brief Constructor. Build the index for the boxes <code>boxes[i]</code>
+     * for all indices <code>i</code> in @p box_indices.
+     *
+     * The boxes are not copied: the vector @p boxes must not be modified or
+     * destroyed while the index is in use.
+     */
+    BoundingBoxBins(const std::vector<libMeshWrappers::BoundingBox>& boxes, const std::vector<int>& box_indices);
+
+    /*!
+     * \brief Constructor. Build the index for all of the boxes in @p boxes.
+     */
+    BoundingBoxBins(const std::vector<libMeshWrappers::BoundingBox>& boxes);
+
+    /*!
+     * \brief Find the indexed boxes that intersect @p query_box, i.e., boxes
+     * whose closed intervals overlap those of @p query_box in each of the
+     * first NDIM coordinate directions.
+     *
+     * The indices of the intersecting boxes are stored in @p box_indices in
+     * increasing order. Any previous contents of @p box_indices are
+     * discarded.
+     */
+    void getIntersectingBoxes(const libMeshWrappers::BoundingBox& query_box, std::vector<int>& box_indices) const;
+
+    /*!
+     * \brief Return the number of bins in each coordinate direction.
+     */
+    const std::array<int, NDIM>& getNumberOfBins() const;
+
+private:
+    /*!
+     * \brief Determine the bin grid and sort the boxes into the bins.
+     */
+    void buildBins(const std::vector<int>& box_indices);
+
+    /*!
+     * \brief Return the index of the bin containing coordinate @p x in
+     * direction @p d, clamped to the range of valid bin indices.
+     */
+    int getBinIndex(double x, unsigned int d) const;
+
+    /*!
+     * The boxes being indexed.
+     */
+    const std::vector<libMeshWrappers::BoundingBox>& d_boxes;
+
+    /*!
+     * Description of the uniform grid of bins.
+     */
+    std::array<double, NDIM> d_x_lower, d_bin_width;
+    std::array<int, NDIM> d_n_bins;
+
+    /*!
+     * Indices of the boxes overlapping each bin, stored contiguously: the
+     * boxes in bin @p b are d_bin_boxes[d_bin_offsets[b]] through
+     * d_bin_boxes[d_bin_offsets[b + 1] - 1].
+     */
+    std::vector<int> d_bin_offsets, d_bin_boxes;
+};
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_IBTK_BoundingBoxBins
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace SAMRAI
@@ -89,6 +90,9 @@ namespace IBTK
  * values): \verbatim
 
  smoother_type = "PATCH_GAUSS_SEIDEL"         // see setSmootherType()
+ chebyshev_num_power_iterations = 10          // see setSmootherType()
+ chebyshev_min_eigenvalue_factor = 0.1        // see setSmootherType()
+ chebyshev_max_eigenvalue_factor = 1.1        // see setSmootherType()
  prolongation_method = "LINEAR_REFINE"        // see setProlongationMethod()
  restriction_method = "CONSERVATIVE_COARSEN"  // see setRestrictionMethod()
  coarse_solver_type = "HYPRE_LEVEL_SOLVER"    // see setCoarseSolverType()
@@ -143,6 +147,31 @@ public:
      * - \c "PATCH_GAUSS_SEIDEL"
      * - \c "PROCESSOR_GAUSS_SEIDEL"
      * - \c "RED_BLACK_GAUSS_SEIDEL"
+     * - \c "RED_BLACK_GAUSS_SEIDEL_THREADED"
+     * - \c "L1_JACOBI"
+     * - \c "CHEBYSHEV"
+     *
+     * \c "RED_BLACK_GAUSS_SEIDEL_THREADED" performs the same red-black sweeps
+     * as \c "RED_BLACK_GAUSS_SEIDEL" with the kernel in patch_smoothers.h,
+     * which vectorizes each sweep and, when IBTK is compiled with OpenMP,
+     * updates the cells of large patches with multiple threads. Problems with
+     * variable coefficients use the same kernels as
+     * \c "RED_BLACK_GAUSS_SEIDEL".
+     *
+     * \c "L1_JACOBI" and \c "CHEBYSHEV" are polynomial smoothers that only
+     * require one ghost cell fill per sweep, and the update of each cell in a
+     * sweep is independent of the other updates. \c "L1_JACOBI" uses the
+     * l1-Jacobi diagonal, and so does not require a damping factor.
+     * \c "CHEBYSHEV" uses Chebyshev acceleration of Jacobi iterations that
+     * targets the eigenvalues of the Jacobi-preconditioned operator in the
+     * interval [chebyshev_min_eigenvalue_factor * lambda,
+     * chebyshev_max_eigenvalue_factor * lambda], in which lambda is an
+     * estimate of the largest eigenvalue that is computed on each level by
+     * chebyshev_num_power_iterations power iterations and reused until the
+     * operator state is reinitialized or the coefficients change. The number
+     * of power iterations must be positive, and the factors must satisfy
+     * 0 < chebyshev_min_eigenvalue_factor < chebyshev_max_eigenvalue_factor.
+     * These smoothers are only implemented for constant coefficients.
      */
     void setSmootherType(const std::string& smoother_type) override;
 
@@ -250,6 +279,15 @@ private:
      */
     CCPoissonPointRelaxationFACOperator& operator=(const CCPoissonPointRelaxationFACOperator& that) = delete;
 
+    /*!
+     * \brief Return an estimate of the largest eigenvalue of the
+     * Jacobi-preconditioned operator on the specified level, which is computed
+     * by power iterations when no valid cached value is available.
+     *
+     * \note This overwrites the scratch data on the level.
+     */
+    double getMaxEigenvalueEstimate(int level_num);
+
     /*
      * Coarse level solvers and solver parameters.
      */
@@ -261,6 +299,17 @@ private:
      */
     std::vector<std::vector<SAMRAI::hier::BoxList<NDIM> > > d_patch_bc_box_overlap;
     std::vector<std::vector<std::map<int, SAMRAI::hier::Box<NDIM> > > > d_patch_neighbor_overlap;
+
+    /*
+     * Chebyshev smoother parameters and the cached eigenvalue estimates on
+     * each level, along with the values of D and C for which they were
+     * computed.
+     */
+    int d_chebyshev_num_power_iterations = 10;
+    double d_chebyshev_min_eigenvalue_factor = 0.1;
+    double d_chebyshev_max_eigenvalue_factor = 1.1;
+    std::vector<double> d_max_eigenvalue_estimates;
+    std::vector<std::pair<double, double> > d_max_eigenvalue_estimate_coefs;
 };
 } // namespace IBTK
 
@@ -21,6 +21,7 @@
 #include <ibtk/config.h>
 
 #include <ibtk/QuadratureCache.h>
+#include <ibtk/QuadratureKeyMap.h>
 
 #include <tbox/Utilities.h>
 
@@ -30,7 +31,6 @@
 #include <libmesh/enum_quadrature_type.h>
 #include <libmesh/fe.h>
 
-#include <map>
 #include <memory>
 #include <tuple>
 
@@ -143,9 +143,9 @@ operator&=(FEUpdateFlags& f1, const FEUpdateFlags f2)
  * one FE object for each quadrature rule instead of constantly recomputing,
  * e.g., shape function values.
  *
- * This class essentially provides a wrapper around std::map to manage FE
- * objects and the quadrature rules they use. The keys are descriptions of
- * quadrature rules.
+ * This class essentially provides a wrapper around IBTK::QuadratureKeyMap to
+ * manage FE objects and the quadrature rules they use. The keys are
+ * descriptions of quadrature rules.
  */
 class FECache
 {
@@ -223,7 +223,7 @@ protected:
     /**
      * Managed libMesh::FE objects of specified dimension and family.
      */
-    std::map<key_type, std::unique_ptr<libMesh::FEBase> > d_fes;
+    QuadratureKeyMap<libMesh::FEBase> d_fes;
 };
 
 inline FECache::FECache(const unsigned int dim, const libMesh::FEType& fe_type, const FEUpdateFlags flags)
@@ -249,11 +249,11 @@ FECache::operator()(const FECache::key_type& quad_key, const libMesh::Elem* elem
 #ifndef NDEBUG
     TBOX_ASSERT(elem->type() == std::get<0>(quad_key));
 #endif
-    auto it = d_fes.find(quad_key);
-    if (it == d_fes.end())
+    libMesh::FEBase* cached_fe = d_fes.find(quad_key);
+    if (cached_fe == nullptr)
     {
         libMesh::QBase& quad = d_quadrature_cache[quad_key];
-        libMesh::FEBase& fe = *(*d_fes.emplace(quad_key, libMesh::FEBase::build(d_dim, d_fe_type)).first).second;
+        libMesh::FEBase& fe = d_fes.insert(quad_key, libMesh::FEBase::build(d_dim, d_fe_type));
         fe.attach_quadrature_rule(&quad);
 
         if (d_update_flags & FEUpdateFlags::update_phi) fe.get_phi();
@@ -265,7 +265,7 @@ FECache::operator()(const FECache::key_type& quad_key, const libMesh::Elem* elem
     }
     else
     {
-        libMesh::FEBase& fe = *(it->second);
+        libMesh::FEBase& fe = *cached_fe;
         // TODO: we need better reinitialization logic than hardcoding in
         // libMesh element types.
         //
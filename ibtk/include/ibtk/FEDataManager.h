@@ -49,9 +49,11 @@ IBTK_DISABLE_EXTRA_WARNINGS
 #include <boost/multi_array.hpp>
 IBTK_ENABLE_EXTRA_WARNINGS
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -395,6 +397,33 @@ private:
  * it produces some artifacts at the coarse-fine interface, but that these
  * generally don't effect the overall solution quality.
  *
+ * <code>use_threaded_element_loops</code>: if <code>TRUE</code> then the
+ * per-element work in FEDataManager::spread() and
+ * FEDataManager::interpWeighted() (i.e., evaluating the positions of and
+ * values at quadrature points and integrating right-hand sides) is
+ * distributed across OpenMP threads. Each thread uses its own FECache and
+ * FEMappingCache objects. Contributions to the finite element vector are
+ * still accumulated in element order, so the results do not depend on the
+ * number of threads. Values are spread to the Eulerian grid by LEInteractor,
+ * which has its own threaded spreading mode. This option has no effect if
+ * IBAMR was not compiled with OpenMP. The default value is
+ * <code>FALSE</code>.
+ *
+ * <code>cache_quadrature_point_data</code>: if <code>TRUE</code> then the
+ * quadrature rules, the positions of the quadrature points, and the JxW
+ * values computed by FEDataManager::spread() and
+ * FEDataManager::interpWeighted() are stored and reused by subsequent calls
+ * to either function with the same position vector values and quadrature
+ * parameters (e.g., an interpolation followed by a spread at the same time
+ * in a time step). The quadrature parameters are the fields of the
+ * InterpSpec or SpreadSpec that FEDataManager::updateInterpQuadratureRule()
+ * and FEDataManager::updateSpreadQuadratureRule() use to select the rule of
+ * each element, so the cached rules match the rules selected by those
+ * functions. The cache stores NDIM + 1 doubles per quadrature point
+ * and a copy of the local part of the position vector: see
+ * FEDataManager::getQuadraturePointCacheMemoryUsage(). The default value is
+ * <code>FALSE</code>.
+ *
  * <h2>Parameters effecting workload estimate calculations</h2>
  * FEDataManager can estimate the amount of work done in IBFE calculations
  * (such as FEDataManager::spread). Since most calculations use a variable
@@ -407,6 +436,20 @@ private:
  * construction through the FEDataManager::WorkloadSpec object, which contains
  * reasonable defaults.
  *
+ * Since the cost of a quadrature point varies (e.g., with the number of
+ * overlapping patches or the work done to compute surface forces), the
+ * workload estimate may alternatively be based on measurements: if
+ * WorkloadSpec::use_measured_costs is <code>true</code> then spread() and
+ * interpWeighted() time the work done on each patch and attribute it to the
+ * patch elements in proportion to their numbers of quadrature points. Other
+ * classes may add their own measurements with addMeasuredCost() or, for work
+ * done on element surfaces, addMeasuredSurfaceCost(). The
+ * quadrature points of each element are then weighted by the ratio of the
+ * measured cost per quadrature point on that element to the average cost per
+ * quadrature point of all elements. Since the workload estimate is computed on
+ * the patches on which the costs were measured, each processor only keeps the
+ * measurements of the elements of its own patches.
+ *
  * \note Multiple FEDataManager objects may be instantiated simultaneously.
  */
 class FEDataManager : public SAMRAI::tbox::Serializable
@@ -522,6 +565,54 @@ public:
         ///
         /// A good value for this is 0.8.
         double duplicated_node_weight = 0.0;
+
+        /// Whether or not the quadrature points of each element should be
+        /// weighted by the measured cost of the work done on that element
+        /// (relative to the average cost per quadrature point of all
+        /// elements). Costs are only measured for element quadrature: nodes
+        /// are not weighted when nodal quadrature is used.
+        bool use_measured_costs = false;
+
+        /// The weight given to the costs measured before the previous
+        /// workload estimate when combining them with the costs measured
+        /// since then. Older measurements are hence gradually forgotten. Must
+        /// be in [0, 1].
+        double measured_cost_history_weight = 0.5;
+    };
+
+    /*!
+     * \brief Enumeration describing which of the active patch elements are
+     * processed by spread() and interpWeighted().
+     *
+     * Processor interior elements are the active patch elements whose degrees
+     * of freedom are all owned by the current processor: computations on them
+     * only read (and write) the locally owned entries of IB-ghosted
+     * vectors. The remaining (processor boundary) elements also need ghost
+     * entries. Processing the two subsets separately permits overlapping the
+     * ghost value update of the input vectors with the work done on the
+     * processor interior elements, e.g.,
+     * @code
+     * batch_vec_ghost_update_begin(vecs, INSERT_VALUES, SCATTER_FORWARD);
+     * fe_data_manager->spread(
+     *     f_data_idx, F, X, system_name, spread_spec, FEDataManager::PROCESSOR_INTERIOR_ELEMS);
+     * batch_vec_ghost_update_end(vecs, INSERT_VALUES, SCATTER_FORWARD);
+     * fe_data_manager->spread(
+     *     f_data_idx, F, X, system_name, spread_spec, FEDataManager::PROCESSOR_BOUNDARY_ELEMS);
+     * @endcode
+     *
+     * @note Nodal quadrature does not distinguish between the two subsets:
+     * all nodes are processed with the processor boundary elements.
+     *
+     * @note The two subsets are only distinguished if
+     * FEDataManager::setElementSubsetsEnabled() was called before the
+     * patch-element mappings were last set up. Otherwise all active patch
+     * elements are treated as processor boundary elements.
+     */
+    enum ElementSubset
+    {
+        ALL_ELEMS,
+        PROCESSOR_INTERIOR_ELEMS,
+        PROCESSOR_BOUNDARY_ELEMS
     };
 
 protected:
@@ -636,6 +727,64 @@ public:
      */
     bool getLoggingEnabled() const;
 
+    /*!
+     * \brief Enable or disable distributing the element loops of spread() and
+     * interpWeighted() across OpenMP threads.
+     *
+     * @note This is usually set from the input database parameter
+     * <code>use_threaded_element_loops</code>.
+     */
+    void setThreadedElementLoopsEnabled(bool use_threaded_element_loops = true);
+
+    /*!
+     * \brief Determine whether the element loops of spread() and
+     * interpWeighted() are distributed across OpenMP threads.
+     */
+    bool getThreadedElementLoopsEnabled() const;
+
+    /*!
+     * \brief Enable or disable caching the quadrature rules, quadrature point
+     * positions, and JxW values used by spread() and interpWeighted() between
+     * calls.
+     *
+     * @note This is usually set from the input database parameter
+     * <code>cache_quadrature_point_data</code>.
+     */
+    void setQuadraturePointCacheEnabled(bool cache_quadrature_point_data = true);
+
+    /*!
+     * \brief Determine whether quadrature point data is cached between calls
+     * to spread() and interpWeighted().
+     */
+    bool getQuadraturePointCacheEnabled() const;
+
+    /*!
+     * \brief Enable or disable distinguishing the processor interior and
+     * processor boundary elements (see FEDataManager::ElementSubset) of each
+     * patch. This reorders the active patch elements, which changes the
+     * results of spread() and interpWeighted() at the level of roundoff, and
+     * takes effect the next time the patch-element mappings are set up (see
+     * FEDataManager::reinitElementMappings()).
+     */
+    void setElementSubsetsEnabled(bool use_elem_subsets = true);
+
+    /*!
+     * \brief Determine whether the processor interior and processor boundary
+     * elements of each patch are distinguished.
+     */
+    bool getElementSubsetsEnabled() const;
+
+    /*!
+     * \brief Delete all cached quadrature point data.
+     */
+    void clearQuadraturePointCache();
+
+    /*!
+     * \return The number of bytes currently used by the quadrature point
+     * cache on this processor.
+     */
+    std::size_t getQuadraturePointCacheMemoryUsage() const;
+
     /*!
      * \name Methods to set and get the patch hierarchy and range of patch
      * levels associated with this manager class.
@@ -688,6 +837,11 @@ public:
     /*!
      * \return A const reference to the map from local patch number to local
      * active elements.
+     *
+     * \note If element subsets are enabled (see
+     * FEDataManager::setElementSubsetsEnabled()) then the processor interior
+     * elements (see FEDataManager::ElementSubset) of each patch are stored
+     * before the processor boundary elements.
      */
     const std::vector<std::vector<libMesh::Elem*> >& getActivePatchElementMap() const;
 
@@ -780,6 +934,11 @@ public:
      * position of the mesh.
      * @param[in] system_name name of the system corresponding to @p F.
      *
+     * @param[in] elem_subset The subset of the active patch elements from
+     * which values are spread. Only the locally owned entries of @p X and
+     * @p F are read when this is PROCESSOR_INTERIOR_ELEMS, so their ghost
+     * values may still be in the process of being updated.
+     *
      * Both @p X and @p F should contain ghost values corresponding to the IB
      * partitioning of the Lagrangian data, i.e., vectors returned from
      * buildIBGhostedVector.
@@ -794,7 +953,8 @@ public:
                 libMesh::NumericVector<double>& F,
                 libMesh::NumericVector<double>& X,
                 const std::string& system_name,
-                const SpreadSpec& spread_spec);
+                const SpreadSpec& spread_spec,
+                ElementSubset elem_subset = ALL_ELEMS);
 
     /*!
      * \brief Spread a density from the FE mesh to the Cartesian grid using
@@ -911,6 +1071,14 @@ public:
      * an L2-projection of the interpolated quantity. It does however weighs/filters
      * the interpolated quantity at the quadrature points to the nodes. Here, the
      * basis functions of the deformational field is used as the filter.
+     *
+     * The parameter @p elem_subset determines which active patch elements
+     * are processed. Calls with PROCESSOR_INTERIOR_ELEMS only read the locally
+     * owned entries of @p X (so its ghost values may still be in the process
+     * of being updated) and do not close @p F. Calls with
+     * PROCESSOR_BOUNDARY_ELEMS add to @p F instead of overwriting it and do
+     * not fill ghost data, i.e., they complete a preceding call with
+     * PROCESSOR_INTERIOR_ELEMS. In both cases @p X is not closed.
      */
     void
     interpWeighted(int f_data_idx,
@@ -922,7 +1090,8 @@ public:
                        std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >(),
                    double fill_data_time = 0.0,
                    bool close_F = true,
-                   bool close_X = true);
+                   bool close_X = true,
+                   ElementSubset elem_subset = ALL_ELEMS);
 
     /*!
      * \brief Interpolate a value from the Cartesian grid to the FE mesh using
@@ -1048,6 +1217,33 @@ public:
                              const int coarsest_ln = -1,
                              const int finest_ln = -1);
 
+    /*!
+     * \brief Record that @p seconds of (measured) work were done on the
+     * elements @p elems, e.g., to compute surface forces on the elements of a
+     * patch, whose quadrature points are given by the offsets @p qp_offsets
+     * (i.e., element @p k has <code>qp_offsets[k + 1] - qp_offsets[k]</code>
+     * quadrature points). The time is split between the elements in
+     * proportion to their numbers of quadrature points. Measurements are only
+     * recorded (and used by addWorkloadEstimate()) if
+     * WorkloadSpec::use_measured_costs is <code>true</code>.
+     */
+    void addMeasuredCost(const std::vector<libMesh::Elem*>& elems,
+                         const std::vector<unsigned int>& qp_offsets,
+                         double seconds);
+
+    /*!
+     * \brief Record that @p seconds of (measured) work were done on the
+     * surfaces of the elements @p elems, e.g., to spread surface forces. The
+     * arguments are the same as those of addMeasuredCost(), except that the
+     * offsets refer to surface quadrature points. Unlike addMeasuredCost(),
+     * the surface quadrature points are not counted as quadrature points of
+     * the elements: the time is charged to each element as a whole, so it does
+     * not change the average cost per quadrature point.
+     */
+    void addMeasuredSurfaceCost(const std::vector<libMesh::Elem*>& elems,
+                                const std::vector<unsigned int>& qp_offsets,
+                                double seconds);
+
     /*!
      * Set integer tags to "one" in cells where refinement of the given level
      * should occur due to the presence of Lagrangian data.  The double time
@@ -1162,8 +1358,29 @@ private:
      * Compute the quadrature point counts in each cell of the level in which
      * the FE mesh is embedded.  Also zeros out node count data for other levels
      * within the specified range of level numbers.
+     *
+     * If @p weight_by_measured_costs is true then each element quadrature
+     * point is counted with the relative measured cost of its element (see
+     * updateMeasuredCosts()) instead of one.
      */
-    void updateQuadPointCountData(int coarsest_ln, int finest_ln);
+    void updateQuadPointCountData(int coarsest_ln, int finest_ln, bool weight_by_measured_costs = false);
+
+    /*!
+     * Combine the costs measured on this processor since the last call to
+     * this function with the previous measurements, discard the measurements
+     * of elements which are not on any local patch, and compute the average
+     * cost per quadrature point of all processors.
+     */
+    void updateMeasuredCosts();
+
+    /*!
+     * Relative measured cost per quadrature point of an element with @p n_qp
+     * quadrature points, i.e., the measured cost per quadrature point of the
+     * element plus its measured surface cost divided by @p n_qp, all divided
+     * by the average cost per quadrature point of all elements. Elements
+     * without measurements have a relative cost of one.
+     */
+    double getRelativeMeasuredCost(const libMesh::Elem* elem, unsigned int n_qp) const;
 
     /*!
      * Collect all of the active elements which are located within a local
@@ -1213,6 +1430,56 @@ private:
      */
     int getPatchLevel(const libMesh::Elem* elem) const;
 
+    /*!
+     * Quadrature rules, quadrature point positions, and JxW values of the
+     * elements on a single patch.
+     */
+    struct PatchQuadratureData
+    {
+        /*!
+         * The quadrature rule of each element.
+         */
+        std::vector<quadrature_key_type> quad_keys;
+
+        /*!
+         * Offset of the first quadrature point of each element, followed by
+         * the total number of quadrature points on the patch.
+         */
+        std::vector<unsigned int> qp_offsets;
+
+        /*!
+         * Positions of the quadrature points, stored contiguously.
+         */
+        std::vector<double> X_qp;
+
+        /*!
+         * JxW values at the quadrature points.
+         */
+        std::vector<double> JxW_qp;
+    };
+
+    /*!
+     * Determine whether or not the quadrature point cache entries for the
+     * processor interior (@p subset is 0) or processor boundary (@p subset
+     * is 1) elements were filled with the current values of @p X_vec and the
+     * given quadrature parameters. If they were not then the entries are
+     * marked as valid (and must be filled by the caller) and this function
+     * returns false.
+     *
+     * @note The data of the processor interior elements only depends on the
+     * locally owned entries of @p X_vec: neither the ghost entries nor the
+     * local form of @p X_vec are accessed when @p subset is 0, and in that
+     * case @p X_local_soln only needs to provide the locally owned entries.
+     */
+    bool checkQuadraturePointCache(libMesh::PetscVector<double>& X_vec,
+                                   const double* X_local_soln,
+                                   libMesh::QuadratureType quad_type,
+                                   libMesh::Order quad_order,
+                                   bool use_adaptive_quadrature,
+                                   double point_density,
+                                   bool allow_rules_with_negative_weights,
+                                   unsigned int subset);
+
     /*!
      * Collect all ghost DOF indices for the specified collection of elements.
      */
@@ -1266,6 +1533,52 @@ private:
      */
     bool d_enable_logging = false;
 
+    /*!
+     * Whether or not to distribute the element loops of spread() and
+     * interpWeighted() across OpenMP threads: see
+     * FEDataManager::setThreadedElementLoopsEnabled().
+     */
+    bool d_use_threaded_element_loops = false;
+
+    /*!
+     * Whether or not to cache quadrature point data between calls to spread()
+     * and interpWeighted(): see
+     * FEDataManager::setQuadraturePointCacheEnabled().
+     */
+    bool d_cache_quadrature_point_data = false;
+
+    /*!
+     * Whether or not to distinguish the processor interior and processor
+     * boundary elements of each patch: see
+     * FEDataManager::setElementSubsetsEnabled().
+     */
+    bool d_use_elem_subsets = false;
+
+    /*!
+     * Whether or not the quadrature point cache contains data for the
+     * processor interior and processor boundary elements of the current
+     * patch-element mappings.
+     */
+    std::array<bool, 2> d_qp_cache_valid = { { false, false } };
+
+    /*!
+     * Copies of the locally owned and of the ghost values of the position
+     * vector used to fill the quadrature point cache.
+     */
+    std::vector<double> d_qp_cache_X, d_qp_cache_X_ghost;
+
+    /*!
+     * Quadrature parameters used to fill the quadrature point cache.
+     */
+    std::tuple<libMesh::QuadratureType, libMesh::Order, bool, double, bool> d_qp_cache_quad_params;
+
+    /*!
+     * Cached quadrature point data, indexed by level number, local patch
+     * number, and element subset (processor interior or processor boundary
+     * elements).
+     */
+    std::vector<std::vector<std::array<PatchQuadratureData, 2> > > d_qp_cache_patch_data;
+
     /*!
      * Grid hierarchy information.
      */
@@ -1338,6 +1651,36 @@ private:
      */
     std::vector<std::vector<std::vector<libMesh::Elem*> > > d_active_patch_elem_map;
     std::vector<std::vector<std::vector<libMesh::Node*> > > d_active_patch_node_map;
+
+    /*!
+     * Number of processor interior elements (which are stored first) in each
+     * entry of d_active_patch_elem_map. This is zero if element subsets are
+     * not enabled.
+     */
+    std::vector<std::vector<std::size_t> > d_active_patch_n_interior_elems;
+
+    /*!
+     * Costs measured on this processor since the last workload estimate and
+     * the combined measurements used for workload estimates. Each maps the
+     * ids of elements on local patches to the time spent on the element (in
+     * seconds) and the number of quadrature points processed on it.
+     */
+    std::unordered_map<libMesh::dof_id_type, std::pair<double, double> > d_elem_new_measured_costs,
+        d_elem_measured_costs;
+
+    /*!
+     * Surface costs (in seconds) measured on this processor since the last
+     * workload estimate and the combined surface costs used for workload
+     * estimates (see addMeasuredSurfaceCost()).
+     */
+    std::unordered_map<libMesh::dof_id_type, double> d_elem_new_measured_surface_costs,
+        d_elem_measured_surface_costs;
+
+    /*!
+     * Average measured cost per quadrature point of all elements, or zero if
+     * no costs have been measured.
+     */
+    double d_average_measured_cost = 0.0;
     std::map<std::string, std::vector<unsigned int> > d_active_patch_ghost_dofs;
     std::vector<libMesh::Elem*> d_active_elems;
 
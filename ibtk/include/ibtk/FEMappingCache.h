@@ -22,6 +22,7 @@
 
 #include <ibtk/FECache.h>
 #include <ibtk/FEMapping.h>
+#include <ibtk/QuadratureKeyMap.h>
 #include <ibtk/libmesh_utilities.h>
 
 #include <libmesh/enum_elem_type.h>
@@ -29,7 +30,6 @@
 #include <libmesh/enum_quadrature_type.h>
 #include <libmesh/quadrature.h>
 
-#include <map>
 #include <memory>
 #include <tuple>
 
@@ -49,8 +49,8 @@ namespace IBTK
  * assumed to be equal (by this metric) to initialize different libMesh
  * objects.
  *
- * This class essentially provides a wrapper around std::map to manage
- * IBTK::FEMapping (and classes inheriting from it) objects.
+ * This class essentially provides a wrapper around IBTK::QuadratureKeyMap to
+ * manage IBTK::FEMapping (and classes inheriting from it) objects.
  */
 template <int dim, int spacedim = dim>
 class FEMappingCache
@@ -99,7 +99,7 @@ protected:
     /**
      * Managed IBTK::FEMapping objects.
      */
-    std::map<key_type, std::unique_ptr<FEMapping<dim, spacedim> > > d_mappings;
+    QuadratureKeyMap<FEMapping<dim, spacedim> > d_mappings;
 };
 
 template <int dim, int spacedim>
@@ -111,20 +111,18 @@ template <int dim, int spacedim>
 inline typename FEMappingCache<dim, spacedim>::value_type&
 FEMappingCache<dim, spacedim>::operator[](const FEMappingCache<dim, spacedim>::key_type& quad_key)
 {
-    auto it = d_mappings.find(quad_key);
-    if (it == d_mappings.end())
+    value_type* mapping = d_mappings.find(quad_key);
+    if (mapping == nullptr)
     {
         const libMesh::ElemType elem_type = std::get<0>(quad_key);
         const int elem_dim = get_dim(elem_type);
         TBOX_ASSERT(elem_dim == dim);
 
-        auto mapping = FEMapping<dim, spacedim>::build(quad_key, d_update_flags);
-        value_type& new_mapping = *(*d_mappings.emplace(quad_key, std::move(mapping)).first).second;
-        return new_mapping;
+        return d_mappings.insert(quad_key, FEMapping<dim, spacedim>::build(quad_key, d_update_flags));
     }
     else
     {
-        return *(it->second);
+        return *mapping;
     }
 }
 
@@ -51,8 +51,16 @@ namespace IBTK
  *   the initial guess (roughly N*N dot products, where N is the number of stored
  *   vector pairs) but will decrease the number of solver iterations. The default
  *   value lowers the number of solver iterations to, typically, no more than two
- *   or three, so its usually the right value.</li>
+ *   or three, so its usually the right value. A separate collection is stored
+ *   for each projection operator (i.e., for the consistent, lumped, and
+ *   stabilized mass matrices of each system) since solutions computed with one
+ *   matrix are not good initial guesses for another. Setting this value to zero
+ *   disables the initial guess, in which case the solver starts from the current
+ *   value of the solution vector.</li>
  * </ol>
+ *
+ * The solvers and their preconditioners are built once per system and reused by
+ * all subsequent projections.
  */
 class FEProjector
 {
@@ -191,7 +199,11 @@ protected:
     std::map<std::string, std::map<double, std::unique_ptr<libMesh::PetscLinearSolver<double> > > >
         d_stab_L2_proj_solver;
 
+    /// Stored solution and RHS pairs used to compute initial guesses for
+    /// projections with the consistent, lumped, and stabilized mass matrices.
     std::map<std::string, FischerGuess> d_initial_guesses;
+    std::map<std::string, FischerGuess> d_lumped_initial_guesses;
+    std::map<std::string, std::map<double, FischerGuess> > d_stab_initial_guesses;
 
 private:
     /*!
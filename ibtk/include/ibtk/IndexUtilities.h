@@ -30,6 +30,7 @@
 #include "IntVector.h"
 #include "Patch.h"
 
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -215,6 +216,32 @@ public:
                                                            const SAMRAI::hier::IntVector<NDIM>& box_size,
                                                            const SAMRAI::hier::IntVector<NDIM>& overlap_size);
 
+    /*!
+     * \brief Compute the position of the cell \em i along a Morton (Z-order)
+     * space-filling curve.
+     *
+     * \param i The index of the cell.
+     *
+     * \param lower The origin of the curve. All components of \em i must be
+     * no smaller than the corresponding components of \em lower.
+     *
+     * \return A key such that sorting cells by their keys orders them along the
+     * curve. Keys are only distinct for offsets smaller than 2^32 (2D) or
+     * 2^21 (3D) cells along each axis.
+     */
+    static std::uint64_t getMortonKey(const SAMRAI::hier::Index<NDIM>& i, const SAMRAI::hier::Index<NDIM>& lower);
+
+    /*!
+     * \brief Compute the position of the cell \em i along a Hilbert
+     * space-filling curve.
+     *
+     * Unlike the Morton curve, consecutive cells along a Hilbert curve are
+     * always face neighbors, which typically results in better locality.
+     *
+     * \see getMortonKey()
+     */
+    static std::uint64_t getHilbertKey(const SAMRAI::hier::Index<NDIM>& i, const SAMRAI::hier::Index<NDIM>& lower);
+
 private:
     /*!
      * \brief Default constructor.
@@ -29,6 +29,7 @@ IBTK_DISABLE_EXTRA_WARNINGS
 #include <boost/multi_array.hpp>
 IBTK_ENABLE_EXTRA_WARNINGS
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -261,10 +262,14 @@ public:
      * \brief Restore any arrays extracted via calls to getArray(),
      * getLocalFormArray(), and getGhostedLocalFormArray().
      *
+     * If \em values_modified is false, the caller guarantees that the values
+     * stored in the extracted arrays were only read, and the version number of
+     * the object (see getVersion()) is not changed.
+     *
      * \note Any outstanding references to the underlying array data are
      * invalidated by restoreArrays().
      */
-    void restoreArrays();
+    void restoreArrays(bool values_modified = true);
 
     /*!
      * \brief Begin updating ghost values.
@@ -276,6 +281,19 @@ public:
      */
     void endGhostUpdate();
 
+    /*!
+     * \brief Returns the version number of the data stored in this object.
+     *
+     * Version numbers are unique across all LData objects and a new version
+     * number is assigned whenever the stored values may have been modified:
+     * i.e., by resetData(), by getVec() (which permits arbitrary modification
+     * of the underlying PETSc Vec), by restoreArrays() when arrays were
+     * previously extracted, and by endGhostUpdate() when the ghost values were
+     * not already up to date. Two calls to getVersion() that return the same
+     * value are therefore guaranteed to refer to the same data.
+     */
+    std::size_t getVersion() const;
+
     /*!
      * \brief Write out object state to the given database.
      */
@@ -310,6 +328,20 @@ private:
     void getArrayCommon();
     void getGhostedLocalFormArrayCommon();
 
+    /*
+     * Assign a new version number to the data.
+     */
+    void updateVersion();
+
+    /*
+     * The version number of the data, the version number for which the ghost
+     * values were last updated, and the counter used to generate unique
+     * version numbers.
+     */
+    std::size_t d_version = 0;
+    std::size_t d_ghost_update_version = 0;
+    static std::size_t s_version_counter;
+
     /*
      * The name of the LData object.
      */
@@ -20,12 +20,14 @@
 
 #include <ibtk/config.h>
 
+#include "ibtk/LEInteractorWeightCache.h"
 #include "ibtk/LInitStrategy.h"
 #include "ibtk/LNodeSet.h"
 #include "ibtk/LNodeSetVariable.h"
 #include "ibtk/LSiloDataWriter.h"
 #include "ibtk/ParallelSet.h"
 #include "ibtk/SAMRAIDataCache.h"
+#include "ibtk/ibtk_enums.h"
 #include "ibtk/ibtk_utilities.h"
 
 #include "BasePatchLevel.h"
@@ -275,6 +277,32 @@ public:
      */
     const std::string& getDefaultSpreadKernelFunction() const;
 
+    /*!
+     * \brief Set the ordering of the local Lagrangian nodes within each patch.
+     *
+     * With the default ordering (LNODE_ORDERING_NONE), the local nodes of each
+     * patch are numbered in the order in which they are stored in the
+     * LNodeSetData. With LNODE_ORDERING_MORTON or LNODE_ORDERING_HILBERT, the
+     * local nodes of each patch are instead sorted by the position of the
+     * cells that contain them along the corresponding space-filling curve
+     * (see IndexUtilities::getMortonKey() and
+     * IndexUtilities::getHilbertKey()), so that consecutive entries of the
+     * Lagrangian data vectors are spread to and interpolated from nearby grid
+     * cells.
+     *
+     * \note The ordering is applied whenever the distribution of the nodes is
+     * recomputed at the end of a data redistribution (i.e., after each
+     * regrid). The initial ordering of the nodes is determined by the
+     * LInitStrategy.
+     */
+    void setNodeOrdering(LNodeOrderingType node_ordering);
+
+    /*!
+     * \brief Return the ordering of the local Lagrangian nodes within each
+     * patch.
+     */
+    LNodeOrderingType getNodeOrdering() const;
+
     /*!
      * \brief Spread a quantity from the Lagrangian mesh to the Eulerian grid
      * using the default spreading kernel function.
@@ -1193,6 +1221,17 @@ private:
     const std::string d_default_interp_kernel_fcn;
     const std::string d_default_spread_kernel_fcn;
 
+    /*
+     * Cached interpolation and spreading stencils for each level of the patch
+     * hierarchy (see LEInteractor::setFromDatabase()).
+     */
+    std::vector<LEInteractorWeightCache> d_weight_caches;
+
+    /*
+     * The ordering of the local Lagrangian nodes within each patch.
+     */
+    LNodeOrderingType d_node_ordering = LNODE_ORDERING_NONE;
+
     /*
      * Whether to emit an error message if IB points "escape" from the computational
      * domain.
@@ -39,6 +39,7 @@ class multi_array;
 namespace IBTK
 {
 class LData;
+class LEInteractorWeightCache;
 template <class T>
 class LIndexSetData;
 } // namespace IBTK
@@ -88,6 +89,35 @@ public:
 
     /*!
      * \brief Set configuration options from a user-supplied database.
+     *
+     * The following options are supported:
+     * - <code>spread_mode</code>: either <code>"SERIAL"</code> (default) or
+     *   <code>"COLORED_TILES"</code>. In the latter case, the Lagrangian
+     *   points in each patch are partitioned into spatial tiles, the tiles
+     *   are colored so that the kernel stencils of points in distinct tiles of
+     *   the same color never overlap, and the tiles of each color are spread
+     *   concurrently (via OpenMP, when IBTK is compiled with OpenMP support)
+     *   without any atomic operations. For a fixed tile size, the results do
+     *   not depend on the number of threads.
+     * - <code>spread_tile_size</code>: the width of each tile, in grid cells
+     *   (default 8). Tiles are always made at least twice as wide as the
+     *   minimum ghost cell width of the spreading kernel.
+     * - <code>kernel_implementation</code>: either <code>"FORTRAN"</code>
+     *   (default) or <code>"TEMPLATED"</code>. In the latter case,
+     *   interpolation and spreading with the PIECEWISE_LINEAR, IB_3, IB_4,
+     *   IB_4_W8, IB_5, IB_6, and BSPLINE_3 through BSPLINE_6 kernels use C++
+     *   implementations in which the stencil width is a compile-time
+     *   constant, so that the tensor-product loops can be unrolled and
+     *   vectorized by the compiler. Other kernels always use the Fortran
+     *   implementations.
+     * - <code>use_weight_cache</code>: whether to reuse the kernel weights
+     *   stored in the LEInteractorWeightCache objects passed to interpolate()
+     *   and spread() (default FALSE). When enabled, the stencils of the
+     *   Lagrangian points are computed once per version of the positions (see
+     *   LData::getVersion()) and reused until the positions are modified.
+     *   Caching is only done for the kernels that have templated
+     *   implementations and, when spreading, with the <code>"SERIAL"</code>
+     *   spread mode.
      */
     static void setFromDatabase(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db);
 
@@ -137,7 +167,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -162,7 +193,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -187,7 +219,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -212,7 +245,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -239,7 +273,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -266,7 +301,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -293,7 +329,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -320,7 +357,8 @@ public:
                             SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                             const SAMRAI::hier::Box<NDIM>& interp_box,
                             const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                            const std::string& interp_fcn = "IB_4");
+                            const std::string& interp_fcn = "IB_4",
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
@@ -651,7 +689,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -679,7 +718,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -707,7 +747,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -735,7 +776,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -765,7 +807,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -795,7 +838,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -825,7 +869,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -855,7 +900,8 @@ public:
                        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                        const SAMRAI::hier::Box<NDIM>& spread_box,
                        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                       const std::string& spread_fcn = "IB_4");
+                       const std::string& spread_fcn = "IB_4",
+                       LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * \brief Spread data from a Lagrangian mesh to an Eulerian grid.  The
@@ -1232,6 +1278,26 @@ private:
      */
     LEInteractor& operator=(const LEInteractor& that) = delete;
 
+    /*!
+     * \brief The algorithm used to spread values onto patches.
+     */
+    static std::string s_spread_mode;
+
+    /*!
+     * \brief The width of each tile when spreading with colored tiles.
+     */
+    static int s_spread_tile_size;
+
+    /*!
+     * \brief The implementation of the standard kernel functions to use.
+     */
+    static std::string s_kernel_implementation;
+
+    /*!
+     * \brief Whether to reuse cached interpolation and spreading stencils.
+     */
+    static bool s_use_weight_cache;
+
     /*!
      * Implementation of the IB interpolation operation.
      */
@@ -1250,7 +1316,8 @@ private:
                             const std::vector<int>& local_indices,
                             const std::vector<double>& periodic_shifts,
                             const std::string& interp_fcn,
-                            int axis = 0);
+                            int axis = 0,
+                            LEInteractorWeightCache* weight_cache = nullptr);
 
     /*!
      * Implementation of the IB spreading operation.
@@ -1270,7 +1337,47 @@ private:
                        const std::vector<int>& local_indices,
                        const std::vector<double>& periodic_shifts,
                        const std::string& spread_fcn,
-                       int axis = 0);
+                       int axis = 0,
+                       LEInteractorWeightCache* weight_cache = nullptr);
+
+    /*!
+     * Spread the values of the specified points by calling the kernel that
+     * corresponds to spread_fcn.
+     */
+    static void spreadPoints(double* q_data,
+                             const SAMRAI::hier::Box<NDIM>& q_data_box,
+                             const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+                             int q_depth,
+                             const double* Q_data,
+                             int Q_depth,
+                             const double* X_data,
+                             const double* x_lower,
+                             const double* x_upper,
+                             const double* dx,
+                             const int* local_indices,
+                             const double* periodic_shifts,
+                             int local_indices_size,
+                             const std::string& spread_fcn,
+                             int axis);
+
+    /*!
+     * Implementation of the IB spreading operation that partitions the points
+     * into colored tiles and spreads all tiles of a given color concurrently.
+     */
+    static void spreadColoredTiles(double* q_data,
+                                   const SAMRAI::hier::Box<NDIM>& q_data_box,
+                                   const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+                                   int q_depth,
+                                   const double* Q_data,
+                                   int Q_depth,
+                                   const double* X_data,
+                                   const double* x_lower,
+                                   const double* x_upper,
+                                   const double* dx,
+                                   const std::vector<int>& local_indices,
+                                   const std::vector<double>& periodic_shifts,
+                                   const std::string& spread_fcn,
+                                   int axis);
 
     /*!
      * \brief Compute the local PETSc indices located within the provided box
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBTK_LEInteractorWeightCache
+#define included_IBTK_LEInteractorWeightCache
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibtk/config.h>
+
+#include "Box.h"
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class LEInteractorWeightCache stores the interpolation and spreading
+ * stencils computed by LEInteractor for a fixed set of Lagrangian positions on
+ * a single patch level so that they can be reused by subsequent calls to
+ * LEInteractor::interpolate() and LEInteractor::spread().
+ *
+ * For each patch, data centering, and kernel function, the cache stores the
+ * lower corner of the stencil of each Lagrangian point along with the 1D
+ * kernel weights along each axis. The cached values are associated with the
+ * version number of the LData object that stores the positions of the
+ * Lagrangian points (see LData::getVersion()) and are discarded as soon as
+ * LEInteractor is called with a different version of the positions.
+ *
+ * Stencils are only cached for kernel functions that have templated
+ * implementations (see LEInteractor::setFromDatabase()) and only when
+ * spreading with the <code>"SERIAL"</code> spread mode; all other cases ignore
+ * the cache.
+ */
+class LEInteractorWeightCache
+{
+public:
+    /*!
+     * \brief Default constructor.
+     */
+    LEInteractorWeightCache() = default;
+
+    /*!
+     * \brief Remove all cached stencils.
+     */
+    void clear();
+
+    /*!
+     * \brief Returns the number of bytes currently used to store cached
+     * stencils.
+     */
+    std::size_t getMemoryUsage() const;
+
+    /*!
+     * \brief The stencils of a list of Lagrangian points on a single patch
+     * data box.
+     */
+    struct Stencils
+    {
+        std::string kernel_fcn;
+        std::array<double, NDIM> x_lower;
+        std::array<double, NDIM> dx;
+        std::vector<int> local_indices;
+        std::vector<double> periodic_shifts;
+        std::vector<int> stencil_lower;
+        std::vector<double> weights;
+
+        /*!
+         * \brief Determine whether the stencils were computed for the given
+         * kernel function, patch data geometry, and list of points.
+         */
+        bool isValid(const std::string& kernel_fcn,
+                     const double* x_lower,
+                     const double* dx,
+                     const int* local_indices,
+                     const double* periodic_shifts,
+                     int local_indices_size) const;
+    };
+
+    /*!
+     * \brief Associate the cache with the given version of the Lagrangian
+     * positions, discarding all cached stencils if that version differs from
+     * the one used to compute them.
+     *
+     * The LData-based interfaces of LEInteractor call this function
+     * automatically. Callers that pass raw arrays of positions to LEInteractor
+     * must call this function whenever the positions change.
+     */
+    void setPositionVersion(std::size_t X_version);
+
+private:
+    friend class LEInteractor;
+
+    /*!
+     * \brief Return the (possibly empty) stencils associated with the given
+     * patch data box.
+     *
+     * Interpolation and spreading typically use different lists of Lagrangian
+     * points (those in the patch interior and those in the ghost box,
+     * respectively), so their stencils are stored separately.
+     */
+    Stencils& getStencils(const SAMRAI::hier::Box<NDIM>& q_data_box, bool spread);
+
+    /*!
+     * The version of the positions used to compute the cached stencils.
+     */
+    std::size_t d_X_version = 0;
+
+    /*!
+     * The cached stencils, indexed by the lower and upper corners of the
+     * patch data box and by whether they are used for spreading.
+     */
+    std::map<std::array<int, 2 * NDIM + 1>, Stencils> d_stencils;
+};
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_IBTK_LEInteractorWeightCache
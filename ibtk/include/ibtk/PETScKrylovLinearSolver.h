@@ -88,11 +88,23 @@ namespace IBTK
  *   caller's responsibility to ensure that the supplied KSP object is properly
  *   destroyed via KSPDestroy().
  *
+ * If pipelined Krylov methods are enabled (see setPipelinedKrylovEnabled()),
+ * the KSP types "gmres", "fgmres", "cg", and "cr" are replaced by their
+ * pipelined variants "pgmres", "pipefgmres", "pipecg", and "pipecr". These
+ * variants use the same number of operator and preconditioner applications
+ * per iteration as the standard methods, but they start their global
+ * reductions with nonblocking MPI collectives and complete them only after
+ * the next operator or preconditioner application, so that the latency of the
+ * reductions is hidden on large numbers of processors. The pipelined variants
+ * are somewhat less stable in finite precision arithmetic than the standard
+ * methods. Other KSP types are not modified.
+ *
  * Sample parameters for initialization from database (and their default
  * values): \verbatim
 
  options_prefix = ""           // see setOptionsPrefix()
  ksp_type = "gmres"            // see setKSPType()
+ use_pipelined_krylov = FALSE  // see setPipelinedKrylovEnabled()
  initial_guess_nonzero = TRUE  // see setInitialGuessNonzero()
  rel_residual_tol = 1.0e-5     // see setRelativeTolerance()
  abs_residual_tol = 1.0e-50    // see setAbsoluteTolerance()
@@ -152,6 +164,16 @@ public:
      */
     void setKSPType(const std::string& ksp_type);
 
+    /*!
+     * \brief Enable or disable the use of the pipelined variants of the
+     * standard Krylov methods.
+     *
+     * The KSP type set by setKSPType() is not modified, so that the standard
+     * method is used again once the pipelined variants are disabled and the
+     * solver state is reinitialized.
+     */
+    void setPipelinedKrylovEnabled(bool use_pipelined_krylov = true);
+
     /*!
      * \brief Set the options prefix used by this PETSc solver object.
      */
@@ -388,6 +410,7 @@ private:
     //\}
 
     std::string d_ksp_type;
+    bool d_use_pipelined_krylov = false;
 
     bool d_reinitializing_solver = false;
 
@@ -53,6 +53,22 @@ namespace IBTK
  * through the static member functions that create and destroy PETSc vector
  * objects.
  *
+ * The local reduction operations of the wrapped PETSc vectors (e.g., the
+ * operation used by VecDot_local()) only sum the contributions of the local
+ * patches and never communicate.  PETSc uses them to implement split-phase
+ * reductions (VecDotBegin()/VecDotEnd(), VecNormBegin()/VecNormEnd(), and
+ * VecMDotBegin()/VecMDotEnd()), which start a nonblocking reduction that may
+ * be completed after other work has been done.  The pipelined Krylov methods
+ * (see PETScKrylovLinearSolver) use these reductions to overlap communication
+ * with operator and preconditioner applications.  The operations that require
+ * several reductions (e.g., VecDotNorm2()) combine them into a single
+ * reduction.  When all components of the vectors are cell-centered or
+ * side-centered, the operations that act on several vectors (VecMDot(),
+ * VecMTDot(), VecMAXPY(), and VecDotNorm2()) also traverse the patch data only
+ * once, so that each row of data of the first vector is loaded once for all of
+ * the other vectors.  The results agree with those of the corresponding
+ * sequence of single-vector operations up to roundoff.
+ *
  * Finally, we remark that PETSc allows vectors with complex-valued entries.
  * This class and the class SAMRAI::solv::SAMRAIVectorReal assume real-values
  * vectors, i.e., data of type \p double or \p float.  The (currently
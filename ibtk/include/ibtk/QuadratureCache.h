@@ -20,6 +20,7 @@
 
 #include <ibtk/config.h>
 
+#include <ibtk/QuadratureKeyMap.h>
 #include <ibtk/libmesh_utilities.h>
 
 #include <libmesh/enum_elem_type.h>
@@ -27,7 +28,6 @@
 #include <libmesh/enum_quadrature_type.h>
 #include <libmesh/quadrature.h>
 
-#include <map>
 #include <memory>
 #include <tuple>
 
@@ -42,8 +42,8 @@ namespace IBTK
  * make this assumption, e.g., we will use data from two quadrature rules
  * assumed to be equal (by this metric) to initialize FEMap objects.
  *
- * This class essentially provides a wrapper around std::map to manage
- * libMesh::QBase (and classes inheriting from it) objects.
+ * This class essentially provides a wrapper around IBTK::QuadratureKeyMap to
+ * manage libMesh::QBase (and classes inheriting from it) objects.
  */
 class QuadratureCache
 {
@@ -94,7 +94,7 @@ protected:
     /**
      * Managed libMesh::Quadrature objects.
      */
-    std::map<key_type, std::unique_ptr<libMesh::QBase> > d_quadratures;
+    QuadratureKeyMap<libMesh::QBase> d_quadratures;
 };
 
 inline QuadratureCache::QuadratureCache(const unsigned int dim) : d_dim(dim)
@@ -105,23 +105,22 @@ inline QuadratureCache::value_type&
 QuadratureCache::operator[](const QuadratureCache::key_type& quad_key)
 {
     TBOX_ASSERT(static_cast<unsigned int>(get_dim(std::get<0>(quad_key))) == d_dim);
-    auto it = d_quadratures.find(quad_key);
-    if (it == d_quadratures.end())
+    libMesh::QBase* quad = d_quadratures.find(quad_key);
+    if (quad == nullptr)
     {
         const libMesh::ElemType elem_type = std::get<0>(quad_key);
         const libMesh::QuadratureType quad_type = std::get<1>(quad_key);
         const libMesh::Order order = std::get<2>(quad_key);
         const bool allow_rules_with_negative_weights = std::get<3>(quad_key);
 
-        libMesh::QBase& new_quad =
-            *(*d_quadratures.emplace(quad_key, libMesh::QBase::build(quad_type, d_dim, order)).first).second;
+        libMesh::QBase& new_quad = d_quadratures.insert(quad_key, libMesh::QBase::build(quad_type, d_dim, order));
         new_quad.allow_rules_with_negative_weights = allow_rules_with_negative_weights;
         new_quad.init(elem_type);
         return new_quad;
     }
     else
     {
-        return *(it->second);
+        return *quad;
     }
 }
 
@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBTK_QuadratureKeyMap
+#define included_IBTK_QuadratureKeyMap
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibtk/config.h>
+
+#include <ibtk/libmesh_utilities.h>
+
+#include <tbox/Utilities.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/**
+ * \brief Class mapping quadrature keys (see IBTK::quadrature_key_type) to
+ * objects of type <code>T</code>. This is the storage used by QuadratureCache,
+ * FECache, and FEMappingCache.
+ *
+ * These caches are accessed once per element in every loop over elements but,
+ * even with adaptive quadrature, only a handful of different keys occur in
+ * practice and consecutive elements usually use the same one. Hence this
+ * class packs each key into a single integer, stores the values in a small
+ * open-addressed hash table with linear probing, and checks the most recently
+ * used entry before searching the table. This is considerably cheaper than
+ * the tuple comparisons required by std::map.
+ *
+ * Values are stored by pointer, so references to them remain valid until the
+ * map is cleared.
+ */
+template <typename T>
+class QuadratureKeyMap
+{
+public:
+    /**
+     * Key type. Completely describes (excepting p-refinement) a libMesh
+     * quadrature rule.
+     */
+    using key_type = quadrature_key_type;
+
+    /**
+     * Type of values stored by this class.
+     */
+    using value_type = T;
+
+    /**
+     * Return a pointer to the value associated with @p quad_key, or
+     * <code>nullptr</code> if there is no such value.
+     */
+    value_type* find(const key_type& quad_key);
+
+    /**
+     * Associate @p value with @p quad_key, which must not already be present
+     * in the map, and return a reference to the value.
+     */
+    value_type& insert(const key_type& quad_key, std::unique_ptr<value_type> value);
+
+    /**
+     * Return the number of stored values.
+     */
+    std::size_t size() const
+    {
+        return d_n_entries;
+    }
+
+    /**
+     * Remove all stored values.
+     */
+    void clear()
+    {
+        d_entries.clear();
+        d_n_entries = 0;
+        d_mru_index = invalid_index;
+    }
+
+private:
+    /**
+     * Pack a key into a single integer. Each of the enumerations has fewer
+     * than 2^16 values so this is one-to-one.
+     */
+    static std::uint64_t pack(const key_type& quad_key);
+
+    /**
+     * Index of the first slot to check for a packed key in a table with
+     * @p n_slots slots (which must be a power of two).
+     */
+    static std::size_t getSlot(std::uint64_t packed_key, std::size_t n_slots);
+
+    /**
+     * Resize the table to @p n_slots slots and reinsert all values.
+     */
+    void rehash(std::size_t n_slots);
+
+    struct Entry
+    {
+        std::uint64_t packed_key = 0;
+        std::unique_ptr<value_type> value;
+    };
+
+    static constexpr std::size_t invalid_index = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Hash table slots. Unoccupied slots have a null value.
+     */
+    std::vector<Entry> d_entries;
+
+    /**
+     * Number of occupied slots.
+     */
+    std::size_t d_n_entries = 0;
+
+    /**
+     * Index of the most recently accessed slot.
+     */
+    std::size_t d_mru_index = invalid_index;
+};
+
+template <typename T>
+constexpr std::size_t QuadratureKeyMap<T>::invalid_index;
+
+template <typename T>
+inline std::uint64_t
+QuadratureKeyMap<T>::pack(const key_type& quad_key)
+{
+    const auto elem_type = static_cast<std::uint64_t>(std::get<0>(quad_key));
+    const auto quad_type = static_cast<std::uint64_t>(std::get<1>(quad_key));
+    const auto order = static_cast<std::uint64_t>(std::get<2>(quad_key));
+    const auto allow_rules_with_negative_weights = static_cast<std::uint64_t>(std::get<3>(quad_key));
+#ifndef NDEBUG
+    TBOX_ASSERT(elem_type < (1u << 16) && quad_type < (1u << 16) && order < (1u << 16));
+#endif
+    return elem_type | (quad_type << 16) | (order << 32) | (allow_rules_with_negative_weights << 48);
+}
+
+template <typename T>
+inline std::size_t
+QuadratureKeyMap<T>::getSlot(const std::uint64_t packed_key, const std::size_t n_slots)
+{
+    // Fibonacci hashing: the high bits of the product are well mixed.
+    return static_cast<std::size_t>((packed_key * 11400714819323198485ull) >> 32) & (n_slots - 1);
+}
+
+template <typename T>
+inline typename QuadratureKeyMap<T>::value_type*
+QuadratureKeyMap<T>::find(const key_type& quad_key)
+{
+    const std::uint64_t packed_key = pack(quad_key);
+    if (d_mru_index != invalid_index && d_entries[d_mru_index].packed_key == packed_key)
+    {
+        return d_entries[d_mru_index].value.get();
+    }
+    if (d_entries.empty()) return nullptr;
+
+    const std::size_t n_slots = d_entries.size();
+    for (std::size_t slot = getSlot(packed_key, n_slots);; slot = (slot + 1) & (n_slots - 1))
+    {
+        Entry& entry = d_entries[slot];
+        if (!entry.value) return nullptr;
+        if (entry.packed_key == packed_key)
+        {
+            d_mru_index = slot;
+            return entry.value.get();
+        }
+    }
+}
+
+template <typename T>
+inline typename QuadratureKeyMap<T>::value_type&
+QuadratureKeyMap<T>::insert(const key_type& quad_key, std::unique_ptr<value_type> value)
+{
+    TBOX_ASSERT(value);
+    TBOX_ASSERT(find(quad_key) == nullptr);
+    // Keep the load factor at or below one half so that probe sequences stay
+    // short and always terminate at an unoccupied slot.
+    if (2 * (d_n_entries + 1) > d_entries.size()) rehash(std::max<std::size_t>(8, 2 * d_entries.size()));
+
+    const std::uint64_t packed_key = pack(quad_key);
+    const std::size_t n_slots = d_entries.size();
+    std::size_t slot = getSlot(packed_key, n_slots);
+    while (d_entries[slot].value) slot = (slot + 1) & (n_slots - 1);
+    d_entries[slot].packed_key = packed_key;
+    d_entries[slot].value = std::move(value);
+    ++d_n_entries;
+    d_mru_index = slot;
+    return *d_entries[slot].value;
+}
+
+template <typename T>
+inline void
+QuadratureKeyMap<T>::rehash(const std::size_t n_slots)
+{
+    std::vector<Entry> old_entries(n_slots);
+    old_entries.swap(d_entries);
+    for (Entry& old_entry : old_entries)
+    {
+        if (!old_entry.value) continue;
+        std::size_t slot = getSlot(old_entry.packed_key, n_slots);
+        while (d_entries[slot].value) slot = (slot + 1) & (n_slots - 1);
+        d_entries[slot] = std::move(old_entry);
+    }
+    d_mru_index = invalid_index;
+    return;
+}
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_IBTK_QuadratureKeyMap
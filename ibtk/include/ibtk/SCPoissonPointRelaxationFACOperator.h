@@ -30,6 +30,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace SAMRAI
@@ -79,6 +80,9 @@ namespace IBTK
  * values): \verbatim
 
  smoother_type = "PATCH_GAUSS_SEIDEL"         // see setSmootherType()
+ chebyshev_num_power_iterations = 10          // see setSmootherType()
+ chebyshev_min_eigenvalue_factor = 0.1        // see setSmootherType()
+ chebyshev_max_eigenvalue_factor = 1.1        // see setSmootherType()
  prolongation_method = "CONSTANT_REFINE"      // see setProlongationMethod()
  restriction_method = "CONSERVATIVE_COARSEN"  // see setRestrictionMethod()
  coarse_solver_type = "HYPRE_LEVEL_SOLVER"    // see setCoarseSolverType()
@@ -129,6 +133,21 @@ public:
      * - \c "PATCH_GAUSS_SEIDEL"
      * - \c "PROCESSOR_GAUSS_SEIDEL"
      * - \c "RED_BLACK_GAUSS_SEIDEL"
+     * - \c "RED_BLACK_GAUSS_SEIDEL_THREADED"
+     * - \c "L1_JACOBI"
+     * - \c "CHEBYSHEV"
+     *
+     * \c "RED_BLACK_GAUSS_SEIDEL_THREADED" performs the same red-black sweeps
+     * as \c "RED_BLACK_GAUSS_SEIDEL" with the kernel in patch_smoothers.h,
+     * which vectorizes each sweep and, when IBTK is compiled with OpenMP,
+     * updates the cells of large patches with multiple threads.
+     *
+     * \c "L1_JACOBI" and \c "CHEBYSHEV" are polynomial smoothers that only
+     * require one ghost cell fill per sweep. \c "L1_JACOBI" uses the l1-Jacobi
+     * diagonal, and so does not require a damping factor. \c "CHEBYSHEV" uses
+     * Chebyshev acceleration of Jacobi iterations; see
+     * CCPoissonPointRelaxationFACOperator::setSmootherType() for a description
+     * of the chebyshev_* input parameters.
      */
     void setSmootherType(const std::string& smoother_type) override;
 
@@ -253,6 +272,26 @@ private:
      * \return A reference to this object.
      */
     SCPoissonPointRelaxationFACOperator& operator=(const SCPoissonPointRelaxationFACOperator& that) = delete;
+
+    /*!
+     * \brief Return an estimate of the largest eigenvalue of the
+     * Jacobi-preconditioned operator on the specified level, which is computed
+     * by power iterations when no valid cached value is available.
+     *
+     * \note This overwrites the scratch data on the level.
+     */
+    double getMaxEigenvalueEstimate(int level_num);
+
+    /*
+     * Chebyshev smoother parameters and the cached eigenvalue estimates on
+     * each level, along with the values of D and C for which they were
+     * computed.
+     */
+    int d_chebyshev_num_power_iterations = 10;
+    double d_chebyshev_min_eigenvalue_factor = 0.1;
+    double d_chebyshev_max_eigenvalue_factor = 1.1;
+    std::vector<double> d_max_eigenvalue_estimates;
+    std::vector<std::pair<double, double> > d_max_eigenvalue_estimate_coefs;
 };
 } // namespace IBTK
 
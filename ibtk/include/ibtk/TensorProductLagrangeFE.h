@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBTK_TensorProductLagrangeFE
+#define included_IBTK_TensorProductLagrangeFE
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibtk/config.h>
+
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/enum_order.h"
+#include "libmesh/enum_quadrature_type.h"
+#include "libmesh/fe_type.h"
+
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class TensorProductLagrangeFE evaluates Lagrange finite element
+ * fields and their gradients at the points of tensor-product Gauss rules, and
+ * integrates against the gradients of the shape functions, by sum
+ * factorization.
+ *
+ * On a quadrilateral or hexahedral element with (p + 1)^d nodes and n^d
+ * quadrature points, evaluating a gradient from the shape function tables
+ * costs O((p + 1)^d n^d) operations. Applying the one-dimensional tables one
+ * coordinate direction at a time reduces this to O(d (p + 1) n^d) operations
+ * (assuming n >= p + 1).
+ *
+ * All computations are done on the reference element: nodal values are given
+ * in libMesh's local node ordering, and values at quadrature points are stored
+ * in the same order as the points of the corresponding libMesh QGauss rule
+ * (i.e., with the first coordinate varying fastest). Gradients and fluxes are
+ * stored point by point, i.e., component k at quadrature point q is entry
+ * <code>q * dim + k</code>. Mapping to physical coordinates is the
+ * responsibility of the caller.
+ *
+ * The supported elements are QUAD4 and HEX8 with FIRST order LAGRANGE bases
+ * and QUAD9 and HEX27 with SECOND order LAGRANGE bases.
+ */
+class TensorProductLagrangeFE
+{
+public:
+    /*!
+     * \brief Whether or not this class supports an element type, finite
+     * element type, and quadrature rule type. The basis must be the one
+     * naturally associated with the element (i.e., the one which is also used
+     * for the geometric mapping).
+     */
+    static bool isSupported(libMesh::ElemType elem_type,
+                            const libMesh::FEType& fe_type,
+                            libMesh::QuadratureType quad_type);
+
+    /*!
+     * \brief Constructor. Set up the one-dimensional tables for elements of
+     * type @p elem_type and a Gauss rule of order @p quad_order.
+     */
+    TensorProductLagrangeFE(libMesh::ElemType elem_type, libMesh::Order quad_order);
+
+    /*!
+     * \brief Return the dimension of the element.
+     */
+    unsigned int getDimension() const;
+
+    /*!
+     * \brief Return the number of nodes (and shape functions) of the element.
+     */
+    unsigned int getNumberOfNodes() const;
+
+    /*!
+     * \brief Return the number of quadrature points.
+     */
+    unsigned int getNumberOfQuadraturePoints() const;
+
+    /*!
+     * \brief Return the quadrature weights on the reference element.
+     */
+    const std::vector<double>& getQuadratureWeights() const;
+
+    /*!
+     * \brief Compute the values at the quadrature points of the field with
+     * nodal values @p nodal_values.
+     */
+    void interpolate(const double* nodal_values, double* qp_values) const;
+
+    /*!
+     * \brief Compute the gradients with respect to the reference coordinates
+     * at the quadrature points of the field with nodal values
+     * @p nodal_values.
+     */
+    void interpolateGradient(const double* nodal_values, double* qp_gradients) const;
+
+    /*!
+     * \brief Add the integrals of the reference gradients of the shape
+     * functions against the fluxes @p qp_fluxes to @p nodal_values, i.e.,
+     * compute
+     *
+     *    nodal_values[i] += sum_q sum_k qp_fluxes[q * dim + k] d_k phi_i(q).
+     *
+     * Quadrature weights are not applied: they should be included in the
+     * fluxes.
+     */
+    void integrateGradient(const double* qp_fluxes, double* nodal_values) const;
+
+private:
+    /*!
+     * \brief Apply a one-dimensional operator @p op with @p n_out rows and
+     * @p n_in columns in coordinate direction @p dir to the tensor-product
+     * array @p in whose extents are @p extents. On return, @p extents
+     * contains the extents of @p out.
+     */
+    void apply1D(const std::vector<double>& op,
+                 unsigned int n_out,
+                 unsigned int n_in,
+                 unsigned int dir,
+                 unsigned int* extents,
+                 const double* in,
+                 double* out) const;
+
+    unsigned int d_dim, d_n_nodes_1d, d_n_qp_1d, d_n_nodes, d_n_qp;
+
+    /*!
+     * One-dimensional shape function values and derivatives at the
+     * one-dimensional quadrature points (n_qp_1d x n_nodes_1d, row major) and
+     * their transposes.
+     */
+    std::vector<double> d_phi, d_dphi, d_phi_trans, d_dphi_trans;
+
+    /*!
+     * Tensor-product quadrature weights.
+     */
+    std::vector<double> d_weights;
+
+    /*!
+     * Index of each libMesh node in the lexicographic ordering of the
+     * tensor-product nodes.
+     */
+    std::vector<unsigned int> d_lexicographic_node_index;
+
+    /*!
+     * Scratch arrays.
+     */
+    mutable std::vector<double> d_lex_values, d_scratch_0, d_scratch_1;
+};
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_IBTK_TensorProductLagrangeFE
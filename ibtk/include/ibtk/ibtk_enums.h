@@ -207,6 +207,38 @@ enum_to_string<NodeOutsidePatchCheckType>(NodeOutsidePatchCheckType val)
     return "UNKNOWN_NODE_OUTSIDE_PATCH_CHECK_TYPE";
 } // enum_to_string
 
+/*!
+ * \brief Enumerated type for different orderings of the local Lagrangian
+ * nodes in each patch.
+ */
+enum LNodeOrderingType
+{
+    LNODE_ORDERING_NONE,
+    LNODE_ORDERING_MORTON,
+    LNODE_ORDERING_HILBERT,
+    UNKNOWN_LNODE_ORDERING_TYPE = -1
+};
+
+template <>
+inline LNodeOrderingType
+string_to_enum<LNodeOrderingType>(const std::string& val)
+{
+    if (strcasecmp(val.c_str(), "NONE") == 0) return LNODE_ORDERING_NONE;
+    if (strcasecmp(val.c_str(), "MORTON") == 0) return LNODE_ORDERING_MORTON;
+    if (strcasecmp(val.c_str(), "HILBERT") == 0) return LNODE_ORDERING_HILBERT;
+    return UNKNOWN_LNODE_ORDERING_TYPE;
+} // string_to_enum
+
+template <>
+inline std::string
+enum_to_string<LNodeOrderingType>(LNodeOrderingType val)
+{
+    if (val == LNODE_ORDERING_NONE) return "NONE";
+    if (val == LNODE_ORDERING_MORTON) return "MORTON";
+    if (val == LNODE_ORDERING_HILBERT) return "HILBERT";
+    return "UNKNOWN_LNODE_ORDERING_TYPE";
+} // enum_to_string
+
 } // namespace IBTK
 
 //////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,8 @@ IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <array>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 /////////////////////////////// FUNCTION DEFINITIONS /////////////////////////
 
@@ -362,10 +364,16 @@ batch_vec_assembly(const std::vector<std::vector<libMesh::PetscVector<double>*>
     }
 }
 
+/**
+ * Start updating the ghost values of each vector in @p vecs. The update must
+ * be completed by calling batch_vec_ghost_update_end() with the same
+ * arguments: in between, work which does not depend on the ghost values of
+ * these vectors can be done while the values are communicated.
+ */
 inline void
-batch_vec_ghost_update(const std::vector<libMesh::PetscVector<double>*>& vecs,
-                       const InsertMode insert_mode,
-                       const ScatterMode scatter_mode)
+batch_vec_ghost_update_begin(const std::vector<libMesh::PetscVector<double>*>& vecs,
+                             const InsertMode insert_mode,
+                             const ScatterMode scatter_mode)
 {
     for (const auto& v : vecs)
     {
@@ -373,6 +381,27 @@ batch_vec_ghost_update(const std::vector<libMesh::PetscVector<double>*>& vecs,
         int ierr = VecGhostUpdateBegin(v->vec(), insert_mode, scatter_mode);
         IBTK_CHKERRQ(ierr);
     }
+}
+
+inline void
+batch_vec_ghost_update_begin(const std::vector<std::vector<libMesh::PetscVector<double>*> >& vecs,
+                             const InsertMode insert_mode,
+                             const ScatterMode scatter_mode)
+{
+    for (unsigned int n = 0; n < vecs.size(); ++n)
+    {
+        batch_vec_ghost_update_begin(vecs[n], insert_mode, scatter_mode);
+    }
+}
+
+/**
+ * Finish updating the ghost values of each vector in @p vecs.
+ */
+inline void
+batch_vec_ghost_update_end(const std::vector<libMesh::PetscVector<double>*>& vecs,
+                           const InsertMode insert_mode,
+                           const ScatterMode scatter_mode)
+{
     for (const auto& v : vecs)
     {
         if (!v) continue;
@@ -382,30 +411,34 @@ batch_vec_ghost_update(const std::vector<libMesh::PetscVector<double>*>& vecs,
 }
 
 inline void
-batch_vec_ghost_update(const std::vector<std::vector<libMesh::PetscVector<double>*> >& vecs,
-                       const InsertMode insert_mode,
-                       const ScatterMode scatter_mode)
+batch_vec_ghost_update_end(const std::vector<std::vector<libMesh::PetscVector<double>*> >& vecs,
+                           const InsertMode insert_mode,
+                           const ScatterMode scatter_mode)
 {
     for (unsigned int n = 0; n < vecs.size(); ++n)
     {
-        for (const auto& v : vecs[n])
-        {
-            if (!v) continue;
-            int ierr = VecGhostUpdateBegin(v->vec(), insert_mode, scatter_mode);
-            IBTK_CHKERRQ(ierr);
-        }
-    }
-    for (unsigned int n = 0; n < vecs.size(); ++n)
-    {
-        for (const auto& v : vecs[n])
-        {
-            if (!v) continue;
-            int ierr = VecGhostUpdateEnd(v->vec(), insert_mode, scatter_mode);
-            IBTK_CHKERRQ(ierr);
-        }
+        batch_vec_ghost_update_end(vecs[n], insert_mode, scatter_mode);
     }
 }
 
+inline void
+batch_vec_ghost_update(const std::vector<libMesh::PetscVector<double>*>& vecs,
+                       const InsertMode insert_mode,
+                       const ScatterMode scatter_mode)
+{
+    batch_vec_ghost_update_begin(vecs, insert_mode, scatter_mode);
+    batch_vec_ghost_update_end(vecs, insert_mode, scatter_mode);
+}
+
+inline void
+batch_vec_ghost_update(const std::vector<std::vector<libMesh::PetscVector<double>*> >& vecs,
+                       const InsertMode insert_mode,
+                       const ScatterMode scatter_mode)
+{
+    batch_vec_ghost_update_begin(vecs, insert_mode, scatter_mode);
+    batch_vec_ghost_update_end(vecs, insert_mode, scatter_mode);
+}
+
 /**
  * Convenience function that calls setup_system_vector for all specified systems
  * and vector names. This function is aware of System::rhs and will reset it
@@ -1603,6 +1636,29 @@ std::vector<libMeshWrappers::BoundingBox>
 get_global_element_bounding_boxes(const libMesh::MeshBase& mesh,
                                   const std::vector<libMeshWrappers::BoundingBox>& local_bboxes);
 
+/**
+ * Send each bounding box in @p local_bboxes, which bounds the local element
+ * with id <code>local_elem_ids[i]</code>, to each processor that owns a
+ * region in @p region_bboxes that it intersects. The owner of
+ * <code>region_bboxes[j]</code> is <code>region_ranks[j]</code>: this list
+ * must be the same on every processor.
+ *
+ * Unlike get_global_element_bounding_boxes(), this function only
+ * communicates between processors that own nearby elements and regions, so
+ * its memory usage is proportional to the number of local and nearby
+ * elements rather than to the total number of elements.
+ *
+ * @return The ids and bounding boxes of all elements (local or not) whose
+ * bounding boxes intersect at least one of the regions owned by the current
+ * processor, sorted by element id.
+ */
+std::vector<std::pair<libMesh::dof_id_type, libMeshWrappers::BoundingBox> >
+get_nearby_element_bounding_boxes(const libMesh::MeshBase& mesh,
+                                  const std::vector<libMesh::dof_id_type>& local_elem_ids,
+                                  const std::vector<libMeshWrappers::BoundingBox>& local_bboxes,
+                                  const std::vector<libMeshWrappers::BoundingBox>& region_bboxes,
+                                  const std::vector<int>& region_ranks);
+
 /**
  * Compute bounding boxes for all elements in @p mesh with coordinates given
  * by @p X_system.
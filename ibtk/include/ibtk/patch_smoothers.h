@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBTK_patch_smoothers
+#define included_IBTK_patch_smoothers
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibtk/config.h>
+
+#include <Box.h>
+
+namespace IBTK
+{
+/**
+ * Perform a single "red" (@p red_or_black = 0) or "black" (@p red_or_black =
+ * 1) Gauss-Seidel half-sweep for F = D div grad U + C U with constant D and C
+ * on the cells of @p box. A cell with index i is "red" if the sum of the
+ * components of i is even.
+ *
+ * This computes the same values as the Fortran routine
+ * smooth_gs_rb_const_dc. The arrays @p U and @p F (and @p mask) store one
+ * depth of cell-centered data (or one axis of side-centered data, in which
+ * case @p box is the corresponding side box) with @p U_gcw (and @p F_gcw and
+ * @p mask_gcw) ghost cells in each direction, with the first index varying
+ * fastest. If @p mask is not <code>nullptr</code>, then values of U at which
+ * @p mask is nonzero are not modified, as in the Fortran routine
+ * rbgssmoothmask.
+ *
+ * Since cells of one color only depend on cells of the other color, all
+ * updates in a half-sweep are independent. Each row of cells is updated in a
+ * loop with a stride of two, which the compiler vectorizes, and when IBTK is
+ * compiled with OpenMP the rows of a sufficiently large box are split into
+ * contiguous blocks that are updated concurrently. The result does not depend
+ * on the number of threads.
+ */
+void red_black_gauss_seidel_const_dc(double* U,
+                                     int U_gcw,
+                                     double D,
+                                     double C,
+                                     const double* F,
+                                     int F_gcw,
+                                     const SAMRAI::hier::Box<NDIM>& box,
+                                     const double* dx,
+                                     int red_or_black,
+                                     const int* mask = nullptr,
+                                     int mask_gcw = 0);
+
+/**
+ * Compute the preconditioned residual Z = M^{-1} (F - A U) for A U = D div
+ * grad U + C U with constant D and C on the cells of @p box. If
+ * @p use_l1_diagonal is false, M is the diagonal of A (Jacobi). Otherwise, M
+ * is the l1-Jacobi diagonal, whose entries are a_ii + sgn(a_ii) sum_{j != i}
+ * |a_ij|, which makes the update U += Z convergent without a damping factor.
+ *
+ * The arrays @p U and @p F (and @p mask) are stored as in
+ * red_black_gauss_seidel_const_dc(), and @p F may be <code>nullptr</code>, in
+ * which case it is treated as zero. The array @p Z stores values on the cells
+ * of @p box only, without ghost cells. Z is zero at cells at which @p mask is
+ * nonzero.
+ *
+ * Since Z only depends on the input values of U, all updates are independent
+ * and each row of cells is computed in a unit-stride loop.
+ */
+void jacobi_residual_const_dc(double* Z,
+                              const double* U,
+                              int U_gcw,
+                              double D,
+                              double C,
+                              const double* F,
+                              int F_gcw,
+                              const SAMRAI::hier::Box<NDIM>& box,
+                              const double* dx,
+                              bool use_l1_diagonal,
+                              const int* mask = nullptr,
+                              int mask_gcw = 0);
+
+/**
+ * Perform the update step of a polynomial smoother on the cells of @p box:
+ * set P = alpha Z + beta P and then U = U + P, in which @p Z is stored as in
+ * jacobi_residual_const_dc(). If @p beta is zero, the input values of P are
+ * not used. If @p P is <code>nullptr</code>, then this only sets U = U +
+ * alpha Z.
+ */
+void polynomial_smoother_update(double* U,
+                                int U_gcw,
+                                double* P,
+                                int P_gcw,
+                                const double* Z,
+                                const SAMRAI::hier::Box<NDIM>& box,
+                                double alpha,
+                                double beta);
+} // namespace IBTK
+
+#endif
@@ -67,6 +67,7 @@ inline Vec
 LData::getVec()
 {
     restoreArrays();
+    updateVersion();
     return d_global_vec;
 } // getVec
 
@@ -122,8 +123,9 @@ LData::getGhostedLocalFormVecArray()
 } // getGhostedLocalFormVecArray
 
 inline void
-LData::restoreArrays()
+LData::restoreArrays(const bool values_modified)
 {
+    if (values_modified && (d_ghosted_local_array || d_array)) updateVersion();
     int ierr;
     if (d_ghosted_local_array)
     {
@@ -146,10 +148,17 @@ LData::restoreArrays()
     return;
 } // restoreArray
 
+inline std::size_t
+LData::getVersion() const
+{
+    return d_version;
+} // getVersion
+
 inline void
 LData::beginGhostUpdate()
 {
-    const int ierr = VecGhostUpdateBegin(getVec(), INSERT_VALUES, SCATTER_FORWARD);
+    restoreArrays();
+    const int ierr = VecGhostUpdateBegin(d_global_vec, INSERT_VALUES, SCATTER_FORWARD);
     IBTK_CHKERRQ(ierr);
     return;
 } // beginGhostUpdate
@@ -157,8 +166,16 @@ LData::beginGhostUpdate()
 inline void
 LData::endGhostUpdate()
 {
-    const int ierr = VecGhostUpdateEnd(getVec(), INSERT_VALUES, SCATTER_FORWARD);
+    restoreArrays();
+    const int ierr = VecGhostUpdateEnd(d_global_vec, INSERT_VALUES, SCATTER_FORWARD);
     IBTK_CHKERRQ(ierr);
+    // Updating the ghost values only modifies the data if they were not
+    // already consistent with the current local values.
+    if (d_ghost_update_version != d_version)
+    {
+        updateVersion();
+        d_ghost_update_version = d_version;
+    }
     return;
 } // endGhostUpdate
 
@@ -199,6 +216,13 @@ setup_petsc_vector(const unsigned int num_local_nodes,
     return global_vec;
 }
 
+inline void
+LData::updateVersion()
+{
+    d_version = ++s_version_counter;
+    return;
+} // updateVersion
+
 template <std::size_t dim>
 void
 LData::destroy_ref(boost::multi_array_ref<double, dim>& ref)
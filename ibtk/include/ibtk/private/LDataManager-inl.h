@@ -48,6 +48,19 @@ LDataManager::getDefaultSpreadKernelFunction() const
     return d_default_spread_kernel_fcn;
 } // getDefaultSpreadKernelFunction
 
+inline void
+LDataManager::setNodeOrdering(const LNodeOrderingType node_ordering)
+{
+    d_node_ordering = node_ordering;
+    return;
+} // setNodeOrdering
+
+inline LNodeOrderingType
+LDataManager::getNodeOrdering() const
+{
+    return d_node_ordering;
+} // getNodeOrdering
+
 inline bool
 LDataManager::levelContainsLagrangianData(const int level_number) const
 {
@@ -13,6 +13,7 @@
 
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
+#include "ibtk/BoundingBoxBins.h"
 #include "ibtk/FECache.h"
 #include "ibtk/FEDataManager.h"
 #include "ibtk/FEMappingCache.h"
@@ -29,6 +30,7 @@
 
 #include "BasePatchHierarchy.h"
 #include "Box.h"
+#include "BoxArray.h"
 #include "CartesianCellDoubleWeightedAverage.h"
 #include "CartesianGridGeometry.h"
 #include "CartesianPatchGeometry.h"
@@ -47,6 +49,7 @@
 #include "PatchData.h"
 #include "PatchHierarchy.h"
 #include "PatchLevel.h"
+#include "ProcessorMapping.h"
 #include "RefineSchedule.h"
 #include "SideData.h"
 #include "SideGeometry.h"
@@ -105,7 +108,9 @@ IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <map>
@@ -113,9 +118,14 @@ IBTK_ENABLE_EXTRA_WARNINGS
 #include <set>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ibtk/namespaces.h" // IWYU pragma: keep
 
 namespace libMesh
@@ -224,47 +234,121 @@ get_JxW(quadrature_key_type key,
     }
 }
 
-#if LIBMESH_VERSION_LESS_THAN(1, 6, 0)
-// libMesh's box intersection code is slow and not in a header (i.e., cannot be
-// inlined). This is problematic for us since we presently call this function
-// for every element on every patch: i.e., for N patches on the current
-// processor and K *total* (i.e., on all processors) elements we call this
-// function K*N times, which takes up a lot of time in regrids. For example:
-// switching to this function lowers the time required to get to the end of the
-// first time step in the TAVR model by 20%.
-inline bool
-bbox_intersects(const libMeshWrappers::BoundingBox& a, const libMeshWrappers::BoundingBox& b)
-{
-    const libMesh::Point& a_lower = a.first;
-    const libMesh::Point& a_upper = a.second;
-
-    const libMesh::Point& b_lower = b.first;
-    const libMesh::Point& b_upper = b.second;
-
-    // Since boxes are tensor products of line intervals it suffices to check
-    // that the line segments for each coordinate axis overlap.
-    for (unsigned int d = 0; d < NDIM; ++d)
+/**
+ * FE objects and scratch arrays used by the element loops in
+ * FEDataManager::spread() and FEDataManager::interpWeighted(). Since the
+ * cached FE and mapping objects are reinitialized on each element, each
+ * thread needs its own copy.
+ */
+struct ElementLoopScratch
+{
+    ElementLoopScratch(const unsigned int dim, const FEType& F_fe_type, const FEType& X_fe_type)
+        : F_fe_cache(dim, F_fe_type, FEUpdateFlags::update_phi),
+          X_fe_cache(dim, X_fe_type, FEUpdateFlags::update_phi),
+          volume_mapping_cache(FEUpdateFlags::update_JxW),
+          surface_mapping_cache(FEUpdateFlags::update_JxW)
     {
-        // Line segments can intersect in two ways:
-        // 1. They can overlap.
-        // 2. One can be inside the other.
-        //
-        // In the first case we want to see if either end point of the second
-        // line segment lies within the first. In the second case we can simply
-        // check that one end point of the first line segment lies in the second
-        // line segment. Note that we don't need, in the second case, to do two
-        // checks since that case is already covered by the first.
-        if (!((a_lower(d) <= b_lower(d) && b_lower(d) <= a_upper(d)) ||
-              (a_lower(d) <= b_upper(d) && b_upper(d) <= a_upper(d))) &&
-            !((b_lower(d) <= a_lower(d) && a_lower(d) <= b_upper(d))))
-        {
-            return false;
-        }
     }
 
-    return true;
+    FECache F_fe_cache;
+    FECache X_fe_cache;
+    FEMappingCache<NDIM, NDIM> volume_mapping_cache;
+    FEMappingCache<NDIM - 1, NDIM> surface_mapping_cache;
+    boost::multi_array<double, 2> F_node;
+    std::vector<double> F_rhs_concatenated;
+    std::vector<double> JxW;
+};
+
+/**
+ * Set up one ElementLoopScratch object for each thread that may execute the
+ * element loops. Only one object is created if the loops are not threaded.
+ */
+std::vector<std::unique_ptr<ElementLoopScratch> >
+build_element_loop_scratch(const bool threaded,
+                           const unsigned int dim,
+                           const FEType& F_fe_type,
+                           const FEType& X_fe_type)
+{
+    int n_threads = 1;
+#ifdef _OPENMP
+    if (threaded) n_threads = omp_get_max_threads();
+#else
+    (void)threaded;
+#endif
+    std::vector<std::unique_ptr<ElementLoopScratch> > scratch(n_threads);
+    for (auto& thread_scratch : scratch)
+    {
+        thread_scratch.reset(new ElementLoopScratch(dim, F_fe_type, X_fe_type));
+    }
+    return scratch;
 }
+
+/**
+ * Get the ElementLoopScratch object belonging to the calling thread.
+ */
+inline ElementLoopScratch&
+get_element_loop_scratch(const std::vector<std::unique_ptr<ElementLoopScratch> >& scratch)
+{
+#ifdef _OPENMP
+    if (scratch.size() > 1) return *scratch[omp_get_thread_num()];
 #endif
+    return *scratch[0];
+}
+
+/**
+ * Get the indices of the element subsets (0 for the processor interior
+ * elements and 1 for the processor boundary elements) that are processed for
+ * a given value of FEDataManager::ElementSubset.
+ */
+std::vector<unsigned int>
+get_elem_subset_indices(const FEDataManager::ElementSubset elem_subset)
+{
+    switch (elem_subset)
+    {
+    case FEDataManager::PROCESSOR_INTERIOR_ELEMS:
+        return { 0 };
+    case FEDataManager::PROCESSOR_BOUNDARY_ELEMS:
+        return { 1 };
+    default:
+        return { 0, 1 };
+    }
+}
+
+/**
+ * Get read access to the values of an IB-ghosted vector that are used by the
+ * given subset of the active patch elements. The processor interior elements
+ * only use locally owned values, which are read through the global vector:
+ * the local form of a ghosted vector must not be accessed while its ghost
+ * values are being updated. The locally owned values are stored first in the
+ * local form, so the same (local) indices are valid in both cases.
+ */
+const double*
+get_elem_subset_array_read(PetscVector<double>& vec, const FEDataManager::ElementSubset elem_subset)
+{
+    if (elem_subset != FEDataManager::PROCESSOR_INTERIOR_ELEMS) return vec.get_array_read();
+    const PetscScalar* array = nullptr;
+    int ierr = VecGetArrayRead(vec.vec(), &array);
+    IBTK_CHKERRQ(ierr);
+    return array;
+}
+
+/**
+ * Restore an array obtained with get_elem_subset_array_read().
+ */
+void
+restore_elem_subset_array_read(PetscVector<double>& vec,
+                               const double* array,
+                               const FEDataManager::ElementSubset elem_subset)
+{
+    if (elem_subset != FEDataManager::PROCESSOR_INTERIOR_ELEMS)
+    {
+        vec.restore_array();
+        return;
+    }
+    int ierr = VecRestoreArrayRead(vec.vec(), &array);
+    IBTK_CHKERRQ(ierr);
+}
+
 } // namespace
 
 FEData::FEData(std::string object_name, EquationSystems& equation_systems, const bool register_for_restart)
@@ -511,6 +595,7 @@ FEDataManager::setPatchHierarchy(Pointer<PatchHierarchy<NDIM> > hierarchy)
     {
         d_eulerian_data_cache->setPatchHierarchy(hierarchy);
     }
+    clearQuadraturePointCache();
     return;
 } // setPatchHierarchy
 
@@ -584,11 +669,16 @@ FEDataManager::reinitElementMappings()
     // The ghosted diagonal mass matrix needs to be rebuilt after repartitioning.
     d_L2_proj_matrix_diag_ghost.clear();
 
+    // Cached quadrature point data is stored for each patch.
+    clearQuadraturePointCache();
+
     // Delete cached hierarchy-dependent data.
     d_active_patch_elem_map.clear();
     d_active_patch_elem_map.resize(d_max_level_number + 1);
     d_active_patch_node_map.clear();
     d_active_patch_node_map.resize(d_max_level_number + 1);
+    d_active_patch_n_interior_elems.clear();
+    d_active_patch_n_interior_elems.resize(d_max_level_number + 1);
     d_active_patch_ghost_dofs.clear();
     d_active_elems.clear();
     d_system_ghost_vec.clear();
@@ -602,6 +692,41 @@ FEDataManager::reinitElementMappings()
         collectActivePatchNodes(d_active_patch_node_map[ln], d_active_patch_elem_map[ln]);
     }
 
+    // Store the processor interior elements of each patch (i.e., the elements
+    // whose degrees of freedom are all owned by this processor) first so that
+    // they can be processed while ghost values are being communicated. The
+    // degrees of freedom of a libMesh DofObject are owned by the processor
+    // that owns the object. If element subsets are not enabled then the
+    // elements are kept in their original order and are all treated as
+    // processor boundary elements.
+    for (unsigned int ln = 0; ln < d_active_patch_elem_map.size(); ++ln)
+    {
+        d_active_patch_n_interior_elems[ln].assign(d_active_patch_elem_map[ln].size(), 0);
+    }
+    if (d_use_elem_subsets)
+    {
+        const processor_id_type rank = getEquationSystems()->get_mesh().processor_id();
+        const auto is_interior_elem = [rank](const Elem* const elem) {
+            if (elem->processor_id() != rank) return false;
+            for (unsigned int n = 0; n < elem->n_nodes(); ++n)
+            {
+                if (elem->node_ref(n).processor_id() != rank) return false;
+            }
+            return true;
+        };
+        for (unsigned int ln = 0; ln < d_active_patch_elem_map.size(); ++ln)
+        {
+            for (unsigned int local_patch_num = 0; local_patch_num < d_active_patch_elem_map[ln].size();
+                 ++local_patch_num)
+            {
+                std::vector<Elem*>& patch_elems = d_active_patch_elem_map[ln][local_patch_num];
+                const auto boundary_begin =
+                    std::stable_partition(patch_elems.begin(), patch_elems.end(), is_interior_elem);
+                d_active_patch_n_interior_elems[ln][local_patch_num] = boundary_begin - patch_elems.begin();
+            }
+        }
+    }
+
     std::set<Elem*> elem_set;
     for (const std::vector<std::vector<Elem*> >& level_elems : d_active_patch_elem_map)
     {
@@ -953,6 +1078,96 @@ sum_weighted_elem_solution(const int n_vars,
     return;
 }
 
+/**
+ * Compute the quadrature rule of each element on a patch, the positions of
+ * the quadrature points, and the JxW values at the quadrature points. The
+ * quadrature points of each element occupy a contiguous range of @p X_qp and
+ * @p JxW_qp starting at the corresponding entry of @p qp_offsets.
+ */
+template <class QuadratureSpec>
+void
+compute_patch_quadrature_data(std::vector<quadrature_key_type>& quad_keys,
+                              std::vector<unsigned int>& qp_offsets,
+                              std::vector<double>& X_qp,
+                              std::vector<double>& JxW_qp,
+                              const QuadratureSpec& quad_spec,
+                              const std::vector<Elem*>& patch_elems,
+                              const std::vector<const boost::multi_array<dof_id_type, 2>*>& X_elem_dof_indices,
+                              const PetscVector<double>& X_petsc_vec,
+                              const double* const X_local_soln,
+                              const double patch_dx_min,
+                              const bool is_volume_mesh,
+                              QuadratureCache& quadrature_cache,
+                              const bool threaded,
+                              const std::vector<std::unique_ptr<ElementLoopScratch> >& element_loop_scratch)
+{
+    const std::size_t num_elems = patch_elems.size();
+    const int n_elems = static_cast<int>(num_elems);
+
+    // Determining which quadrature rule should be used on which processor is
+    // surprisingly expensive, so cache the keys:
+    quad_keys.resize(num_elems);
+
+    // Cache interpolated positions too:
+    std::vector<boost::multi_array<double, 2> > X_nodes(num_elems);
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded) schedule(static)
+#endif
+    for (int e_idx = 0; e_idx < n_elems; ++e_idx)
+    {
+        Elem* const elem = patch_elems[e_idx];
+        get_values_for_interpolation(X_nodes[e_idx], X_petsc_vec, X_local_soln, *X_elem_dof_indices[e_idx]);
+        quad_keys[e_idx] = getQuadratureKey(quad_spec.quad_type,
+                                            quad_spec.quad_order,
+                                            quad_spec.use_adaptive_quadrature,
+                                            quad_spec.point_density,
+                                            quad_spec.allow_rules_with_negative_weights,
+                                            elem,
+                                            X_nodes[e_idx],
+                                            patch_dx_min);
+    }
+
+    // The quadrature cache populates itself on demand, so look up the number
+    // of quadrature points of each element serially.
+    qp_offsets.resize(num_elems + 1);
+    qp_offsets[0] = 0;
+    for (unsigned int e_idx = 0; e_idx < num_elems; ++e_idx)
+    {
+        QBase& qrule = quadrature_cache[quad_keys[e_idx]];
+        qp_offsets[e_idx + 1] = qp_offsets[e_idx] + qrule.n_points();
+    }
+    const unsigned int n_qp_patch = qp_offsets[num_elems];
+    X_qp.resize(NDIM * n_qp_patch);
+    JxW_qp.resize(n_qp_patch);
+
+    // Loop over the elements and compute the positions of and JxW values at
+    // the quadrature points.
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded) schedule(static)
+#endif
+    for (int e_idx = 0; e_idx < n_elems; ++e_idx)
+    {
+        ElementLoopScratch& scratch = get_element_loop_scratch(element_loop_scratch);
+        Elem* const elem = patch_elems[e_idx];
+        const quadrature_key_type& key = quad_keys[e_idx];
+        const FEBase& X_fe = scratch.X_fe_cache(key, elem);
+        const std::vector<std::vector<double> >& phi_X = X_fe.get_phi();
+        const std::vector<double>& JxW =
+            get_JxW(key, elem, is_volume_mesh, scratch.volume_mapping_cache, scratch.surface_mapping_cache);
+
+        const unsigned int qp_offset = qp_offsets[e_idx];
+        const unsigned int n_qp = qp_offsets[e_idx + 1] - qp_offset;
+        TBOX_ASSERT(n_qp == phi_X[0].size());
+        TBOX_ASSERT(n_qp == JxW.size());
+        double* X_begin = &X_qp[NDIM * qp_offset];
+        std::fill(X_begin, X_begin + NDIM * n_qp, 0.0);
+        sum_weighted_elem_solution</*weights_are_unity*/ true>(
+            NDIM, phi_X.size(), qp_offset, phi_X, {}, X_nodes[e_idx], X_qp);
+        std::copy(JxW.begin(), JxW.end(), JxW_qp.begin() + qp_offset);
+    }
+    return;
+} // compute_patch_quadrature_data
+
 void
 FEDataManager::spread(const int f_data_idx,
                       NumericVector<double>& F_vec,
@@ -969,7 +1184,8 @@ FEDataManager::spread(const int f_data_idx,
                       NumericVector<double>& F_vec,
                       NumericVector<double>& X_vec,
                       const std::string& system_name,
-                      const FEDataManager::SpreadSpec& spread_spec)
+                      const FEDataManager::SpreadSpec& spread_spec,
+                      const ElementSubset elem_subset)
 {
     IBTK_TIMER_START(t_spread);
 
@@ -1012,12 +1228,13 @@ FEDataManager::spread(const int f_data_idx,
 
     // convenience alias for the quadrature key type used by FECache and FEMappingCache
     using quad_key_type = quadrature_key_type;
-    FECache F_fe_cache(dim, F_fe_type, FEUpdateFlags::update_phi);
-    FECache X_fe_cache(dim, X_fe_type, FEUpdateFlags::update_phi);
 
-    // We have to support both volumetric and surface meshes based on runtime data
-    FEMappingCache<NDIM, NDIM> volume_mapping_cache(FEUpdateFlags::update_JxW);
-    FEMappingCache<NDIM - 1, NDIM> surface_mapping_cache(FEUpdateFlags::update_JxW);
+    // Set up the FECache and FEMappingCache objects (one set per thread if the
+    // element loops are threaded). We have to support both volumetric and
+    // surface meshes based on runtime data.
+    const bool threaded = d_use_threaded_element_loops;
+    const std::vector<std::unique_ptr<ElementLoopScratch> > element_loop_scratch =
+        build_element_loop_scratch(threaded, dim, F_fe_type, X_fe_type);
     const bool is_volume_mesh = dim == NDIM;
 
     // Check to see if we are using nodal quadrature.
@@ -1033,6 +1250,15 @@ FEDataManager::spread(const int f_data_idx,
     TBOX_ASSERT(std::find(fe_family_whitelist.begin(), fe_family_whitelist.end(), X_fe_type.family) !=
                 fe_family_whitelist.end());
 
+    // Nodal quadrature does not distinguish between processor interior and
+    // processor boundary elements: spread from all nodes with the processor
+    // boundary elements.
+    if (use_nodal_quadrature && elem_subset == PROCESSOR_INTERIOR_ELEMS)
+    {
+        IBTK_TIMER_STOP(t_spread);
+        return;
+    }
+
     if (use_nodal_quadrature)
     {
         // Multiply by the nodal volume fractions (to convert densities into
@@ -1133,16 +1359,35 @@ FEDataManager::spread(const int f_data_idx,
     {
         // Extract local form vectors.
         auto F_petsc_vec = static_cast<PetscVector<double>*>(&F_vec);
-        const double* const F_local_soln = F_petsc_vec->get_array_read();
+        const double* const F_local_soln = get_elem_subset_array_read(*F_petsc_vec, elem_subset);
 
         auto X_petsc_vec = static_cast<PetscVector<double>*>(&X_vec);
-        const double* const X_local_soln = X_petsc_vec->get_array_read();
+        const double* const X_local_soln = get_elem_subset_array_read(*X_petsc_vec, elem_subset);
 
         // Loop over the patches to interpolate nodal values on the FE mesh to
         // the element quadrature points, then spread those values onto the
         // Eulerian grid.
-        boost::multi_array<double, 2> F_node;
-        std::vector<double> F_JxW_qp, X_qp;
+        const bool use_qp_cache = d_cache_quadrature_point_data;
+        const bool measure_costs = d_default_workload_spec.use_measured_costs;
+        const std::vector<unsigned int> elem_subset_indices = get_elem_subset_indices(elem_subset);
+        std::array<bool, 2> qp_cache_hit = { { false, false } };
+        bool qp_cache_miss = false;
+        for (const unsigned int subset : elem_subset_indices)
+        {
+            qp_cache_hit[subset] =
+                use_qp_cache && checkQuadraturePointCache(*X_petsc_vec,
+                                                          X_local_soln,
+                                                          spread_spec.quad_type,
+                                                          spread_spec.quad_order,
+                                                          spread_spec.use_adaptive_quadrature,
+                                                          spread_spec.point_density,
+                                                          spread_spec.allow_rules_with_negative_weights,
+                                                          subset);
+            qp_cache_miss = qp_cache_miss || !qp_cache_hit[subset];
+        }
+        PatchQuadratureData patch_qp_scratch;
+        std::vector<Elem*> patch_elems;
+        std::vector<double> F_JxW_qp;
         for (int ln = 0; ln <= d_hierarchy->getFinestLevelNumber(); ++ln)
         {
             Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
@@ -1150,109 +1395,149 @@ FEDataManager::spread(const int f_data_idx,
             // Spread from the nodes.
             for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++local_patch_num)
             {
-                // The relevant collection of elements.
-                const std::vector<Elem*>& patch_elems = d_active_patch_elem_map[ln][local_patch_num];
-                const size_t num_active_patch_elems = patch_elems.size();
-                if (!num_active_patch_elems) continue;
-
                 const Pointer<Patch<NDIM> > patch = level->getPatch(p());
                 const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
                 const double* const patch_dx = patch_geom->getDx();
                 const double patch_dx_min = *std::min_element(patch_dx, patch_dx + NDIM);
 
-                // Determining which quadrature rule should be used on which
-                // processor is surprisingly expensive, so cache the keys:
-                std::vector<quad_key_type> quad_keys(num_active_patch_elems);
-
-                // Cache interpolated positions too:
-                std::vector<boost::multi_array<double, 2> > X_nodes(num_active_patch_elems);
-
-                // Setup vectors to store the values of F_JxW and X at the
-                // quadrature points.
-                unsigned int n_qp_patch = 0;
-                for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
+                for (const unsigned int subset : elem_subset_indices)
                 {
-                    Elem* const elem = patch_elems[e_idx];
+                    // The relevant collection of elements. The processor
+                    // interior elements are stored first.
+                    const std::vector<Elem*>& all_patch_elems = d_active_patch_elem_map[ln][local_patch_num];
+                    const auto boundary_begin =
+                        all_patch_elems.begin() + d_active_patch_n_interior_elems[ln][local_patch_num];
+                    if (subset == 0)
+                        patch_elems.assign(all_patch_elems.begin(), boundary_begin);
+                    else
+                        patch_elems.assign(boundary_begin, all_patch_elems.end());
+                    const size_t num_active_patch_elems = patch_elems.size();
+                    if (!num_active_patch_elems) continue;
+                    const int n_patch_elems = static_cast<int>(num_active_patch_elems);
+                    const auto patch_start_time = std::chrono::steady_clock::now();
+
+                    // The DOF map caches are populated on demand and hence
+                    // cannot be accessed concurrently: look up the DOF indices
+                    // of each element before entering the (possibly threaded)
+                    // element loops.
+                    std::vector<const boost::multi_array<dof_id_type, 2>*> F_elem_dof_indices(
+                        num_active_patch_elems);
+                    for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
+                    {
+                        Elem* const elem = patch_elems[e_idx];
 #ifndef NDEBUG
-                    TBOX_ASSERT(getPatchLevel(elem) == ln);
+                        TBOX_ASSERT(getPatchLevel(elem) == ln);
 #endif // ifndef NDEBUG
-                    const auto& X_dof_indices = X_dof_map_cache.dof_indices(elem);
-                    get_values_for_interpolation(X_nodes[e_idx], *X_petsc_vec, X_local_soln, X_dof_indices);
-                    const quad_key_type key = getQuadratureKey(spread_spec.quad_type,
-                                                               spread_spec.quad_order,
-                                                               spread_spec.use_adaptive_quadrature,
-                                                               spread_spec.point_density,
-                                                               spread_spec.allow_rules_with_negative_weights,
-                                                               elem,
-                                                               X_nodes[e_idx],
-                                                               patch_dx_min);
-                    quad_keys[e_idx] = key;
-                    QBase& qrule = d_fe_data->d_quadrature_cache[key];
-                    n_qp_patch += qrule.n_points();
-                }
-                if (!n_qp_patch) continue;
-                F_JxW_qp.resize(n_vars * n_qp_patch);
-                X_qp.resize(NDIM * n_qp_patch);
+                        F_elem_dof_indices[e_idx] = &F_dof_map_cache.dof_indices(elem);
+                    }
 
-                // Loop over the elements and compute the values to be spread and
-                // the positions of the quadrature points.
-                int qp_offset = 0;
-                for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
-                {
-                    Elem* const elem = patch_elems[e_idx];
-                    const auto& F_dof_indices = F_dof_map_cache.dof_indices(elem);
-                    get_values_for_interpolation(F_node, *F_petsc_vec, F_local_soln, F_dof_indices);
-                    const quad_key_type& key = quad_keys[e_idx];
-                    const FEBase& X_fe = X_fe_cache(key, elem);
-                    const FEBase& F_fe = F_fe_cache(key, elem);
-                    const QBase& qrule = d_fe_data->d_quadrature_cache[key];
+                    // Get the quadrature rules, the positions of the
+                    // quadrature points, and the JxW values, either from the
+                    // cache or by computing them.
+                    PatchQuadratureData& qp_data =
+                        use_qp_cache ? d_qp_cache_patch_data[ln][local_patch_num][subset] : patch_qp_scratch;
+                    if (!qp_cache_hit[subset])
+                    {
+                        std::vector<const boost::multi_array<dof_id_type, 2>*> X_elem_dof_indices(
+                            num_active_patch_elems);
+                        for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
+                        {
+                            X_elem_dof_indices[e_idx] = &X_dof_map_cache.dof_indices(patch_elems[e_idx]);
+                        }
+                        compute_patch_quadrature_data(qp_data.quad_keys,
+                                                      qp_data.qp_offsets,
+                                                      qp_data.X_qp,
+                                                      qp_data.JxW_qp,
+                                                      spread_spec,
+                                                      patch_elems,
+                                                      X_elem_dof_indices,
+                                                      *X_petsc_vec,
+                                                      X_local_soln,
+                                                      patch_dx_min,
+                                                      is_volume_mesh,
+                                                      d_fe_data->d_quadrature_cache,
+                                                      threaded,
+                                                      element_loop_scratch);
+                    }
+                    const std::vector<quad_key_type>& quad_keys = qp_data.quad_keys;
+                    const std::vector<unsigned int>& qp_offsets = qp_data.qp_offsets;
+                    const std::vector<double>& X_qp = qp_data.X_qp;
+                    const std::vector<double>& JxW_qp = qp_data.JxW_qp;
+                    TBOX_ASSERT(quad_keys.size() == num_active_patch_elems);
+                    const unsigned int n_qp_patch = qp_offsets[num_active_patch_elems];
+                    if (!n_qp_patch) continue;
+                    F_JxW_qp.resize(n_vars * n_qp_patch);
+
+                    // Loop over the elements and compute the values to be
+                    // spread. Each element writes to its own range of
+                    // quadrature points.
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded) schedule(static)
+#endif
+                    for (int e_idx = 0; e_idx < n_patch_elems; ++e_idx)
+                    {
+                        ElementLoopScratch& scratch = get_element_loop_scratch(element_loop_scratch);
+                        Elem* const elem = patch_elems[e_idx];
+                        const auto& F_dof_indices = *F_elem_dof_indices[e_idx];
+                        get_values_for_interpolation(scratch.F_node, *F_petsc_vec, F_local_soln, F_dof_indices);
+                        const quad_key_type& key = quad_keys[e_idx];
+                        const FEBase& F_fe = scratch.F_fe_cache(key, elem);
+                        const std::vector<std::vector<double> >& phi_F = F_fe.get_phi();
+
+                        const unsigned int qp_offset = qp_offsets[e_idx];
+                        const unsigned int n_qp = qp_offsets[e_idx + 1] - qp_offset;
+                        TBOX_ASSERT(n_qp == phi_F[0].size());
+                        scratch.JxW.assign(JxW_qp.begin() + qp_offset, JxW_qp.begin() + qp_offset + n_qp);
+                        double* F_begin = &F_JxW_qp[n_vars * qp_offset];
+                        std::fill(F_begin, F_begin + n_vars * n_qp, 0.0);
+
+                        sum_weighted_elem_solution</*weights_are_unity*/ false>(n_vars,
+                                                                                F_dof_indices[0].size(),
+                                                                                qp_offset,
+                                                                                phi_F,
+                                                                                scratch.JxW,
+                                                                                scratch.F_node,
+                                                                                F_JxW_qp);
+                    }
 
-                    // JxW depends on the element
-                    const std::vector<double>& JxW_F =
-                        get_JxW(key, elem, is_volume_mesh, volume_mapping_cache, surface_mapping_cache);
-                    const std::vector<std::vector<double> >& phi_F = F_fe.get_phi();
-                    const std::vector<std::vector<double> >& phi_X = X_fe.get_phi();
-
-                    const unsigned int n_qp = qrule.n_points();
-                    TBOX_ASSERT(n_qp == phi_F[0].size());
-                    TBOX_ASSERT(n_qp == phi_X[0].size());
-                    TBOX_ASSERT(n_qp == JxW_F.size());
-                    double* F_begin = &F_JxW_qp[n_vars * qp_offset];
-                    double* X_begin = &X_qp[NDIM * qp_offset];
-                    std::fill(F_begin, F_begin + n_vars * n_qp, 0.0);
-                    std::fill(X_begin, X_begin + NDIM * n_qp, 0.0);
-
-                    sum_weighted_elem_solution</*weights_are_unity*/ false>(
-                        n_vars, F_dof_indices[0].size(), qp_offset, phi_F, JxW_F, F_node, F_JxW_qp);
-                    sum_weighted_elem_solution</*weights_are_unity*/ true>(
-                        NDIM, phi_X.size(), qp_offset, phi_X, {}, X_nodes[e_idx], X_qp);
-                    qp_offset += n_qp;
-                }
+                    zeroExteriorValues(*patch_geom, X_qp, F_JxW_qp, n_vars);
 
-                zeroExteriorValues(*patch_geom, X_qp, F_JxW_qp, n_vars);
+                    // Spread values from the quadrature points to the Cartesian
+                    // grid patch.
+                    const Box<NDIM> spread_box = patch->getBox();
+                    Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+                    if (cc_data)
+                    {
+                        Pointer<CellData<NDIM, double> > f_cc_data = f_data;
+                        LEInteractor::spread(
+                            f_cc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, spread_spec.kernel_fcn);
+                    }
+                    if (sc_data)
+                    {
+                        Pointer<SideData<NDIM, double> > f_sc_data = f_data;
+                        LEInteractor::spread(
+                            f_sc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, spread_spec.kernel_fcn);
+                    }
 
-                // Spread values from the quadrature points to the Cartesian grid
-                // patch.
-                const Box<NDIM> spread_box = patch->getBox();
-                Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
-                if (cc_data)
-                {
-                    Pointer<CellData<NDIM, double> > f_cc_data = f_data;
-                    LEInteractor::spread(
-                        f_cc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, spread_spec.kernel_fcn);
-                }
-                if (sc_data)
-                {
-                    Pointer<SideData<NDIM, double> > f_sc_data = f_data;
-                    LEInteractor::spread(
-                        f_sc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, spread_spec.kernel_fcn);
+                    if (measure_costs)
+                    {
+                        addMeasuredCost(
+                            patch_elems,
+                            qp_offsets,
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - patch_start_time).count());
+                    }
                 }
             }
         }
+        if (use_qp_cache && qp_cache_miss && d_enable_logging)
+        {
+            plog << "FEDataManager::spread(): quadrature point cache uses " << getQuadraturePointCacheMemoryUsage()
+                 << " bytes\n";
+        }
 
         // Restore local form vectors.
-        F_petsc_vec->restore_array();
-        X_petsc_vec->restore_array();
+        restore_elem_subset_array_read(*F_petsc_vec, F_local_soln, elem_subset);
+        restore_elem_subset_array_read(*X_petsc_vec, X_local_soln, elem_subset);
     }
 
     IBTK_TIMER_STOP(t_spread);
@@ -1717,7 +2002,8 @@ FEDataManager::interpWeighted(const int f_data_idx,
                               const std::vector<Pointer<RefineSchedule<NDIM> > >& f_refine_scheds,
                               const double fill_data_time,
                               const bool close_F,
-                              const bool close_X)
+                              const bool close_X,
+                              const ElementSubset elem_subset)
 {
     IBTK_TIMER_START(t_interp_weighted);
 
@@ -1761,19 +2047,25 @@ FEDataManager::interpWeighted(const int f_data_idx,
 
     // convenience alias for the quadrature key type used by FECache and FEMappingCache
     using quad_key_type = quadrature_key_type;
-    FECache F_fe_cache(dim, F_fe_type, FEUpdateFlags::update_phi);
-    FECache X_fe_cache(dim, X_fe_type, FEUpdateFlags::update_phi);
-    FEMappingCache<NDIM, NDIM> volume_mapping_cache(FEUpdateFlags::update_JxW);
-    FEMappingCache<NDIM - 1, NDIM> surface_mapping_cache(FEUpdateFlags::update_JxW);
+    const bool threaded = d_use_threaded_element_loops;
+    const std::vector<std::unique_ptr<ElementLoopScratch> > element_loop_scratch =
+        build_element_loop_scratch(threaded, dim, F_fe_type, X_fe_type);
     const bool is_volume_mesh = dim == NDIM;
 
-    // Communicate any unsynchronized ghost data.
-    for (const auto& f_refine_sched : f_refine_scheds)
+    // Communicate any unsynchronized ghost data. When processing a subset of
+    // the elements this is done (and the ghost values of X are updated) by
+    // the caller.
+    const bool first_subset = elem_subset != PROCESSOR_BOUNDARY_ELEMS;
+    const bool last_subset = elem_subset != PROCESSOR_INTERIOR_ELEMS;
+    if (first_subset)
     {
-        if (f_refine_sched) f_refine_sched->fillData(fill_data_time);
+        for (const auto& f_refine_sched : f_refine_scheds)
+        {
+            if (f_refine_sched) f_refine_sched->fillData(fill_data_time);
+        }
     }
 
-    if (close_X) X_vec.close();
+    if (close_X && elem_subset == ALL_ELEMS) X_vec.close();
 
     // Check to see if we are using nodal quadrature.
     const bool use_nodal_quadrature = interp_spec.use_nodal_quadrature;
@@ -1791,11 +2083,11 @@ FEDataManager::interpWeighted(const int f_data_idx,
     // Extract local form vectors.
     auto X_petsc_vec = dynamic_cast<PetscVector<double>*>(&X_vec);
     TBOX_ASSERT(X_petsc_vec != nullptr);
-    const double* const X_local_soln = X_petsc_vec->get_array_read();
+    const double* const X_local_soln = get_elem_subset_array_read(*X_petsc_vec, elem_subset);
     // Since we do a lot of assembly in this routine into off-processor
     // entries we will directly insert into the ghost values (and then
     // scatter in the calling function with the usual batch function).
-    F_vec.zero();
+    if (first_subset) F_vec.zero();
     auto F_petsc_vec = dynamic_cast<PetscVector<double>*>(&F_vec);
     Vec F_local_form = nullptr;
     double* F_local_soln = nullptr;
@@ -1812,7 +2104,10 @@ FEDataManager::interpWeighted(const int f_data_idx,
         IBTK_CHKERRQ(ierr);
     }
 
-    if (use_nodal_quadrature)
+    // Nodal quadrature does not distinguish between processor interior and
+    // processor boundary elements: interpolate to all nodes with the processor
+    // boundary elements.
+    if (use_nodal_quadrature && last_subset)
     {
         // Extract local form vectors.
         PetscVector<double>* dX_vec = buildIBGhostedDiagonalL2MassMatrix(system_name);
@@ -1925,15 +2220,36 @@ FEDataManager::interpWeighted(const int f_data_idx,
         // Restore local form vectors.
         dX_vec->restore_array();
     }
-    else
+    else if (!use_nodal_quadrature)
     {
         // Loop over the patches to interpolate values to the element quadrature
         // points from the grid, then use these values to compute the projection
         // of the interpolated velocity field onto the FE basis functions.
+        const bool use_qp_cache = d_cache_quadrature_point_data;
+        const bool measure_costs = d_default_workload_spec.use_measured_costs;
+        const std::vector<unsigned int> elem_subset_indices = get_elem_subset_indices(elem_subset);
+        std::array<bool, 2> qp_cache_hit = { { false, false } };
+        bool qp_cache_miss = false;
+        for (const unsigned int subset : elem_subset_indices)
+        {
+            qp_cache_hit[subset] =
+                use_qp_cache && checkQuadraturePointCache(*X_petsc_vec,
+                                                          X_local_soln,
+                                                          interp_spec.quad_type,
+                                                          interp_spec.quad_order,
+                                                          interp_spec.use_adaptive_quadrature,
+                                                          interp_spec.point_density,
+                                                          interp_spec.allow_rules_with_negative_weights,
+                                                          subset);
+            qp_cache_miss = qp_cache_miss || !qp_cache_hit[subset];
+        }
+        PatchQuadratureData patch_qp_scratch;
+        std::vector<Elem*> patch_elems;
         DenseVector<double> F_rhs;
-        // Assemble F_rhs_e's vectors in an interleaved format (see the implementation):
+        // Assemble the F_rhs_e vectors of all elements on the patch in an
+        // interleaved format (see the implementation):
         std::vector<double> F_rhs_concatenated;
-        std::vector<double> F_qp, X_qp;
+        std::vector<double> F_qp;
         std::vector<libMesh::dof_id_type> dof_id_scratch;
         for (int ln = 0; ln <= d_hierarchy->getFinestLevelNumber(); ++ln)
         {
@@ -1941,154 +2257,195 @@ FEDataManager::interpWeighted(const int f_data_idx,
             int local_patch_num = 0;
             for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++local_patch_num)
             {
-                // The relevant collection of elements.
-                const std::vector<Elem*>& patch_elems = d_active_patch_elem_map[ln][local_patch_num];
-                const size_t num_active_patch_elems = patch_elems.size();
-                if (!num_active_patch_elems) continue;
-
                 const Pointer<Patch<NDIM> > patch = level->getPatch(p());
                 const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
                 const double* const patch_dx = patch_geom->getDx();
                 const double patch_dx_min = *std::min_element(patch_dx, patch_dx + NDIM);
 
-                // Determining which quadrature rule should be used on which
-                // processor is surprisingly expensive, so cache the keys:
-                std::vector<quad_key_type> quad_keys(num_active_patch_elems);
-
-                // Cache interpolated positions too:
-                std::vector<boost::multi_array<double, 2> > X_nodes(num_active_patch_elems);
-
-                // Setup vectors to store the values of F and X at the quadrature
-                // points.
-                unsigned int n_qp_patch = 0;
-                for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
-                {
-                    Elem* const elem = patch_elems[e_idx];
-                    const auto& X_dof_indices = X_dof_map_cache.dof_indices(elem);
-                    get_values_for_interpolation(X_nodes[e_idx], *X_petsc_vec, X_local_soln, X_dof_indices);
-                    const quad_key_type key = getQuadratureKey(interp_spec.quad_type,
-                                                               interp_spec.quad_order,
-                                                               interp_spec.use_adaptive_quadrature,
-                                                               interp_spec.point_density,
-                                                               interp_spec.allow_rules_with_negative_weights,
-                                                               elem,
-                                                               X_nodes[e_idx],
-                                                               patch_dx_min);
-                    QBase& qrule = d_fe_data->d_quadrature_cache[key];
-                    n_qp_patch += qrule.n_points();
-                    quad_keys[e_idx] = key;
-                }
-                if (!n_qp_patch) continue;
-                F_qp.resize(n_vars * n_qp_patch);
-                X_qp.resize(NDIM * n_qp_patch);
-                std::fill(F_qp.begin(), F_qp.end(), 0.0);
-
-                // Loop over the elements and compute the positions of the
-                // quadrature points.
-                int qp_offset = 0;
-                for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
-                {
-                    Elem* const elem = patch_elems[e_idx];
-                    TBOX_ASSERT(elem->active());
-                    const quad_key_type& key = quad_keys[e_idx];
-                    const QBase& qrule = d_fe_data->d_quadrature_cache[key];
-                    const FEBase& X_fe = X_fe_cache(key, elem);
-                    const std::vector<std::vector<double> >& phi_X = X_fe.get_phi();
-
-                    const unsigned int n_node = elem->n_nodes();
-                    const unsigned int n_qp = qrule.n_points();
-                    TBOX_ASSERT(n_qp == phi_X[0].size());
-                    double* X_begin = &X_qp[NDIM * qp_offset];
-                    std::fill(X_begin, X_begin + NDIM * n_qp, 0.0);
-                    sum_weighted_elem_solution<true>(NDIM, n_node, qp_offset, phi_X, {}, X_nodes[e_idx], X_qp);
-                    qp_offset += n_qp;
-                }
-
-                // Interpolate values from the Cartesian grid patch to the
-                // quadrature points.
-                //
-                // NOTE: Values are interpolated only to those quadrature points
-                // that are within the patch interior.
-                const Box<NDIM>& interp_box = patch->getBox();
-                Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
-                if (cc_data)
-                {
-                    Pointer<CellData<NDIM, double> > f_cc_data = f_data;
-                    LEInteractor::interpolate(
-                        F_qp, n_vars, X_qp, NDIM, f_cc_data, patch, interp_box, interp_spec.kernel_fcn);
-                }
-                if (sc_data)
+                for (const unsigned int subset : elem_subset_indices)
                 {
-                    Pointer<SideData<NDIM, double> > f_sc_data = f_data;
-                    LEInteractor::interpolate(
-                        F_qp, n_vars, X_qp, NDIM, f_sc_data, patch, interp_box, interp_spec.kernel_fcn);
-                }
-
-                // Loop over the elements and accumulate the right-hand-side values.
-                qp_offset = 0;
-                for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
-                {
-                    Elem* const elem = patch_elems[e_idx];
-                    const auto& F_dof_indices = F_dof_map_cache.dof_indices(elem);
-                    // check the concatenation assumption
-#ifndef NDEBUG
-                    for (unsigned int i = 0; i < n_vars; ++i)
+                    // The relevant collection of elements. The processor
+                    // interior elements are stored first.
+                    const std::vector<Elem*>& all_patch_elems = d_active_patch_elem_map[ln][local_patch_num];
+                    const auto boundary_begin =
+                        all_patch_elems.begin() + d_active_patch_n_interior_elems[ln][local_patch_num];
+                    if (subset == 0)
+                        patch_elems.assign(all_patch_elems.begin(), boundary_begin);
+                    else
+                        patch_elems.assign(boundary_begin, all_patch_elems.end());
+                    const size_t num_active_patch_elems = patch_elems.size();
+                    if (!num_active_patch_elems) continue;
+                    const int n_patch_elems = static_cast<int>(num_active_patch_elems);
+                    const auto patch_start_time = std::chrono::steady_clock::now();
+
+                    // The DOF map caches are populated on demand and hence
+                    // cannot be accessed concurrently: look up the DOF indices
+                    // of each element before entering the (possibly threaded)
+                    // element loops. Each element also gets its own range of
+                    // entries in F_rhs_concatenated.
+                    std::vector<const boost::multi_array<dof_id_type, 2>*> F_elem_dof_indices(
+                        num_active_patch_elems);
+                    std::vector<std::size_t> rhs_offsets(num_active_patch_elems + 1, 0);
+                    for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
                     {
-                        TBOX_ASSERT(F_dof_indices[i].size() == F_dof_indices[0].size());
-                    }
+                        Elem* const elem = patch_elems[e_idx];
+                        TBOX_ASSERT(elem->active());
+                        F_elem_dof_indices[e_idx] = &F_dof_map_cache.dof_indices(elem);
+                        const auto& F_dof_indices = *F_elem_dof_indices[e_idx];
+                        // check the concatenation assumption
+#ifndef NDEBUG
+                        for (unsigned int i = 0; i < n_vars; ++i)
+                        {
+                            TBOX_ASSERT(F_dof_indices[i].size() == F_dof_indices[0].size());
+                        }
 #endif
-                    F_rhs_concatenated.resize(n_vars * F_dof_indices[0].size());
-                    std::fill(F_rhs_concatenated.begin(), F_rhs_concatenated.end(), 0.0);
-                    const quad_key_type& key = quad_keys[e_idx];
-                    const FEBase& F_fe = F_fe_cache(key, elem);
-                    const QBase& qrule = d_fe_data->d_quadrature_cache[key];
+                        rhs_offsets[e_idx + 1] = rhs_offsets[e_idx] + n_vars * F_dof_indices[0].size();
+                    }
 
-                    // JxW depends on the element
-                    const std::vector<double>& JxW_F =
-                        get_JxW(key, elem, is_volume_mesh, volume_mapping_cache, surface_mapping_cache);
-                    const std::vector<std::vector<double> >& phi_F = F_fe.get_phi();
+                    // Get the quadrature rules, the positions of the
+                    // quadrature points, and the JxW values, either from the
+                    // cache or by computing them.
+                    PatchQuadratureData& qp_data =
+                        use_qp_cache ? d_qp_cache_patch_data[ln][local_patch_num][subset] : patch_qp_scratch;
+                    if (!qp_cache_hit[subset])
+                    {
+                        std::vector<const boost::multi_array<dof_id_type, 2>*> X_elem_dof_indices(
+                            num_active_patch_elems);
+                        for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
+                        {
+                            X_elem_dof_indices[e_idx] = &X_dof_map_cache.dof_indices(patch_elems[e_idx]);
+                        }
+                        compute_patch_quadrature_data(qp_data.quad_keys,
+                                                      qp_data.qp_offsets,
+                                                      qp_data.X_qp,
+                                                      qp_data.JxW_qp,
+                                                      interp_spec,
+                                                      patch_elems,
+                                                      X_elem_dof_indices,
+                                                      *X_petsc_vec,
+                                                      X_local_soln,
+                                                      patch_dx_min,
+                                                      is_volume_mesh,
+                                                      d_fe_data->d_quadrature_cache,
+                                                      threaded,
+                                                      element_loop_scratch);
+                    }
+                    const std::vector<quad_key_type>& quad_keys = qp_data.quad_keys;
+                    const std::vector<unsigned int>& qp_offsets = qp_data.qp_offsets;
+                    const std::vector<double>& X_qp = qp_data.X_qp;
+                    const std::vector<double>& JxW_qp = qp_data.JxW_qp;
+                    TBOX_ASSERT(quad_keys.size() == num_active_patch_elems);
+                    const unsigned int n_qp_patch = qp_offsets[num_active_patch_elems];
+                    if (!n_qp_patch) continue;
+                    F_qp.resize(n_vars * n_qp_patch);
+                    std::fill(F_qp.begin(), F_qp.end(), 0.0);
+
+                    // Interpolate values from the Cartesian grid patch to the
+                    // quadrature points.
+                    //
+                    // NOTE: Values are interpolated only to those quadrature
+                    // points that are within the patch interior.
+                    const Box<NDIM>& interp_box = patch->getBox();
+                    Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+                    if (cc_data)
+                    {
+                        Pointer<CellData<NDIM, double> > f_cc_data = f_data;
+                        LEInteractor::interpolate(
+                            F_qp, n_vars, X_qp, NDIM, f_cc_data, patch, interp_box, interp_spec.kernel_fcn);
+                    }
+                    if (sc_data)
+                    {
+                        Pointer<SideData<NDIM, double> > f_sc_data = f_data;
+                        LEInteractor::interpolate(
+                            F_qp, n_vars, X_qp, NDIM, f_sc_data, patch, interp_box, interp_spec.kernel_fcn);
+                    }
 
-                    const unsigned int n_qp = qrule.n_points();
-                    TBOX_ASSERT(n_qp == phi_F[0].size());
-                    TBOX_ASSERT(n_qp == JxW_F.size());
-                    const size_t n_basis = F_dof_indices[0].size();
-                    integrate_elem_rhs(n_vars, n_basis, qp_offset, phi_F, JxW_F, F_qp, F_rhs_concatenated);
+                    // Loop over the elements and compute the right-hand-side values.
+                    F_rhs_concatenated.resize(rhs_offsets[num_active_patch_elems]);
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded) schedule(static)
+#endif
+                    for (int e_idx = 0; e_idx < n_patch_elems; ++e_idx)
+                    {
+                        ElementLoopScratch& scratch = get_element_loop_scratch(element_loop_scratch);
+                        Elem* const elem = patch_elems[e_idx];
+                        const auto& F_dof_indices = *F_elem_dof_indices[e_idx];
+                        const quad_key_type& key = quad_keys[e_idx];
+                        const FEBase& F_fe = scratch.F_fe_cache(key, elem);
+                        const std::vector<std::vector<double> >& phi_F = F_fe.get_phi();
+
+                        const unsigned int qp_offset = qp_offsets[e_idx];
+                        const unsigned int n_qp = qp_offsets[e_idx + 1] - qp_offset;
+                        TBOX_ASSERT(n_qp == phi_F[0].size());
+                        scratch.JxW.assign(JxW_qp.begin() + qp_offset, JxW_qp.begin() + qp_offset + n_qp);
+                        const size_t n_basis = F_dof_indices[0].size();
+                        scratch.F_rhs_concatenated.resize(n_vars * n_basis);
+                        std::fill(scratch.F_rhs_concatenated.begin(), scratch.F_rhs_concatenated.end(), 0.0);
+                        integrate_elem_rhs(
+                            n_vars, n_basis, qp_offset, phi_F, scratch.JxW, F_qp, scratch.F_rhs_concatenated);
+                        std::copy(scratch.F_rhs_concatenated.begin(),
+                                  scratch.F_rhs_concatenated.end(),
+                                  F_rhs_concatenated.begin() + rhs_offsets[e_idx]);
+                    }
 
-                    for (unsigned int var_n = 0; var_n < n_vars; ++var_n)
+                    // Accumulate the right-hand-side values. This is done in
+                    // element order (and not by the threads) so that the result
+                    // does not depend on the number of threads.
+                    for (unsigned int e_idx = 0; e_idx < num_active_patch_elems; ++e_idx)
                     {
-                        F_rhs.resize(F_dof_indices[var_n].size());
-                        std::copy(F_rhs_concatenated.begin() + var_n * n_basis,
-                                  F_rhs_concatenated.begin() + (var_n + 1) * n_basis,
-                                  F_rhs.get_values().begin());
-
-                        // We do *not* apply constraints here. See the note in the
-                        // documentation of this function for an explanation.
-                        if (is_ghosted)
+                        const auto& F_dof_indices = *F_elem_dof_indices[e_idx];
+                        const size_t n_basis = F_dof_indices[0].size();
+                        const double* const F_rhs_elem = &F_rhs_concatenated[rhs_offsets[e_idx]];
+                        for (unsigned int var_n = 0; var_n < n_vars; ++var_n)
                         {
-                            for (unsigned int i = 0; i < F_dof_indices[var_n].size(); ++i)
+                            F_rhs.resize(F_dof_indices[var_n].size());
+                            std::copy(F_rhs_elem + var_n * n_basis,
+                                      F_rhs_elem + (var_n + 1) * n_basis,
+                                      F_rhs.get_values().begin());
+
+                            // We do *not* apply constraints here. See the note in
+                            // the documentation of this function for an
+                            // explanation.
+                            if (is_ghosted)
                             {
-                                const PetscInt index = F_petsc_vec->map_global_to_local_index(F_dof_indices[var_n][i]);
+                                for (unsigned int i = 0; i < F_dof_indices[var_n].size(); ++i)
+                                {
+                                    const PetscInt index =
+                                        F_petsc_vec->map_global_to_local_index(F_dof_indices[var_n][i]);
 #ifndef NDEBUG
-                                TBOX_ASSERT(0 <= index);
-                                TBOX_ASSERT(index < F_local_size);
+                                    TBOX_ASSERT(0 <= index);
+                                    TBOX_ASSERT(index < F_local_size);
 #endif
-                                F_local_soln[index] += F_rhs(i);
+                                    F_local_soln[index] += F_rhs(i);
+                                }
+                            }
+                            else
+                            {
+                                copy_dof_ids_to_vector(var_n, F_dof_indices, dof_id_scratch);
+                                F_vec.add_vector(F_rhs, dof_id_scratch);
                             }
                         }
-                        else
-                        {
-                            copy_dof_ids_to_vector(var_n, F_dof_indices, dof_id_scratch);
-                            F_vec.add_vector(F_rhs, dof_id_scratch);
-                        }
                     }
-                    qp_offset += n_qp;
+
+                    if (measure_costs)
+                    {
+                        addMeasuredCost(
+                            patch_elems,
+                            qp_offsets,
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - patch_start_time).count());
+                    }
                 }
             }
         }
+        if (use_qp_cache && qp_cache_miss && d_enable_logging)
+        {
+            plog << "FEDataManager::interpWeighted(): quadrature point cache uses "
+                 << getQuadraturePointCacheMemoryUsage() << " bytes\n";
+        }
     }
 
     // Restore local form vectors.
-    X_petsc_vec->restore_array();
+    restore_elem_subset_array_read(*X_petsc_vec, X_local_soln, elem_subset);
     if (is_ghosted)
     {
         int ierr = VecRestoreArray(F_local_form, &F_local_soln);
@@ -2096,7 +2453,7 @@ FEDataManager::interpWeighted(const int f_data_idx,
         ierr = VecGhostRestoreLocalForm(F_petsc_vec->vec(), &F_local_form);
         IBTK_CHKERRQ(ierr);
 
-        if (close_F)
+        if (close_F && last_subset)
         {
             ierr = VecGhostUpdateBegin(F_petsc_vec->vec(), ADD_VALUES, SCATTER_REVERSE);
             IBTK_CHKERRQ(ierr);
@@ -2106,7 +2463,7 @@ FEDataManager::interpWeighted(const int f_data_idx,
     }
 
     // Accumulate data.
-    if (close_F) F_vec.close();
+    if (close_F && last_subset) F_vec.close();
 
     IBTK_TIMER_STOP(t_interp_weighted);
     return;
@@ -2483,9 +2840,9 @@ FEDataManager::updateSpreadQuadratureRule(std::unique_ptr<QBase>& qrule,
     return updateQuadratureRule(qrule,
                                 spec.quad_type,
                                 spec.quad_order,
-                                spec.allow_rules_with_negative_weights,
-                                spec.point_density,
                                 spec.use_adaptive_quadrature,
+                                spec.point_density,
+                                spec.allow_rules_with_negative_weights,
                                 elem,
                                 X_node,
                                 dx_min);
@@ -2505,7 +2862,9 @@ FEDataManager::addWorkloadEstimate(Pointer<PatchHierarchy<NDIM> > hierarchy,
     TBOX_ASSERT(finest_ln >= getCoarsestPatchLevelNumber() && finest_ln <= getFinestPatchLevelNumber());
 
     {
-        updateQuadPointCountData(0, hierarchy->getFinestLevelNumber());
+        const bool use_measured_costs = d_default_workload_spec.use_measured_costs;
+        if (use_measured_costs) updateMeasuredCosts();
+        updateQuadPointCountData(0, hierarchy->getFinestLevelNumber(), use_measured_costs);
         HierarchyCellDataOpsReal<NDIM, double> hier_cc_data_ops(hierarchy, coarsest_ln, finest_ln);
         hier_cc_data_ops.axpy(
             workload_data_idx, d_default_workload_spec.q_point_weight, d_qp_count_idx, workload_data_idx);
@@ -2568,6 +2927,46 @@ FEDataManager::addWorkloadEstimate(Pointer<PatchHierarchy<NDIM> > hierarchy,
     return;
 } // addWorkloadEstimate
 
+void
+FEDataManager::addMeasuredCost(const std::vector<Elem*>& elems,
+                               const std::vector<unsigned int>& qp_offsets,
+                               const double seconds)
+{
+    if (!d_default_workload_spec.use_measured_costs || elems.empty()) return;
+    TBOX_ASSERT(qp_offsets.size() == elems.size() + 1);
+    const unsigned int n_qp_total = qp_offsets[elems.size()] - qp_offsets[0];
+    if (!n_qp_total) return;
+    const double seconds_per_qp = seconds / n_qp_total;
+    for (unsigned int e_idx = 0; e_idx < elems.size(); ++e_idx)
+    {
+        const unsigned int n_qp = qp_offsets[e_idx + 1] - qp_offsets[e_idx];
+        if (!n_qp) continue;
+        std::pair<double, double>& cost = d_elem_new_measured_costs[elems[e_idx]->id()];
+        cost.first += seconds_per_qp * n_qp;
+        cost.second += n_qp;
+    }
+    return;
+} // addMeasuredCost
+
+void
+FEDataManager::addMeasuredSurfaceCost(const std::vector<Elem*>& elems,
+                                      const std::vector<unsigned int>& qp_offsets,
+                                      const double seconds)
+{
+    if (!d_default_workload_spec.use_measured_costs || elems.empty()) return;
+    TBOX_ASSERT(qp_offsets.size() == elems.size() + 1);
+    const unsigned int n_qp_total = qp_offsets[elems.size()] - qp_offsets[0];
+    if (!n_qp_total) return;
+    const double seconds_per_qp = seconds / n_qp_total;
+    for (unsigned int e_idx = 0; e_idx < elems.size(); ++e_idx)
+    {
+        const unsigned int n_qp = qp_offsets[e_idx + 1] - qp_offsets[e_idx];
+        if (!n_qp) continue;
+        d_elem_new_measured_surface_costs[elems[e_idx]->id()] += seconds_per_qp * n_qp;
+    }
+    return;
+} // addMeasuredSurfaceCost
+
 void
 FEDataManager::applyGradientDetector(const Pointer<BasePatchHierarchy<NDIM> > hierarchy,
                                      const int level_number,
@@ -2841,6 +3240,13 @@ FEDataManager::FEDataManager(std::string object_name,
       d_ghost_width(std::move(ghost_width))
 {
     TBOX_ASSERT(!d_object_name.empty());
+    const double history_weight = d_default_workload_spec.measured_cost_history_weight;
+    if (!(history_weight >= 0.0 && history_weight <= 1.0))
+    {
+        TBOX_ERROR(d_object_name << "::FEDataManager():\n"
+                                 << "WorkloadSpec::measured_cost_history_weight = " << history_weight
+                                 << " is not in [0, 1]." << std::endl);
+    }
 
     if (d_registered_for_restart)
     {
@@ -2874,6 +3280,8 @@ FEDataManager::FEDataManager(std::string object_name,
         TBOX_ERROR("unrecognized value " << input_db->getString("node_outside_patch_check")
                                          << "for input entry 'node_outside_patch_check'.");
     }
+    d_use_threaded_element_loops = input_db->getBoolWithDefault("use_threaded_element_loops", false);
+    d_cache_quadrature_point_data = input_db->getBoolWithDefault("cache_quadrature_point_data", false);
 
     // Setup Timers.
     IBTK_DO_ONCE(
@@ -2920,10 +3328,161 @@ FEDataManager::getLoggingEnabled() const
     return d_enable_logging;
 } // getLoggingEnabled
 
+void
+FEDataManager::setThreadedElementLoopsEnabled(bool use_threaded_element_loops)
+{
+    d_use_threaded_element_loops = use_threaded_element_loops;
+    return;
+} // setThreadedElementLoopsEnabled
+
+bool
+FEDataManager::getThreadedElementLoopsEnabled() const
+{
+    return d_use_threaded_element_loops;
+} // getThreadedElementLoopsEnabled
+
+void
+FEDataManager::setQuadraturePointCacheEnabled(bool cache_quadrature_point_data)
+{
+    d_cache_quadrature_point_data = cache_quadrature_point_data;
+    if (!d_cache_quadrature_point_data) clearQuadraturePointCache();
+    return;
+} // setQuadraturePointCacheEnabled
+
+bool
+FEDataManager::getQuadraturePointCacheEnabled() const
+{
+    return d_cache_quadrature_point_data;
+} // getQuadraturePointCacheEnabled
+
+void
+FEDataManager::setElementSubsetsEnabled(bool use_elem_subsets)
+{
+    d_use_elem_subsets = use_elem_subsets;
+    return;
+} // setElementSubsetsEnabled
+
+bool
+FEDataManager::getElementSubsetsEnabled() const
+{
+    return d_use_elem_subsets;
+} // getElementSubsetsEnabled
+
+void
+FEDataManager::clearQuadraturePointCache()
+{
+    d_qp_cache_valid.fill(false);
+    std::vector<double>().swap(d_qp_cache_X);
+    std::vector<double>().swap(d_qp_cache_X_ghost);
+    std::vector<std::vector<std::array<PatchQuadratureData, 2> > >().swap(d_qp_cache_patch_data);
+    return;
+} // clearQuadraturePointCache
+
+std::size_t
+FEDataManager::getQuadraturePointCacheMemoryUsage() const
+{
+    std::size_t n_bytes = (d_qp_cache_X.capacity() + d_qp_cache_X_ghost.capacity()) * sizeof(double);
+    for (const std::vector<std::array<PatchQuadratureData, 2> >& level_data : d_qp_cache_patch_data)
+    {
+        for (const std::array<PatchQuadratureData, 2>& patch_data : level_data)
+        {
+            for (const PatchQuadratureData& subset_data : patch_data)
+            {
+                n_bytes += subset_data.quad_keys.capacity() * sizeof(quadrature_key_type);
+                n_bytes += subset_data.qp_offsets.capacity() * sizeof(unsigned int);
+                n_bytes += (subset_data.X_qp.capacity() + subset_data.JxW_qp.capacity()) * sizeof(double);
+            }
+        }
+    }
+    return n_bytes;
+} // getQuadraturePointCacheMemoryUsage
+
 /////////////////////////////// PRIVATE //////////////////////////////////////
 
+bool
+FEDataManager::checkQuadraturePointCache(PetscVector<double>& X_vec,
+                                         const double* const X_local_soln,
+                                         const QuadratureType quad_type,
+                                         const Order quad_order,
+                                         const bool use_adaptive_quadrature,
+                                         const double point_density,
+                                         const bool allow_rules_with_negative_weights,
+                                         const unsigned int subset)
+{
+    TBOX_ASSERT(subset < 2);
+
+    // Determine the size of the locally owned part of the position vector
+    // and, for the processor boundary elements, the number of its ghost
+    // entries. The local form of the vector is not accessed for the processor
+    // interior elements since its ghost entries may still be in the process
+    // of being updated.
+    PetscInt X_owned_size = 0;
+    int ierr = VecGetLocalSize(X_vec.vec(), &X_owned_size);
+    IBTK_CHKERRQ(ierr);
+    PetscInt X_local_size = X_owned_size;
+    if (subset == 1)
+    {
+        Vec X_local_form = nullptr;
+        ierr = VecGhostGetLocalForm(X_vec.vec(), &X_local_form);
+        IBTK_CHKERRQ(ierr);
+        if (X_local_form)
+        {
+            ierr = VecGetSize(X_local_form, &X_local_size);
+            IBTK_CHKERRQ(ierr);
+            ierr = VecGhostRestoreLocalForm(X_vec.vec(), &X_local_form);
+            IBTK_CHKERRQ(ierr);
+        }
+    }
+    const std::size_t n_ghosts = X_local_size - X_owned_size;
+
+    // The cached data is still valid if it was computed with bitwise identical
+    // positions and the same quadrature parameters (the kernel function does
+    // not matter). These are the parameters with which
+    // updateInterpQuadratureRule() and updateSpreadQuadratureRule() select
+    // the rule of each element, so the cached rules are the ones those
+    // functions would select for the same positions. Comparing the vector
+    // entries is much cheaper than recomputing the quadrature data and,
+    // unlike the identity of the vector object, is not affected by copying
+    // positions into a scratch vector. The processor interior elements only
+    // depend on the locally owned entries: the ghost entries are only
+    // compared for the processor boundary elements.
+    const auto quad_params = std::make_tuple(
+        quad_type, quad_order, use_adaptive_quadrature, point_density, allow_rules_with_negative_weights);
+    const bool owned_equal =
+        quad_params == d_qp_cache_quad_params && d_qp_cache_X.size() == static_cast<std::size_t>(X_owned_size) &&
+        std::memcmp(d_qp_cache_X.data(), X_local_soln, sizeof(double) * X_owned_size) == 0;
+    const bool ghost_equal =
+        subset == 0 ||
+        (d_qp_cache_X_ghost.size() == n_ghosts &&
+         std::memcmp(d_qp_cache_X_ghost.data(), X_local_soln + X_owned_size, sizeof(double) * n_ghosts) == 0);
+    if (d_qp_cache_valid[subset] && owned_equal && ghost_equal)
+    {
+        return true;
+    }
+
+    // Otherwise reset the cache. Previously allocated memory is kept since
+    // the amount of data usually changes very little between time steps.
+    if (!owned_equal)
+    {
+        d_qp_cache_valid.fill(false);
+        d_qp_cache_quad_params = quad_params;
+        d_qp_cache_X.assign(X_local_soln, X_local_soln + X_owned_size);
+    }
+    if (!ghost_equal)
+    {
+        d_qp_cache_X_ghost.assign(X_local_soln + X_owned_size, X_local_soln + X_local_size);
+    }
+    d_qp_cache_patch_data.resize(d_active_patch_elem_map.size());
+    for (unsigned int ln = 0; ln < d_active_patch_elem_map.size(); ++ln)
+    {
+        d_qp_cache_patch_data[ln].resize(d_active_patch_elem_map[ln].size());
+    }
+    d_qp_cache_valid[subset] = true;
+    return false;
+} // checkQuadraturePointCache
+
 void
-FEDataManager::updateQuadPointCountData(const int coarsest_ln, const int finest_ln)
+FEDataManager::updateQuadPointCountData(const int coarsest_ln, const int finest_ln, const bool weight_by_measured_costs)
 {
     // The patch hierarchy should be completely set up at this point so we can
     // 1. assert that the Eulerian data cache is ready
@@ -3035,6 +3594,8 @@ FEDataManager::updateQuadPointCountData(const int coarsest_ln, const int finest_
                     const std::vector<std::vector<double> >& X_phi = X_fe.get_phi();
                     TBOX_ASSERT(qrule.n_points() == X_phi[0].size());
 
+                    const double qp_weight =
+                        weight_by_measured_costs ? getRelativeMeasuredCost(elem, qrule.n_points()) : 1.0;
                     Point X_qp;
                     for (unsigned int qp = 0; qp < qrule.n_points(); ++qp)
                     {
@@ -3042,7 +3603,7 @@ FEDataManager::updateQuadPointCountData(const int coarsest_ln, const int finest_
                         const hier::Index<NDIM> i = IndexUtilities::getCellIndex(X_qp, grid_geom, ratio);
                         if (patch_box.contains(i))
                         {
-                            (*qp_count_data)(i) += 1.0;
+                            (*qp_count_data)(i) += qp_weight;
                             ++n_local_q_points;
                         }
                     }
@@ -3081,6 +3642,100 @@ FEDataManager::updateQuadPointCountData(const int coarsest_ln, const int finest_
     return;
 } // updateQuadPointCountData
 
+void
+FEDataManager::updateMeasuredCosts()
+{
+    // The workload estimate is computed on the patches on which the costs were
+    // measured, so each processor only needs the costs of the elements of its
+    // own patches. Measurements of elements which are no longer associated
+    // with any local patch are discarded.
+    std::unordered_set<dof_id_type> local_elem_ids;
+    for (const std::vector<std::vector<Elem*> >& level_patch_elems : d_active_patch_elem_map)
+    {
+        for (const std::vector<Elem*>& patch_elems : level_patch_elems)
+        {
+            for (const Elem* const elem : patch_elems) local_elem_ids.insert(elem->id());
+        }
+    }
+
+    const double history_weight = d_default_workload_spec.measured_cost_history_weight;
+    for (auto it = d_elem_measured_costs.begin(); it != d_elem_measured_costs.end();)
+    {
+        if (local_elem_ids.count(it->first))
+        {
+            it->second.first *= history_weight;
+            it->second.second *= history_weight;
+            ++it;
+        }
+        else
+        {
+            it = d_elem_measured_costs.erase(it);
+        }
+    }
+    for (const auto& elem_cost : d_elem_new_measured_costs)
+    {
+        if (!local_elem_ids.count(elem_cost.first)) continue;
+        std::pair<double, double>& cost = d_elem_measured_costs[elem_cost.first];
+        cost.first += elem_cost.second.first;
+        cost.second += elem_cost.second.second;
+    }
+    d_elem_new_measured_costs.clear();
+
+    // Surface costs are combined in the same way but are kept separately since
+    // their quadrature points are not counted in the workload estimate.
+    for (auto it = d_elem_measured_surface_costs.begin(); it != d_elem_measured_surface_costs.end();)
+    {
+        if (local_elem_ids.count(it->first))
+        {
+            it->second *= history_weight;
+            ++it;
+        }
+        else
+        {
+            it = d_elem_measured_surface_costs.erase(it);
+        }
+    }
+    for (const auto& elem_cost : d_elem_new_measured_surface_costs)
+    {
+        if (!local_elem_ids.count(elem_cost.first)) continue;
+        d_elem_measured_surface_costs[elem_cost.first] += elem_cost.second;
+    }
+    d_elem_new_measured_surface_costs.clear();
+
+    // Normalize by the average cost per quadrature point of all processors so
+    // that the workload estimates of different processors are comparable.
+    std::array<double, 2> totals = { { 0.0, 0.0 } };
+    for (const auto& elem_cost : d_elem_measured_costs)
+    {
+        totals[0] += elem_cost.second.first;
+        totals[1] += elem_cost.second.second;
+    }
+    IBTK_MPI::sumReduction(totals.data(), 2);
+    d_average_measured_cost = totals[1] > 0.0 ? totals[0] / totals[1] : 0.0;
+    return;
+} // updateMeasuredCosts
+
+double
+FEDataManager::getRelativeMeasuredCost(const Elem* const elem, const unsigned int n_qp) const
+{
+    if (d_average_measured_cost == 0.0) return 1.0;
+    double relative_cost = 1.0;
+    const auto it = d_elem_measured_costs.find(elem->id());
+    if (it != d_elem_measured_costs.end() && it->second.second != 0.0)
+    {
+        relative_cost = it->second.first / it->second.second / d_average_measured_cost;
+    }
+
+    // Surface costs are charged to the element as a whole, i.e., they are split
+    // between its (volume) quadrature points.
+    const auto surface_it = d_elem_measured_surface_costs.find(elem->id());
+    if (surface_it != d_elem_measured_surface_costs.end() && n_qp)
+    {
+        relative_cost += surface_it->second / d_average_measured_cost / n_qp;
+    }
+    return relative_cost;
+} // getRelativeMeasuredCost
+
 void
 FEDataManager::collectActivePatchElements(std::vector<std::vector<Elem*> >& active_patch_elems,
                                           const int level_number,
@@ -3088,7 +3743,7 @@ FEDataManager::collectActivePatchElements(std::vector<std::vector<Elem*> >& acti
                                           const int finest_elem_ln)
 {
     // Get the necessary FE data.
-    const MeshBase& mesh = d_fe_data->d_es->get_mesh();
+    MeshBase& mesh = d_fe_data->d_es->get_mesh();
     System& X_system = d_fe_data->d_es->get_system(COORDINATES_SYSTEM_NAME);
 
     // Setup data structures used to assign elements to patches.
@@ -3154,17 +3809,76 @@ FEDataManager::collectActivePatchElements(std::vector<std::vector<Elem*> >& acti
         local_bboxes.back().union_with(local_qp_bboxes[box_n]);
 #endif
     }
-    const std::vector<libMeshWrappers::BoundingBox> global_bboxes =
-        get_global_element_bounding_boxes(mesh, local_bboxes);
+
+    // Rather than gathering the bounding boxes of all elements on every
+    // processor, we only send the bounding boxes of the active elements on the
+    // levels of interest to the processors that own patches they might
+    // intersect. The patch boxes are grown by an extra cell so that roundoff
+    // in the computation of their extents cannot cause elements to be
+    // missed.
+    std::vector<dof_id_type> local_elem_ids;
+    std::vector<libMeshWrappers::BoundingBox> local_elem_bboxes;
+    {
+        std::size_t box_n = 0;
+        const auto el_begin = mesh.local_elements_begin();
+        const auto el_end = mesh.local_elements_end();
+        for (auto el_it = el_begin; el_it != el_end; ++el_it, ++box_n)
+        {
+            const Elem* const elem = *el_it;
+            if (!elem->active()) continue;
+            const int elem_ln = getPatchLevel(elem);
+            if (coarsest_elem_ln <= elem_ln && elem_ln <= finest_elem_ln)
+            {
+                local_elem_ids.push_back(elem->id());
+                local_elem_bboxes.push_back(local_bboxes[box_n]);
+            }
+        }
+        TBOX_ASSERT(box_n == local_bboxes.size());
+    }
+
+    const BoxArray<NDIM>& level_boxes = level->getBoxes();
+    const ProcessorMapping& processor_mapping = level->getProcessorMapping();
+    const IntVector<NDIM>& ratio = level->getRatio();
+    const Box<NDIM> domain_box = Box<NDIM>::refine(grid_geom->getPhysicalDomain()[0], ratio);
+    const double* const grid_x_lower = grid_geom->getXLower();
+    const double* const grid_dx = grid_geom->getDx();
+    std::vector<libMeshWrappers::BoundingBox> region_bboxes(level_boxes.getNumberOfBoxes());
+    std::vector<int> region_ranks(level_boxes.getNumberOfBoxes());
+    for (int i = 0; i < level_boxes.getNumberOfBoxes(); ++i)
+    {
+        const Box<NDIM>& box = level_boxes[i];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            const double dx = grid_dx[d] / ratio(d);
+            const int ghost_width = d_associated_elem_ghost_width(d) + 1;
+            region_bboxes[i].first(d) = grid_x_lower[d] + dx * (box.lower(d) - domain_box.lower(d) - ghost_width);
+            region_bboxes[i].second(d) = grid_x_lower[d] + dx * (box.upper(d) + 1 - domain_box.lower(d) + ghost_width);
+        }
+        for (unsigned int d = NDIM; d < LIBMESH_DIM; ++d)
+        {
+            region_bboxes[i].first(d) = 0.0;
+            region_bboxes[i].second(d) = 0.0;
+        }
+        region_ranks[i] = processor_mapping.getProcessorAssignment(i);
+    }
+    const std::vector<std::pair<dof_id_type, libMeshWrappers::BoundingBox> > nearby_elem_bboxes =
+        get_nearby_element_bounding_boxes(mesh, local_elem_ids, local_elem_bboxes, region_bboxes, region_ranks);
+
+    // Sort the bounding boxes of the nearby elements into a spatial index so
+    // that we only need to check the elements that are near each patch.
+    std::vector<libMeshWrappers::BoundingBox> nearby_bboxes;
+    nearby_bboxes.reserve(nearby_elem_bboxes.size());
+    for (const auto& id_bbox : nearby_elem_bboxes) nearby_bboxes.push_back(id_bbox.second);
+    const BoundingBoxBins bbox_bins(nearby_bboxes);
 
     int local_patch_num = 0;
+    std::vector<int> patch_elem_indices;
     for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++local_patch_num)
     {
         std::set<Elem*>& elems = local_patch_elems[local_patch_num];
         Pointer<Patch<NDIM> > patch = level->getPatch(p());
         const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
         const double* const dx = pgeom->getDx();
-        // TODO: reimplement this with an rtree description of SAMRAI's patches
         libMeshWrappers::BoundingBox patch_bbox;
         for (unsigned int d = 0; d < NDIM; ++d)
         {
@@ -3177,24 +3891,10 @@ FEDataManager::collectActivePatchElements(std::vector<std::vector<Elem*> >& acti
             patch_bbox.second(d) = 0.0;
         }
 
-        auto el_it = mesh.elements_begin();
-        for (const libMeshWrappers::BoundingBox& bbox : global_bboxes)
+        bbox_bins.getIntersectingBoxes(patch_bbox, patch_elem_indices);
+        for (const int elem_idx : patch_elem_indices)
         {
-            if ((*el_it)->active())
-            {
-                const int elem_ln = getPatchLevel(*el_it);
-                if (coarsest_elem_ln <= elem_ln && elem_ln <= finest_elem_ln)
-                {
-#if LIBMESH_VERSION_LESS_THAN(1, 6, 0)
-                    if (bbox_intersects(bbox, patch_bbox)) elems.insert(*el_it);
-#else
-                    // New versions of libMesh have this function's performance
-                    // problems fixed
-                    if (bbox.intersects(patch_bbox)) elems.insert(*el_it);
-#endif
-                }
-            }
-            ++el_it;
+            elems.insert(mesh.elem_ptr(nearby_elem_bboxes[elem_idx].first));
         }
     }
 
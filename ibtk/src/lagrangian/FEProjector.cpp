@@ -709,8 +709,9 @@ FEProjector::computeL2Projection(PetscVector<double>& U_vec,
         ierr = KSPSetFromOptions(solver->ksp());
         IBTK_CHKERRQ(ierr);
 
-        auto pair = d_initial_guesses.emplace(system_name, d_num_fischer_vectors);
-        FischerGuess& fischer_guess = (pair.first)->second;
+        // The matrices differ, so each one keeps its own collection of vectors.
+        auto& initial_guesses = consistent_mass_matrix ? d_initial_guesses : d_lumped_initial_guesses;
+        FischerGuess& fischer_guess = initial_guesses.emplace(system_name, d_num_fischer_vectors).first->second;
 
         fischer_guess.guess(U_vec, F_vec);
         solver->solve(
@@ -762,12 +763,19 @@ FEProjector::computeStabilizedL2Projection(PetscVector<double>& U_vec,
     IBTK_CHKERRQ(ierr);
     ierr = KSPSetFromOptions(solver->ksp());
     IBTK_CHKERRQ(ierr);
+
+    FischerGuess& fischer_guess =
+        d_stab_initial_guesses[system_name].emplace(epsilon, d_num_fischer_vectors).first->second;
+
+    fischer_guess.guess(U_vec, F_vec);
     solver->solve(*M_mat, *M_mat, U_vec, F_vec, rtol_set ? runtime_rtol : tol, max_it_set ? runtime_max_it : max_its);
     KSPConvergedReason reason;
     ierr = KSPGetConvergedReason(solver->ksp(), &reason);
     IBTK_CHKERRQ(ierr);
     converged = reason > 0;
 
+    fischer_guess.submit(U_vec, F_vec);
+
     if (close_U) U_vec.close();
     system.get_dof_map().enforce_constraints_exactly(system, &U_vec);
 
@@ -38,6 +38,8 @@ namespace IBTK
 {
 /////////////////////////////// STATIC ///////////////////////////////////////
 
+std::size_t LData::s_version_counter = 0;
+
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
 LData::LData(std::string name,
@@ -59,6 +61,7 @@ LData::LData(std::string name,
     d_global_node_count /= d_depth;
     d_local_node_count = num_local_nodes;
     d_ghost_node_count = static_cast<int>(d_nonlocal_petsc_indices.size());
+    updateVersion();
     return;
 } // LData
 
@@ -93,6 +96,7 @@ LData::LData(std::string name, Vec vec, std::vector<int> nonlocal_petsc_indices,
     d_local_node_count = local_node_count;
     d_local_node_count /= d_depth;
     d_ghost_node_count = static_cast<int>(d_nonlocal_petsc_indices.size());
+    updateVersion();
     return;
 } // LData
 
@@ -180,6 +184,7 @@ LData::resetData(Vec vec, const std::vector<int>& nonlocal_petsc_indices, const
     d_local_node_count /= d_depth;
     d_nonlocal_petsc_indices = nonlocal_petsc_indices;
     d_ghost_node_count = static_cast<int>(d_nonlocal_petsc_indices.size());
+    updateVersion();
     return;
 } // resetData
 
@@ -204,7 +209,7 @@ LData::putToDatabase(Pointer<Database> db)
     {
         db->putDoubleArray("vals", ghosted_local_vec_array, d_depth * (num_local_nodes + num_ghost_nodes));
     }
-    restoreArrays();
+    restoreArrays(/*values_modified*/ false);
     return;
 } // putToDatabase
 
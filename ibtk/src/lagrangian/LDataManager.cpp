@@ -19,6 +19,7 @@
 #include "ibtk/LData.h"
 #include "ibtk/LDataManager.h"
 #include "ibtk/LEInteractor.h"
+#include "ibtk/LEInteractorWeightCache.h"
 #include "ibtk/LIndexSetData.h"
 #include "ibtk/LInitStrategy.h"
 #include "ibtk/LMesh.h"
@@ -105,6 +106,7 @@ IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
@@ -267,6 +269,7 @@ LDataManager::setPatchLevels(const int coarsest_ln, const int finest_ln)
 
     // Resize some arrays.
     d_level_contains_lag_data.resize(d_finest_ln + 1);
+    d_weight_caches.resize(d_finest_ln + 1);
     d_strct_name_to_strct_id_map.resize(d_finest_ln + 1);
     d_strct_id_to_strct_name_map.resize(d_finest_ln + 1);
     d_strct_id_to_lag_idx_range_map.resize(d_finest_ln + 1);
@@ -630,26 +633,54 @@ LDataManager::spread(const int f_data_idx,
             if (cc_data)
             {
                 Pointer<CellData<NDIM, double> > f_cc_data = f_data;
-                LEInteractor::spread(
-                    f_cc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, spread_kernel_fcn);
+                LEInteractor::spread(f_cc_data,
+                                     F_data[ln],
+                                     X_data[ln],
+                                     idx_data,
+                                     patch,
+                                     box,
+                                     periodic_shift,
+                                     spread_kernel_fcn,
+                                     &d_weight_caches[ln]);
             }
             if (ec_data)
             {
                 Pointer<EdgeData<NDIM, double> > f_ec_data = f_data;
-                LEInteractor::spread(
-                    f_ec_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, spread_kernel_fcn);
+                LEInteractor::spread(f_ec_data,
+                                     F_data[ln],
+                                     X_data[ln],
+                                     idx_data,
+                                     patch,
+                                     box,
+                                     periodic_shift,
+                                     spread_kernel_fcn,
+                                     &d_weight_caches[ln]);
             }
             if (nc_data)
             {
                 Pointer<NodeData<NDIM, double> > f_nc_data = f_data;
-                LEInteractor::spread(
-                    f_nc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, spread_kernel_fcn);
+                LEInteractor::spread(f_nc_data,
+                                     F_data[ln],
+                                     X_data[ln],
+                                     idx_data,
+                                     patch,
+                                     box,
+                                     periodic_shift,
+                                     spread_kernel_fcn,
+                                     &d_weight_caches[ln]);
             }
             if (sc_data)
             {
                 Pointer<SideData<NDIM, double> > f_sc_data = f_data;
-                LEInteractor::spread(
-                    f_sc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, spread_kernel_fcn);
+                LEInteractor::spread(f_sc_data,
+                                     F_data[ln],
+                                     X_data[ln],
+                                     idx_data,
+                                     patch,
+                                     box,
+                                     periodic_shift,
+                                     spread_kernel_fcn,
+                                     &d_weight_caches[ln]);
             }
             if (f_phys_bdry_op)
             {
@@ -762,7 +793,8 @@ LDataManager::interp(const int f_data_idx,
                                           patch,
                                           box,
                                           periodic_shift,
-                                          d_default_interp_kernel_fcn);
+                                          d_default_interp_kernel_fcn,
+                                          &d_weight_caches[ln]);
             }
             if (ec_data)
             {
@@ -774,7 +806,8 @@ LDataManager::interp(const int f_data_idx,
                                           patch,
                                           box,
                                           periodic_shift,
-                                          d_default_interp_kernel_fcn);
+                                          d_default_interp_kernel_fcn,
+                                          &d_weight_caches[ln]);
             }
             if (nc_data)
             {
@@ -786,7 +819,8 @@ LDataManager::interp(const int f_data_idx,
                                           patch,
                                           box,
                                           periodic_shift,
-                                          d_default_interp_kernel_fcn);
+                                          d_default_interp_kernel_fcn,
+                                          &d_weight_caches[ln]);
             }
             if (sc_data)
             {
@@ -798,7 +832,8 @@ LDataManager::interp(const int f_data_idx,
                                           patch,
                                           box,
                                           periodic_shift,
-                                          d_default_interp_kernel_fcn);
+                                          d_default_interp_kernel_fcn,
+                                          &d_weight_caches[ln]);
             }
         }
     }
@@ -1940,6 +1975,13 @@ LDataManager::endDataRedistribution(const int coarsest_ln_in, const int finest_l
         }
     }
 
+    // Discard cached interpolation and spreading stencils, which refer to the
+    // old patches.
+    for (int level_number = coarsest_ln; level_number <= finest_ln; ++level_number)
+    {
+        d_weight_caches[level_number].clear();
+    }
+
     // If a Silo data writer is registered with the manager, give it access to
     // the new application orderings.
     if (d_silo_writer)
@@ -2876,14 +2918,45 @@ LDataManager::computeNodeDistribution(AO& ao,
     unsigned int local_offset = 0;
     std::map<int, int> lag_idx_to_petsc_idx;
 #if 1
+    std::vector<std::pair<std::uint64_t, LNode*> > sorted_nodes;
     for (PatchLevel<NDIM>::Iterator p(level); p; p++)
     {
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         const Box<NDIM>& patch_box = patch->getBox();
         const Pointer<LNodeSetData> idx_data = patch->getPatchData(d_lag_node_index_current_idx);
+
+        // Optionally sort the nodes of the patch along a space-filling curve
+        // through the patch cells. The sort is stable so that nodes located in
+        // the same cell retain their relative order.
+        sorted_nodes.clear();
         for (LNodeSetData::DataIterator it = idx_data->data_begin(patch_box); it != idx_data->data_end(); ++it)
         {
-            LNode* const node_idx = *it;
+            std::uint64_t key = 0;
+            switch (d_node_ordering)
+            {
+            case LNODE_ORDERING_MORTON:
+                key = IndexUtilities::getMortonKey(it.getCellIndex(), patch_box.lower());
+                break;
+            case LNODE_ORDERING_HILBERT:
+                key = IndexUtilities::getHilbertKey(it.getCellIndex(), patch_box.lower());
+                break;
+            default:
+                break;
+            }
+            sorted_nodes.emplace_back(key, *it);
+        }
+        if (d_node_ordering != LNODE_ORDERING_NONE)
+        {
+            std::stable_sort(sorted_nodes.begin(),
+                             sorted_nodes.end(),
+                             [](const std::pair<std::uint64_t, LNode*>& a, const std::pair<std::uint64_t, LNode*>& b) {
+                                 return a.first < b.first;
+                             });
+        }
+
+        for (const auto& key_node_pair : sorted_nodes)
+        {
+            LNode* const node_idx = key_node_pair.second;
             const int lag_idx = node_idx->getLagrangianIndex();
             local_lag_indices.push_back(lag_idx);
             const int petsc_idx = local_offset++;
@@ -16,6 +16,7 @@
 #include "ibtk/IndexUtilities.h"
 #include "ibtk/LData.h"
 #include "ibtk/LEInteractor.h"
+#include "ibtk/LEInteractorWeightCache.h"
 #include "ibtk/LIndexSetData.h"
 #include "ibtk/LSet.h"
 #include "ibtk/ibtk_utilities.h"
@@ -49,6 +50,8 @@ IBTK_ENABLE_EXTRA_WARNINGS
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -1311,14 +1314,737 @@ spread_data(const int stencil_sz,
     }
 #endif
 } // spread_data
+
+// Templated implementations of the standard kernel functions.
+//
+// Each kernel class provides its stencil width as a compile-time constant
+// along with a function that, given the position of a point relative to the
+// lower side of the patch (in units of the grid spacing), computes the 1D
+// weights of the stencil and returns the index of the first point of the
+// stencil relative to the lower index of the patch. The stencil conventions
+// match those of the Fortran implementations.
+
+inline double
+piecewise_linear_delta(double r)
+{
+    r = std::abs(r);
+    return (r < 1.0 ? 1.0 - r : 0.0);
+}
+
+inline double
+ib_3_delta(double r)
+{
+    r = std::abs(r);
+    if (r < 0.5)
+    {
+        return (1.0 + std::sqrt(1.0 - 3.0 * r * r)) / 3.0;
+    }
+    else if (r < 1.5)
+    {
+        return (5.0 - 3.0 * r - std::sqrt(1.0 - 3.0 * (1.0 - r) * (1.0 - r))) / 6.0;
+    }
+    return 0.0;
+}
+
+inline double
+bspline_3_delta(const double x)
+{
+    const double modx = std::abs(x);
+    const double r = modx + 1.5;
+    const double r2 = r * r;
+    if (modx <= 0.5)
+    {
+        return 0.5 * (-2.0 * r2 + 6.0 * r - 3.0);
+    }
+    else if (modx <= 1.5)
+    {
+        return 0.5 * (r2 - 6.0 * r + 9.0);
+    }
+    return 0.0;
+}
+
+inline double
+bspline_4_delta(const double x)
+{
+    const double modx = std::abs(x);
+    const double r = modx + 2.0;
+    const double r2 = r * r;
+    const double r3 = r2 * r;
+    if (modx <= 1.0)
+    {
+        return (1.0 / 6.0) * (3.0 * r3 - 24.0 * r2 + 60.0 * r - 44.0);
+    }
+    else if (modx <= 2.0)
+    {
+        return (1.0 / 6.0) * (-r3 + 12.0 * r2 - 48.0 * r + 64.0);
+    }
+    return 0.0;
+}
+
+inline double
+bspline_5_delta(const double x)
+{
+    const double modx = std::abs(x);
+    const double r = modx + 2.5;
+    const double r2 = r * r;
+    const double r3 = r2 * r;
+    const double r4 = r3 * r;
+    if (modx <= 0.5)
+    {
+        return (1.0 / 24.0) * (6.0 * r4 - 60.0 * r3 + 210.0 * r2 - 300.0 * r + 155.0);
+    }
+    else if (modx <= 1.5)
+    {
+        return (1.0 / 24.0) * (-4.0 * r4 + 60.0 * r3 - 330.0 * r2 + 780.0 * r - 655.0);
+    }
+    else if (modx <= 2.5)
+    {
+        return (1.0 / 24.0) * (r4 - 20.0 * r3 + 150.0 * r2 - 500.0 * r + 625.0);
+    }
+    return 0.0;
+}
+
+inline double
+bspline_6_delta(const double x)
+{
+    const double modx = std::abs(x);
+    const double r = modx + 3.0;
+    const double r2 = r * r;
+    const double r3 = r2 * r;
+    const double r4 = r3 * r;
+    const double r5 = r4 * r;
+    if (modx <= 1.0)
+    {
+        return (1.0 / 60.0) * (2193.0 - 3465.0 * r + 2130.0 * r2 - 630.0 * r3 + 90.0 * r4 - 5.0 * r5);
+    }
+    else if (modx <= 2.0)
+    {
+        return (1.0 / 120.0) * (-10974.0 + 12270.0 * r - 5340.0 * r2 + 1140.0 * r3 - 120.0 * r4 + 5.0 * r5);
+    }
+    else if (modx <= 3.0)
+    {
+        return (1.0 / 120.0) * (7776.0 - 6480.0 * r + 2160.0 * r2 - 360.0 * r3 + 30.0 * r4 - r5);
+    }
+    return 0.0;
+}
+
+// Kernels whose stencils are determined by the cell containing the point: odd
+// stencils are centered on that cell, and even stencils are shifted towards
+// the side of the cell on which the point lies.
+template <int stencil_width, double (*delta)(double)>
+struct CellCenteredKernel
+{
+    static constexpr int width = stencil_width;
+
+    static inline int
+    computeWeights(const double X_o_dx, double* const w)
+    {
+        const int ic_center = static_cast<int>(std::floor(X_o_dx));
+        int ic_lower = ic_center - width / 2;
+        if (width % 2 == 0 && X_o_dx >= static_cast<double>(ic_center) + 0.5) ++ic_lower;
+        for (int k = 0; k < width; ++k)
+        {
+            w[k] = delta(X_o_dx - (static_cast<double>(ic_lower + k) + 0.5));
+        }
+        return ic_lower;
+    }
+};
+
+using PiecewiseLinearKernel = CellCenteredKernel<2, piecewise_linear_delta>;
+using IB3Kernel = CellCenteredKernel<3, ib_3_delta>;
+using BSpline3Kernel = CellCenteredKernel<3, bspline_3_delta>;
+using BSpline4Kernel = CellCenteredKernel<4, bspline_4_delta>;
+using BSpline5Kernel = CellCenteredKernel<5, bspline_5_delta>;
+using BSpline6Kernel = CellCenteredKernel<6, bspline_6_delta>;
+
+struct IB4Kernel
+{
+    static constexpr int width = 4;
+
+    static inline int
+    computeWeights(const double X_o_dx, double* const w)
+    {
+        const int ic_lower = NINT(X_o_dx) - 2;
+        const double r = X_o_dx - (static_cast<double>(ic_lower + 1) + 0.5);
+        const double q = std::sqrt(1.0 + 4.0 * r * (1.0 - r));
+        w[0] = 0.125 * (3.0 - 2.0 * r - q);
+        w[1] = 0.125 * (3.0 - 2.0 * r + q);
+        w[2] = 0.125 * (1.0 + 2.0 * r + q);
+        w[3] = 0.125 * (1.0 + 2.0 * r - q);
+        return ic_lower;
+    }
+};
+
+struct IB4W8Kernel
+{
+    static constexpr int width = 8;
+
+    static inline int
+    computeWeights(const double X_o_dx, double* const w)
+    {
+        const int ic_lower = NINT(X_o_dx) - 4;
+        double r = 0.5 * (X_o_dx - (static_cast<double>(ic_lower + 3) + 0.5));
+        double q = std::sqrt(1.0 + 4.0 * r * (1.0 - r));
+        w[1] = 0.0625 * (3.0 - 2.0 * r - q);
+        w[3] = 0.0625 * (3.0 - 2.0 * r + q);
+        w[5] = 0.0625 * (1.0 + 2.0 * r + q);
+        w[7] = 0.0625 * (1.0 + 2.0 * r - q);
+        r += 0.5;
+        q = std::sqrt(1.0 + 4.0 * r * (1.0 - r));
+        w[0] = 0.0625 * (3.0 - 2.0 * r - q);
+        w[2] = 0.0625 * (3.0 - 2.0 * r + q);
+        w[4] = 0.0625 * (1.0 + 2.0 * r + q);
+        w[6] = 0.0625 * (1.0 + 2.0 * r - q);
+        return ic_lower;
+    }
+};
+
+struct IB5Kernel
+{
+    static constexpr int width = 5;
+
+    static inline int
+    computeWeights(const double X_o_dx, double* const w)
+    {
+        const double K = (38.0 - std::sqrt(69.0)) / 60.0;
+        const int ic_center = static_cast<int>(std::floor(X_o_dx));
+        const double r = X_o_dx - (static_cast<double>(ic_center) + 0.5);
+        const double r2 = r * r;
+        const double r3 = r2 * r;
+        const double r4 = r2 * r2;
+        const double r6 = r4 * r2;
+        const double phi =
+            (136.0 - 40.0 * K - 40.0 * r2 +
+             std::sqrt(2.0) * std::sqrt(3123.0 - 6840.0 * K + 3600.0 * K * K - 12440.0 * r2 + 25680.0 * K * r2 -
+                                        12600.0 * K * K * r2 + 8080.0 * r4 - 8400.0 * K * r4 - 1400.0 * r6)) /
+            280.0;
+        w[0] = (1.0 / 12.0) * (-2.0 + 2.0 * phi + 2.0 * K + r - 3.0 * K * r + 2.0 * r2 - r3);
+        w[1] = (1.0 / 6.0) * (4.0 - 4.0 * phi - K - 4.0 * r + 3.0 * K * r - r2 + r3);
+        w[2] = phi;
+        w[3] = (1.0 / 6.0) * (4.0 - 4.0 * phi - K + 4.0 * r - 3.0 * K * r - r2 - r3);
+        w[4] = (1.0 / 12.0) * (-2.0 + 2.0 * phi + 2.0 * K - r + 3.0 * K * r + 2.0 * r2 + r3);
+        return ic_center - 2;
+    }
+};
+
+struct IB6Kernel
+{
+    static constexpr int width = 6;
+
+    static inline int
+    computeWeights(const double X_o_dx, double* const w)
+    {
+        const double K = (59.0 / 60.0) * (1.0 - std::sqrt(1.0 - (3220.0 / 3481.0)));
+        const int ic_lower = NINT(X_o_dx) - 3;
+        const double r = 1.0 - X_o_dx + (static_cast<double>(ic_lower + 2) + 0.5);
+        const double r2 = r * r;
+        const double r3 = r2 * r;
+        const double alpha = 28.0;
+        const double beta =
+            (9.0 / 4.0) - (3.0 / 2.0) * (K + r2) + ((22.0 / 3.0) - 7.0 * K) * r - (7.0 / 3.0) * r3;
+        const double gamma = 0.25 * (((161.0 / 36.0) - (59.0 / 6.0) * K + 5.0 * K * K) * 0.5 * r2 +
+                                     (-(109.0 / 24.0) + 5.0 * K) * (1.0 / 3.0) * r2 * r2 + (5.0 / 18.0) * r3 * r3);
+        const double discr = beta * beta - 4.0 * alpha * gamma;
+        const double sgn = (1.5 - K >= 0.0 ? 1.0 : -1.0);
+        const double pm3 = (-beta + sgn * std::sqrt(discr)) / (2.0 * alpha);
+        w[0] = pm3;
+        w[1] =
+            -3.0 * pm3 - (1.0 / 16.0) + (1.0 / 8.0) * (K + r2) + (1.0 / 12.0) * (3.0 * K - 1.0) * r + (1.0 / 12.0) * r3;
+        w[2] = 2.0 * pm3 + (1.0 / 4.0) + (1.0 / 6.0) * (4.0 - 3.0 * K) * r - (1.0 / 6.0) * r3;
+        w[3] = 2.0 * pm3 + (5.0 / 8.0) - (1.0 / 4.0) * (K + r2);
+        w[4] = -3.0 * pm3 + (1.0 / 4.0) - (1.0 / 6.0) * (4.0 - 3.0 * K) * r + (1.0 / 6.0) * r3;
+        w[5] = pm3 - (1.0 / 16.0) + (1.0 / 8.0) * (K + r2) - (1.0 / 12.0) * (3.0 * K - 1.0) * r - (1.0 / 12.0) * r3;
+        return ic_lower;
+    }
+};
+
+// Compute the lower corner of the stencil (in the index space of the patch data)
+// and the 1D weights along each axis of point s (the l-th entry of the index
+// list).
+template <class Kernel>
+inline void
+compute_point_weights(int* const stencil_lower,
+                      double* const weights,
+                      const int s,
+                      const int l,
+                      const double* const X_data,
+                      const double* const periodic_shifts,
+                      const double* const x_lower,
+                      const double* const dx,
+                      const int* const ilower)
+{
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        const double X_o_dx = (X_data[NDIM * s + d] + periodic_shifts[NDIM * l + d] - x_lower[d]) / dx[d];
+        stencil_lower[d] = Kernel::computeWeights(X_o_dx, weights + d * Kernel::width) + ilower[d];
+    }
+    return;
+} // compute_point_weights
+
+// Compute the stencils of all points in the index list.
+template <class Kernel>
+void
+compute_stencils(int* const stencil_lower,
+                 double* const weights,
+                 const double* const X_data,
+                 const Box<NDIM>& q_data_box,
+                 const double* const x_lower,
+                 const double* const dx,
+                 const int* const local_indices,
+                 const double* const periodic_shifts,
+                 const int local_indices_size)
+{
+    const int* const ilower = q_data_box.lower();
+    for (int l = 0; l < local_indices_size; ++l)
+    {
+        compute_point_weights<Kernel>(stencil_lower + NDIM * l,
+                                      weights + NDIM * Kernel::width * l,
+                                      local_indices[l],
+                                      l,
+                                      X_data,
+                                      periodic_shifts,
+                                      x_lower,
+                                      dx,
+                                      ilower);
+    }
+    return;
+} // compute_stencils
+
+// The stencil of a single Lagrangian point: the tensor-product weights, the
+// offset of the first stencil point in the (ghosted) patch data array, and
+// the range of stencil points that lie within the ghost box.
+template <class Kernel>
+struct KernelStencil
+{
+    static constexpr int width = Kernel::width;
+#if (NDIM == 2)
+    double w[width][width];
+#endif
+#if (NDIM == 3)
+    double w[width][width][width];
+#endif
+    int offset;
+    int istart[NDIM], istop[NDIM];
+    bool interior;
+};
+
+// Form the tensor-product stencil of a point from the lower corner of its
+// stencil and its 1D weights, scaling the weights by fac.
+template <class Kernel>
+inline void
+form_stencil(KernelStencil<Kernel>& stencil,
+             const int* const stencil_lower,
+             const double* const weights,
+             const int* const ig_lower,
+             const int* const ig_upper,
+             const int* const stride,
+             const double fac)
+{
+    constexpr int width = Kernel::width;
+    stencil.offset = 0;
+    stencil.interior = true;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        const int ic_lower = stencil_lower[d];
+        stencil.offset += (ic_lower - ig_lower[d]) * stride[d];
+        stencil.istart[d] = std::max(ig_lower[d] - ic_lower, 0);
+        stencil.istop[d] = (width - 1) - std::max(ic_lower + width - 1 - ig_upper[d], 0);
+        stencil.interior = stencil.interior && stencil.istart[d] == 0 && stencil.istop[d] == width - 1;
+    }
+
+    // Form the tensor product of the 1D weights.
+    const double* const w0 = weights;
+    const double* const w1 = weights + width;
+#if (NDIM == 2)
+    for (int i1 = 0; i1 < width; ++i1)
+    {
+        const double wy = w1[i1] * fac;
+        for (int i0 = 0; i0 < width; ++i0)
+        {
+            stencil.w[i1][i0] = w0[i0] * wy;
+        }
+    }
+#endif
+#if (NDIM == 3)
+    const double* const w2 = weights + 2 * width;
+    for (int i2 = 0; i2 < width; ++i2)
+    {
+        const double wz = w2[i2] * fac;
+        for (int i1 = 0; i1 < width; ++i1)
+        {
+            const double wyz = w1[i1] * wz;
+            for (int i0 = 0; i0 < width; ++i0)
+            {
+                stencil.w[i2][i1][i0] = w0[i0] * wyz;
+            }
+        }
+    }
+#endif
+    return;
+} // form_stencil
+
+// Set up the extents and strides of the ghost box of the patch data.
+inline int
+compute_ghost_box_layout(const Box<NDIM>& q_data_box,
+                         const IntVector<NDIM>& q_gcw,
+                         int* const ig_lower,
+                         int* const ig_upper,
+                         int* const stride)
+{
+    int depth_stride = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ig_lower[d] = q_data_box.lower()(d) - q_gcw(d);
+        ig_upper[d] = q_data_box.upper()(d) + q_gcw(d);
+        stride[d] = depth_stride;
+        depth_stride *= ig_upper[d] - ig_lower[d] + 1;
+    }
+    return depth_stride;
+} // compute_ghost_box_layout
+
+// Interpolate q onto Q. If cached_stencil_lower and cached_weights are
+// non-null, they provide the stencils of the points (as computed by
+// compute_stencils()); otherwise the stencils are computed on the fly.
+template <class Kernel>
+void
+interpolate_kernel(double* const Q_data,
+                   const double* const X_data,
+                   const double* const q_data,
+                   const Box<NDIM>& q_data_box,
+                   const IntVector<NDIM>& q_gcw,
+                   const int q_depth,
+                   const double* const x_lower,
+                   const double* const dx,
+                   const int* const local_indices,
+                   const double* const periodic_shifts,
+                   const int local_indices_size,
+                   const int* const cached_stencil_lower,
+                   const double* const cached_weights)
+{
+    constexpr int width = Kernel::width;
+    int ig_lower[NDIM], ig_upper[NDIM], stride[NDIM];
+    const int depth_stride = compute_ghost_box_layout(q_data_box, q_gcw, ig_lower, ig_upper, stride);
+    const int* const ilower = q_data_box.lower();
+    int point_stencil_lower[NDIM];
+    double point_weights[NDIM * width];
+    KernelStencil<Kernel> stencil;
+    for (int l = 0; l < local_indices_size; ++l)
+    {
+        const int s = local_indices[l];
+        if (cached_stencil_lower && cached_weights)
+        {
+            form_stencil(stencil,
+                         cached_stencil_lower + NDIM * l,
+                         cached_weights + NDIM * width * l,
+                         ig_lower,
+                         ig_upper,
+                         stride,
+                         1.0);
+        }
+        else
+        {
+            compute_point_weights<Kernel>(
+                point_stencil_lower, point_weights, s, l, X_data, periodic_shifts, x_lower, dx, ilower);
+            form_stencil(stencil, point_stencil_lower, point_weights, ig_lower, ig_upper, stride, 1.0);
+        }
+        for (int k = 0; k < q_depth; ++k)
+        {
+            const int offset = stencil.offset + k * depth_stride;
+            double Q = 0.0;
+            if (stencil.interior)
+            {
+                // The stencil width is a compile-time constant here, so the
+                // compiler can fully unroll and vectorize these loops.
+#if (NDIM == 3)
+                for (int i2 = 0; i2 < width; ++i2)
+                {
+#endif
+                    for (int i1 = 0; i1 < width; ++i1)
+                    {
+#if (NDIM == 2)
+                        const double* const q = q_data + offset + i1 * stride[1];
+                        const double* const w = stencil.w[i1];
+#endif
+#if (NDIM == 3)
+                        const double* const q = q_data + offset + i1 * stride[1] + i2 * stride[2];
+                        const double* const w = stencil.w[i2][i1];
+#endif
+                        for (int i0 = 0; i0 < width; ++i0)
+                        {
+                            Q += w[i0] * q[i0];
+                        }
+                    }
+#if (NDIM == 3)
+                }
+#endif
+            }
+            else
+            {
+#if (NDIM == 3)
+                for (int i2 = stencil.istart[2]; i2 <= stencil.istop[2]; ++i2)
+                {
+#endif
+                    for (int i1 = stencil.istart[1]; i1 <= stencil.istop[1]; ++i1)
+                    {
+                        for (int i0 = stencil.istart[0]; i0 <= stencil.istop[0]; ++i0)
+                        {
+#if (NDIM == 2)
+                            Q += stencil.w[i1][i0] * q_data[offset + i0 + i1 * stride[1]];
+#endif
+#if (NDIM == 3)
+                            Q += stencil.w[i2][i1][i0] * q_data[offset + i0 + i1 * stride[1] + i2 * stride[2]];
+#endif
+                        }
+                    }
+#if (NDIM == 3)
+                }
+#endif
+            }
+            Q_data[q_depth * s + k] = Q;
+        }
+    }
+    return;
+} // interpolate_kernel
+
+// Spread Q onto q. If cached_stencil_lower and cached_weights are non-null,
+// they provide the stencils of the points (as computed by compute_stencils());
+// otherwise the stencils are computed on the fly.
+template <class Kernel>
+void
+spread_kernel(double* const q_data,
+              const Box<NDIM>& q_data_box,
+              const IntVector<NDIM>& q_gcw,
+              const int q_depth,
+              const double* const Q_data,
+              const double* const X_data,
+              const double* const x_lower,
+              const double* const dx,
+              const int* const local_indices,
+              const double* const periodic_shifts,
+              const int local_indices_size,
+              const int* const cached_stencil_lower,
+              const double* const cached_weights)
+{
+    constexpr int width = Kernel::width;
+    int ig_lower[NDIM], ig_upper[NDIM], stride[NDIM];
+    const int depth_stride = compute_ghost_box_layout(q_data_box, q_gcw, ig_lower, ig_upper, stride);
+    const int* const ilower = q_data_box.lower();
+    double fac = 1.0;
+    for (unsigned int d = 0; d < NDIM; ++d) fac /= dx[d];
+    int point_stencil_lower[NDIM];
+    double point_weights[NDIM * width];
+    KernelStencil<Kernel> stencil;
+    for (int l = 0; l < local_indices_size; ++l)
+    {
+        const int s = local_indices[l];
+        if (cached_stencil_lower && cached_weights)
+        {
+            form_stencil(stencil,
+                         cached_stencil_lower + NDIM * l,
+                         cached_weights + NDIM * width * l,
+                         ig_lower,
+                         ig_upper,
+                         stride,
+                         fac);
+        }
+        else
+        {
+            compute_point_weights<Kernel>(
+                point_stencil_lower, point_weights, s, l, X_data, periodic_shifts, x_lower, dx, ilower);
+            form_stencil(stencil, point_stencil_lower, point_weights, ig_lower, ig_upper, stride, fac);
+        }
+        for (int k = 0; k < q_depth; ++k)
+        {
+            const int offset = stencil.offset + k * depth_stride;
+            const double V = Q_data[q_depth * s + k];
+            if (stencil.interior)
+            {
+#if (NDIM == 3)
+                for (int i2 = 0; i2 < width; ++i2)
+                {
+#endif
+                    for (int i1 = 0; i1 < width; ++i1)
+                    {
+#if (NDIM == 2)
+                        double* const q = q_data + offset + i1 * stride[1];
+                        const double* const w = stencil.w[i1];
+#endif
+#if (NDIM == 3)
+                        double* const q = q_data + offset + i1 * stride[1] + i2 * stride[2];
+                        const double* const w = stencil.w[i2][i1];
+#endif
+                        for (int i0 = 0; i0 < width; ++i0)
+                        {
+                            q[i0] += w[i0] * V;
+                        }
+                    }
+#if (NDIM == 3)
+                }
+#endif
+            }
+            else
+            {
+#if (NDIM == 3)
+                for (int i2 = stencil.istart[2]; i2 <= stencil.istop[2]; ++i2)
+                {
+#endif
+                    for (int i1 = stencil.istart[1]; i1 <= stencil.istop[1]; ++i1)
+                    {
+                        for (int i0 = stencil.istart[0]; i0 <= stencil.istop[0]; ++i0)
+                        {
+#if (NDIM == 2)
+                            q_data[offset + i0 + i1 * stride[1]] += stencil.w[i1][i0] * V;
+#endif
+#if (NDIM == 3)
+                            q_data[offset + i0 + i1 * stride[1] + i2 * stride[2]] += stencil.w[i2][i1][i0] * V;
+#endif
+                        }
+                    }
+#if (NDIM == 3)
+                }
+#endif
+            }
+        }
+    }
+    return;
+} // spread_kernel
+
+// The templated routines associated with a single kernel function.
+struct TemplatedKernel
+{
+    int width;
+
+    void (*compute_stencils)(int*,
+                             double*,
+                             const double*,
+                             const Box<NDIM>&,
+                             const double*,
+                             const double*,
+                             const int*,
+                             const double*,
+                             int);
+
+    void (*interpolate)(double*,
+                        const double*,
+                        const double*,
+                        const Box<NDIM>&,
+                        const IntVector<NDIM>&,
+                        int,
+                        const double*,
+                        const double*,
+                        const int*,
+                        const double*,
+                        int,
+                        const int*,
+                        const double*);
+
+    void (*spread)(double*,
+                   const Box<NDIM>&,
+                   const IntVector<NDIM>&,
+                   int,
+                   const double*,
+                   const double*,
+                   const double*,
+                   const double*,
+                   const int*,
+                   const double*,
+                   int,
+                   const int*,
+                   const double*);
+};
+
+template <class Kernel>
+TemplatedKernel
+make_templated_kernel()
+{
+    return { Kernel::width, &compute_stencils<Kernel>, &interpolate_kernel<Kernel>, &spread_kernel<Kernel> };
+} // make_templated_kernel
+
+// Return the templated routines for the specified kernel function. If there is
+// no templated implementation of that kernel, all function pointers are null.
+TemplatedKernel
+get_templated_kernel(const std::string& kernel_fcn)
+{
+    if (kernel_fcn == "PIECEWISE_LINEAR") return make_templated_kernel<PiecewiseLinearKernel>();
+    if (kernel_fcn == "IB_3") return make_templated_kernel<IB3Kernel>();
+    if (kernel_fcn == "IB_4") return make_templated_kernel<IB4Kernel>();
+    if (kernel_fcn == "IB_4_W8") return make_templated_kernel<IB4W8Kernel>();
+    if (kernel_fcn == "IB_5") return make_templated_kernel<IB5Kernel>();
+    if (kernel_fcn == "IB_6") return make_templated_kernel<IB6Kernel>();
+    if (kernel_fcn == "BSPLINE_3") return make_templated_kernel<BSpline3Kernel>();
+    if (kernel_fcn == "BSPLINE_4") return make_templated_kernel<BSpline4Kernel>();
+    if (kernel_fcn == "BSPLINE_5") return make_templated_kernel<BSpline5Kernel>();
+    if (kernel_fcn == "BSPLINE_6") return make_templated_kernel<BSpline6Kernel>();
+    return { 0, nullptr, nullptr, nullptr };
+} // get_templated_kernel
+
+// Make sure that the cached stencils correspond to the given points and patch
+// data geometry, recomputing them if necessary.
+void
+update_cached_stencils(LEInteractorWeightCache::Stencils& stencils,
+                       const TemplatedKernel& kernel,
+                       const std::string& kernel_fcn,
+                       const double* const X_data,
+                       const Box<NDIM>& q_data_box,
+                       const double* const x_lower,
+                       const double* const dx,
+                       const int* const local_indices,
+                       const double* const periodic_shifts,
+                       const int local_indices_size)
+{
+    if (stencils.isValid(kernel_fcn, x_lower, dx, local_indices, periodic_shifts, local_indices_size)) return;
+    stencils.kernel_fcn = kernel_fcn;
+    std::copy(x_lower, x_lower + NDIM, stencils.x_lower.begin());
+    std::copy(dx, dx + NDIM, stencils.dx.begin());
+    stencils.local_indices.assign(local_indices, local_indices + local_indices_size);
+    stencils.periodic_shifts.assign(periodic_shifts, periodic_shifts + NDIM * local_indices_size);
+    stencils.stencil_lower.resize(NDIM * local_indices_size);
+    stencils.weights.resize(NDIM * kernel.width * local_indices_size);
+    kernel.compute_stencils(stencils.stencil_lower.data(),
+                            stencils.weights.data(),
+                            X_data,
+                            q_data_box,
+                            x_lower,
+                            dx,
+                            local_indices,
+                            periodic_shifts,
+                            local_indices_size);
+    return;
+} // update_cached_stencils
 } // namespace
 
 double (*LEInteractor::s_kernel_fcn)(double r) = &ib4_kernel_fcn;
 int LEInteractor::s_kernel_fcn_stencil_size = 4;
+std::string LEInteractor::s_spread_mode = "SERIAL";
+int LEInteractor::s_spread_tile_size = 8;
+std::string LEInteractor::s_kernel_implementation = "FORTRAN";
+bool LEInteractor::s_use_weight_cache = false;
 
-void LEInteractor::setFromDatabase(Pointer<Database> /*db*/)
+void
+LEInteractor::setFromDatabase(Pointer<Database> db)
 {
-    // intentionally blank
+    if (!db) return;
+    s_spread_mode = db->getStringWithDefault("spread_mode", s_spread_mode);
+    if (s_spread_mode != "SERIAL" && s_spread_mode != "COLORED_TILES")
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << "  unknown spread_mode " << s_spread_mode << "\n"
+                   << "  valid choices are: SERIAL, COLORED_TILES" << std::endl);
+    }
+    s_spread_tile_size = db->getIntegerWithDefault("spread_tile_size", s_spread_tile_size);
+    if (s_spread_tile_size < 1)
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << "  spread_tile_size must be positive" << std::endl);
+    }
+    s_kernel_implementation = db->getStringWithDefault("kernel_implementation", s_kernel_implementation);
+    if (s_kernel_implementation != "FORTRAN" && s_kernel_implementation != "TEMPLATED")
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << "  unknown kernel_implementation " << s_kernel_implementation << "\n"
+                   << "  valid choices are: FORTRAN, TEMPLATED" << std::endl);
+    }
+    s_use_weight_cache = db->getBoolWithDefault("use_weight_cache", s_use_weight_cache);
     return;
 }
 
@@ -1326,6 +2052,10 @@ void
 LEInteractor::printClassData(std::ostream& os)
 {
     os << "LEInteractor::printClassData():\n";
+    os << "  s_spread_mode = " << s_spread_mode << "\n";
+    os << "  s_spread_tile_size = " << s_spread_tile_size << "\n";
+    os << "  s_kernel_implementation = " << s_kernel_implementation << "\n";
+    os << "  s_use_weight_cache = " << s_use_weight_cache << "\n";
     return;
 }
 
@@ -1368,7 +2098,8 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(Q_data);
@@ -1379,6 +2110,7 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
     TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     interpolate(Q_data->getGhostedLocalFormVecArray()->data(),
                 Q_data->getDepth(),
                 X_data->getGhostedLocalFormVecArray()->data(),
@@ -1388,9 +2120,10 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                 patch,
                 interp_box,
                 periodic_shift,
-                interp_fcn);
+                interp_fcn,
+                weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -1403,7 +2136,8 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(Q_data);
@@ -1414,6 +2148,7 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
     TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     interpolate(Q_data->getGhostedLocalFormVecArray()->data(),
                 Q_data->getDepth(),
                 X_data->getGhostedLocalFormVecArray()->data(),
@@ -1423,9 +2158,10 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                 patch,
                 interp_box,
                 periodic_shift,
-                interp_fcn);
+                interp_fcn,
+                weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -1438,7 +2174,8 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
     if (Q_data->getDepth() != NDIM || q_data->getDepth() != 1)
     {
@@ -1455,6 +2192,7 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
     TBOX_ASSERT(X_data->getDepth() == NDIM);
     TBOX_ASSERT(q_data->getDepth() == 1);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     interpolate(Q_data->getGhostedLocalFormVecArray()->data(),
                 Q_data->getDepth(),
                 X_data->getGhostedLocalFormVecArray()->data(),
@@ -1464,9 +2202,10 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                 patch,
                 interp_box,
                 periodic_shift,
-                interp_fcn);
+                interp_fcn,
+                weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -1479,7 +2218,8 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
     if (NDIM != 3 || Q_data->getDepth() != NDIM || q_data->getDepth() != 1)
     {
@@ -1496,6 +2236,7 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
     TBOX_ASSERT(X_data->getDepth() == NDIM);
     TBOX_ASSERT(q_data->getDepth() == 1);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     interpolate(Q_data->getGhostedLocalFormVecArray()->data(),
                 Q_data->getDepth(),
                 X_data->getGhostedLocalFormVecArray()->data(),
@@ -1505,9 +2246,10 @@ LEInteractor::interpolate(Pointer<LData> Q_data,
                 patch,
                 interp_box,
                 periodic_shift,
-                interp_fcn);
+                interp_fcn,
+                weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -1522,7 +2264,8 @@ LEInteractor::interpolate(double* const Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -1570,7 +2313,9 @@ LEInteractor::interpolate(double* const Q_data,
                     patch_touches_upper_physical_bdry,
                     local_indices,
                     periodic_shifts,
-                    interp_fcn);
+                    interp_fcn,
+                    /*axis*/ 0,
+                    weight_cache);
     }
     return;
 }
@@ -1586,7 +2331,8 @@ LEInteractor::interpolate(double* const Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -1640,7 +2386,9 @@ LEInteractor::interpolate(double* const Q_data,
                     patch_touches_upper_physical_bdry,
                     local_indices,
                     periodic_shifts,
-                    interp_fcn);
+                    interp_fcn,
+                    /*axis*/ 0,
+                    weight_cache);
     }
     return;
 }
@@ -1656,7 +2404,8 @@ LEInteractor::interpolate(double* const Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -1724,7 +2473,8 @@ LEInteractor::interpolate(double* const Q_data,
                         local_indices,
                         periodic_shifts,
                         interp_fcn,
-                        axis);
+                        axis,
+                        weight_cache);
             for (const auto& local_index : local_indices)
             {
                 Q_data[NDIM * local_index + axis] = Q_data_axis[local_index];
@@ -1745,7 +2495,8 @@ LEInteractor::interpolate(double* const Q_data,
                           const Pointer<Patch<NDIM> > patch,
                           const Box<NDIM>& interp_box,
                           const IntVector<NDIM>& periodic_shift,
-                          const std::string& interp_fcn)
+                          const std::string& interp_fcn,
+                          LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -1816,7 +2567,8 @@ LEInteractor::interpolate(double* const Q_data,
                         local_indices,
                         periodic_shifts,
                         interp_fcn,
-                        axis);
+                        axis,
+                        weight_cache);
             for (const auto& local_index : local_indices)
             {
                 Q_data[NDIM * local_index + axis] = Q_data_axis[local_index];
@@ -2532,7 +3284,8 @@ LEInteractor::spread(Pointer<CellData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(Q_data);
@@ -2543,6 +3296,7 @@ LEInteractor::spread(Pointer<CellData<NDIM, double> > q_data,
     TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     spread(q_data,
            Q_data->getGhostedLocalFormVecArray()->data(),
            Q_data->getDepth(),
@@ -2552,9 +3306,10 @@ LEInteractor::spread(Pointer<CellData<NDIM, double> > q_data,
            patch,
            spread_box,
            periodic_shift,
-           spread_fcn);
+           spread_fcn,
+           weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -2567,7 +3322,8 @@ LEInteractor::spread(Pointer<NodeData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(Q_data);
@@ -2578,6 +3334,7 @@ LEInteractor::spread(Pointer<NodeData<NDIM, double> > q_data,
     TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     spread(q_data,
            Q_data->getGhostedLocalFormVecArray()->data(),
            Q_data->getDepth(),
@@ -2587,9 +3344,10 @@ LEInteractor::spread(Pointer<NodeData<NDIM, double> > q_data,
            patch,
            spread_box,
            periodic_shift,
-           spread_fcn);
+           spread_fcn,
+           weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -2602,7 +3360,8 @@ LEInteractor::spread(Pointer<SideData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
     if (Q_data->getDepth() != NDIM || q_data->getDepth() != 1)
     {
@@ -2619,6 +3378,7 @@ LEInteractor::spread(Pointer<SideData<NDIM, double> > q_data,
     TBOX_ASSERT(Q_data->getDepth() == NDIM);
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     spread(q_data,
            Q_data->getGhostedLocalFormVecArray()->data(),
            Q_data->getDepth(),
@@ -2628,9 +3388,10 @@ LEInteractor::spread(Pointer<SideData<NDIM, double> > q_data,
            patch,
            spread_box,
            periodic_shift,
-           spread_fcn);
+           spread_fcn,
+           weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -2643,7 +3404,8 @@ LEInteractor::spread(Pointer<EdgeData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
     if (NDIM != 3 || Q_data->getDepth() != NDIM || q_data->getDepth() != 1)
     {
@@ -2660,6 +3422,7 @@ LEInteractor::spread(Pointer<EdgeData<NDIM, double> > q_data,
     TBOX_ASSERT(Q_data->getDepth() == NDIM);
     TBOX_ASSERT(X_data->getDepth() == NDIM);
 #endif
+    if (weight_cache) weight_cache->setPositionVersion(X_data->getVersion());
     spread(q_data,
            Q_data->getGhostedLocalFormVecArray()->data(),
            Q_data->getDepth(),
@@ -2669,9 +3432,10 @@ LEInteractor::spread(Pointer<EdgeData<NDIM, double> > q_data,
            patch,
            spread_box,
            periodic_shift,
-           spread_fcn);
+           spread_fcn,
+           weight_cache);
     Q_data->restoreArrays();
-    X_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
     return;
 }
 
@@ -2686,7 +3450,8 @@ LEInteractor::spread(Pointer<CellData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -2734,7 +3499,9 @@ LEInteractor::spread(Pointer<CellData<NDIM, double> > q_data,
                patch_touches_upper_physical_bdry,
                local_indices,
                periodic_shifts,
-               spread_fcn);
+               spread_fcn,
+               /*axis*/ 0,
+               weight_cache);
     }
     return;
 }
@@ -2750,7 +3517,8 @@ LEInteractor::spread(Pointer<NodeData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -2804,7 +3572,9 @@ LEInteractor::spread(Pointer<NodeData<NDIM, double> > q_data,
                patch_touches_upper_physical_bdry,
                local_indices,
                periodic_shifts,
-               spread_fcn);
+               spread_fcn,
+               /*axis*/ 0,
+               weight_cache);
     }
     return;
 }
@@ -2820,7 +3590,8 @@ LEInteractor::spread(Pointer<SideData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -2892,7 +3663,8 @@ LEInteractor::spread(Pointer<SideData<NDIM, double> > q_data,
                    local_indices,
                    periodic_shifts,
                    spread_fcn,
-                   axis);
+                   axis,
+                   weight_cache);
         }
     }
     return;
@@ -2909,7 +3681,8 @@ LEInteractor::spread(Pointer<EdgeData<NDIM, double> > q_data,
                      const Pointer<Patch<NDIM> > patch,
                      const Box<NDIM>& spread_box,
                      const IntVector<NDIM>& periodic_shift,
-                     const std::string& spread_fcn)
+                     const std::string& spread_fcn,
+                     LEInteractorWeightCache* const weight_cache)
 {
 #if !defined(NDEBUG)
     TBOX_ASSERT(q_data);
@@ -2984,7 +3757,8 @@ LEInteractor::spread(Pointer<EdgeData<NDIM, double> > q_data,
                    local_indices,
                    periodic_shifts,
                    spread_fcn,
-                   axis);
+                   axis,
+                   weight_cache);
         }
     }
     return;
@@ -3696,7 +4470,8 @@ LEInteractor::interpolate(double* const Q_data,
                           const std::vector<int>& local_indices,
                           const std::vector<double>& periodic_shifts,
                           const std::string& interp_fcn,
-                          const int axis)
+                          const int axis,
+                          LEInteractorWeightCache* const weight_cache)
 {
     const int stencil_size = getStencilSize(interp_fcn);
     const int min_ghosts = getMinimumGhostWidth(interp_fcn);
@@ -3711,6 +4486,46 @@ LEInteractor::interpolate(double* const Q_data,
     }
     if (local_indices.empty()) return;
     const int local_indices_size = static_cast<int>(local_indices.size());
+    if (s_kernel_implementation == "TEMPLATED" || (s_use_weight_cache && weight_cache))
+    {
+        const TemplatedKernel kernel = get_templated_kernel(interp_fcn);
+        if (kernel.interpolate)
+        {
+            const int* cached_stencil_lower = nullptr;
+            const double* cached_weights = nullptr;
+            if (s_use_weight_cache && weight_cache)
+            {
+                LEInteractorWeightCache::Stencils& stencils =
+                    weight_cache->getStencils(q_data_box, /*spread*/ false);
+                update_cached_stencils(stencils,
+                                       kernel,
+                                       interp_fcn,
+                                       X_data,
+                                       q_data_box,
+                                       x_lower,
+                                       dx,
+                                       local_indices.data(),
+                                       periodic_shifts.data(),
+                                       local_indices_size);
+                cached_stencil_lower = stencils.stencil_lower.data();
+                cached_weights = stencils.weights.data();
+            }
+            kernel.interpolate(Q_data,
+                               X_data,
+                               q_data,
+                               q_data_box,
+                               q_gcw,
+                               q_depth,
+                               x_lower,
+                               dx,
+                               local_indices.data(),
+                               periodic_shifts.data(),
+                               local_indices_size,
+                               cached_stencil_lower,
+                               cached_weights);
+            return;
+        }
+    }
     const IntVector<NDIM>& ilower = q_data_box.lower();
     const IntVector<NDIM>& iupper = q_data_box.upper();
     if (interp_fcn == "PIECEWISE_CONSTANT")
@@ -4170,7 +4985,8 @@ LEInteractor::spread(double* const q_data,
                      const std::vector<int>& local_indices,
                      const std::vector<double>& periodic_shifts,
                      const std::string& spread_fcn,
-                     const int axis)
+                     const int axis,
+                     LEInteractorWeightCache* const weight_cache)
 {
     const int stencil_size = getStencilSize(spread_fcn);
     const int min_ghosts = getMinimumGhostWidth(spread_fcn);
@@ -4190,7 +5006,248 @@ LEInteractor::spread(double* const q_data,
                    << "  ghost cell width         = " << q_gcw_min << "\n");
     }
     if (local_indices.empty()) return;
-    const int local_indices_size = static_cast<int>(local_indices.size());
+    if (s_use_weight_cache && weight_cache && s_spread_mode == "SERIAL")
+    {
+        const TemplatedKernel kernel = get_templated_kernel(spread_fcn);
+        if (kernel.spread)
+        {
+            const int local_indices_size = static_cast<int>(local_indices.size());
+            LEInteractorWeightCache::Stencils& stencils = weight_cache->getStencils(q_data_box, /*spread*/ true);
+            update_cached_stencils(stencils,
+                                   kernel,
+                                   spread_fcn,
+                                   X_data,
+                                   q_data_box,
+                                   x_lower,
+                                   dx,
+                                   local_indices.data(),
+                                   periodic_shifts.data(),
+                                   local_indices_size);
+            kernel.spread(q_data,
+                          q_data_box,
+                          q_gcw,
+                          q_depth,
+                          Q_data,
+                          X_data,
+                          x_lower,
+                          dx,
+                          local_indices.data(),
+                          periodic_shifts.data(),
+                          local_indices_size,
+                          stencils.stencil_lower.data(),
+                          stencils.weights.data());
+            return;
+        }
+    }
+    if (s_spread_mode == "COLORED_TILES")
+    {
+        spreadColoredTiles(q_data,
+                           q_data_box,
+                           q_gcw,
+                           q_depth,
+                           Q_data,
+                           Q_depth,
+                           X_data,
+                           x_lower,
+                           x_upper,
+                           dx,
+                           local_indices,
+                           periodic_shifts,
+                           spread_fcn,
+                           axis);
+    }
+    else
+    {
+        spreadPoints(q_data,
+                     q_data_box,
+                     q_gcw,
+                     q_depth,
+                     Q_data,
+                     Q_depth,
+                     X_data,
+                     x_lower,
+                     x_upper,
+                     dx,
+                     local_indices.data(),
+                     periodic_shifts.data(),
+                     static_cast<int>(local_indices.size()),
+                     spread_fcn,
+                     axis);
+    }
+    return;
+}
+
+void
+LEInteractor::spreadColoredTiles(double* const q_data,
+                                 const Box<NDIM>& q_data_box,
+                                 const IntVector<NDIM>& q_gcw,
+                                 const int q_depth,
+                                 const double* const Q_data,
+                                 const int Q_depth,
+                                 const double* const X_data,
+                                 const double* const x_lower,
+                                 const double* const x_upper,
+                                 const double* const dx,
+                                 const std::vector<int>& local_indices,
+                                 const std::vector<double>& periodic_shifts,
+                                 const std::string& spread_fcn,
+                                 const int axis)
+{
+    // Each point writes to cells that are at most getMinimumGhostWidth() cells
+    // away from the cell containing the point. Tiles of the same color are
+    // separated by at least one full tile along some axis, so a tile width of
+    // at least twice that distance guarantees that the stencils of points in
+    // different tiles of the same color never overlap.
+    const int stencil_width = getMinimumGhostWidth(spread_fcn);
+    const int tile_size = std::max(s_spread_tile_size, 2 * stencil_width);
+
+    // Determine the tile containing each point.
+    const int num_points = static_cast<int>(local_indices.size());
+    std::vector<int> point_tiles(NDIM * num_points);
+    std::array<int, NDIM> tile_lower, tile_upper;
+    tile_lower.fill(std::numeric_limits<int>::max());
+    tile_upper.fill(std::numeric_limits<int>::lowest());
+    for (int l = 0; l < num_points; ++l)
+    {
+        const int s = local_indices[l];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            const int ic = static_cast<int>(
+                std::floor((X_data[d + s * NDIM] + periodic_shifts[d + l * NDIM] - x_lower[d]) / dx[d]));
+            const int it = (ic >= 0 ? ic / tile_size : -((-ic - 1) / tile_size) - 1);
+            point_tiles[d + l * NDIM] = it;
+            tile_lower[d] = std::min(tile_lower[d], it);
+            tile_upper[d] = std::max(tile_upper[d], it);
+        }
+    }
+
+    // Bucket the points by tile with a stable counting sort so that points
+    // within each tile are spread in the same order as the serial algorithm.
+    int num_tiles = 1;
+    std::array<int, NDIM> tile_stride;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        tile_stride[d] = num_tiles;
+        num_tiles *= tile_upper[d] - tile_lower[d] + 1;
+    }
+    std::vector<int> point_tile_ids(num_points);
+    std::vector<int> tile_offsets(num_tiles + 1, 0);
+    for (int l = 0; l < num_points; ++l)
+    {
+        int tile_id = 0;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            tile_id += (point_tiles[d + l * NDIM] - tile_lower[d]) * tile_stride[d];
+        }
+        point_tile_ids[l] = tile_id;
+        ++tile_offsets[tile_id + 1];
+    }
+    std::partial_sum(tile_offsets.begin(), tile_offsets.end(), tile_offsets.begin());
+    std::vector<int> tile_local_indices(num_points);
+    std::vector<double> tile_periodic_shifts(NDIM * num_points);
+    {
+        std::vector<int> tile_fill(tile_offsets.begin(), tile_offsets.end() - 1);
+        for (int l = 0; l < num_points; ++l)
+        {
+            const int k = tile_fill[point_tile_ids[l]]++;
+            tile_local_indices[k] = local_indices[l];
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                tile_periodic_shifts[d + k * NDIM] = periodic_shifts[d + l * NDIM];
+            }
+        }
+    }
+
+    // Color the nonempty tiles by the parity of their tile indices.
+    static const int num_colors = 1 << NDIM;
+    std::array<std::vector<int>, num_colors> color_tiles;
+    for (int tile_id = 0; tile_id < num_tiles; ++tile_id)
+    {
+        if (tile_offsets[tile_id] == tile_offsets[tile_id + 1]) continue;
+        int color = 0;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            const int it = (tile_id / tile_stride[d]) % (tile_upper[d] - tile_lower[d] + 1);
+            color |= (it % 2) << d;
+        }
+        color_tiles[color].push_back(tile_id);
+    }
+
+    // Spread one color at a time. Tiles of a given color write to disjoint
+    // sets of grid cells and hence may be processed concurrently without
+    // synchronization. The order in which values are accumulated into each
+    // grid cell does not depend on the number of threads.
+    for (int color = 0; color < num_colors; ++color)
+    {
+        const std::vector<int>& tiles = color_tiles[color];
+        const int num_color_tiles = static_cast<int>(tiles.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int k = 0; k < num_color_tiles; ++k)
+        {
+            const int tile_id = tiles[k];
+            const int begin = tile_offsets[tile_id];
+            const int end = tile_offsets[tile_id + 1];
+            spreadPoints(q_data,
+                         q_data_box,
+                         q_gcw,
+                         q_depth,
+                         Q_data,
+                         Q_depth,
+                         X_data,
+                         x_lower,
+                         x_upper,
+                         dx,
+                         &tile_local_indices[begin],
+                         &tile_periodic_shifts[NDIM * begin],
+                         end - begin,
+                         spread_fcn,
+                         axis);
+        }
+    }
+    return;
+}
+
+void
+LEInteractor::spreadPoints(double* const q_data,
+                           const Box<NDIM>& q_data_box,
+                           const IntVector<NDIM>& q_gcw,
+                           const int q_depth,
+                           const double* const Q_data,
+                           const int Q_depth,
+                           const double* const X_data,
+                           const double* const x_lower,
+                           const double* const x_upper,
+                           const double* const dx,
+                           const int* const local_indices,
+                           const double* const periodic_shifts,
+                           const int local_indices_size,
+                           const std::string& spread_fcn,
+                           const int axis)
+{
+    if (local_indices_size == 0) return;
+    if (s_kernel_implementation == "TEMPLATED")
+    {
+        const TemplatedKernel kernel = get_templated_kernel(spread_fcn);
+        if (kernel.spread)
+        {
+            kernel.spread(q_data,
+                          q_data_box,
+                          q_gcw,
+                          q_depth,
+                          Q_data,
+                          X_data,
+                          x_lower,
+                          dx,
+                          local_indices,
+                          periodic_shifts,
+                          local_indices_size,
+                          /*cached_stencil_lower*/ nullptr,
+                          /*cached_weights*/ nullptr);
+            return;
+        }
+    }
     const IntVector<NDIM>& ilower = q_data_box.lower();
     const IntVector<NDIM>& iupper = q_data_box.upper();
     if (spread_fcn == "PIECEWISE_CONSTANT")
@@ -4199,8 +5256,8 @@ LEInteractor::spread(double* const q_data,
                                                 x_lower,
                                                 x_upper,
                                                 q_depth,
-                                                &local_indices[0],
-                                                &periodic_shifts[0],
+                                                local_indices,
+                                                periodic_shifts,
                                                 local_indices_size,
                                                 X_data,
                                                 Q_data,
@@ -4232,8 +5289,8 @@ LEInteractor::spread(double* const q_data,
                                                   x_upper,
                                                   q_depth,
                                                   axis,
-                                                  &local_indices[0],
-                                                  &periodic_shifts[0],
+                                                  local_indices,
+                                                  periodic_shifts,
                                                   local_indices_size,
                                                   X_data,
                                                   Q_data,
@@ -4264,8 +5321,8 @@ LEInteractor::spread(double* const q_data,
                                               x_lower,
                                               x_upper,
                                               q_depth,
-                                              &local_indices[0],
-                                              &periodic_shifts[0],
+                                              local_indices,
+                                              periodic_shifts,
                                               local_indices_size,
                                               X_data,
                                               Q_data,
@@ -4296,8 +5353,8 @@ LEInteractor::spread(double* const q_data,
                                              x_lower,
                                              x_upper,
                                              q_depth,
-                                             &local_indices[0],
-                                             &periodic_shifts[0],
+                                             local_indices,
+                                             periodic_shifts,
                                              local_indices_size,
                                              X_data,
                                              Q_data,
@@ -4328,8 +5385,8 @@ LEInteractor::spread(double* const q_data,
                                   x_lower,
                                   x_upper,
                                   q_depth,
-                                  &local_indices[0],
-                                  &periodic_shifts[0],
+                                  local_indices,
+                                  periodic_shifts,
                                   local_indices_size,
                                   X_data,
                                   Q_data,
@@ -4360,8 +5417,8 @@ LEInteractor::spread(double* const q_data,
                                   x_lower,
                                   x_upper,
                                   q_depth,
-                                  &local_indices[0],
-                                  &periodic_shifts[0],
+                                  local_indices,
+                                  periodic_shifts,
                                   local_indices_size,
                                   X_data,
                                   Q_data,
@@ -4392,8 +5449,8 @@ LEInteractor::spread(double* const q_data,
                                      x_lower,
                                      x_upper,
                                      q_depth,
-                                     &local_indices[0],
-                                     &periodic_shifts[0],
+                                     local_indices,
+                                     periodic_shifts,
                                      local_indices_size,
                                      X_data,
                                      Q_data,
@@ -4424,8 +5481,8 @@ LEInteractor::spread(double* const q_data,
                                   x_lower,
                                   x_upper,
                                   q_depth,
-                                  &local_indices[0],
-                                  &periodic_shifts[0],
+                                  local_indices,
+                                  periodic_shifts,
                                   local_indices_size,
                                   X_data,
                                   Q_data,
@@ -4456,8 +5513,8 @@ LEInteractor::spread(double* const q_data,
                                   x_lower,
                                   x_upper,
                                   q_depth,
-                                  &local_indices[0],
-                                  &periodic_shifts[0],
+                                  local_indices,
+                                  periodic_shifts,
                                   local_indices_size,
                                   X_data,
                                   Q_data,
@@ -4488,8 +5545,8 @@ LEInteractor::spread(double* const q_data,
                                        x_lower,
                                        x_upper,
                                        q_depth,
-                                       &local_indices[0],
-                                       &periodic_shifts[0],
+                                       local_indices,
+                                       periodic_shifts,
                                        local_indices_size,
                                        X_data,
                                        Q_data,
@@ -4520,8 +5577,8 @@ LEInteractor::spread(double* const q_data,
                                        x_lower,
                                        x_upper,
                                        q_depth,
-                                       &local_indices[0],
-                                       &periodic_shifts[0],
+                                       local_indices,
+                                       periodic_shifts,
                                        local_indices_size,
                                        X_data,
                                        Q_data,
@@ -4552,8 +5609,8 @@ LEInteractor::spread(double* const q_data,
                                        x_lower,
                                        x_upper,
                                        q_depth,
-                                       &local_indices[0],
-                                       &periodic_shifts[0],
+                                       local_indices,
+                                       periodic_shifts,
                                        local_indices_size,
                                        X_data,
                                        Q_data,
@@ -4584,8 +5641,8 @@ LEInteractor::spread(double* const q_data,
                                        x_lower,
                                        x_upper,
                                        q_depth,
-                                       &local_indices[0],
-                                       &periodic_shifts[0],
+                                       local_indices,
+                                       periodic_shifts,
                                        local_indices_size,
                                        X_data,
                                        Q_data,
@@ -4622,8 +5679,8 @@ LEInteractor::spread(double* const q_data,
                           Q_data,
                           Q_depth,
                           X_data,
-                          &local_indices[0],
-                          &periodic_shifts[0],
+                          local_indices,
+                          periodic_shifts,
                           local_indices_size);
     }
     else
@@ -5007,7 +6064,8 @@ template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_dat
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_data,
                                               const SAMRAI::tbox::Pointer<LData> X_data,
@@ -5016,7 +6074,8 @@ template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_dat
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_data,
                                               const SAMRAI::tbox::Pointer<LData> X_data,
@@ -5025,7 +6084,8 @@ template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_dat
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_data,
                                               const SAMRAI::tbox::Pointer<LData> X_data,
@@ -5034,7 +6094,8 @@ template void IBTK::LEInteractor::interpolate(SAMRAI::tbox::Pointer<LData> Q_dat
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const int Q_depth,
@@ -5045,7 +6106,8 @@ template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const int Q_depth,
@@ -5056,7 +6118,8 @@ template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const int Q_depth,
@@ -5067,7 +6130,8 @@ template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const int Q_depth,
@@ -5078,7 +6142,8 @@ template void IBTK::LEInteractor::interpolate(double* const Q_data,
                                               const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                               const SAMRAI::hier::Box<NDIM>& interp_box,
                                               const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                              const std::string& interp_fcn);
+                                              const std::string& interp_fcn,
+                                              LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::CellData<NDIM, double> > q_data,
                                          const SAMRAI::tbox::Pointer<LData> Q_data,
@@ -5087,7 +6152,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Cel
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::NodeData<NDIM, double> > q_data,
                                          const SAMRAI::tbox::Pointer<LData> Q_data,
@@ -5096,7 +6162,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Nod
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::SideData<NDIM, double> > q_data,
                                          const SAMRAI::tbox::Pointer<LData> Q_data,
@@ -5105,7 +6172,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Sid
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::EdgeData<NDIM, double> > q_data,
                                          const SAMRAI::tbox::Pointer<LData> Q_data,
@@ -5114,7 +6182,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Edg
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::CellData<NDIM, double> > q_data,
                                          const double* const Q_data,
@@ -5125,7 +6194,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Cel
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::NodeData<NDIM, double> > q_data,
                                          const double* const Q_data,
@@ -5136,7 +6206,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Nod
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::SideData<NDIM, double> > q_data,
                                          const double* const Q_data,
@@ -5147,7 +6218,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Sid
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::EdgeData<NDIM, double> > q_data,
                                          const double* const Q_data,
@@ -5158,7 +6230,8 @@ template void IBTK::LEInteractor::spread(SAMRAI::tbox::Pointer<SAMRAI::pdat::Edg
                                          const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
                                          const SAMRAI::hier::Box<NDIM>& spread_box,
                                          const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
-                                         const std::string& spread_fcn);
+                                         const std::string& spread_fcn,
+                                         LEInteractorWeightCache* const weight_cache);
 
 template void IBTK::LEInteractor::buildLocalIndices(std::vector<int>& local_indices,
                                                     std::vector<double>& periodic_shifts,
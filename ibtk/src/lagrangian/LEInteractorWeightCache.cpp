@@ -0,0 +1,117 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibtk/LEInteractorWeightCache.h"
+
+#include "Box.h"
+
+#include "ibtk/app_namespaces.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+void
+LEInteractorWeightCache::clear()
+{
+    d_X_version = 0;
+    d_stencils.clear();
+    return;
+} // clear
+
+std::size_t
+LEInteractorWeightCache::getMemoryUsage() const
+{
+    std::size_t n_bytes = 0;
+    for (const auto& key_stencils_pair : d_stencils)
+    {
+        const Stencils& stencils = key_stencils_pair.second;
+        n_bytes += sizeof(Stencils);
+        n_bytes += stencils.local_indices.capacity() * sizeof(int);
+        n_bytes += stencils.periodic_shifts.capacity() * sizeof(double);
+        n_bytes += stencils.stencil_lower.capacity() * sizeof(int);
+        n_bytes += stencils.weights.capacity() * sizeof(double);
+    }
+    return n_bytes;
+} // getMemoryUsage
+
+bool
+LEInteractorWeightCache::Stencils::isValid(const std::string& kernel_fcn,
+                                           const double* const x_lower,
+                                           const double* const dx,
+                                           const int* const local_indices,
+                                           const double* const periodic_shifts,
+                                           const int local_indices_size) const
+{
+    if (this->kernel_fcn != kernel_fcn) return false;
+    if (static_cast<int>(this->local_indices.size()) != local_indices_size) return false;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        if (this->x_lower[d] != x_lower[d] || this->dx[d] != dx[d]) return false;
+    }
+    return std::equal(local_indices, local_indices + local_indices_size, this->local_indices.begin()) &&
+           std::equal(periodic_shifts, periodic_shifts + NDIM * local_indices_size, this->periodic_shifts.begin());
+} // isValid
+
+void
+LEInteractorWeightCache::setPositionVersion(const std::size_t X_version)
+{
+    if (X_version != d_X_version)
+    {
+        // Keep the allocated storage around: the stencils will be recomputed
+        // for the same patches the next time they are used.
+        for (auto& key_stencils_pair : d_stencils)
+        {
+            Stencils& stencils = key_stencils_pair.second;
+            stencils.kernel_fcn.clear();
+            stencils.local_indices.clear();
+            stencils.periodic_shifts.clear();
+            stencils.stencil_lower.clear();
+            stencils.weights.clear();
+        }
+        d_X_version = X_version;
+    }
+    return;
+} // setPositionVersion
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+LEInteractorWeightCache::Stencils&
+LEInteractorWeightCache::getStencils(const Box<NDIM>& q_data_box, const bool spread)
+{
+    std::array<int, 2 * NDIM + 1> key;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        key[d] = q_data_box.lower()(d);
+        key[NDIM + d] = q_data_box.upper()(d);
+    }
+    key[2 * NDIM] = spread ? 1 : 0;
+    return d_stencils[key];
+} // getStencils
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,318 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibtk/TensorProductLagrangeFE.h"
+
+#include "tbox/Utilities.h"
+
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/enum_fe_family.h"
+#include "libmesh/enum_order.h"
+#include "libmesh/enum_quadrature_type.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/quadrature_gauss.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// One-dimensional indices of the nodes of the supported elements, in libMesh's
+// local node ordering. One-dimensional node 0 is at -1, node 1 is at +1, and
+// node 2 (if present) is at 0, which is libMesh's ordering of the nodes of
+// EDGE2 and EDGE3 elements.
+const unsigned int QUAD4_I0[] = { 0, 1, 1, 0 };
+const unsigned int QUAD4_I1[] = { 0, 0, 1, 1 };
+
+const unsigned int QUAD9_I0[] = { 0, 1, 1, 0, 2, 1, 2, 0, 2 };
+const unsigned int QUAD9_I1[] = { 0, 0, 1, 1, 0, 2, 1, 2, 2 };
+
+const unsigned int HEX8_I0[] = { 0, 1, 1, 0, 0, 1, 1, 0 };
+const unsigned int HEX8_I1[] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+const unsigned int HEX8_I2[] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+
+const unsigned int HEX27_I0[] = { 0, 1, 1, 0, 0, 1, 1, 0, 2, 1, 2, 0, 0, 1, 1, 0, 2, 1, 2, 0, 2, 2, 1, 2, 0, 2, 2 };
+const unsigned int HEX27_I1[] = { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 1, 2, 0, 0, 1, 1, 0, 2, 1, 2, 2, 0, 2, 1, 2, 2, 2 };
+const unsigned int HEX27_I2[] = { 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 2, 2, 2, 2, 1, 1, 1, 1, 0, 2, 2, 2, 2, 1, 2 };
+
+const double NODES_1D[] = { -1.0, 1.0, 0.0 };
+
+// Value of one-dimensional Lagrange shape function a at x.
+inline double
+lagrange_1d(const unsigned int a, const unsigned int n_nodes, const double x)
+{
+    double val = 1.0;
+    for (unsigned int b = 0; b < n_nodes; ++b)
+    {
+        if (b != a) val *= (x - NODES_1D[b]) / (NODES_1D[a] - NODES_1D[b]);
+    }
+    return val;
+}
+
+// Derivative of one-dimensional Lagrange shape function a at x.
+inline double
+lagrange_1d_deriv(const unsigned int a, const unsigned int n_nodes, const double x)
+{
+    double val = 0.0;
+    for (unsigned int c = 0; c < n_nodes; ++c)
+    {
+        if (c == a) continue;
+        double term = 1.0 / (NODES_1D[a] - NODES_1D[c]);
+        for (unsigned int b = 0; b < n_nodes; ++b)
+        {
+            if (b != a && b != c) term *= (x - NODES_1D[b]) / (NODES_1D[a] - NODES_1D[b]);
+        }
+        val += term;
+    }
+    return val;
+}
+} // namespace
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+bool
+TensorProductLagrangeFE::isSupported(const ElemType elem_type, const FEType& fe_type, const QuadratureType quad_type)
+{
+    if (fe_type.family != LAGRANGE || quad_type != QGAUSS) return false;
+    switch (elem_type)
+    {
+    case QUAD4:
+    case HEX8:
+        return fe_type.order == FIRST;
+    case QUAD9:
+    case HEX27:
+        return fe_type.order == SECOND;
+    default:
+        return false;
+    }
+} // isSupported
+
+TensorProductLagrangeFE::TensorProductLagrangeFE(const ElemType elem_type, const Order quad_order)
+{
+    const unsigned int* i0 = nullptr;
+    const unsigned int* i1 = nullptr;
+    const unsigned int* i2 = nullptr;
+    switch (elem_type)
+    {
+    case QUAD4:
+        d_dim = 2;
+        d_n_nodes_1d = 2;
+        i0 = QUAD4_I0;
+        i1 = QUAD4_I1;
+        break;
+    case QUAD9:
+        d_dim = 2;
+        d_n_nodes_1d = 3;
+        i0 = QUAD9_I0;
+        i1 = QUAD9_I1;
+        break;
+    case HEX8:
+        d_dim = 3;
+        d_n_nodes_1d = 2;
+        i0 = HEX8_I0;
+        i1 = HEX8_I1;
+        i2 = HEX8_I2;
+        break;
+    case HEX27:
+        d_dim = 3;
+        d_n_nodes_1d = 3;
+        i0 = HEX27_I0;
+        i1 = HEX27_I1;
+        i2 = HEX27_I2;
+        break;
+    default:
+        TBOX_ERROR("TensorProductLagrangeFE::TensorProductLagrangeFE(): unsupported element type "
+                   << elem_type << "\n");
+    }
+
+    // Use the same one-dimensional rule that libMesh uses to build
+    // tensor-product Gauss rules.
+    QGauss q_1d(1, quad_order);
+    q_1d.init(EDGE2);
+    d_n_qp_1d = q_1d.n_points();
+    d_n_nodes = d_n_nodes_1d;
+    d_n_qp = d_n_qp_1d;
+    for (unsigned int d = 1; d < d_dim; ++d)
+    {
+        d_n_nodes *= d_n_nodes_1d;
+        d_n_qp *= d_n_qp_1d;
+    }
+
+    d_phi.resize(d_n_qp_1d * d_n_nodes_1d);
+    d_dphi.resize(d_n_qp_1d * d_n_nodes_1d);
+    d_phi_trans.resize(d_n_qp_1d * d_n_nodes_1d);
+    d_dphi_trans.resize(d_n_qp_1d * d_n_nodes_1d);
+    for (unsigned int q = 0; q < d_n_qp_1d; ++q)
+    {
+        const double x = q_1d.qp(q)(0);
+        for (unsigned int a = 0; a < d_n_nodes_1d; ++a)
+        {
+            d_phi[q * d_n_nodes_1d + a] = lagrange_1d(a, d_n_nodes_1d, x);
+            d_dphi[q * d_n_nodes_1d + a] = lagrange_1d_deriv(a, d_n_nodes_1d, x);
+            d_phi_trans[a * d_n_qp_1d + q] = d_phi[q * d_n_nodes_1d + a];
+            d_dphi_trans[a * d_n_qp_1d + q] = d_dphi[q * d_n_nodes_1d + a];
+        }
+    }
+
+    d_weights.resize(d_n_qp);
+    for (unsigned int q = 0; q < d_n_qp; ++q)
+    {
+        d_weights[q] = 1.0;
+        for (unsigned int d = 0, r = q; d < d_dim; ++d, r /= d_n_qp_1d)
+        {
+            d_weights[q] *= q_1d.w(r % d_n_qp_1d);
+        }
+    }
+
+    d_lexicographic_node_index.resize(d_n_nodes);
+    for (unsigned int n = 0; n < d_n_nodes; ++n)
+    {
+        d_lexicographic_node_index[n] = i0[n] + d_n_nodes_1d * (i1[n] + (d_dim == 3 ? d_n_nodes_1d * i2[n] : 0));
+    }
+
+    const unsigned int n_max = std::max(d_n_nodes, d_n_qp);
+    d_lex_values.resize(n_max);
+    d_scratch_0.resize(n_max);
+    d_scratch_1.resize(n_max);
+    return;
+} // TensorProductLagrangeFE
+
+unsigned int
+TensorProductLagrangeFE::getDimension() const
+{
+    return d_dim;
+} // getDimension
+
+unsigned int
+TensorProductLagrangeFE::getNumberOfNodes() const
+{
+    return d_n_nodes;
+} // getNumberOfNodes
+
+unsigned int
+TensorProductLagrangeFE::getNumberOfQuadraturePoints() const
+{
+    return d_n_qp;
+} // getNumberOfQuadraturePoints
+
+const std::vector<double>&
+TensorProductLagrangeFE::getQuadratureWeights() const
+{
+    return d_weights;
+} // getQuadratureWeights
+
+void
+TensorProductLagrangeFE::interpolate(const double* const nodal_values, double* const qp_values) const
+{
+    for (unsigned int n = 0; n < d_n_nodes; ++n) d_lex_values[d_lexicographic_node_index[n]] = nodal_values[n];
+    unsigned int extents[3] = { d_n_nodes_1d, d_n_nodes_1d, d_n_nodes_1d };
+    const double* in = d_lex_values.data();
+    for (unsigned int dir = 0; dir < d_dim; ++dir)
+    {
+        double* const out = dir + 1 == d_dim ? qp_values : (dir % 2 == 0 ? d_scratch_0.data() : d_scratch_1.data());
+        apply1D(d_phi, d_n_qp_1d, d_n_nodes_1d, dir, extents, in, out);
+        in = out;
+    }
+    return;
+} // interpolate
+
+void
+TensorProductLagrangeFE::interpolateGradient(const double* const nodal_values, double* const qp_gradients) const
+{
+    for (unsigned int n = 0; n < d_n_nodes; ++n) d_lex_values[d_lexicographic_node_index[n]] = nodal_values[n];
+    for (unsigned int k = 0; k < d_dim; ++k)
+    {
+        unsigned int extents[3] = { d_n_nodes_1d, d_n_nodes_1d, d_n_nodes_1d };
+        const double* in = d_lex_values.data();
+        for (unsigned int dir = 0; dir < d_dim; ++dir)
+        {
+            double* const out = dir % 2 == 0 ? d_scratch_0.data() : d_scratch_1.data();
+            apply1D(dir == k ? d_dphi : d_phi, d_n_qp_1d, d_n_nodes_1d, dir, extents, in, out);
+            in = out;
+        }
+        for (unsigned int q = 0; q < d_n_qp; ++q) qp_gradients[q * d_dim + k] = in[q];
+    }
+    return;
+} // interpolateGradient
+
+void
+TensorProductLagrangeFE::integrateGradient(const double* const qp_fluxes, double* const nodal_values) const
+{
+    std::fill(d_lex_values.begin(), d_lex_values.begin() + d_n_nodes, 0.0);
+    for (unsigned int k = 0; k < d_dim; ++k)
+    {
+        // The first application writes to d_scratch_0, so start from d_scratch_1.
+        double* const flux = d_scratch_1.data();
+        for (unsigned int q = 0; q < d_n_qp; ++q) flux[q] = qp_fluxes[q * d_dim + k];
+        unsigned int extents[3] = { d_n_qp_1d, d_n_qp_1d, d_n_qp_1d };
+        const double* in = flux;
+        for (unsigned int dir = 0; dir < d_dim; ++dir)
+        {
+            double* const out = dir % 2 == 0 ? d_scratch_0.data() : d_scratch_1.data();
+            apply1D(dir == k ? d_dphi_trans : d_phi_trans, d_n_nodes_1d, d_n_qp_1d, dir, extents, in, out);
+            in = out;
+        }
+        for (unsigned int n = 0; n < d_n_nodes; ++n) d_lex_values[n] += in[n];
+    }
+    for (unsigned int n = 0; n < d_n_nodes; ++n) nodal_values[n] += d_lex_values[d_lexicographic_node_index[n]];
+    return;
+} // integrateGradient
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+void
+TensorProductLagrangeFE::apply1D(const std::vector<double>& op,
+                                 const unsigned int n_out,
+                                 const unsigned int n_in,
+                                 const unsigned int dir,
+                                 unsigned int* const extents,
+                                 const double* const in,
+                                 double* const out) const
+{
+    unsigned int stride = 1, n_outer = 1;
+    for (unsigned int d = 0; d < dir; ++d) stride *= extents[d];
+    for (unsigned int d = dir + 1; d < d_dim; ++d) n_outer *= extents[d];
+    for (unsigned int o = 0; o < n_outer; ++o)
+    {
+        const double* const in_o = in + o * n_in * stride;
+        double* const out_o = out + o * n_out * stride;
+        for (unsigned int r = 0; r < n_out; ++r)
+        {
+            const double* const op_r = op.data() + r * n_in;
+            for (unsigned int s = 0; s < stride; ++s)
+            {
+                double val = 0.0;
+                for (unsigned int c = 0; c < n_in; ++c) val += op_r[c] * in_o[c * stride + s];
+                out_o[r * stride + s] = val;
+            }
+        }
+    }
+    extents[dir] = n_out;
+    return;
+} // apply1D
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
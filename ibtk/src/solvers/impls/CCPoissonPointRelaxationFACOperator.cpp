@@ -22,19 +22,23 @@
 #include "ibtk/CoarseFineBoundaryRefinePatchStrategy.h"
 #include "ibtk/HierarchyGhostCellInterpolation.h"
 #include "ibtk/HierarchyMathOps.h"
+#include "ibtk/IBTK_MPI.h"
 #include "ibtk/LinearSolver.h"
 #include "ibtk/PoissonFACPreconditionerStrategy.h"
 #include "ibtk/PoissonSolver.h"
 #include "ibtk/RobinPhysBdryPatchStrategy.h"
 #include "ibtk/ibtk_utilities.h"
+#include "ibtk/patch_smoothers.h"
 
 #include "ArrayData.h"
 #include "Box.h"
 #include "CartesianGridGeometry.h"
 #include "CartesianPatchGeometry.h"
 #include "CellData.h"
+#include "CellIndex.h"
 #include "CoarsenOperator.h"
 #include "HierarchyCellDataOpsReal.h"
+#include "HierarchyDataOpsReal.h"
 #include "MultiblockDataTranslator.h"
 #include "Patch.h"
 #include "PatchDescriptor.h"
@@ -55,6 +59,8 @@
 #include "tbox/TimerManager.h"
 #include "tbox/Utilities.h"
 
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -284,6 +290,9 @@ enum SmootherType
     PATCH_GAUSS_SEIDEL,
     PROCESSOR_GAUSS_SEIDEL,
     RED_BLACK_GAUSS_SEIDEL,
+    RED_BLACK_GAUSS_SEIDEL_THREADED,
+    L1_JACOBI,
+    CHEBYSHEV,
     UNKNOWN = -1
 };
 
@@ -292,8 +301,11 @@ get_smoother_type(const std::string& smoother_type_string)
 {
     if (smoother_type_string == "PATCH_GAUSS_SEIDEL") return PATCH_GAUSS_SEIDEL;
     if (smoother_type_string == "PROCESSOR_GAUSS_SEIDEL") return PROCESSOR_GAUSS_SEIDEL;
-    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL")
-        return RED_BLACK_GAUSS_SEIDEL;
+    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL") return RED_BLACK_GAUSS_SEIDEL;
+    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL_THREADED") return RED_BLACK_GAUSS_SEIDEL_THREADED;
+    if (smoother_type_string == "L1_JACOBI") return L1_JACOBI;
+    if (smoother_type_string == "CHEBYSHEV")
+        return CHEBYSHEV;
     else
         return UNKNOWN;
 } // get_smoother_type
@@ -301,7 +313,7 @@ get_smoother_type(const std::string& smoother_type_string)
 inline bool
 use_red_black_ordering(SmootherType smoother_type)
 {
-    if (smoother_type == RED_BLACK_GAUSS_SEIDEL)
+    if (smoother_type == RED_BLACK_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED)
     {
         return true;
     }
@@ -314,7 +326,8 @@ use_red_black_ordering(SmootherType smoother_type)
 inline bool
 do_local_data_update(SmootherType smoother_type)
 {
-    if (smoother_type == PROCESSOR_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL)
+    if (smoother_type == PROCESSOR_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL ||
+        smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED)
     {
         return true;
     }
@@ -323,6 +336,33 @@ do_local_data_update(SmootherType smoother_type)
         return false;
     }
 } // do_local_data_update
+
+inline bool
+use_threaded_kernel(SmootherType smoother_type)
+{
+    return smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED;
+} // use_threaded_kernel
+
+inline bool
+use_polynomial_smoother(SmootherType smoother_type)
+{
+    return smoother_type == L1_JACOBI || smoother_type == CHEBYSHEV;
+} // use_polynomial_smoother
+
+// Deterministic pseudo-random initial values for the power iterations used to
+// estimate eigenvalues. The values only depend on the cell index, so the
+// estimates do not depend on the number of processors or on the patches.
+inline double
+power_iteration_initial_value(const hier::Index<NDIM>& i)
+{
+    std::uint32_t hash = 2166136261u;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        hash ^= static_cast<std::uint32_t>(i(d));
+        hash *= 16777619u;
+    }
+    return static_cast<double>(hash % 1024u) / 1024.0 - 0.5;
+} // power_iteration_initial_value
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -352,6 +392,12 @@ CCPoissonPointRelaxationFACOperator::CCPoissonPointRelaxationFACOperator(const s
     if (input_db)
     {
         if (input_db->keyExists("smoother_type")) d_smoother_type = input_db->getString("smoother_type");
+        if (input_db->keyExists("chebyshev_num_power_iterations"))
+            d_chebyshev_num_power_iterations = input_db->getInteger("chebyshev_num_power_iterations");
+        if (input_db->keyExists("chebyshev_min_eigenvalue_factor"))
+            d_chebyshev_min_eigenvalue_factor = input_db->getDouble("chebyshev_min_eigenvalue_factor");
+        if (input_db->keyExists("chebyshev_max_eigenvalue_factor"))
+            d_chebyshev_max_eigenvalue_factor = input_db->getDouble("chebyshev_max_eigenvalue_factor");
         if (input_db->keyExists("prolongation_method"))
             d_prolongation_method = input_db->getString("prolongation_method");
         if (input_db->keyExists("restriction_method")) d_restriction_method = input_db->getString("restriction_method");
@@ -388,6 +434,23 @@ CCPoissonPointRelaxationFACOperator::CCPoissonPointRelaxationFACOperator(const s
         }
     }
 
+    // Check the parameters of the Chebyshev smoother. Without power iterations
+    // the eigenvalue estimate vanishes, and an empty target interval makes the
+    // Chebyshev recurrence undefined.
+    if (d_chebyshev_num_power_iterations < 1)
+    {
+        TBOX_ERROR(d_object_name << "::CCPoissonPointRelaxationFACOperator():\n"
+                                 << "  chebyshev_num_power_iterations must be at least 1" << std::endl);
+    }
+    if (!(0.0 < d_chebyshev_min_eigenvalue_factor &&
+          d_chebyshev_min_eigenvalue_factor < d_chebyshev_max_eigenvalue_factor))
+    {
+        TBOX_ERROR(d_object_name << "::CCPoissonPointRelaxationFACOperator():\n"
+                                 << "  the Chebyshev eigenvalue factors must satisfy\n"
+                                 << "  0 < chebyshev_min_eigenvalue_factor < chebyshev_max_eigenvalue_factor"
+                                 << std::endl);
+    }
+
     // Configure the coarse level solver.
     setCoarseSolverType(d_coarse_solver_type);
 
@@ -461,6 +524,28 @@ CCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
 #endif
     const bool red_black_ordering = use_red_black_ordering(smoother_type);
     const bool update_local_data = do_local_data_update(smoother_type);
+    const bool threaded_kernel = use_threaded_kernel(smoother_type);
+    const bool polynomial_smoother = use_polynomial_smoother(smoother_type);
+    if (polynomial_smoother && (!d_poisson_spec.dIsConstant() || d_poisson_spec.cIsVariable()))
+    {
+        TBOX_ERROR(d_object_name << "::smoothError():\n"
+                                 << "  smoother type " << smoother_type_string
+                                 << " is only implemented for constant coefficients" << std::endl);
+    }
+
+    // Determine the interval targeted by the Chebyshev smoother. This must be
+    // done before the scratch data is used below, since the eigenvalue
+    // estimate is computed using the scratch data.
+    double cheb_theta = 0.0, cheb_delta = 0.0, cheb_sigma = 0.0, cheb_rho = 0.0;
+    if (smoother_type == CHEBYSHEV)
+    {
+        const double max_eigenvalue = getMaxEigenvalueEstimate(level_num);
+        const double lambda_max = d_chebyshev_max_eigenvalue_factor * max_eigenvalue;
+        const double lambda_min = d_chebyshev_min_eigenvalue_factor * max_eigenvalue;
+        cheb_theta = 0.5 * (lambda_max + lambda_min);
+        cheb_delta = 0.5 * (lambda_max - lambda_min);
+        cheb_sigma = cheb_theta / cheb_delta;
+    }
 
     // Cache coarse-fine interface ghost cell values in the "scratch" data.
     if (level_num > d_coarsest_ln && num_sweeps > 1)
@@ -484,6 +569,7 @@ CCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
 
     // Smooth the error by the specified number of sweeps.
     if (red_black_ordering) num_sweeps *= 2;
+    std::vector<double> Z;
     for (int isweep = 0; isweep < num_sweeps; ++isweep)
     {
         // Re-fill ghost cell data as needed.
@@ -530,6 +616,26 @@ CCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
             xeqScheduleGhostFillNoCoarse(error_idx, level_num);
         }
 
+        // Determine the coefficients of the polynomial smoother update. The
+        // Chebyshev search direction is stored in the interior of the scratch
+        // data, which is not used to cache coarse-fine interface values.
+        double alpha = 1.0, beta = 0.0;
+        if (smoother_type == CHEBYSHEV)
+        {
+            if (isweep == 0)
+            {
+                alpha = 1.0 / cheb_theta;
+                cheb_rho = 1.0 / cheb_sigma;
+            }
+            else
+            {
+                const double rho_new = 1.0 / (2.0 * cheb_sigma - cheb_rho);
+                alpha = 2.0 * rho_new / cheb_delta;
+                beta = rho_new * cheb_rho;
+                cheb_rho = rho_new;
+            }
+        }
+
         // Smooth the error on the patches.
         int patch_counter = 0;
         for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++patch_counter)
@@ -537,6 +643,7 @@ CCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
             Pointer<Patch<NDIM> > patch = level->getPatch(p());
             Pointer<CellData<NDIM, double> > error_data = error.getComponentPatchData(0, *patch);
             Pointer<CellData<NDIM, double> > residual_data = residual.getComponentPatchData(0, *patch);
+            Pointer<CellData<NDIM, double> > scratch_data = patch->getPatchData(scratch_idx);
 #if !defined(NDEBUG)
             const Box<NDIM>& ghost_box = error_data->getGhostBox();
             TBOX_ASSERT(ghost_box == residual_data->getGhostBox());
@@ -601,9 +708,30 @@ CCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
                 const int U_ghosts = (error_data->getGhostCellWidth()).max();
                 const double* const F = residual_data->getPointer(depth);
                 const int F_ghosts = (residual_data->getGhostCellWidth()).max();
-                if (D_is_constant && !C_is_var)
+                if (polynomial_smoother)
                 {
-                    if (red_black_ordering)
+                    Z.resize(patch_box.size());
+                    const bool use_l1_diagonal = smoother_type == L1_JACOBI;
+                    jacobi_residual_const_dc(Z.data(), U, U_ghosts, D, C, F, F_ghosts, patch_box, dx, use_l1_diagonal);
+                    if (smoother_type == CHEBYSHEV)
+                    {
+                        double* const P = scratch_data->getPointer(depth);
+                        const int P_ghosts = (scratch_data->getGhostCellWidth()).max();
+                        polynomial_smoother_update(U, U_ghosts, P, P_ghosts, Z.data(), patch_box, alpha, beta);
+                    }
+                    else
+                    {
+                        polynomial_smoother_update(U, U_ghosts, nullptr, 0, Z.data(), patch_box, alpha, beta);
+                    }
+                }
+                else if (D_is_constant && !C_is_var)
+                {
+                    if (threaded_kernel)
+                    {
+                        const int red_or_black = isweep % 2; // "red" = 0, "black" = 1
+                        red_black_gauss_seidel_const_dc(U, U_ghosts, D, C, F, F_ghosts, patch_box, dx, red_or_black);
+                    }
+                    else if (red_black_ordering)
                     {
                         int red_or_black = isweep % 2; // "red" = 0, "black" = 1
                         SMOOTH_GS_RB_CONST_DC_FC(U,
@@ -970,6 +1098,14 @@ CCPoissonPointRelaxationFACOperator::initializeOperatorStateSpecialized(const SA
     // Setup fill pattern spec objects.
     d_op_stencil_fill_pattern = new CellNoCornersFillPattern(CELLG, true, false, false);
 
+    // Reset the eigenvalue estimates used by the Chebyshev smoother.
+    d_max_eigenvalue_estimates.resize(d_finest_ln + 1, 0.0);
+    d_max_eigenvalue_estimate_coefs.resize(d_finest_ln + 1);
+    for (int ln = coarsest_reset_ln; ln <= finest_reset_ln; ++ln)
+    {
+        d_max_eigenvalue_estimates[ln] = 0.0;
+    }
+
     // Get overlap information for setting patch boundary conditions.
     d_patch_bc_box_overlap.resize(d_finest_ln + 1);
     for (int ln = coarsest_reset_ln; ln <= finest_reset_ln; ++ln)
@@ -1029,6 +1165,8 @@ CCPoissonPointRelaxationFACOperator::deallocateOperatorStateSpecialized(const in
     {
         d_patch_bc_box_overlap.clear();
         d_patch_neighbor_overlap.clear();
+        d_max_eigenvalue_estimates.clear();
+        d_max_eigenvalue_estimate_coefs.clear();
         if (d_coarse_solver) d_coarse_solver->deallocateSolverState();
     }
     return;
@@ -1036,6 +1174,77 @@ CCPoissonPointRelaxationFACOperator::deallocateOperatorStateSpecialized(const in
 
 /////////////////////////////// PRIVATE //////////////////////////////////////
 
+double
+CCPoissonPointRelaxationFACOperator::getMaxEigenvalueEstimate(const int level_num)
+{
+    const double D = d_poisson_spec.getDConstant();
+    const double C = d_poisson_spec.cIsZero() ? 0.0 : d_poisson_spec.getCConstant();
+    if (d_max_eigenvalue_estimates[level_num] > 0.0 &&
+        d_max_eigenvalue_estimate_coefs[level_num] == std::make_pair(D, C))
+    {
+        return d_max_eigenvalue_estimates[level_num];
+    }
+
+    // Estimate the largest eigenvalue of M^{-1} A, in which M is the diagonal
+    // of A, by power iterations on the first component of the scratch data.
+    // The coarse-fine interface ghost cell values remain zero throughout.
+    Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_num);
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        Pointer<CellData<NDIM, double> > scratch_data = patch->getPatchData(d_scratch_idx);
+        scratch_data->fillAll(0.0);
+        for (Box<NDIM>::Iterator b(patch->getBox()); b; b++)
+        {
+            const CellIndex<NDIM> i(b());
+            (*scratch_data)(i, 0) = power_iteration_initial_value(i);
+        }
+    }
+    double max_eigenvalue = 0.0;
+    std::vector<double> Z;
+    for (int k = 0; k < d_chebyshev_num_power_iterations; ++k)
+    {
+        xeqScheduleGhostFillNoCoarse(d_scratch_idx, level_num);
+
+        // Replace v by M^{-1} A v = -Z and accumulate the squared norms of the
+        // old and new values.
+        double norms_sq[2] = { 0.0, 0.0 };
+        for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+        {
+            Pointer<Patch<NDIM> > patch = level->getPatch(p());
+            Pointer<CellData<NDIM, double> > scratch_data = patch->getPatchData(d_scratch_idx);
+            const Box<NDIM>& patch_box = patch->getBox();
+            const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+            Z.resize(patch_box.size());
+            jacobi_residual_const_dc(Z.data(),
+                                     scratch_data->getPointer(0),
+                                     (scratch_data->getGhostCellWidth()).max(),
+                                     D,
+                                     C,
+                                     nullptr,
+                                     0,
+                                     patch_box,
+                                     pgeom->getDx(),
+                                     false);
+            int offset = 0;
+            for (Box<NDIM>::Iterator b(patch_box); b; b++, ++offset)
+            {
+                const CellIndex<NDIM> i(b());
+                norms_sq[0] += (*scratch_data)(i, 0) * (*scratch_data)(i, 0);
+                norms_sq[1] += Z[offset] * Z[offset];
+                (*scratch_data)(i, 0) = -Z[offset];
+            }
+        }
+        IBTK_MPI::sumReduction(norms_sq, 2);
+        if (norms_sq[0] == 0.0 || norms_sq[1] == 0.0) break;
+        max_eigenvalue = std::sqrt(norms_sq[1] / norms_sq[0]);
+        d_level_data_ops[level_num]->scale(d_scratch_idx, 1.0 / std::sqrt(norms_sq[1]), d_scratch_idx, true);
+    }
+    d_max_eigenvalue_estimates[level_num] = max_eigenvalue;
+    d_max_eigenvalue_estimate_coefs[level_num] = std::make_pair(D, C);
+    return max_eigenvalue;
+} // getMaxEigenvalueEstimate
+
 //////////////////////////////////////////////////////////////////////////////
 
 } // namespace IBTK
@@ -63,6 +63,32 @@ namespace
 static Timer* t_solve_system;
 static Timer* t_initialize_solver_state;
 static Timer* t_deallocate_solver_state;
+
+// Return the pipelined variant of a standard Krylov method, or the input KSP
+// type if there is no such variant. The pipelined variants overlap their
+// global reductions with the subsequent operator and preconditioner
+// applications.
+std::string
+get_pipelined_ksp_type(const std::string& ksp_type)
+{
+    if (ksp_type == KSPGMRES) return KSPPGMRES;
+    if (ksp_type == KSPFGMRES) return KSPPIPEFGMRES;
+    if (ksp_type == KSPCG) return KSPPIPECG;
+    if (ksp_type == KSPCR) return KSPPIPECR;
+    return ksp_type;
+} // get_pipelined_ksp_type
+
+// Return the standard Krylov method of which the input KSP type is the
+// pipelined variant, or the input KSP type if it is not a pipelined variant.
+std::string
+get_standard_ksp_type(const std::string& ksp_type)
+{
+    if (ksp_type == KSPPGMRES) return KSPGMRES;
+    if (ksp_type == KSPPIPEFGMRES) return KSPFGMRES;
+    if (ksp_type == KSPPIPECG) return KSPCG;
+    if (ksp_type == KSPPIPECR) return KSPCR;
+    return ksp_type;
+} // get_standard_ksp_type
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -90,6 +116,8 @@ PETScKrylovLinearSolver::PETScKrylovLinearSolver(std::string object_name,
         if (input_db->keyExists("abs_residual_tol")) d_abs_residual_tol = input_db->getDouble("abs_residual_tol");
         if (input_db->keyExists("rel_residual_tol")) d_rel_residual_tol = input_db->getDouble("rel_residual_tol");
         if (input_db->keyExists("ksp_type")) d_ksp_type = input_db->getString("ksp_type");
+        if (input_db->keyExists("use_pipelined_krylov"))
+            d_use_pipelined_krylov = input_db->getBool("use_pipelined_krylov");
         if (input_db->keyExists("initial_guess_nonzero"))
             d_initial_guess_nonzero = input_db->getBool("initial_guess_nonzero");
         if (input_db->keyExists("enable_logging")) d_enable_logging = input_db->getBool("enable_logging");
@@ -137,6 +165,13 @@ PETScKrylovLinearSolver::setKSPType(const std::string& ksp_type)
     return;
 } // setKSPType
 
+void
+PETScKrylovLinearSolver::setPipelinedKrylovEnabled(const bool use_pipelined_krylov)
+{
+    d_use_pipelined_krylov = use_pipelined_krylov;
+    return;
+} // setPipelinedKrylovEnabled
+
 void
 PETScKrylovLinearSolver::setOptionsPrefix(const std::string& options_prefix)
 {
@@ -335,11 +370,13 @@ PETScKrylovLinearSolver::initializeSolverState(const SAMRAIVectorReal<NDIM, doub
     IBTK_CHKERRQ(ierr);
 
     // Reset the member state variables to correspond to the values used by the
-    // KSP object.  (Command-line options always take precedence.)
+    // KSP object.  (Command-line options always take precedence.)  If
+    // pipelined Krylov methods are enabled, d_ksp_type stores the standard
+    // method, so that the pipelined variant can later be disabled.
     const char* ksp_type;
     ierr = KSPGetType(d_petsc_ksp, &ksp_type);
     IBTK_CHKERRQ(ierr);
-    d_ksp_type = ksp_type;
+    d_ksp_type = d_use_pipelined_krylov ? get_standard_ksp_type(ksp_type) : std::string(ksp_type);
     PetscBool initial_guess_nonzero;
     ierr = KSPGetInitialGuessNonzero(d_petsc_ksp, &initial_guess_nonzero);
     IBTK_CHKERRQ(ierr);
@@ -500,7 +537,7 @@ PETScKrylovLinearSolver::resetWrappedKSP(KSP& petsc_ksp)
     const char* ksp_type;
     ierr = KSPGetType(d_petsc_ksp, &ksp_type);
     IBTK_CHKERRQ(ierr);
-    d_ksp_type = std::string(ksp_type);
+    d_ksp_type = d_use_pipelined_krylov ? get_standard_ksp_type(ksp_type) : std::string(ksp_type);
 
     // Set d_options_prefix to correspond to that used by the supplied KSP.
     const char* options_prefix;
@@ -559,11 +596,15 @@ PETScKrylovLinearSolver::resetKSPOptions()
 {
     if (!d_petsc_ksp) return;
     int ierr;
-    const KSPType ksp_type = d_ksp_type.c_str();
-    ierr = KSPSetType(d_petsc_ksp, ksp_type);
+    const std::string ksp_type_name = d_use_pipelined_krylov ? get_pipelined_ksp_type(d_ksp_type) : d_ksp_type;
+    ierr = KSPSetType(d_petsc_ksp, ksp_type_name.c_str());
     IBTK_CHKERRQ(ierr);
-    std::string ksp_type_name(ksp_type);
-    if (ksp_type_name.find("gmres") != std::string::npos)
+
+    // Iterative refinement of classical Gram-Schmidt requires additional
+    // blocking reductions, so it is only enabled for the standard GMRES
+    // variants. The pipelined variants do not use it.
+    if (ksp_type_name.find("gmres") != std::string::npos && ksp_type_name != KSPPGMRES &&
+        ksp_type_name != KSPPIPEFGMRES)
     {
         ierr = KSPGMRESSetCGSRefinementType(d_petsc_ksp, KSP_GMRES_CGS_REFINE_IFNEEDED);
         IBTK_CHKERRQ(ierr);
@@ -19,6 +19,7 @@
 #include "ibtk/CoarseFineBoundaryRefinePatchStrategy.h"
 #include "ibtk/HierarchyGhostCellInterpolation.h"
 #include "ibtk/HierarchyMathOps.h"
+#include "ibtk/IBTK_MPI.h"
 #include "ibtk/LinearSolver.h"
 #include "ibtk/PoissonFACPreconditionerStrategy.h"
 #include "ibtk/PoissonSolver.h"
@@ -29,6 +30,7 @@
 #include "ibtk/SideSynchCopyFillPattern.h"
 #include "ibtk/StaggeredPhysicalBoundaryHelper.h"
 #include "ibtk/ibtk_utilities.h"
+#include "ibtk/patch_smoothers.h"
 
 #include "ArrayData.h"
 #include "Box.h"
@@ -36,6 +38,7 @@
 #include "CartesianGridGeometry.h"
 #include "CartesianPatchGeometry.h"
 #include "CoarsenOperator.h"
+#include "HierarchyDataOpsReal.h"
 #include "HierarchySideDataOpsReal.h"
 #include "MultiblockDataTranslator.h"
 #include "Patch.h"
@@ -48,6 +51,7 @@
 #include "SideData.h"
 #include "SideDataFactory.h"
 #include "SideGeometry.h"
+#include "SideIndex.h"
 #include "SideVariable.h"
 #include "Variable.h"
 #include "VariableContext.h"
@@ -64,6 +68,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -199,6 +205,9 @@ enum SmootherType
     PATCH_GAUSS_SEIDEL,
     PROCESSOR_GAUSS_SEIDEL,
     RED_BLACK_GAUSS_SEIDEL,
+    RED_BLACK_GAUSS_SEIDEL_THREADED,
+    L1_JACOBI,
+    CHEBYSHEV,
     UNKNOWN = -1
 };
 
@@ -207,8 +216,11 @@ get_smoother_type(const std::string& smoother_type_string)
 {
     if (smoother_type_string == "PATCH_GAUSS_SEIDEL") return PATCH_GAUSS_SEIDEL;
     if (smoother_type_string == "PROCESSOR_GAUSS_SEIDEL") return PROCESSOR_GAUSS_SEIDEL;
-    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL")
-        return RED_BLACK_GAUSS_SEIDEL;
+    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL") return RED_BLACK_GAUSS_SEIDEL;
+    if (smoother_type_string == "RED_BLACK_GAUSS_SEIDEL_THREADED") return RED_BLACK_GAUSS_SEIDEL_THREADED;
+    if (smoother_type_string == "L1_JACOBI") return L1_JACOBI;
+    if (smoother_type_string == "CHEBYSHEV")
+        return CHEBYSHEV;
     else
         return UNKNOWN;
 } // get_smoother_type
@@ -216,7 +228,7 @@ get_smoother_type(const std::string& smoother_type_string)
 inline bool
 use_red_black_ordering(SmootherType smoother_type)
 {
-    if (smoother_type == RED_BLACK_GAUSS_SEIDEL)
+    if (smoother_type == RED_BLACK_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED)
     {
         return true;
     }
@@ -229,7 +241,8 @@ use_red_black_ordering(SmootherType smoother_type)
 inline bool
 do_local_data_update(SmootherType smoother_type)
 {
-    if (smoother_type == PROCESSOR_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL)
+    if (smoother_type == PROCESSOR_GAUSS_SEIDEL || smoother_type == RED_BLACK_GAUSS_SEIDEL ||
+        smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED)
     {
         return true;
     }
@@ -238,6 +251,33 @@ do_local_data_update(SmootherType smoother_type)
         return false;
     }
 } // do_local_data_update
+
+inline bool
+use_threaded_kernel(SmootherType smoother_type)
+{
+    return smoother_type == RED_BLACK_GAUSS_SEIDEL_THREADED;
+} // use_threaded_kernel
+
+inline bool
+use_polynomial_smoother(SmootherType smoother_type)
+{
+    return smoother_type == L1_JACOBI || smoother_type == CHEBYSHEV;
+} // use_polynomial_smoother
+
+// Deterministic pseudo-random initial values for the power iterations used to
+// estimate eigenvalues. The values only depend on the index, so the estimates
+// do not depend on the number of processors or on the patches.
+inline double
+power_iteration_initial_value(const hier::Index<NDIM>& i)
+{
+    std::uint32_t hash = 2166136261u;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        hash ^= static_cast<std::uint32_t>(i(d));
+        hash *= 16777619u;
+    }
+    return static_cast<double>(hash % 1024u) / 1024.0 - 0.5;
+} // power_iteration_initial_value
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -268,6 +308,12 @@ SCPoissonPointRelaxationFACOperator::SCPoissonPointRelaxationFACOperator(const s
     if (input_db)
     {
         if (input_db->keyExists("smoother_type")) d_smoother_type = input_db->getString("smoother_type");
+        if (input_db->keyExists("chebyshev_num_power_iterations"))
+            d_chebyshev_num_power_iterations = input_db->getInteger("chebyshev_num_power_iterations");
+        if (input_db->keyExists("chebyshev_min_eigenvalue_factor"))
+            d_chebyshev_min_eigenvalue_factor = input_db->getDouble("chebyshev_min_eigenvalue_factor");
+        if (input_db->keyExists("chebyshev_max_eigenvalue_factor"))
+            d_chebyshev_max_eigenvalue_factor = input_db->getDouble("chebyshev_max_eigenvalue_factor");
         if (input_db->keyExists("prolongation_method"))
             d_prolongation_method = input_db->getString("prolongation_method");
         if (input_db->keyExists("restriction_method")) d_restriction_method = input_db->getString("restriction_method");
@@ -304,6 +350,23 @@ SCPoissonPointRelaxationFACOperator::SCPoissonPointRelaxationFACOperator(const s
         }
     }
 
+    // Check the parameters of the Chebyshev smoother. Without power iterations
+    // the eigenvalue estimate vanishes, and an empty target interval makes the
+    // Chebyshev recurrence undefined.
+    if (d_chebyshev_num_power_iterations < 1)
+    {
+        TBOX_ERROR(d_object_name << "::SCPoissonPointRelaxationFACOperator():\n"
+                                 << "  chebyshev_num_power_iterations must be at least 1" << std::endl);
+    }
+    if (!(0.0 < d_chebyshev_min_eigenvalue_factor &&
+          d_chebyshev_min_eigenvalue_factor < d_chebyshev_max_eigenvalue_factor))
+    {
+        TBOX_ERROR(d_object_name << "::SCPoissonPointRelaxationFACOperator():\n"
+                                 << "  the Chebyshev eigenvalue factors must satisfy\n"
+                                 << "  0 < chebyshev_min_eigenvalue_factor < chebyshev_max_eigenvalue_factor"
+                                 << std::endl);
+    }
+
     // Configure the coarse level solver.
     setCoarseSolverType(d_coarse_solver_type);
 
@@ -386,6 +449,22 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
 #endif
     const bool red_black_ordering = use_red_black_ordering(smoother_type);
     const bool update_local_data = do_local_data_update(smoother_type);
+    const bool threaded_kernel = use_threaded_kernel(smoother_type);
+    const bool polynomial_smoother = use_polynomial_smoother(smoother_type);
+
+    // Determine the interval targeted by the Chebyshev smoother. This must be
+    // done before the scratch data is used below, since the eigenvalue
+    // estimate is computed using the scratch data.
+    double cheb_theta = 0.0, cheb_delta = 0.0, cheb_sigma = 0.0, cheb_rho = 0.0;
+    if (smoother_type == CHEBYSHEV)
+    {
+        const double max_eigenvalue = getMaxEigenvalueEstimate(level_num);
+        const double lambda_max = d_chebyshev_max_eigenvalue_factor * max_eigenvalue;
+        const double lambda_min = d_chebyshev_min_eigenvalue_factor * max_eigenvalue;
+        cheb_theta = 0.5 * (lambda_max + lambda_min);
+        cheb_delta = 0.5 * (lambda_max - lambda_min);
+        cheb_sigma = cheb_theta / cheb_delta;
+    }
 
     // Cache coarse-fine interface ghost cell values in the "scratch" data.
     if (level_num > d_coarsest_ln && num_sweeps > 1)
@@ -413,6 +492,7 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
 
     // Smooth the error by the specified number of sweeps.
     if (red_black_ordering) num_sweeps *= 2;
+    std::vector<double> Z;
     for (int isweep = 0; isweep < num_sweeps; ++isweep)
     {
         // Re-fill ghost cell data as needed.
@@ -462,6 +542,26 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
             xeqScheduleGhostFillNoCoarse(error_idx, level_num);
         }
 
+        // Determine the coefficients of the polynomial smoother update. The
+        // Chebyshev search direction is stored in the interior of the scratch
+        // data, which is not used to cache coarse-fine interface values.
+        double alpha = 1.0, beta = 0.0;
+        if (smoother_type == CHEBYSHEV)
+        {
+            if (isweep == 0)
+            {
+                alpha = 1.0 / cheb_theta;
+                cheb_rho = 1.0 / cheb_sigma;
+            }
+            else
+            {
+                const double rho_new = 1.0 / (2.0 * cheb_sigma - cheb_rho);
+                alpha = 2.0 * rho_new / cheb_delta;
+                beta = rho_new * cheb_rho;
+                cheb_rho = rho_new;
+            }
+        }
+
         // Smooth the error on the patches.
         int patch_counter = 0;
         for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++patch_counter)
@@ -469,6 +569,7 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
             Pointer<Patch<NDIM> > patch = level->getPatch(p());
             Pointer<SideData<NDIM, double> > error_data = error.getComponentPatchData(0, *patch);
             Pointer<SideData<NDIM, double> > residual_data = residual.getComponentPatchData(0, *patch);
+            Pointer<SideData<NDIM, double> > scratch_data = patch->getPatchData(scratch_idx);
 #if !defined(NDEBUG)
             const Box<NDIM>& ghost_box = error_data->getGhostBox();
             TBOX_ASSERT(ghost_box == residual_data->getGhostBox());
@@ -521,9 +622,54 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
                     const int F_ghosts = (residual_data->getGhostCellWidth()).max();
                     const int* const mask = mask_data->getPointer(axis, depth);
                     const int mask_ghosts = (mask_data->getGhostCellWidth()).max();
-                    if (patch_has_dirichlet_bdry && d_bc_helper->patchTouchesDirichletBoundaryAxis(patch, axis))
+                    if (polynomial_smoother)
+                    {
+                        // Values at Dirichlet boundaries are not modified.
+                        const bool use_mask =
+                            patch_has_dirichlet_bdry && d_bc_helper->patchTouchesDirichletBoundaryAxis(patch, axis);
+                        Z.resize(side_patch_box.size());
+                        jacobi_residual_const_dc(Z.data(),
+                                                 U,
+                                                 U_ghosts,
+                                                 D,
+                                                 C,
+                                                 F,
+                                                 F_ghosts,
+                                                 side_patch_box,
+                                                 dx,
+                                                 smoother_type == L1_JACOBI,
+                                                 use_mask ? mask : nullptr,
+                                                 mask_ghosts);
+                        if (smoother_type == CHEBYSHEV)
+                        {
+                            double* const P = scratch_data->getPointer(axis, depth);
+                            const int P_ghosts = (scratch_data->getGhostCellWidth()).max();
+                            polynomial_smoother_update(
+                                U, U_ghosts, P, P_ghosts, Z.data(), side_patch_box, alpha, beta);
+                        }
+                        else
+                        {
+                            polynomial_smoother_update(U, U_ghosts, nullptr, 0, Z.data(), side_patch_box, alpha, beta);
+                        }
+                    }
+                    else if (patch_has_dirichlet_bdry && d_bc_helper->patchTouchesDirichletBoundaryAxis(patch, axis))
                     {
-                        if (red_black_ordering)
+                        if (threaded_kernel)
+                        {
+                            const int red_or_black = isweep % 2; // "red" = 0, "black" = 1
+                            red_black_gauss_seidel_const_dc(U,
+                                                            U_ghosts,
+                                                            D,
+                                                            C,
+                                                            F,
+                                                            F_ghosts,
+                                                            side_patch_box,
+                                                            dx,
+                                                            red_or_black,
+                                                            mask,
+                                                            mask_ghosts);
+                        }
+                        else if (red_black_ordering)
                         {
                             int red_or_black = isweep % 2; // "red" = 0, "black" = 1
                             RB_GS_SMOOTH_MASK_FC(U,
@@ -568,7 +714,13 @@ SCPoissonPointRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, double>&
                     }
                     else
                     {
-                        if (red_black_ordering)
+                        if (threaded_kernel)
+                        {
+                            const int red_or_black = isweep % 2; // "red" = 0, "black" = 1
+                            red_black_gauss_seidel_const_dc(
+                                U, U_ghosts, D, C, F, F_ghosts, side_patch_box, dx, red_or_black);
+                        }
+                        else if (red_black_ordering)
                         {
                             int red_or_black = isweep % 2; // "red" = 0, "black" = 1
                             SMOOTH_GS_RB_CONST_DC_FC(U,
@@ -800,6 +952,14 @@ SCPoissonPointRelaxationFACOperator::initializeOperatorStateSpecialized(const SA
     }
     d_synch_fill_pattern = new SideSynchCopyFillPattern();
 
+    // Reset the eigenvalue estimates used by the Chebyshev smoother.
+    d_max_eigenvalue_estimates.resize(d_finest_ln + 1, 0.0);
+    d_max_eigenvalue_estimate_coefs.resize(d_finest_ln + 1);
+    for (int ln = coarsest_reset_ln; ln <= finest_reset_ln; ++ln)
+    {
+        d_max_eigenvalue_estimates[ln] = 0.0;
+    }
+
     // Get overlap information for setting patch boundary conditions.
     d_patch_bc_box_overlap.resize(d_finest_ln + 1);
     for (int ln = coarsest_reset_ln; ln <= finest_reset_ln; ++ln)
@@ -870,6 +1030,8 @@ SCPoissonPointRelaxationFACOperator::deallocateOperatorStateSpecialized(const in
     {
         d_patch_bc_box_overlap.clear();
         d_patch_neighbor_overlap.clear();
+        d_max_eigenvalue_estimates.clear();
+        d_max_eigenvalue_estimate_coefs.clear();
         if (d_coarse_solver) d_coarse_solver->deallocateSolverState();
     }
     return;
@@ -877,6 +1039,97 @@ SCPoissonPointRelaxationFACOperator::deallocateOperatorStateSpecialized(const in
 
 /////////////////////////////// PRIVATE //////////////////////////////////////
 
+double
+SCPoissonPointRelaxationFACOperator::getMaxEigenvalueEstimate(const int level_num)
+{
+    const double D = d_poisson_spec.getDConstant();
+    const double C = d_poisson_spec.cIsZero() ? 0.0 : d_poisson_spec.getCConstant();
+    if (d_max_eigenvalue_estimates[level_num] > 0.0 &&
+        d_max_eigenvalue_estimate_coefs[level_num] == std::make_pair(D, C))
+    {
+        return d_max_eigenvalue_estimates[level_num];
+    }
+
+    // Estimate the largest eigenvalue of M^{-1} A, in which M is the diagonal
+    // of A, by power iterations on the first component of the scratch data.
+    // The coarse-fine interface ghost cell values remain zero throughout, and
+    // values at Dirichlet boundaries are set to zero.
+    Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_num);
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        Pointer<SideData<NDIM, double> > scratch_data = patch->getPatchData(d_scratch_idx);
+        scratch_data->fillAll(0.0);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            for (Box<NDIM>::Iterator b(SideGeometry<NDIM>::toSideBox(patch->getBox(), axis)); b; b++)
+            {
+                const SideIndex<NDIM> i(b(), axis, SideIndex<NDIM>::Lower);
+                (*scratch_data)(i, 0) = power_iteration_initial_value(i);
+            }
+        }
+    }
+    double max_eigenvalue = 0.0;
+    std::vector<double> Z;
+    for (int k = 0; k < d_chebyshev_num_power_iterations; ++k)
+    {
+        xeqScheduleGhostFillNoCoarse(d_scratch_idx, level_num);
+
+        // Replace v by M^{-1} A v = -Z and accumulate the squared norms of the
+        // old and new values. The faces on the boundary of a patch are either
+        // shared with a neighboring patch or on the boundary of the level, so
+        // weighting them by one half makes the norms independent of the patch
+        // layout.
+        double norms_sq[2] = { 0.0, 0.0 };
+        for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+        {
+            Pointer<Patch<NDIM> > patch = level->getPatch(p());
+            Pointer<SideData<NDIM, double> > scratch_data = patch->getPatchData(d_scratch_idx);
+            Pointer<SideData<NDIM, int> > mask_data = patch->getPatchData(d_mask_idx);
+            const Box<NDIM>& patch_box = patch->getBox();
+            const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+            const bool patch_has_dirichlet_bdry = d_bc_helper->patchTouchesDirichletBoundary(patch);
+            for (unsigned int axis = 0; axis < NDIM; ++axis)
+            {
+                const Box<NDIM> side_patch_box = SideGeometry<NDIM>::toSideBox(patch_box, axis);
+                const bool use_mask =
+                    patch_has_dirichlet_bdry && d_bc_helper->patchTouchesDirichletBoundaryAxis(patch, axis);
+                Z.resize(side_patch_box.size());
+                jacobi_residual_const_dc(Z.data(),
+                                         scratch_data->getPointer(axis, 0),
+                                         (scratch_data->getGhostCellWidth()).max(),
+                                         D,
+                                         C,
+                                         nullptr,
+                                         0,
+                                         side_patch_box,
+                                         pgeom->getDx(),
+                                         false,
+                                         use_mask ? mask_data->getPointer(axis, 0) : nullptr,
+                                         (mask_data->getGhostCellWidth()).max());
+                int offset = 0;
+                for (Box<NDIM>::Iterator b(side_patch_box); b; b++, ++offset)
+                {
+                    const SideIndex<NDIM> i(b(), axis, SideIndex<NDIM>::Lower);
+                    const bool on_patch_bdry =
+                        i(axis) == side_patch_box.lower(axis) || i(axis) == side_patch_box.upper(axis);
+                    const double weight = on_patch_bdry ? 0.5 : 1.0;
+                    norms_sq[0] += weight * (*scratch_data)(i, 0) * (*scratch_data)(i, 0);
+                    norms_sq[1] += weight * Z[offset] * Z[offset];
+                    (*scratch_data)(i, 0) = -Z[offset];
+                }
+            }
+        }
+        IBTK_MPI::sumReduction(norms_sq, 2);
+        if (norms_sq[0] == 0.0 || norms_sq[1] == 0.0) break;
+        max_eigenvalue = std::sqrt(norms_sq[1] / norms_sq[0]);
+        d_level_data_ops[level_num]->scale(d_scratch_idx, 1.0 / std::sqrt(norms_sq[1]), d_scratch_idx, true);
+    }
+    d_max_eigenvalue_estimates[level_num] = max_eigenvalue;
+    d_max_eigenvalue_estimate_coefs[level_num] = std::make_pair(D, C);
+    return max_eigenvalue;
+} // getMaxEigenvalueEstimate
+
 //////////////////////////////////////////////////////////////////////////////
 
 } // namespace IBTK
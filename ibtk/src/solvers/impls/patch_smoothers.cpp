@@ -0,0 +1,330 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibtk/patch_smoothers.h"
+
+#include "Box.h"
+#include "Index.h"
+#include "tbox/Utilities.h"
+
+#include <array>
+#include <cmath>
+
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// Boxes with fewer cells than this are smoothed by a single thread, since
+// starting a parallel region costs more than the update itself.
+static const int MIN_THREADED_BOX_SIZE = 4096;
+
+// Strides of an array with the given number of ghost cells that stores data
+// on a box.
+inline std::array<int, NDIM>
+compute_strides(const Box<NDIM>& box, const int gcw)
+{
+    std::array<int, NDIM> strides;
+    strides[0] = 1;
+    for (unsigned int d = 1; d < NDIM; ++d)
+    {
+        strides[d] = strides[d - 1] * (box.upper(d - 1) - box.lower(d - 1) + 1 + 2 * gcw);
+    }
+    return strides;
+} // compute_strides
+
+// Offset of the first cell of the row with the given (nonaxial) indices.
+inline int
+compute_row_offset(const Box<NDIM>& box, const int gcw, const std::array<int, NDIM>& strides, const Index<NDIM>& i)
+{
+    int offset = 0;
+    for (unsigned int d = 0; d < NDIM; ++d) offset += (i(d) - box.lower(d) + gcw) * strides[d];
+    return offset;
+} // compute_row_offset
+} // namespace
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+void
+red_black_gauss_seidel_const_dc(double* const U,
+                                const int U_gcw,
+                                const double D,
+                                const double C,
+                                const double* const F,
+                                const int F_gcw,
+                                const Box<NDIM>& box,
+                                const double* const dx,
+                                const int red_or_black,
+                                const int* const mask,
+                                const int mask_gcw)
+{
+#if !defined(NDEBUG)
+    TBOX_ASSERT(U_gcw >= 1);
+    TBOX_ASSERT(red_or_black == 0 || red_or_black == 1);
+#endif
+    if (box.empty()) return;
+
+    std::array<double, NDIM> fac_d;
+    double fac_sum = 0.0;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        fac_d[d] = D / (dx[d] * dx[d]);
+        fac_sum += fac_d[d];
+    }
+    const double fac = 0.5 / (fac_sum - 0.5 * C);
+
+    const std::array<int, NDIM> U_strides = compute_strides(box, U_gcw);
+    const std::array<int, NDIM> F_strides = compute_strides(box, F_gcw);
+    const std::array<int, NDIM> mask_strides = compute_strides(box, mask_gcw);
+
+    // Each row of cells along the first axis is updated by a single thread
+    // and the rows are distributed in contiguous blocks.
+    const int n0 = box.upper(0) - box.lower(0) + 1;
+    const int n1 = box.upper(1) - box.lower(1) + 1;
+    int n_rows = n1;
+#if (NDIM == 3)
+    n_rows *= box.upper(2) - box.lower(2) + 1;
+#endif
+    const bool threaded = box.size() >= MIN_THREADED_BOX_SIZE;
+    const double fac0 = fac_d[0];
+    const double fac1 = fac_d[1];
+    const int U_stride1 = U_strides[1];
+#if (NDIM == 3)
+    const double fac2 = fac_d[2];
+    const int U_stride2 = U_strides[2];
+#endif
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (threaded)
+#endif
+    for (int row = 0; row < n_rows; ++row)
+    {
+        Index<NDIM> i = box.lower();
+        i(1) += row % n1;
+#if (NDIM == 3)
+        i(2) += row / n1;
+#endif
+        int row_sum = 0;
+        for (unsigned int d = 0; d < NDIM; ++d) row_sum += i(d);
+
+        // The first cell of the row with the current color. Unlike mod(), the
+        // bitwise and gives the correct parity for negative indices.
+        const int k_begin = (row_sum + red_or_black) & 1;
+        double* const U_row = U + compute_row_offset(box, U_gcw, U_strides, i);
+        const double* const F_row = F + compute_row_offset(box, F_gcw, F_strides, i);
+
+        // Cells of one color only depend on cells of the other color, so
+        // there are no dependencies between the iterations of these loops.
+        if (mask)
+        {
+            const int* const mask_row = mask + compute_row_offset(box, mask_gcw, mask_strides, i);
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int k = k_begin; k < n0; k += 2)
+            {
+                double U_sum = fac0 * (U_row[k - 1] + U_row[k + 1]);
+                U_sum += fac1 * (U_row[k - U_stride1] + U_row[k + U_stride1]);
+#if (NDIM == 3)
+                U_sum += fac2 * (U_row[k - U_stride2] + U_row[k + U_stride2]);
+#endif
+                U_row[k] = mask_row[k] == 0 ? fac * (U_sum - F_row[k]) : U_row[k];
+            }
+        }
+        else
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int k = k_begin; k < n0; k += 2)
+            {
+                double U_sum = fac0 * (U_row[k - 1] + U_row[k + 1]);
+                U_sum += fac1 * (U_row[k - U_stride1] + U_row[k + U_stride1]);
+#if (NDIM == 3)
+                U_sum += fac2 * (U_row[k - U_stride2] + U_row[k + U_stride2]);
+#endif
+                U_row[k] = fac * (U_sum - F_row[k]);
+            }
+        }
+    }
+    return;
+} // red_black_gauss_seidel_const_dc
+
+void
+jacobi_residual_const_dc(double* const Z,
+                         const double* const U,
+                         const int U_gcw,
+                         const double D,
+                         const double C,
+                         const double* const F,
+                         const int F_gcw,
+                         const Box<NDIM>& box,
+                         const double* const dx,
+                         const bool use_l1_diagonal,
+                         const int* const mask,
+                         const int mask_gcw)
+{
+#if !defined(NDEBUG)
+    TBOX_ASSERT(U_gcw >= 1);
+#endif
+    if (box.empty()) return;
+
+    std::array<double, NDIM> fac_d;
+    double fac_sum = 0.0;
+    double abs_fac_sum = 0.0;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        fac_d[d] = D / (dx[d] * dx[d]);
+        fac_sum += fac_d[d];
+        abs_fac_sum += std::abs(fac_d[d]);
+    }
+    const double diag = C - 2.0 * fac_sum;
+    double M = diag;
+    if (use_l1_diagonal) M += (diag < 0.0 ? -2.0 : 2.0) * abs_fac_sum;
+    const double M_inv = 1.0 / M;
+
+    const std::array<int, NDIM> U_strides = compute_strides(box, U_gcw);
+    const std::array<int, NDIM> F_strides = compute_strides(box, F_gcw);
+    const std::array<int, NDIM> Z_strides = compute_strides(box, 0);
+    const std::array<int, NDIM> mask_strides = compute_strides(box, mask_gcw);
+
+    const int n0 = box.upper(0) - box.lower(0) + 1;
+    const int n1 = box.upper(1) - box.lower(1) + 1;
+    int n_rows = n1;
+#if (NDIM == 3)
+    n_rows *= box.upper(2) - box.lower(2) + 1;
+#endif
+    const bool threaded = box.size() >= MIN_THREADED_BOX_SIZE;
+    const double fac0 = fac_d[0];
+    const double fac1 = fac_d[1];
+    const int U_stride1 = U_strides[1];
+#if (NDIM == 3)
+    const double fac2 = fac_d[2];
+    const int U_stride2 = U_strides[2];
+#endif
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (threaded)
+#endif
+    for (int row = 0; row < n_rows; ++row)
+    {
+        Index<NDIM> i = box.lower();
+        i(1) += row % n1;
+#if (NDIM == 3)
+        i(2) += row / n1;
+#endif
+        const double* const U_row = U + compute_row_offset(box, U_gcw, U_strides, i);
+        const double* const F_row = F ? F + compute_row_offset(box, F_gcw, F_strides, i) : nullptr;
+        const int* const mask_row = mask ? mask + compute_row_offset(box, mask_gcw, mask_strides, i) : nullptr;
+        double* const Z_row = Z + compute_row_offset(box, 0, Z_strides, i);
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+        for (int k = 0; k < n0; ++k)
+        {
+            double AU = fac0 * (U_row[k - 1] + U_row[k + 1]);
+            AU += fac1 * (U_row[k - U_stride1] + U_row[k + U_stride1]);
+#if (NDIM == 3)
+            AU += fac2 * (U_row[k - U_stride2] + U_row[k + U_stride2]);
+#endif
+            AU += diag * U_row[k];
+            const double r = (F_row ? F_row[k] : 0.0) - AU;
+            Z_row[k] = (!mask_row || mask_row[k] == 0) ? M_inv * r : 0.0;
+        }
+    }
+    return;
+} // jacobi_residual_const_dc
+
+void
+polynomial_smoother_update(double* const U,
+                           const int U_gcw,
+                           double* const P,
+                           const int P_gcw,
+                           const double* const Z,
+                           const Box<NDIM>& box,
+                           const double alpha,
+                           const double beta)
+{
+    if (box.empty()) return;
+
+    const std::array<int, NDIM> U_strides = compute_strides(box, U_gcw);
+    const std::array<int, NDIM> P_strides = compute_strides(box, P_gcw);
+    const std::array<int, NDIM> Z_strides = compute_strides(box, 0);
+
+    const int n0 = box.upper(0) - box.lower(0) + 1;
+    const int n1 = box.upper(1) - box.lower(1) + 1;
+    int n_rows = n1;
+#if (NDIM == 3)
+    n_rows *= box.upper(2) - box.lower(2) + 1;
+#endif
+    const bool threaded = box.size() >= MIN_THREADED_BOX_SIZE;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (threaded)
+#endif
+    for (int row = 0; row < n_rows; ++row)
+    {
+        Index<NDIM> i = box.lower();
+        i(1) += row % n1;
+#if (NDIM == 3)
+        i(2) += row / n1;
+#endif
+        double* const U_row = U + compute_row_offset(box, U_gcw, U_strides, i);
+        const double* const Z_row = Z + compute_row_offset(box, 0, Z_strides, i);
+        if (!P)
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int k = 0; k < n0; ++k) U_row[k] += alpha * Z_row[k];
+            continue;
+        }
+
+        // Do not read P when beta is zero, so that uninitialized values
+        // (e.g., NaNs) do not propagate into the update.
+        double* const P_row = P + compute_row_offset(box, P_gcw, P_strides, i);
+        if (beta == 0.0)
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int k = 0; k < n0; ++k)
+            {
+                P_row[k] = alpha * Z_row[k];
+                U_row[k] += P_row[k];
+            }
+        }
+        else
+        {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (int k = 0; k < n0; ++k)
+            {
+                P_row[k] = alpha * Z_row[k] + beta * P_row[k];
+                U_row[k] += P_row[k];
+            }
+        }
+    }
+    return;
+} // polynomial_smoother_update
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
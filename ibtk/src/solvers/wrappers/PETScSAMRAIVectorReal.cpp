@@ -19,9 +19,20 @@
 #include "ibtk/PETScSAMRAIVectorReal.h"
 #include "ibtk/ibtk_utilities.h"
 
+#include "ArrayData.h"
+#include "Box.h"
+#include "CellData.h"
+#include "CellVariable.h"
+#include "Index.h"
 #include "IntVector.h"
+#include "Patch.h"
+#include "PatchData.h"
 #include "PatchHierarchy.h"
+#include "PatchLevel.h"
 #include "SAMRAIVectorReal.h"
+#include "SideData.h"
+#include "SideGeometry.h"
+#include "SideVariable.h"
 #include "tbox/MathUtilities.h"
 #include "tbox/Pointer.h"
 #include "tbox/Timer.h"
@@ -32,9 +43,12 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include "ibtk/namespaces.h" // IWYU pragma: keep
 
@@ -104,6 +118,355 @@ static Timer* t_vec_dot_norm2;
 #define PSVR_CHECK3(v1, v2, v3)
 #define PSVR_CHECKN(v, N)
 #endif
+
+// Strides of an array that stores data on the given box.
+inline std::array<int, NDIM>
+compute_strides(const Box<NDIM>& array_box)
+{
+    std::array<int, NDIM> strides;
+    strides[0] = 1;
+    for (unsigned int d = 1; d < NDIM; ++d)
+    {
+        strides[d] = strides[d - 1] * (array_box.upper(d - 1) - array_box.lower(d - 1) + 1);
+    }
+    return strides;
+} // compute_strides
+
+// Offset of the given index in an array that stores data on the given box.
+inline int
+compute_offset(const Box<NDIM>& array_box, const std::array<int, NDIM>& strides, const Index<NDIM>& i)
+{
+    int offset = 0;
+    for (unsigned int d = 0; d < NDIM; ++d) offset += (i(d) - array_box.lower(d)) * strides[d];
+    return offset;
+} // compute_offset
+
+// First index of the row of cells (along the first axis) of the box with the
+// given number.
+inline Index<NDIM>
+get_row_start(const Box<NDIM>& box, const int row)
+{
+    Index<NDIM> i = box.lower();
+#if (NDIM == 2)
+    i(1) += row;
+#endif
+#if (NDIM == 3)
+    const int n1 = box.upper(1) - box.lower(1) + 1;
+    i(1) += row % n1;
+    i(2) += row / n1;
+#endif
+    return i;
+} // get_row_start
+
+// Add the dot products of x with each of the arrays y[j] over the cells of
+// box, weighted by the first depth of cvol (if cvol is not null), to dots[j].
+// Each row of x and cvol is loaded once for all of the arrays y[j], but each
+// dot product is accumulated in the same order as a separate dot product.
+void
+accumulate_dots(const ArrayData<NDIM, double>& x,
+                const std::vector<const ArrayData<NDIM, double>*>& y,
+                const ArrayData<NDIM, double>* const cvol,
+                const Box<NDIM>& box,
+                double* const dots)
+{
+    Box<NDIM> ibox = box * x.getBox();
+    for (const ArrayData<NDIM, double>* const y_j : y) ibox = ibox * y_j->getBox();
+    if (cvol) ibox = ibox * cvol->getBox();
+    if (ibox.empty()) return;
+
+    const std::size_t nv = y.size();
+    const std::array<int, NDIM> x_strides = compute_strides(x.getBox());
+    const std::array<int, NDIM> cvol_strides = compute_strides(cvol ? cvol->getBox() : ibox);
+    std::vector<std::array<int, NDIM> > y_strides(nv);
+    for (std::size_t j = 0; j < nv; ++j) y_strides[j] = compute_strides(y[j]->getBox());
+    std::vector<double> sums(nv, 0.0);
+
+    const int n0 = ibox.upper(0) - ibox.lower(0) + 1;
+    const int n_rows = ibox.size() / n0;
+    for (int depth = 0; depth < x.getDepth(); ++depth)
+    {
+        for (int row = 0; row < n_rows; ++row)
+        {
+            const Index<NDIM> i = get_row_start(ibox, row);
+            const double* const x_row = x.getPointer(depth) + compute_offset(x.getBox(), x_strides, i);
+            const double* const cvol_row =
+                cvol ? cvol->getPointer(0) + compute_offset(cvol->getBox(), cvol_strides, i) : nullptr;
+            for (std::size_t j = 0; j < nv; ++j)
+            {
+                const double* const y_row = y[j]->getPointer(depth) + compute_offset(y[j]->getBox(), y_strides[j], i);
+                double sum = sums[j];
+                if (cvol_row)
+                {
+                    for (int k = 0; k < n0; ++k) sum += x_row[k] * y_row[k] * cvol_row[k];
+                }
+                else
+                {
+                    for (int k = 0; k < n0; ++k) sum += x_row[k] * y_row[k];
+                }
+                sums[j] = sum;
+            }
+        }
+    }
+    for (std::size_t j = 0; j < nv; ++j) dots[j] += sums[j];
+    return;
+} // accumulate_dots
+
+// Set y = y + sum_j alpha[j] x[j] on the cells of box, which must be
+// contained in the boxes of all of the arrays. Each row of y is loaded once
+// for all of the arrays x[j] and the terms are added in order of j, as in a
+// sequence of axpy operations.
+void
+add_scaled_arrays(ArrayData<NDIM, double>& y,
+                  const std::vector<const ArrayData<NDIM, double>*>& x,
+                  const double* const alpha,
+                  const Box<NDIM>& box)
+{
+    if (box.empty()) return;
+
+    const std::size_t nv = x.size();
+    const std::array<int, NDIM> y_strides = compute_strides(y.getBox());
+    std::vector<std::array<int, NDIM> > x_strides(nv);
+    for (std::size_t j = 0; j < nv; ++j) x_strides[j] = compute_strides(x[j]->getBox());
+
+    const int n0 = box.upper(0) - box.lower(0) + 1;
+    const int n_rows = box.size() / n0;
+    for (int depth = 0; depth < y.getDepth(); ++depth)
+    {
+        for (int row = 0; row < n_rows; ++row)
+        {
+            const Index<NDIM> i = get_row_start(box, row);
+            double* const y_row = y.getPointer(depth) + compute_offset(y.getBox(), y_strides, i);
+            for (std::size_t j = 0; j < nv; ++j)
+            {
+                const double* const x_row = x[j]->getPointer(depth) + compute_offset(x[j]->getBox(), x_strides[j], i);
+                const double alpha_j = alpha[j];
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for (int k = 0; k < n0; ++k) y_row[k] += alpha_j * x_row[k];
+            }
+        }
+    }
+    return;
+} // add_scaled_arrays
+
+// Set y = y + sum_j alpha[j] x[j] on the cells of box on which y is defined.
+// As in SAMRAI, each term only modifies the cells on which x[j] is also
+// defined.
+void
+maxpy_arrays(ArrayData<NDIM, double>& y,
+             const std::vector<const ArrayData<NDIM, double>*>& x,
+             const double* const alpha,
+             const Box<NDIM>& box)
+{
+    const Box<NDIM> ibox = box * y.getBox();
+    bool same_boxes = true;
+    for (const ArrayData<NDIM, double>* const x_j : x) same_boxes = same_boxes && (ibox * x_j->getBox()) == ibox;
+    if (same_boxes)
+    {
+        add_scaled_arrays(y, x, alpha, ibox);
+    }
+    else
+    {
+        for (std::size_t j = 0; j < x.size(); ++j)
+        {
+            add_scaled_arrays(y, { x[j] }, &alpha[j], ibox * x[j]->getBox());
+        }
+    }
+    return;
+} // maxpy_arrays
+
+// Whether all components of x and of the vectors y[j] are cell-centered or
+// side-centered, with the same centering in each vector, and are defined on
+// the same patch levels, in which case operations involving these vectors can
+// be done in a single pass over the patch data.
+bool
+can_fuse_operations(const SAMRAIVectorReal<NDIM, double>& x, const std::vector<SAMRAIVectorReal<NDIM, double>*>& y)
+{
+    const int ncomp = x.getNumberOfComponents();
+    for (const SAMRAIVectorReal<NDIM, double>* const y_j : y)
+    {
+        if (y_j->getPatchHierarchy().getPointer() != x.getPatchHierarchy().getPointer() ||
+            y_j->getCoarsestLevelNumber() != x.getCoarsestLevelNumber() ||
+            y_j->getFinestLevelNumber() != x.getFinestLevelNumber() || y_j->getNumberOfComponents() != ncomp)
+        {
+            return false;
+        }
+    }
+    for (int comp = 0; comp < ncomp; ++comp)
+    {
+        Pointer<CellVariable<NDIM, double> > x_cc_var = x.getComponentVariable(comp);
+        Pointer<SideVariable<NDIM, double> > x_sc_var = x.getComponentVariable(comp);
+        if (!x_cc_var && !x_sc_var) return false;
+        for (const SAMRAIVectorReal<NDIM, double>* const y_j : y)
+        {
+            Pointer<CellVariable<NDIM, double> > y_cc_var = y_j->getComponentVariable(comp);
+            Pointer<SideVariable<NDIM, double> > y_sc_var = y_j->getComponentVariable(comp);
+            if ((x_cc_var && !y_cc_var) || (x_sc_var && !y_sc_var)) return false;
+        }
+    }
+    return true;
+} // can_fuse_operations
+
+// Compute the local parts of the dot products of x with each of the vectors
+// y[j] in a single pass over the patch data. As in SAMRAIVectorReal::dot(),
+// the products are summed patch by patch and component by component.
+void
+mdot_local(SAMRAIVectorReal<NDIM, double>& x, const std::vector<SAMRAIVectorReal<NDIM, double>*>& y, double* const val)
+{
+    const std::size_t nv = y.size();
+    if (!can_fuse_operations(x, y))
+    {
+        static const bool local_only = true;
+        for (std::size_t j = 0; j < nv; ++j)
+        {
+            val[j] = x.dot(Pointer<SAMRAIVectorReal<NDIM, double> >(y[j], false), local_only);
+        }
+        return;
+    }
+
+    std::fill(val, val + nv, 0.0);
+    std::vector<double> comp_dots(nv), patch_dots(nv);
+    std::vector<const ArrayData<NDIM, double>*> y_arrays(nv);
+    Pointer<PatchHierarchy<NDIM> > hierarchy = x.getPatchHierarchy();
+    for (int comp = 0; comp < x.getNumberOfComponents(); ++comp)
+    {
+        const int x_idx = x.getComponentDescriptorIndex(comp);
+        const int cvol_idx = x.getControlVolumeIndex(comp);
+        const bool has_cvol = cvol_idx >= 0;
+        Pointer<CellVariable<NDIM, double> > comp_cc_var = x.getComponentVariable(comp);
+        std::fill(comp_dots.begin(), comp_dots.end(), 0.0);
+        for (int ln = x.getCoarsestLevelNumber(); ln <= x.getFinestLevelNumber(); ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = hierarchy->getPatchLevel(ln);
+            for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+            {
+                Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                const Box<NDIM>& patch_box = patch->getBox();
+                std::fill(patch_dots.begin(), patch_dots.end(), 0.0);
+                if (comp_cc_var)
+                {
+                    Pointer<CellData<NDIM, double> > x_data = patch->getPatchData(x_idx);
+                    Pointer<CellData<NDIM, double> > cvol_data =
+                        (has_cvol ? patch->getPatchData(cvol_idx) : Pointer<PatchData<NDIM> >(nullptr));
+                    for (std::size_t j = 0; j < nv; ++j)
+                    {
+                        Pointer<CellData<NDIM, double> > y_data =
+                            patch->getPatchData(y[j]->getComponentDescriptorIndex(comp));
+                        y_arrays[j] = &y_data->getArrayData();
+                    }
+                    accumulate_dots(x_data->getArrayData(),
+                                    y_arrays,
+                                    cvol_data ? &cvol_data->getArrayData() : nullptr,
+                                    patch_box,
+                                    patch_dots.data());
+                }
+                else
+                {
+                    Pointer<SideData<NDIM, double> > x_data = patch->getPatchData(x_idx);
+                    Pointer<SideData<NDIM, double> > cvol_data =
+                        (has_cvol ? patch->getPatchData(cvol_idx) : Pointer<PatchData<NDIM> >(nullptr));
+                    for (unsigned int axis = 0; axis < NDIM; ++axis)
+                    {
+                        if (!x_data->getDirectionVector()(axis)) continue;
+                        for (std::size_t j = 0; j < nv; ++j)
+                        {
+                            Pointer<SideData<NDIM, double> > y_data =
+                                patch->getPatchData(y[j]->getComponentDescriptorIndex(comp));
+                            y_arrays[j] = &y_data->getArrayData(axis);
+                        }
+                        accumulate_dots(x_data->getArrayData(axis),
+                                        y_arrays,
+                                        cvol_data ? &cvol_data->getArrayData(axis) : nullptr,
+                                        SideGeometry<NDIM>::toSideBox(patch_box, axis),
+                                        patch_dots.data());
+                    }
+                }
+                for (std::size_t j = 0; j < nv; ++j) comp_dots[j] += patch_dots[j];
+            }
+        }
+        for (std::size_t j = 0; j < nv; ++j) val[j] += comp_dots[j];
+    }
+    return;
+} // mdot_local
+
+// Set y = y + sum_j alpha[j] x[j], including ghost cells, in a single pass
+// over the patch data.
+void
+maxpy(SAMRAIVectorReal<NDIM, double>& y,
+      const double* const alpha,
+      const std::vector<SAMRAIVectorReal<NDIM, double>*>& x)
+{
+    const std::size_t nv = x.size();
+    if (!can_fuse_operations(y, x))
+    {
+        static const bool interior_only = false;
+        Pointer<SAMRAIVectorReal<NDIM, double> > y_ptr(&y, false);
+        for (std::size_t j = 0; j < nv; ++j)
+        {
+            Pointer<SAMRAIVectorReal<NDIM, double> > x_ptr(x[j], false);
+            if (MathUtilities<double>::equalEps(alpha[j], 1.0))
+            {
+                y.add(x_ptr, y_ptr, interior_only);
+            }
+            else if (MathUtilities<double>::equalEps(alpha[j], -1.0))
+            {
+                y.subtract(y_ptr, x_ptr, interior_only);
+            }
+            else
+            {
+                y.axpy(alpha[j], x_ptr, y_ptr, interior_only);
+            }
+        }
+        return;
+    }
+
+    std::vector<const ArrayData<NDIM, double>*> x_arrays(nv);
+    Pointer<PatchHierarchy<NDIM> > hierarchy = y.getPatchHierarchy();
+    for (int comp = 0; comp < y.getNumberOfComponents(); ++comp)
+    {
+        const int y_idx = y.getComponentDescriptorIndex(comp);
+        Pointer<CellVariable<NDIM, double> > comp_cc_var = y.getComponentVariable(comp);
+        for (int ln = y.getCoarsestLevelNumber(); ln <= y.getFinestLevelNumber(); ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = hierarchy->getPatchLevel(ln);
+            for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+            {
+                Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                if (comp_cc_var)
+                {
+                    Pointer<CellData<NDIM, double> > y_data = patch->getPatchData(y_idx);
+                    for (std::size_t j = 0; j < nv; ++j)
+                    {
+                        Pointer<CellData<NDIM, double> > x_data =
+                            patch->getPatchData(x[j]->getComponentDescriptorIndex(comp));
+                        x_arrays[j] = &x_data->getArrayData();
+                    }
+                    maxpy_arrays(y_data->getArrayData(), x_arrays, alpha, y_data->getGhostBox());
+                }
+                else
+                {
+                    Pointer<SideData<NDIM, double> > y_data = patch->getPatchData(y_idx);
+                    for (unsigned int axis = 0; axis < NDIM; ++axis)
+                    {
+                        if (!y_data->getDirectionVector()(axis)) continue;
+                        for (std::size_t j = 0; j < nv; ++j)
+                        {
+                            Pointer<SideData<NDIM, double> > x_data =
+                                patch->getPatchData(x[j]->getComponentDescriptorIndex(comp));
+                            x_arrays[j] = &x_data->getArrayData(axis);
+                        }
+                        maxpy_arrays(y_data->getArrayData(axis),
+                                     x_arrays,
+                                     alpha,
+                                     SideGeometry<NDIM>::toSideBox(y_data->getGhostBox(), axis));
+                    }
+                }
+            }
+        }
+    }
+    return;
+} // maxpy
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -307,11 +670,9 @@ PETScSAMRAIVectorReal::VecMDot_SAMRAI(Vec x, PetscInt nv, const Vec* y, PetscSca
     IBTK_TIMER_START(t_vec_m_dot);
     PSVR_CHECK1(x);
     PSVR_CHECKN(y, nv);
-    static const bool local_only = true;
-    for (PetscInt i = 0; i < nv; ++i)
-    {
-        val[i] = PSVR_CAST2(x)->dot(PSVR_CAST2(y[i]), local_only);
-    }
+    std::vector<SAMRAIVectorReal<NDIM, PetscScalar>*> y_vecs(nv);
+    for (PetscInt i = 0; i < nv; ++i) y_vecs[i] = PSVR_CAST2(y[i]).getPointer();
+    mdot_local(*PSVR_CAST2(x), y_vecs, val);
     IBTK_MPI::sumReduction(val, nv);
     IBTK_TIMER_STOP(t_vec_m_dot);
     PetscFunctionReturn(0);
@@ -368,11 +729,9 @@ PETScSAMRAIVectorReal::VecMTDot_SAMRAI(Vec x, PetscInt nv, const Vec* y, PetscSc
     IBTK_TIMER_START(t_vec_m_t_dot);
     PSVR_CHECK1(x);
     PSVR_CHECKN(y, nv);
-    static const bool local_only = true;
-    for (PetscInt i = 0; i < nv; ++i)
-    {
-        val[i] = PSVR_CAST2(x)->dot(PSVR_CAST2(y[i]), local_only);
-    }
+    std::vector<SAMRAIVectorReal<NDIM, PetscScalar>*> y_vecs(nv);
+    for (PetscInt i = 0; i < nv; ++i) y_vecs[i] = PSVR_CAST2(y[i]).getPointer();
+    mdot_local(*PSVR_CAST2(x), y_vecs, val);
     IBTK_MPI::sumReduction(val, nv);
     IBTK_TIMER_STOP(t_vec_m_t_dot);
     PetscFunctionReturn(0);
@@ -490,22 +849,9 @@ PETScSAMRAIVectorReal::VecMAXPY_SAMRAI(Vec y, PetscInt nv, const PetscScalar* al
     IBTK_TIMER_START(t_vec_maxpy);
     PSVR_CHECK1(y);
     PSVR_CHECKN(x, nv);
-    static const bool interior_only = false;
-    for (PetscInt i = 0; i < nv; ++i)
-    {
-        if (MathUtilities<double>::equalEps(alpha[i], 1.0))
-        {
-            PSVR_CAST2(y)->add(PSVR_CAST2(x[i]), PSVR_CAST2(y), interior_only);
-        }
-        else if (MathUtilities<double>::equalEps(alpha[i], -1.0))
-        {
-            PSVR_CAST2(y)->subtract(PSVR_CAST2(y), PSVR_CAST2(x[i]), interior_only);
-        }
-        else
-        {
-            PSVR_CAST2(y)->axpy(alpha[i], PSVR_CAST2(x[i]), PSVR_CAST2(y), interior_only);
-        }
-    }
+    std::vector<SAMRAIVectorReal<NDIM, PetscScalar>*> x_vecs(nv);
+    for (PetscInt i = 0; i < nv; ++i) x_vecs[i] = PSVR_CAST2(x[i]).getPointer();
+    maxpy(*PSVR_CAST2(y), alpha, x_vecs);
     int ierr = PetscObjectStateIncrease(reinterpret_cast<PetscObject>(y));
     CHKERRQ(ierr);
     IBTK_TIMER_STOP(t_vec_maxpy);
@@ -718,11 +1064,9 @@ PETScSAMRAIVectorReal::VecMDot_local_SAMRAI(Vec x, PetscInt nv, const Vec* y, Pe
     IBTK_TIMER_START(t_vec_m_dot_local);
     PSVR_CHECK1(x);
     PSVR_CHECKN(y, nv);
-    static const bool local_only = true;
-    for (PetscInt i = 0; i < nv; ++i)
-    {
-        val[i] = PSVR_CAST2(x)->dot(PSVR_CAST2(y[i]), local_only);
-    }
+    std::vector<SAMRAIVectorReal<NDIM, PetscScalar>*> y_vecs(nv);
+    for (PetscInt i = 0; i < nv; ++i) y_vecs[i] = PSVR_CAST2(y[i]).getPointer();
+    mdot_local(*PSVR_CAST2(x), y_vecs, val);
     IBTK_TIMER_STOP(t_vec_m_dot_local);
     PetscFunctionReturn(0);
 }
@@ -733,11 +1077,9 @@ PETScSAMRAIVectorReal::VecMTDot_local_SAMRAI(Vec x, PetscInt nv, const Vec* y, P
     IBTK_TIMER_START(t_vec_m_t_dot_local);
     PSVR_CHECK1(x);
     PSVR_CHECKN(y, nv);
-    static const bool local_only = true;
-    for (PetscInt i = 0; i < nv; ++i)
-    {
-        val[i] = PSVR_CAST2(x)->dot(PSVR_CAST2(y[i]), local_only);
-    }
+    std::vector<SAMRAIVectorReal<NDIM, PetscScalar>*> y_vecs(nv);
+    for (PetscInt i = 0; i < nv; ++i) y_vecs[i] = PSVR_CAST2(y[i]).getPointer();
+    mdot_local(*PSVR_CAST2(x), y_vecs, val);
     IBTK_TIMER_STOP(t_vec_m_t_dot_local);
     PetscFunctionReturn(0);
 }
@@ -757,8 +1099,11 @@ PETScSAMRAIVectorReal::VecDotNorm2_SAMRAI(Vec s, Vec t, PetscScalar* dp, PetscSc
 {
     IBTK_TIMER_START(t_vec_dot_norm2);
     PSVR_CHECK2(s, t);
-    *dp = PSVR_CAST2(s)->dot(PSVR_CAST2(t));
-    *nm = PSVR_CAST2(t)->dot(PSVR_CAST2(t));
+    PetscScalar val[2];
+    mdot_local(*PSVR_CAST2(t), { PSVR_CAST2(s).getPointer(), PSVR_CAST2(t).getPointer() }, val);
+    IBTK_MPI::sumReduction(val, 2);
+    *dp = val[0];
+    *nm = val[1];
     IBTK_TIMER_STOP(t_vec_dot_norm2);
     PetscFunctionReturn(0);
 }
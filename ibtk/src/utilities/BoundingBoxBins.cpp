@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibtk/BoundingBoxBins.h"
+#include "ibtk/libmesh_utilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// Call f(b) for the flattened index b of each bin in the range of bins
+// [lower, upper].
+template <class F>
+inline void
+for_each_bin(const std::array<int, NDIM>& lower,
+             const std::array<int, NDIM>& upper,
+             const std::array<int, NDIM>& n_bins,
+             F f)
+{
+    std::array<int, NDIM> i = lower;
+    while (true)
+    {
+        int b = i[NDIM - 1];
+        for (int d = NDIM - 2; d >= 0; --d) b = b * n_bins[d] + i[d];
+        f(b);
+
+        unsigned int d = 0;
+        while (d < NDIM && ++i[d] > upper[d])
+        {
+            i[d] = lower[d];
+            ++d;
+        }
+        if (d == NDIM) break;
+    }
+    return;
+} // for_each_bin
+
+// The maximum average number of bins per box.
+static const double MAX_BINS_PER_BOX = 2.0;
+} // namespace
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+BoundingBoxBins::BoundingBoxBins(const std::vector<libMeshWrappers::BoundingBox>& boxes,
+                                 const std::vector<int>& box_indices)
+    : d_boxes(boxes)
+{
+    buildBins(box_indices);
+    return;
+} // BoundingBoxBins
+
+BoundingBoxBins::BoundingBoxBins(const std::vector<libMeshWrappers::BoundingBox>& boxes) : d_boxes(boxes)
+{
+    std::vector<int> box_indices(boxes.size());
+    std::iota(box_indices.begin(), box_indices.end(), 0);
+    buildBins(box_indices);
+    return;
+} // BoundingBoxBins
+
+void
+BoundingBoxBins::getIntersectingBoxes(const libMeshWrappers::BoundingBox& query_box,
+                                      std::vector<int>& box_indices) const
+{
+    box_indices.clear();
+    if (d_bin_boxes.empty()) return;
+
+    std::array<int, NDIM> lower, upper;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        // Skip the search altogether if the query box does not intersect the
+        // region covered by the bins.
+        const double x_upper = d_x_lower[d] + d_n_bins[d] * d_bin_width[d];
+        if (query_box.second(d) < d_x_lower[d] || query_box.first(d) > x_upper) return;
+        lower[d] = getBinIndex(query_box.first(d), d);
+        upper[d] = getBinIndex(query_box.second(d), d);
+    }
+
+    for_each_bin(lower, upper, d_n_bins, [&](const int b) {
+        for (int k = d_bin_offsets[b]; k < d_bin_offsets[b + 1]; ++k)
+        {
+            const int box_idx = d_bin_boxes[k];
+            const libMeshWrappers::BoundingBox& box = d_boxes[box_idx];
+            bool intersects = true;
+            for (unsigned int d = 0; d < NDIM && intersects; ++d)
+            {
+                intersects = box.first(d) <= query_box.second(d) && query_box.first(d) <= box.second(d);
+            }
+            if (intersects) box_indices.push_back(box_idx);
+        }
+    });
+
+    // Boxes that span several bins may have been found more than once.
+    std::sort(box_indices.begin(), box_indices.end());
+    box_indices.erase(std::unique(box_indices.begin(), box_indices.end()), box_indices.end());
+    return;
+} // getIntersectingBoxes
+
+const std::array<int, NDIM>&
+BoundingBoxBins::getNumberOfBins() const
+{
+    return d_n_bins;
+} // getNumberOfBins
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+void
+BoundingBoxBins::buildBins(const std::vector<int>& box_indices)
+{
+    d_x_lower.fill(0.0);
+    d_bin_width.fill(1.0);
+    d_n_bins.fill(1);
+    d_bin_offsets.assign(2, 0);
+    d_bin_boxes.clear();
+
+    // Empty boxes (e.g., default-constructed ones) never intersect anything
+    // and are not indexed.
+    std::vector<int> nonempty_box_indices;
+    nonempty_box_indices.reserve(box_indices.size());
+    for (const int box_idx : box_indices)
+    {
+        const libMeshWrappers::BoundingBox& box = d_boxes[box_idx];
+        bool is_empty = false;
+        for (unsigned int d = 0; d < NDIM; ++d) is_empty = is_empty || box.first(d) > box.second(d);
+        if (!is_empty) nonempty_box_indices.push_back(box_idx);
+    }
+    if (nonempty_box_indices.empty()) return;
+
+    // Determine the extents of the boxes and their average size.
+    std::array<double, NDIM> x_upper, mean_width;
+    d_x_lower.fill(std::numeric_limits<double>::max());
+    x_upper.fill(std::numeric_limits<double>::lowest());
+    mean_width.fill(0.0);
+    for (const int box_idx : nonempty_box_indices)
+    {
+        const libMeshWrappers::BoundingBox& box = d_boxes[box_idx];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            d_x_lower[d] = std::min(d_x_lower[d], double(box.first(d)));
+            x_upper[d] = std::max(x_upper[d], double(box.second(d)));
+            mean_width[d] += box.second(d) - box.first(d);
+        }
+    }
+
+    // Use bins that are about as wide as the average box, but limit the total
+    // number of bins so that the memory required by the index is proportional
+    // to the number of boxes.
+    const auto n_boxes = static_cast<double>(nonempty_box_indices.size());
+    std::array<double, NDIM> n_bins;
+    double n_total_bins = 1.0;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        mean_width[d] /= n_boxes;
+        const double width = x_upper[d] - d_x_lower[d];
+        n_bins[d] = mean_width[d] > 0.0 ? std::max(1.0, std::min(width / mean_width[d], MAX_BINS_PER_BOX * n_boxes)) :
+                                          (width > 0.0 ? MAX_BINS_PER_BOX * n_boxes : 1.0);
+        n_total_bins *= n_bins[d];
+    }
+    const double scale = std::min(1.0, std::pow(MAX_BINS_PER_BOX * n_boxes / n_total_bins, 1.0 / NDIM));
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        d_n_bins[d] = std::max(1, static_cast<int>(std::floor(scale * n_bins[d])));
+        const double width = x_upper[d] - d_x_lower[d];
+        d_bin_width[d] = width > 0.0 ? width / d_n_bins[d] : 1.0;
+    }
+
+    // Sort the boxes into the bins.
+    int n_flat_bins = 1;
+    for (unsigned int d = 0; d < NDIM; ++d) n_flat_bins *= d_n_bins[d];
+    d_bin_offsets.assign(n_flat_bins + 1, 0);
+    std::array<int, NDIM> lower, upper;
+    const auto get_bin_range = [&](const libMeshWrappers::BoundingBox& box) {
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            lower[d] = getBinIndex(box.first(d), d);
+            upper[d] = getBinIndex(box.second(d), d);
+        }
+    };
+    for (const int box_idx : nonempty_box_indices)
+    {
+        get_bin_range(d_boxes[box_idx]);
+        for_each_bin(lower, upper, d_n_bins, [&](const int b) { ++d_bin_offsets[b + 1]; });
+    }
+    std::partial_sum(d_bin_offsets.begin(), d_bin_offsets.end(), d_bin_offsets.begin());
+    d_bin_boxes.resize(d_bin_offsets.back());
+    std::vector<int> bin_fill(d_bin_offsets.begin(), d_bin_offsets.end() - 1);
+    for (const int box_idx : nonempty_box_indices)
+    {
+        get_bin_range(d_boxes[box_idx]);
+        for_each_bin(lower, upper, d_n_bins, [&](const int b) { d_bin_boxes[bin_fill[b]++] = box_idx; });
+    }
+    return;
+} // buildBins
+
+int
+BoundingBoxBins::getBinIndex(const double x, const unsigned int d) const
+{
+    // Clamp before converting to an integer so that points far outside of the
+    // bins do not overflow.
+    const double i = std::floor((x - d_x_lower[d]) / d_bin_width[d]);
+    return static_cast<int>(std::max(0.0, std::min(i, static_cast<double>(d_n_bins[d] - 1))));
+} // getBinIndex
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
@@ -15,16 +15,100 @@
 
 #include "ibtk/IndexUtilities.h"
 
+#include "Index.h"
+
 #include "ibtk/namespaces.h" // IWYU pragma: keep
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 /////////////////////////////// NAMESPACE ////////////////////////////////////
 
 namespace IBTK
 {
 /////////////////////////////// STATIC ///////////////////////////////////////
 
+namespace
+{
+// The number of bits of each coordinate that are encoded in a 64-bit key.
+static const int SFC_BITS = NDIM == 2 ? 32 : 21;
+
+inline std::array<std::uint64_t, NDIM>
+get_sfc_coords(const hier::Index<NDIM>& i, const hier::Index<NDIM>& lower)
+{
+    std::array<std::uint64_t, NDIM> x;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        x[d] = static_cast<std::uint64_t>(std::max(i(d) - lower(d), 0));
+    }
+    return x;
+} // get_sfc_coords
+
+inline std::uint64_t
+interleave_bits(const std::array<std::uint64_t, NDIM>& x)
+{
+    std::uint64_t key = 0;
+    for (int b = SFC_BITS - 1; b >= 0; --b)
+    {
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            key = (key << 1) | ((x[d] >> b) & 1);
+        }
+    }
+    return key;
+} // interleave_bits
+} // namespace
+
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
+std::uint64_t
+IndexUtilities::getMortonKey(const hier::Index<NDIM>& i, const hier::Index<NDIM>& lower)
+{
+    return interleave_bits(get_sfc_coords(i, lower));
+} // getMortonKey
+
+std::uint64_t
+IndexUtilities::getHilbertKey(const hier::Index<NDIM>& i, const hier::Index<NDIM>& lower)
+{
+    // Convert the coordinates to the "transposed" Hilbert index using the
+    // algorithm of J. Skilling, "Programming the Hilbert curve", AIP Conf.
+    // Proc. 707 (2004), and then interleave the bits of the transposed index.
+    std::array<std::uint64_t, NDIM> x = get_sfc_coords(i, lower);
+    const std::uint64_t M = std::uint64_t(1) << (SFC_BITS - 1);
+    for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+    {
+        const std::uint64_t P = Q - 1;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            if (x[d] & Q)
+            {
+                x[0] ^= P;
+            }
+            else
+            {
+                const std::uint64_t t = (x[0] ^ x[d]) & P;
+                x[0] ^= t;
+                x[d] ^= t;
+            }
+        }
+    }
+    for (unsigned int d = 1; d < NDIM; ++d)
+    {
+        x[d] ^= x[d - 1];
+    }
+    std::uint64_t t = 0;
+    for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+    {
+        if (x[NDIM - 1] & Q) t ^= Q - 1;
+    }
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        x[d] ^= t;
+    }
+    return interleave_bits(x);
+} // getHilbertKey
+
 /////////////////////////////// PROTECTED ////////////////////////////////////
 
 /////////////////////////////// PRIVATE //////////////////////////////////////
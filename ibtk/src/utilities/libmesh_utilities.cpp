@@ -13,6 +13,7 @@
 
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
+#include "ibtk/BoundingBoxBins.h"
 #include "ibtk/FECache.h"
 #include "ibtk/QuadratureCache.h"
 #include "ibtk/libmesh_utilities.h"
@@ -60,6 +61,7 @@ IBTK_ENABLE_EXTRA_WARNINGS
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 /////////////////////////////// NAMESPACE ////////////////////////////////////
@@ -562,6 +564,114 @@ get_global_element_bounding_boxes(const libMesh::MeshBase& mesh,
     return global_bboxes;
 } // get_local_element_bounding_boxes
 
+std::vector<std::pair<libMesh::dof_id_type, libMeshWrappers::BoundingBox> >
+get_nearby_element_bounding_boxes(const libMesh::MeshBase& mesh,
+                                  const std::vector<libMesh::dof_id_type>& local_elem_ids,
+                                  const std::vector<libMeshWrappers::BoundingBox>& local_bboxes,
+                                  const std::vector<libMeshWrappers::BoundingBox>& region_bboxes,
+                                  const std::vector<int>& region_ranks)
+{
+    TBOX_ASSERT(local_elem_ids.size() == local_bboxes.size());
+    TBOX_ASSERT(region_bboxes.size() == region_ranks.size());
+    const MPI_Comm comm = mesh.comm().get();
+    int rank = 0, n_ranks = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &n_ranks);
+
+    // Determine which processors need each local bounding box. Each element
+    // is sent at most once to each processor.
+    const BoundingBoxBins region_bins(region_bboxes);
+    std::vector<std::vector<unsigned long> > send_ids(n_ranks);
+    std::vector<std::vector<double> > send_bboxes(n_ranks);
+    std::vector<int> regions, ranks;
+    for (std::size_t i = 0; i < local_bboxes.size(); ++i)
+    {
+        region_bins.getIntersectingBoxes(local_bboxes[i], regions);
+        ranks.clear();
+        for (const int region : regions) ranks.push_back(region_ranks[region]);
+        std::sort(ranks.begin(), ranks.end());
+        ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+        for (const int r : ranks)
+        {
+            send_ids[r].push_back(local_elem_ids[i]);
+            for (unsigned int d = 0; d < LIBMESH_DIM; ++d) send_bboxes[r].push_back(local_bboxes[i].first(d));
+            for (unsigned int d = 0; d < LIBMESH_DIM; ++d) send_bboxes[r].push_back(local_bboxes[i].second(d));
+        }
+    }
+
+    // Exchange the number of boxes and then the boxes themselves, skipping
+    // pairs of processors that have nothing to exchange.
+    std::vector<int> send_counts(n_ranks), recv_counts(n_ranks);
+    for (int r = 0; r < n_ranks; ++r) send_counts[r] = r == rank ? 0 : static_cast<int>(send_ids[r].size());
+    int ierr = MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    TBOX_ASSERT(ierr == 0);
+
+    const int id_tag = 0, bbox_tag = 1;
+    std::vector<std::vector<unsigned long> > recv_ids(n_ranks);
+    std::vector<std::vector<double> > recv_bboxes(n_ranks);
+    std::vector<MPI_Request> requests;
+    for (int r = 0; r < n_ranks; ++r)
+    {
+        if (recv_counts[r] == 0) continue;
+        recv_ids[r].resize(recv_counts[r]);
+        recv_bboxes[r].resize(2 * LIBMESH_DIM * recv_counts[r]);
+        requests.emplace_back();
+        ierr = MPI_Irecv(recv_ids[r].data(), recv_counts[r], MPI_UNSIGNED_LONG, r, id_tag, comm, &requests.back());
+        TBOX_ASSERT(ierr == 0);
+        requests.emplace_back();
+        ierr = MPI_Irecv(recv_bboxes[r].data(),
+                         static_cast<int>(recv_bboxes[r].size()),
+                         MPI_DOUBLE,
+                         r,
+                         bbox_tag,
+                         comm,
+                         &requests.back());
+        TBOX_ASSERT(ierr == 0);
+    }
+    for (int r = 0; r < n_ranks; ++r)
+    {
+        if (send_counts[r] == 0) continue;
+        requests.emplace_back();
+        ierr = MPI_Isend(send_ids[r].data(), send_counts[r], MPI_UNSIGNED_LONG, r, id_tag, comm, &requests.back());
+        TBOX_ASSERT(ierr == 0);
+        requests.emplace_back();
+        ierr = MPI_Isend(send_bboxes[r].data(),
+                         static_cast<int>(send_bboxes[r].size()),
+                         MPI_DOUBLE,
+                         r,
+                         bbox_tag,
+                         comm,
+                         &requests.back());
+        TBOX_ASSERT(ierr == 0);
+    }
+    ierr = MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    TBOX_ASSERT(ierr == 0);
+
+    // The boxes of local elements do not need to be communicated.
+    recv_ids[rank] = std::move(send_ids[rank]);
+    recv_bboxes[rank] = std::move(send_bboxes[rank]);
+
+    using id_bbox_pair = std::pair<libMesh::dof_id_type, libMeshWrappers::BoundingBox>;
+    std::vector<id_bbox_pair> nearby_bboxes;
+    for (int r = 0; r < n_ranks; ++r)
+    {
+        for (std::size_t i = 0; i < recv_ids[r].size(); ++i)
+        {
+            libMeshWrappers::BoundingBox bbox;
+            for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+            {
+                bbox.first(d) = recv_bboxes[r][2 * LIBMESH_DIM * i + d];
+                bbox.second(d) = recv_bboxes[r][2 * LIBMESH_DIM * i + LIBMESH_DIM + d];
+            }
+            nearby_bboxes.emplace_back(static_cast<libMesh::dof_id_type>(recv_ids[r][i]), bbox);
+        }
+    }
+    std::sort(nearby_bboxes.begin(), nearby_bboxes.end(), [](const id_bbox_pair& a, const id_bbox_pair& b) {
+        return a.first < b.first;
+    });
+    return nearby_bboxes;
+} // get_nearby_element_bounding_boxes
+
 std::vector<libMeshWrappers::BoundingBox>
 get_global_element_bounding_boxes(const libMesh::MeshBase& mesh, const libMesh::System& X_system)
 {
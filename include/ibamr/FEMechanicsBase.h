@@ -36,6 +36,7 @@
 #include "libmesh/equation_systems.h"
 #include "libmesh/explicit_system.h"
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -52,6 +53,12 @@ namespace IBAMR
  *   <li>FEProjector: Input database passed along to the object responsible for
  *     computing projections onto the finite element space. See the
  *     documentation of IBTK::FEProjector for more information.</li>
+ *   <li>use_sum_factorization: Whether or not to compute the interior force
+ *     density of parts consisting of QUAD4, QUAD9, HEX8, or HEX27 elements by
+ *     sum factorization (see IBTK::TensorProductLagrangeFE) when the PK1
+ *     stress function and its quadrature rule allow it. The result differs
+ *     from that of the standard assembly by roundoff. Defaults to
+ *     <code>FALSE</code>.</li>
  * </ol>
  */
 class FEMechanicsBase : public SAMRAI::tbox::Serializable
@@ -187,8 +194,82 @@ public:
      */
     using PK1StressFcnPtr = IBTK::TensorMeshFcnPtr;
 
+    /*!
+     * Struct storing the data at a batch of quadrature points that is passed
+     * to batched PK1 stress tensor functions (see BatchedPK1StressFcnPtr).
+     *
+     * All arrays are stored as structures of arrays: the values of one
+     * component at all points of the batch are contiguous, so that
+     * constitutive models can be written as loops over the points which the
+     * compiler can vectorize. For example, component (i, j) of the
+     * deformation gradient at point p is
+     * <code>FF[(i * NDIM + j) * n_points + p]</code>.
+     */
+    struct PK1StressBatch
+    {
+        /*!
+         * Number of quadrature points in the batch.
+         */
+        unsigned int n_points = 0;
+
+        /*!
+         * Deformation gradient (NDIM * NDIM components). In 2D, the
+         * out-of-plane component of the deformation gradient is one.
+         */
+        std::vector<double> FF;
+
+        /*!
+         * Current (x) and reference (X) positions (NDIM components).
+         */
+        std::vector<double> x, X;
+
+        /*!
+         * Values of the variables requested through the system_data member of
+         * PK1StressFcnData, one array per system: variable v of system s at
+         * point p is <code>var_data[s][v * n_points + p]</code>.
+         */
+        std::vector<std::vector<double> > var_data;
+
+        /*!
+         * Gradients of the variables requested through the system_data member
+         * of PK1StressFcnData, one array per system: component d of the
+         * gradient of variable v of system s at point p is
+         * <code>grad_var_data[s][(v * NDIM + d) * n_points + p]</code>.
+         */
+        std::vector<std::vector<double> > grad_var_data;
+
+        /*!
+         * Elements in the batch. The points of <code>elems[e]</code> are
+         * <code>elem_offsets[e]</code> through
+         * <code>elem_offsets[e + 1] - 1</code>.
+         */
+        std::vector<libMesh::Elem*> elems;
+        std::vector<unsigned int> elem_offsets;
+
+        /*!
+         * The first Piola-Kirchhoff stress tensor (NDIM * NDIM components),
+         * which is computed by the batched PK1 stress function. This array has
+         * the correct size when the function is called.
+         */
+        std::vector<double> PP;
+    };
+
+    /*!
+     * Typedef specifying interface for a batched PK1 stress tensor function,
+     * which computes the stress at all points of a PK1StressBatch at once.
+     */
+    using BatchedPK1StressFcnPtr = void (*)(PK1StressBatch& batch, double data_time, void* ctx);
+
     /*!
      * Struct encapsulating PK1 stress tensor function data.
+     *
+     * A PK1 stress function is either evaluated at one point at a time (fcn)
+     * or at a batch of points at once (batched_fcn). The interior force
+     * density is computed with batched_fcn if it is provided. If only
+     * batched_fcn is provided then registerPK1StressFunction() sets fcn to a
+     * function which evaluates batched_fcn at a single point (with ctx set
+     * accordingly), which is used wherever the stress is needed at
+     * individual points (e.g., on element boundaries).
      */
     struct PK1StressFcnData
     {
@@ -201,11 +282,28 @@ public:
         {
         }
 
+        PK1StressFcnData(BatchedPK1StressFcnPtr batched_fcn,
+                         std::vector<IBTK::SystemData> system_data = {},
+                         void* const ctx = nullptr,
+                         const libMesh::QuadratureType& quad_type = libMesh::INVALID_Q_RULE,
+                         const libMesh::Order& quad_order = libMesh::INVALID_ORDER)
+            : fcn(nullptr),
+              system_data(std::move(system_data)),
+              ctx(ctx),
+              quad_type(quad_type),
+              quad_order(quad_order),
+              batched_fcn(batched_fcn),
+              batched_ctx(ctx)
+        {
+        }
+
         PK1StressFcnPtr fcn;
         std::vector<IBTK::SystemData> system_data;
         void* ctx;
         libMesh::QuadratureType quad_type;
         libMesh::Order quad_order;
+        BatchedPK1StressFcnPtr batched_fcn = nullptr;
+        void* batched_ctx = nullptr;
     };
 
     /*!
@@ -216,6 +314,9 @@ public:
      * @note       It is possible to register multiple PK1 stress functions with
      *             this class.  This is intended to be used to implement
      *             selective reduced integration.
+     *
+     * @note       Batched PK1 stress functions (see PK1StressBatch) are
+     *             registered through this function as well.
      */
     virtual void registerPK1StressFunction(const PK1StressFcnData& data, unsigned int part = 0);
 
@@ -466,6 +567,10 @@ protected:
 
     /*!
      * \brief Compute the static pressure field.
+     *
+     * The pressure is computed by an L2 projection whose initial guess is
+     * computed from the pressures computed at previous times: see the
+     * documentation of IBTK::FEProjector.
      */
     void computeStaticPressure(libMesh::PetscVector<double>& P_vec,
                                libMesh::PetscVector<double>& X_vec,
@@ -643,6 +748,7 @@ protected:
     std::vector<libMesh::Order> d_default_quad_order_stress, d_default_quad_order_force, d_default_quad_order_pressure;
     bool d_use_consistent_mass_matrix = true;
     bool d_allow_rules_with_negative_weights = true;
+    bool d_use_sum_factorization = false;
     bool d_include_normal_stress_in_weak_form = false;
     bool d_include_tangential_stress_in_weak_form = false;
     bool d_include_normal_surface_forces_in_weak_form = true;
@@ -663,6 +769,13 @@ protected:
      */
     std::vector<std::vector<PK1StressFcnData> > d_PK1_stress_fcn_data;
 
+    /*!
+     * Copies of the data of PK1 stress functions that only provide a batched
+     * implementation. These are the contexts of the functions that evaluate
+     * the batched implementations at single points.
+     */
+    std::vector<std::unique_ptr<PK1StressFcnData> > d_batched_PK1_stress_fcn_data;
+
     /*!
      * Functions used to compute additional body and surface forces on the
      * Lagrangian mesh.
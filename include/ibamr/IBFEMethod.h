@@ -167,6 +167,13 @@ class IBFEDirectForcingKinematics;
  *   <li><code>spread_use_nodal_quadrature</code>: Same as above, but for spreading.
  *   <li><code>IB_use_nodal_quadrature</code>: overriding alias for the two previous
  *   entries - has the same default.</li>
+ *   <li><code>overlap_ghost_communication</code>: Whether or not the
+ *   communication of the ghost values of the structure's position (and, when
+ *   spreading, force density) should be overlapped with interpolation and
+ *   spreading on the elements which do not need them: see
+ *   IBTK::FEDataManager::ElementSubset. This changes the order in which the
+ *   elements are processed and hence the results at the level of roundoff.
+ *   Defaults to <code>FALSE</code>.</li>
  * </ul>
  *
  * <h2>Options Controlling libMesh Partitioning</h2>
@@ -300,6 +307,22 @@ class IBFEDirectForcingKinematics;
  * assigned to each node of every element (i.e., each node is counted more than
  * once): see IBTK::FEDataManager::WorkloadSpec for more information.
  *
+ * Since the actual cost of an IB point can vary a lot (e.g., when surface
+ * forces or jump conditions are computed on some elements) the workload
+ * estimate may instead be based on the measured cost of the work done on each
+ * element by spreading, interpolation, and the computation of surface forces
+ * and jump conditions: setting <code>workload_use_measured_costs</code> to
+ * <code>TRUE</code> (the default is <code>FALSE</code>) weights each IB point
+ * by the cost per IB point measured on its element relative to the average
+ * cost per IB point. The time spent on surface forces and jump conditions is
+ * charged to each element as a whole, i.e., it is split between the IB points
+ * of the element, and does not change the average cost per IB point. The
+ * parameter <code>workload_measured_cost_history_weight</code> (default
+ * <code>0.5</code>, must be in [0, 1]) is the weight given to measurements
+ * made before the previous regrid. Forces computed by the libMesh partitioning (e.g., by
+ * evaluating PK1 stress functions on the interior of elements) are not
+ * measured since they do not depend on the patch distribution.
+ *
  * For efficiency reasons this class only associates elements with patches if
  * they can interact with the patches (e.g., the points used for velocity
  * interpolation can lie inside the patch). Hence, over time, this association
@@ -1107,6 +1130,12 @@ protected:
     bool d_split_normal_force = false, d_split_tangential_force = false;
     bool d_use_jump_conditions = false;
 
+    /*!
+     * Whether or not to overlap the ghost value updates of IB-ghosted vectors
+     * with interpolation and spreading on processor interior elements.
+     */
+    bool d_overlap_ghost_communication = false;
+
     /*!
      * Data related to handling stress normalization.
      */
@@ -132,6 +132,36 @@ public:
         const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& f_prolongation_scheds,
         double data_time) = 0;
 
+    /*!
+     * Apply the linearized fluid-structure coupling operator, i.e., compute
+     *
+     *    f := f + alpha*S[X]*A*J[X]*u,
+     *
+     * in which J and S are the interpolation and spreading operators
+     * associated with the fixed Lagrangian-Eulerian coupling positions and A
+     * is the Lagrangian force Jacobian.
+     *
+     * The default implementation calls interpolateLinearizedVelocity(),
+     * computeLinearizedResidual(), computeLinearizedLagrangianForce(), and
+     * spreadLinearizedForce() in sequence, using temporary solver vectors
+     * created by createSolverVecs(). Implementations may override it to fuse
+     * these stages, e.g., to avoid the intermediate position vectors and to
+     * reuse data that depend only on the fixed positions (such as kernel
+     * weights) between the interpolation and spreading steps.
+     *
+     * \note The patch data index associated with \p f_phys_bdry_op is set to
+     * \p f_data_idx before spreading.
+     */
+    virtual void applyLinearizedCouplingOperator(
+        int f_data_idx,
+        int u_data_idx,
+        double alpha,
+        IBTK::RobinPhysBdryPatchStrategy* f_phys_bdry_op,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > >& u_synch_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& f_prolongation_scheds,
+        double data_time);
+
     /*!
      * Construct the IB interpolation operator.
      */
@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDE GUARD ////////////////////////////////
+
+#ifndef included_IBAMR_IBLinearizedCouplingOperator
+#define included_IBAMR_IBLinearizedCouplingOperator
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <ibamr/config.h>
+
+#include "ibamr/IBImplicitStrategy.h"
+
+#include "ibtk/LinearOperator.h"
+#include "ibtk/ibtk_utilities.h"
+
+#include "CoarsenSchedule.h"
+#include "HierarchyDataOpsReal.h"
+#include "RefineSchedule.h"
+#include "SAMRAIVectorReal.h"
+#include "tbox/Pointer.h"
+
+#include <string>
+#include <vector>
+
+namespace IBTK
+{
+class RobinPhysBdryPatchStrategy;
+} // namespace IBTK
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBAMR
+{
+/*!
+ * \brief Class IBLinearizedCouplingOperator is a concrete IBTK::LinearOperator
+ * which implements the linearized fluid-structure coupling operator
+ *
+ *    y = alpha*S[X]*A*J[X]*x
+ *
+ * of the implicit IB method, in which J and S are the interpolation and
+ * spreading operators associated with the fixed Lagrangian-Eulerian coupling
+ * positions X and A is the Lagrangian force Jacobian.
+ *
+ * The operator acts on the first (velocity) component of x and y. The
+ * remaining components of y are set to zero by apply() and are copied from y by
+ * applyAdd(). The operator is evaluated by
+ * IBImplicitStrategy::applyLinearizedCouplingOperator() using user-provided
+ * scratch patch data indices and the communication schedules associated with
+ * them, so it can be wrapped in a PETSc shell matrix by IBTK::PETScMatLOWrapper
+ * and applied repeatedly during a Krylov solve without allocating additional
+ * Lagrangian vectors.
+ *
+ * \see IBImplicitStaggeredHierarchyIntegrator
+ */
+class IBLinearizedCouplingOperator : public IBTK::LinearOperator
+{
+public:
+    /*!
+     * \brief Class constructor.
+     */
+    IBLinearizedCouplingOperator(std::string object_name, SAMRAI::tbox::Pointer<IBImplicitStrategy> ib_implicit_ops);
+
+    /*!
+     * \brief Destructor.
+     */
+    ~IBLinearizedCouplingOperator();
+
+    /*!
+     * \brief Set the scalar coefficient alpha.
+     */
+    void setCouplingCoefficient(double alpha);
+
+    /*!
+     * \brief Set the scratch patch data indices and the communication
+     * schedules used to interpolate the velocity and to spread the force.
+     *
+     * \note The schedules must be associated with the scratch patch data
+     * indices, and \p phys_bdry_op must be the physical boundary operator used
+     * by those schedules.
+     */
+    void setScratchData(
+        int u_scratch_idx,
+        int f_scratch_idx,
+        IBTK::RobinPhysBdryPatchStrategy* phys_bdry_op,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > >& u_synch_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& f_prolongation_scheds);
+
+    /*!
+     * \name Linear operator functionality.
+     */
+    //\{
+
+    /*!
+     * \brief Compute y=Ax.
+     *
+     * The positions at which the operator is linearized are those provided by
+     * the IBImplicitStrategy object at the current solution time.
+     *
+     * \see setSolutionTime
+     */
+    void apply(SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& x,
+               SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& y) override;
+
+    /*!
+     * \brief Compute z=Ax+y.
+     *
+     * \note The vectors y and z may be the same.
+     */
+    void applyAdd(SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& x,
+                  SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& y,
+                  SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& z) override;
+
+    /*!
+     * \brief Compute hierarchy dependent data required for computing y=Ax and
+     * z=Ax+y.
+     */
+    void initializeOperatorState(const SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& in,
+                                 const SAMRAI::solv::SAMRAIVectorReal<NDIM, double>& out) override;
+
+    /*!
+     * \brief Remove all hierarchy dependent data allocated by
+     * initializeOperatorState().
+     */
+    void deallocateOperatorState() override;
+
+    //\}
+
+private:
+    /*!
+     * \brief Default constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     */
+    IBLinearizedCouplingOperator() = delete;
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    IBLinearizedCouplingOperator(const IBLinearizedCouplingOperator& from) = delete;
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    IBLinearizedCouplingOperator& operator=(const IBLinearizedCouplingOperator& that) = delete;
+
+    SAMRAI::tbox::Pointer<IBImplicitStrategy> d_ib_implicit_ops;
+    double d_alpha = 1.0;
+
+    // Scratch data and the communication schedules associated with them.
+    int d_u_scratch_idx = IBTK::invalid_index, d_f_scratch_idx = IBTK::invalid_index;
+    IBTK::RobinPhysBdryPatchStrategy* d_phys_bdry_op = nullptr;
+    std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > > d_u_synch_scheds;
+    std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > > d_u_ghost_fill_scheds;
+    std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > > d_f_prolongation_scheds;
+
+    // Data operations for the velocity component.
+    SAMRAI::tbox::Pointer<SAMRAI::math::HierarchyDataOpsReal<NDIM, double> > d_hier_velocity_data_ops;
+};
+} // namespace IBAMR
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_IBAMR_IBLinearizedCouplingOperator
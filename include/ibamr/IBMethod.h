@@ -28,6 +28,7 @@
 
 #include "ibtk/LInitStrategy.h"
 #include "ibtk/LSiloDataWriter.h"
+#include "ibtk/ibtk_enums.h"
 #include "ibtk/ibtk_utilities.h"
 
 #include "GriddingAlgorithm.h"
@@ -87,6 +88,11 @@ namespace IBAMR
  * \brief Class IBMethod is an implementation of the abstract base class
  * IBImplicitStrategy that provides functionality required by the standard IB
  * method.
+ *
+ * The optional input entry <code>node_ordering</code> (<code>"NONE"</code>,
+ * the default, <code>"MORTON"</code>, or <code>"HILBERT"</code>) determines how
+ * the local Lagrangian nodes of each patch are ordered after each regrid; see
+ * IBTK::LDataManager::setNodeOrdering().
  */
 class IBMethod : public IBImplicitStrategy
 {
@@ -307,6 +313,26 @@ public:
         const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& f_prolongation_scheds,
         double data_time) override;
 
+    /*!
+     * Apply the linearized fluid-structure coupling operator f := f +
+     * alpha*S*A*J*u using the fixed Lagrangian-Eulerian coupling positions.
+     *
+     * The interpolated velocity and the linearized force are stored in the
+     * linearized velocity and force data, so no additional Lagrangian vectors
+     * are allocated. When LEInteractor caches kernel weights, repeated
+     * applications with the same fixed positions (e.g., during a Krylov solve)
+     * reuse the interpolation and spreading weights computed by the first one.
+     */
+    void applyLinearizedCouplingOperator(
+        int f_data_idx,
+        int u_data_idx,
+        double alpha,
+        IBTK::RobinPhysBdryPatchStrategy* f_phys_bdry_op,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > >& u_synch_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > >& f_prolongation_scheds,
+        double data_time) override;
+
     /*!
      * Construct the IB interpolation operator.
      */
@@ -545,6 +571,7 @@ protected:
     std::string d_interp_kernel_fcn = "IB_4", d_spread_kernel_fcn = "IB_4";
     bool d_error_if_points_leave_domain = false;
     SAMRAI::hier::IntVector<NDIM> d_ghosts;
+    IBTK::LNodeOrderingType d_node_ordering = IBTK::LNODE_ORDERING_NONE;
 
     /*
      * Lagrangian variables.
@@ -67,6 +67,21 @@ namespace IBAMR
  * force function with any function that implements the interface required by
  * registerSpringForceFunction().  Users may also specify additional force
  * functions that may be associated with arbitrary integer indices.
+ *
+ * \note Springs that use default_spring_force() are grouped together and their
+ * stiffnesses and resting lengths are stored in contiguous arrays so that their
+ * forces can be evaluated in vectorizable loops. Springs that use any other
+ * force function are evaluated by calling that function for each spring.
+ *
+ * \note If the input database sets <code>threaded_force_accumulation =
+ * TRUE</code>, the springs and beams on each level are colored when the level
+ * data are initialized (i.e., initially and after each regrid) so that no two
+ * springs (or beams) of the same color share a node. The forces of each color
+ * are then accumulated at the nodes concurrently with OpenMP, without atomics.
+ * Colors are processed in a fixed order, so the computed forces do not depend
+ * on the number of threads; they may differ from those computed in serial
+ * mode by roundoff because the order of summation at each node changes.
+ * User-registered spring force functions are always called serially.
  */
 class IBStandardForceGen : public IBLagrangianForceStrategy
 {
@@ -191,6 +206,20 @@ private:
         std::vector<SpringForceFcnPtr> force_fcns;
         std::vector<SpringForceDerivFcnPtr> force_deriv_fcns;
         std::vector<const double*> parameters;
+
+        // Springs [0, num_default_springs) use default_spring_force(). Their
+        // parameters are gathered into stiffnesses and rest_lengths before
+        // each force evaluation.
+        int num_default_springs = 0;
+        std::vector<double> stiffnesses, rest_lengths;
+
+        // Scratch storage for the force generated by each spring.
+        std::vector<double> forces;
+
+        // Springs sorted by color: springs colored_springs[color_offsets[c]]
+        // through colored_springs[color_offsets[c + 1] - 1] do not share any
+        // nodes. Only used with threaded force accumulation.
+        std::vector<int> color_offsets, colored_springs;
     };
     std::vector<SpringData> d_spring_data;
 
@@ -200,6 +229,17 @@ private:
         std::vector<int> petsc_global_mastr_node_idxs, petsc_global_next_node_idxs, petsc_global_prev_node_idxs;
         std::vector<const double*> rigidities;
         std::vector<const IBTK::Vector*> curvatures;
+
+        // Bending rigidities and curvatures gathered before each force
+        // evaluation, and scratch storage for the force generated by each
+        // beam.
+        std::vector<double> rigidity_values, curvature_values;
+        std::vector<double> forces;
+
+        // Beams sorted by color: beams colored_beams[color_offsets[c]] through
+        // colored_beams[color_offsets[c + 1] - 1] do not share any nodes. Only
+        // used with threaded force accumulation.
+        std::vector<int> color_offsets, colored_beams;
     };
     std::vector<BeamData> d_beam_data;
 
@@ -208,6 +248,10 @@ private:
         std::vector<int> petsc_node_idxs, petsc_global_node_idxs;
         std::vector<const double*> kappa, eta;
         std::vector<const IBTK::Point*> X0;
+
+        // Stiffnesses, damping coefficients, and target positions gathered
+        // before each force evaluation.
+        std::vector<double> kappa_values, eta_values, X0_values;
     };
     std::vector<TargetPointData> d_target_point_data;
 
@@ -274,6 +318,12 @@ private:
      * \brief Logging settings.
      */
     bool d_log_target_point_displacements = false;
+
+    /*!
+     * \brief Whether to accumulate spring and beam forces concurrently, one
+     * color at a time.
+     */
+    bool d_threaded_force_accumulation = false;
 };
 } // namespace IBAMR
 
@@ -32,6 +32,7 @@
 
 #include "muParser.h"
 
+#include <array>
 #include <vector>
 
 namespace IBTK
@@ -56,6 +57,26 @@ class Database;
 
 namespace IBAMR
 {
+// Class NonbondedForceEvaluator computes pairwise forces between all pairs of
+// Lagrangian nodes that are within interaction_radius grid cells of each
+// other. The force function must vanish for nodes that are farther apart.
+//
+// Interacting pairs are found with a cell-linked list built for each patch
+// from the nodes in the patch and its ghost cells, including periodic images.
+// The physical domain may consist of multiple boxes and may be periodic, but
+// the Lagrangian index data must have at least ceil(interaction_radius +
+// verlet_skin + 2*regrid_alpha) ghost cells. When IBAMR is built with OpenMP,
+// the neighbor search and the force function evaluations are performed by
+// multiple threads, so the force function must be thread safe; the forces are
+// accumulated at the local nodes in a fixed order. Forces on nonlocal nodes are
+// summed into the processes that own them.
+//
+// If use_verlet_lists is set in the input database, the pairs of nodes that
+// are within interaction_radius + verlet_skin grid cells of each other are
+// stored in per-level neighbor (Verlet) lists that are reused by subsequent
+// force evaluations. The lists are rebuilt after each regrid and whenever some
+// node has moved more than half of verlet_skin grid cells since they were last
+// built. Otherwise, the pairs are found anew for each force evaluation.
 class NonbondedForceEvaluator : public IBLagrangianForceStrategy
 {
 public:
@@ -79,6 +100,14 @@ public:
                         std::vector<int> cell_offset,
                         SAMRAI::tbox::Pointer<IBTK::LData> F_data);
 
+    // Implementation of initializeLevelData. Invalidates the Verlet list of
+    // the level.
+    void initializeLevelData(SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<NDIM> > hierarchy,
+                             int level_number,
+                             double init_data_time,
+                             bool initial_time,
+                             IBTK::LDataManager* l_data_manager) override;
+
     // Implementation of computeLagrangianForce.
     void computeLagrangianForce(SAMRAI::tbox::Pointer<IBTK::LData> F_data,
                                 SAMRAI::tbox::Pointer<IBTK::LData> X_data,
@@ -101,12 +130,58 @@ private:
     // Assignment operator, not implemented.
     NonbondedForceEvaluator& operator=(const NonbondedForceEvaluator& that) = delete;
 
+    // Determine whether the Verlet list of the given level can be used with
+    // the given node positions.
+    bool verletListIsValid(SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+                           int level_number,
+                           IBTK::LDataManager* l_data_manager);
+
+    // Rebuild the Verlet list of the given level with the given skin (in
+    // units of the grid spacing).
+    void buildVerletList(SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+                         SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<NDIM> > hierarchy,
+                         int level_number,
+                         IBTK::LDataManager* l_data_manager,
+                         double skin);
+
+    // Compute the forces on the given level using its Verlet list.
+    void computeVerletListForces(SAMRAI::tbox::Pointer<IBTK::LData> F_data,
+                                 SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+                                 int level_number);
+
     // interaction radius:
     double d_interaction_radius;
 
     // regrid_alpha, for computing buffer to add to interactions:
     double d_regrid_alpha;
 
+    // Verlet list settings. The skin is measured in units of the grid spacing.
+    bool d_use_verlet_lists = false;
+    double d_verlet_skin;
+
+    // Verlet list of a single level, stored in compressed sparse row format:
+    // the master node with local PETSc index mstr_idxs[i] interacts with the
+    // nodes with local PETSc indices nbr_idxs[j] for nbr_offsets[i] <= j <
+    // nbr_offsets[i + 1], displaced by the periodic shifts
+    // nbr_periodic_shifts[NDIM * j], ..., nbr_periodic_shifts[NDIM * j + NDIM - 1].
+    struct VerletList
+    {
+        bool is_valid = false;
+        std::vector<int> mstr_idxs;
+        std::vector<int> nbr_offsets;
+        std::vector<int> nbr_idxs;
+        std::vector<double> nbr_periodic_shifts;
+
+        // Scratch storage for the force generated by each pair of nodes.
+        std::vector<double> pair_forces;
+
+        // Grid spacing and positions of the local nodes at the time the list
+        // was built.
+        std::array<double, NDIM> dx;
+        std::vector<double> X_ref;
+    };
+    std::vector<VerletList> d_verlet_lists;
+
     // parameters for force function:
     SAMRAI::tbox::Array<double> d_parameters;
 
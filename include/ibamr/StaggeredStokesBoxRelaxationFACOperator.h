@@ -22,12 +22,9 @@
 
 #include "ibamr/StaggeredStokesFACPreconditionerStrategy.h"
 
+#include "Index.h"
 #include "tbox/Pointer.h"
 
-#include "petscksp.h"
-#include "petscmat.h"
-#include "petscvec.h"
-
 #include <array>
 #include <string>
 #include <vector>
@@ -58,6 +55,19 @@ namespace IBAMR
  * \brief Class StaggeredStokesBoxRelaxationFACOperator is a concrete
  * StaggeredStokesFACPreconditionerStrategy implementing a box relaxation
  * (Vanka-type) smoother for use as a multigrid preconditioner.
+ *
+ * Each box consists of a single cell. Since the box operator depends only on
+ * the grid spacing, its inverse is computed once per level when the operator
+ * state is initialized and is applied directly to the right-hand side of each
+ * box system.
+ *
+ * By default, the cells of each patch are relaxed in lexicographic order. If
+ * the input database sets <code>use_multicolor_ordering = TRUE</code>, the
+ * cells are instead colored so that no two cells of the same color share any
+ * of the values read or written by their box solves. The cells of each color
+ * are then relaxed in batches, which are processed concurrently with OpenMP
+ * when it is available. The result does not depend on the number of threads
+ * but differs from that of the lexicographic ordering.
  */
 class StaggeredStokesBoxRelaxationFACOperator : public StaggeredStokesFACPreconditionerStrategy
 {
@@ -145,11 +155,20 @@ private:
     StaggeredStokesBoxRelaxationFACOperator& operator=(const StaggeredStokesBoxRelaxationFACOperator& that) = delete;
 
     /*
-     * Box operator data.
+     * Whether to relax the cells of each patch in multicolor order.
+     */
+    bool d_use_multicolor_ordering = false;
+
+    /*
+     * Inverse of the box operator on each level, stored in row-major order.
+     */
+    std::vector<std::vector<double> > d_box_op_inv;
+
+    /*
+     * Cells of each local patch sorted by color. Only used with the multicolor
+     * ordering.
      */
-    std::vector<Mat> d_box_op;
-    std::vector<Vec> d_box_e, d_box_r;
-    std::vector<KSP> d_box_ksp;
+    std::vector<std::vector<std::vector<std::vector<SAMRAI::hier::Index<NDIM> > > > > d_patch_colored_cells;
 
     /*
      * Mappings from patch indices to patch operators.
@@ -23,6 +23,7 @@
 #include "ibtk/IBTK_CHKERRQ.h"
 #include "ibtk/IBTK_MPI.h"
 #include "ibtk/LibMeshSystemVectors.h"
+#include "ibtk/TensorProductLagrangeFE.h"
 #include "ibtk/ibtk_utilities.h"
 #include "ibtk/libmesh_utilities.h"
 
@@ -68,8 +69,11 @@
 #include "libmesh/variant_filter_iterator.h"
 #include "libmesh/vector_value.h"
 
+#include <algorithm>
 #include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "ibamr/namespaces.h" // IWYU pragma: keep
 
@@ -84,6 +88,10 @@ namespace
 // Version of FEMechanicsBase restart file data.
 const int FE_MECHANICS_BASE_VERSION = 1;
 
+// Number of elements whose quadrature point data are passed to a batched PK1
+// stress function at once.
+const std::size_t PK1_STRESS_BATCH_SIZE = 64;
+
 inline boundary_id_type
 get_dirichlet_bdry_ids(const std::vector<boundary_id_type>& bdry_ids)
 {
@@ -188,6 +196,81 @@ get_Grad_U(libMesh::TensorValue<double>& Grad_U,
         }
     }
 }
+
+// Reorder an array storing the components of some quantity point by point
+// into one storing the values at all points component by component.
+inline void
+transpose_point_data(std::vector<double>& data, const unsigned int n_points, std::vector<double>& scratch)
+{
+    if (n_points == 0) return;
+    const std::size_t n_comps = data.size() / n_points;
+    scratch.resize(data.size());
+    for (unsigned int p = 0; p < n_points; ++p)
+    {
+        for (std::size_t c = 0; c < n_comps; ++c)
+        {
+            scratch[c * n_points + p] = data[p * n_comps + c];
+        }
+    }
+    data.swap(scratch);
+}
+
+// Evaluate a batched PK1 stress function at a single point. This is the
+// per-point PK1 stress function registered for PK1 stress functions that only
+// provide a batched implementation.
+void
+evaluate_batched_PK1_stress_fcn(TensorValue<double>& PP,
+                                const TensorValue<double>& FF,
+                                const libMesh::Point& x,
+                                const libMesh::Point& X,
+                                Elem* const elem,
+                                const std::vector<const std::vector<double>*>& var_data,
+                                const std::vector<const std::vector<VectorValue<double> >*>& grad_var_data,
+                                const double data_time,
+                                void* const ctx)
+{
+    const auto& fcn_data = *static_cast<const FEMechanicsBase::PK1StressFcnData*>(ctx);
+    FEMechanicsBase::PK1StressBatch batch;
+    batch.n_points = 1;
+    batch.FF.resize(NDIM * NDIM);
+    batch.x.resize(NDIM);
+    batch.X.resize(NDIM);
+    for (unsigned int i = 0; i < NDIM; ++i)
+    {
+        batch.x[i] = x(i);
+        batch.X[i] = X(i);
+        for (unsigned int j = 0; j < NDIM; ++j)
+        {
+            batch.FF[i * NDIM + j] = FF(i, j);
+        }
+    }
+    batch.var_data.resize(var_data.size());
+    for (std::size_t s = 0; s < var_data.size(); ++s)
+    {
+        batch.var_data[s] = *var_data[s];
+    }
+    batch.grad_var_data.resize(grad_var_data.size());
+    for (std::size_t s = 0; s < grad_var_data.size(); ++s)
+    {
+        for (const VectorValue<double>& grad_var : *grad_var_data[s])
+        {
+            for (unsigned int d = 0; d < NDIM; ++d) batch.grad_var_data[s].push_back(grad_var(d));
+        }
+    }
+    batch.elems.push_back(elem);
+    batch.elem_offsets = { 0, 1 };
+    batch.PP.resize(NDIM * NDIM);
+    fcn_data.batched_fcn(batch, data_time, fcn_data.batched_ctx);
+    PP.zero();
+    for (unsigned int i = 0; i < NDIM; ++i)
+    {
+        for (unsigned int j = 0; j < NDIM; ++j)
+        {
+            PP(i, j) = batch.PP[i * NDIM + j];
+        }
+    }
+    return;
+} // evaluate_batched_PK1_stress_fcn
 } // namespace
 
 const std::string FEMechanicsBase::COORDS_SYSTEM_NAME = "IB coordinates system";
@@ -286,6 +369,16 @@ FEMechanicsBase::registerPK1StressFunction(const PK1StressFcnData& data, const u
     {
         d_PK1_stress_fcn_data[part].back().quad_order = d_default_quad_order_stress[part];
     }
+
+    // Stresses are also evaluated at individual points (e.g., on element
+    // boundaries), so supply a per-point function if only a batched one was
+    // provided.
+    if (data.batched_fcn && !data.fcn)
+    {
+        d_batched_PK1_stress_fcn_data.emplace_back(new PK1StressFcnData(d_PK1_stress_fcn_data[part].back()));
+        d_PK1_stress_fcn_data[part].back().fcn = evaluate_batched_PK1_stress_fcn;
+        d_PK1_stress_fcn_data[part].back().ctx = d_batched_PK1_stress_fcn_data.back().get();
+    }
 }
 
 std::vector<FEMechanicsBase::PK1StressFcnData>
@@ -944,127 +1037,355 @@ FEMechanicsBase::assembleInteriorForceDensityRHS(PetscVector<double>& F_rhs_vec,
         //
         // This right-hand side vector is used to solve for the nodal values of
         // the interior elastic force density.
+        //
+        // Batched PK1 stress functions are evaluated at the interior
+        // quadrature points of PK1_STRESS_BATCH_SIZE elements at once. The
+        // values of dphi * JxW of the elements in the batch are stored so
+        // that the interior forces can be computed after the stress function
+        // returns.
+        const PK1StressFcnData& fcn_data = d_PK1_stress_fcn_data[part][k];
+        const bool use_batched_fcn = fcn_data.batched_fcn != nullptr;
+        PK1StressBatch batch;
+        std::vector<double> dphi_JxW, transpose_scratch;
+        std::vector<std::size_t> dphi_JxW_offsets;
         TensorValue<double> PP, FF, FF_inv_trans;
         VectorValue<double> F, F_qp, n, x;
-        const MeshBase::const_element_iterator el_begin = mesh.active_local_elements_begin();
-        const MeshBase::const_element_iterator el_end = mesh.active_local_elements_end();
-        for (MeshBase::const_element_iterator el_it = el_begin; el_it != el_end; ++el_it)
+        const std::vector<Elem*> local_elems(mesh.active_local_elements_begin(), mesh.active_local_elements_end());
+        const std::size_t batch_size = use_batched_fcn ? PK1_STRESS_BATCH_SIZE : 1;
+
+        // Per-point PK1 stress functions which do not require any additional
+        // system data are evaluated by sum factorization if all of the local
+        // elements are tensor-product elements of the same type and the
+        // quadrature rule is a tensor-product Gauss rule. In that case the
+        // interior forces are computed without tabulating the shape functions
+        // on each element.
+        const FEType X_fe_type = X_system.get_dof_map().variable_type(0);
+        bool use_sum_factorization = d_use_sum_factorization && !use_batched_fcn && fcn_data.system_data.empty() &&
+                                     dim == NDIM && X_fe_type == F_fe_type && !local_elems.empty() &&
+                                     TensorProductLagrangeFE::isSupported(
+                                         local_elems.front()->type(), F_fe_type, fcn_data.quad_type);
+        for (const Elem* const elem : local_elems)
         {
-            Elem* const elem = *el_it;
-            const auto& F_dof_indices = F_dof_map_cache.dof_indices(elem);
-            for (unsigned int d = 0; d < NDIM; ++d)
-            {
-                F_rhs_e[d].resize(static_cast<int>(F_dof_indices[d].size()));
-            }
-            fe.reinit(elem);
-            fe.collectDataForInterpolation(elem);
-            fe.interpolate(elem);
-            const unsigned int n_qp = qrule->n_points();
-            const size_t n_basis = dphi.size();
-            for (unsigned int qp = 0; qp < n_qp; ++qp)
+            if (!use_sum_factorization) break;
+            use_sum_factorization = elem->type() == local_elems.front()->type() && elem->p_level() == 0;
+        }
+        std::unique_ptr<TensorProductLagrangeFE> tp_fe;
+        FEDataManager::SystemDofMapCache& X_dof_map_cache = *d_fe_data[part]->getDofMapCache(COORDS_SYSTEM_NAME);
+        boost::multi_array<double, 2> x_node;
+        std::vector<double> tp_nodal_values, tp_x_qp, tp_X_qp, tp_grad_x_qp, tp_grad_X_qp, tp_flux_qp;
+        if (use_sum_factorization)
+        {
+            tp_fe.reset(new TensorProductLagrangeFE(local_elems.front()->type(), fcn_data.quad_order));
+            const unsigned int n_qp = tp_fe->getNumberOfQuadraturePoints();
+            tp_nodal_values.resize(tp_fe->getNumberOfNodes());
+            tp_x_qp.resize(NDIM * n_qp);
+            tp_X_qp.resize(NDIM * n_qp);
+            tp_grad_x_qp.resize(NDIM * NDIM * n_qp);
+            tp_grad_X_qp.resize(NDIM * NDIM * n_qp);
+            tp_flux_qp.resize(NDIM * NDIM * n_qp);
+        }
+        for (std::size_t batch_begin = 0; batch_begin < local_elems.size(); batch_begin += batch_size)
+        {
+            const std::size_t batch_end = std::min(batch_begin + batch_size, local_elems.size());
+            if (use_batched_fcn)
             {
-                const libMesh::Point& X = q_point[qp];
-                const std::vector<double>& x_data = fe_interp_var_data[qp][X_sys_idx];
-                const std::vector<VectorValue<double> >& grad_x_data = fe_interp_grad_var_data[qp][X_sys_idx];
-                get_x_and_FF(x, FF, x_data, grad_x_data);
-
-                // Compute the value of the first Piola-Kirchhoff stress tensor
-                // at the quadrature point and add the corresponding forces to
-                // the right-hand-side vector.
-                fe.setInterpolatedDataPointers(PK1_var_data, PK1_grad_var_data, PK1_fcn_system_idxs, elem, qp);
-                d_PK1_stress_fcn_data[part][k].fcn(
-                    PP, FF, x, X, elem, PK1_var_data, PK1_grad_var_data, data_time, d_PK1_stress_fcn_data[part][k].ctx);
-                for (unsigned int basis_n = 0; basis_n < n_basis; ++basis_n)
+                // Collect the data at the interior quadrature points of the
+                // elements in the batch point by point and then reorder it
+                // component by component.
+                batch.n_points = 0;
+                batch.FF.clear();
+                batch.x.clear();
+                batch.X.clear();
+                batch.var_data.assign(PK1_fcn_system_idxs.size(), std::vector<double>());
+                batch.grad_var_data.assign(PK1_fcn_system_idxs.size(), std::vector<double>());
+                batch.elems.assign(local_elems.begin() + batch_begin, local_elems.begin() + batch_end);
+                batch.elem_offsets.assign(1, 0);
+                dphi_JxW.clear();
+                dphi_JxW_offsets.assign(1, 0);
+                for (Elem* const elem : batch.elems)
                 {
-                    F_qp = -PP * dphi[basis_n][qp] * JxW[qp];
-                    for (unsigned int i = 0; i < NDIM; ++i)
+                    fe.reinit(elem);
+                    fe.collectDataForInterpolation(elem);
+                    fe.interpolate(elem);
+                    const unsigned int n_qp = qrule->n_points();
+                    const size_t n_basis = dphi.size();
+                    for (unsigned int qp = 0; qp < n_qp; ++qp)
                     {
-                        F_rhs_e[i](basis_n) += F_qp(i);
+                        const libMesh::Point& X = q_point[qp];
+                        const std::vector<double>& x_data = fe_interp_var_data[qp][X_sys_idx];
+                        const std::vector<VectorValue<double> >& grad_x_data = fe_interp_grad_var_data[qp][X_sys_idx];
+                        for (unsigned int i = 0; i < NDIM; ++i)
+                        {
+                            batch.x.push_back(x_data[i]);
+                            batch.X.push_back(X(i));
+                            for (unsigned int j = 0; j < NDIM; ++j) batch.FF.push_back(grad_x_data[i](j));
+                        }
+                        fe.setInterpolatedDataPointers(PK1_var_data, PK1_grad_var_data, PK1_fcn_system_idxs, elem, qp);
+                        for (std::size_t s = 0; s < PK1_var_data.size(); ++s)
+                        {
+                            batch.var_data[s].insert(
+                                batch.var_data[s].end(), PK1_var_data[s]->begin(), PK1_var_data[s]->end());
+                            for (const VectorValue<double>& grad_var : *PK1_grad_var_data[s])
+                            {
+                                for (unsigned int d = 0; d < NDIM; ++d) batch.grad_var_data[s].push_back(grad_var(d));
+                            }
+                        }
                     }
+                    for (unsigned int basis_n = 0; basis_n < n_basis; ++basis_n)
+                    {
+                        for (unsigned int qp = 0; qp < n_qp; ++qp)
+                        {
+                            for (unsigned int j = 0; j < NDIM; ++j)
+                            {
+                                dphi_JxW.push_back(dphi[basis_n][qp](j) * JxW[qp]);
+                            }
+                        }
+                    }
+                    batch.n_points += n_qp;
+                    batch.elem_offsets.push_back(batch.n_points);
+                    dphi_JxW_offsets.push_back(dphi_JxW.size());
+                }
+                transpose_point_data(batch.FF, batch.n_points, transpose_scratch);
+                transpose_point_data(batch.x, batch.n_points, transpose_scratch);
+                transpose_point_data(batch.X, batch.n_points, transpose_scratch);
+                for (std::vector<double>& var_data : batch.var_data)
+                {
+                    transpose_point_data(var_data, batch.n_points, transpose_scratch);
+                }
+                for (std::vector<double>& grad_var_data : batch.grad_var_data)
+                {
+                    transpose_point_data(grad_var_data, batch.n_points, transpose_scratch);
                 }
+
+                // Compute the values of the first Piola-Kirchhoff stress
+                // tensor at all points of the batch.
+                batch.PP.assign(NDIM * NDIM * batch.n_points, 0.0);
+                fcn_data.batched_fcn(batch, data_time, fcn_data.batched_ctx);
             }
 
-            // Loop over the element boundaries.
-            for (unsigned int side = 0; side < elem->n_sides(); ++side)
+            for (std::size_t e = batch_begin; e < batch_end; ++e)
             {
-                // Skip non-physical boundaries.
-                if (!is_physical_bdry(elem, side, boundary_info, F_dof_map)) continue;
-
-                // Determine if we need to integrate surface forces along this
-                // part of the physical boundary; if not, skip the present side.
-                const bool at_dirichlet_bdry = is_dirichlet_bdry(elem, side, boundary_info, F_dof_map);
-                const bool integrate_normal_stress = (d_include_normal_stress_in_weak_form && !at_dirichlet_bdry) ||
-                                                     (!d_include_normal_stress_in_weak_form && at_dirichlet_bdry);
-                const bool integrate_tangential_stress =
-                    (d_include_tangential_stress_in_weak_form && !at_dirichlet_bdry) ||
-                    (!d_include_tangential_stress_in_weak_form && at_dirichlet_bdry);
-                if (!integrate_normal_stress && !integrate_tangential_stress) continue;
-
-                fe.reinit(elem, side);
-                fe.interpolate(elem, side);
-                const unsigned int n_qp_face = qrule_face->n_points();
-                const size_t n_basis_face = phi_face.size();
-                for (unsigned int qp = 0; qp < n_qp_face; ++qp)
+                Elem* const elem = local_elems[e];
+                const auto& F_dof_indices = F_dof_map_cache.dof_indices(elem);
+                for (unsigned int d = 0; d < NDIM; ++d)
                 {
-                    const libMesh::Point& X = q_point_face[qp];
-                    const std::vector<double>& x_data = fe_interp_var_data[qp][X_sys_idx];
-                    const std::vector<VectorValue<double> >& grad_x_data = fe_interp_grad_var_data[qp][X_sys_idx];
-                    get_x_and_FF(x, FF, x_data, grad_x_data);
-                    tensor_inverse_transpose(FF_inv_trans, FF, NDIM);
-
-                    F.zero();
+                    F_rhs_e[d].resize(static_cast<int>(F_dof_indices[d].size()));
+                }
+                if (use_batched_fcn)
+                {
+                    // Add the forces corresponding to the stresses computed by
+                    // the batched function to the right-hand-side vector.
+                    const std::size_t batch_e = e - batch_begin;
+                    const unsigned int qp_offset = batch.elem_offsets[batch_e];
+                    const unsigned int n_qp = batch.elem_offsets[batch_e + 1] - qp_offset;
+                    const double* const elem_dphi_JxW = dphi_JxW.data() + dphi_JxW_offsets[batch_e];
+                    const size_t n_basis =
+                        n_qp == 0 ? 0 : (dphi_JxW_offsets[batch_e + 1] - dphi_JxW_offsets[batch_e]) / (n_qp * NDIM);
+                    for (unsigned int basis_n = 0; basis_n < n_basis; ++basis_n)
+                    {
+                        for (unsigned int qp = 0; qp < n_qp; ++qp)
+                        {
+                            const double* const dphi_JxW_qp = elem_dphi_JxW + (basis_n * n_qp + qp) * NDIM;
+                            for (unsigned int i = 0; i < NDIM; ++i)
+                            {
+                                double PP_dphi_JxW = 0.0;
+                                for (unsigned int j = 0; j < NDIM; ++j)
+                                {
+                                    PP_dphi_JxW += batch.PP[(i * NDIM + j) * batch.n_points + qp_offset + qp] *
+                                                   dphi_JxW_qp[j];
+                                }
+                                F_rhs_e[i](basis_n) -= PP_dphi_JxW;
+                            }
+                        }
+                    }
+                }
+                else if (use_sum_factorization)
+                {
+                    // Compute the current and reference positions and their
+                    // gradients with respect to the reference element
+                    // coordinates at the quadrature points.
+                    const auto& X_dof_indices = X_dof_map_cache.dof_indices(elem);
+                    get_values_for_interpolation(x_node, X_vec, X_dof_indices);
+                    const unsigned int n_nodes = tp_fe->getNumberOfNodes();
+                    const unsigned int n_qp = tp_fe->getNumberOfQuadraturePoints();
+                    TBOX_ASSERT(x_node.shape()[0] == n_nodes);
+                    for (unsigned int d = 0; d < NDIM; ++d)
+                    {
+                        for (unsigned int node_n = 0; node_n < n_nodes; ++node_n)
+                        {
+                            tp_nodal_values[node_n] = x_node[node_n][d];
+                        }
+                        tp_fe->interpolate(tp_nodal_values.data(), &tp_x_qp[d * n_qp]);
+                        tp_fe->interpolateGradient(tp_nodal_values.data(), &tp_grad_x_qp[d * NDIM * n_qp]);
+                        for (unsigned int node_n = 0; node_n < n_nodes; ++node_n)
+                        {
+                            tp_nodal_values[node_n] = elem->point(node_n)(d);
+                        }
+                        tp_fe->interpolate(tp_nodal_values.data(), &tp_X_qp[d * n_qp]);
+                        tp_fe->interpolateGradient(tp_nodal_values.data(), &tp_grad_X_qp[d * NDIM * n_qp]);
+                    }
 
                     // Compute the value of the first Piola-Kirchhoff stress
-                    // tensor at the quadrature point and add the corresponding
-                    // traction force to the right-hand-side vector.
-                    if (d_PK1_stress_fcn_data[part][k].fcn)
+                    // tensor at each quadrature point and the corresponding
+                    // fluxes -PP * dX/ds^{-T} * JxW against the gradients of
+                    // the shape functions on the reference element.
+                    const std::vector<double>& weights = tp_fe->getQuadratureWeights();
+                    TensorValue<double> grad_x, grad_X, grad_X_inv_trans, flux;
+                    libMesh::Point X;
+                    for (unsigned int qp = 0; qp < n_qp; ++qp)
                     {
-                        fe.setInterpolatedDataPointers(PK1_var_data, PK1_grad_var_data, PK1_fcn_system_idxs, elem, qp);
-                        d_PK1_stress_fcn_data[part][k].fcn(PP,
-                                                           FF,
-                                                           x,
-                                                           X,
-                                                           elem,
-                                                           PK1_var_data,
-                                                           PK1_grad_var_data,
-                                                           data_time,
-                                                           d_PK1_stress_fcn_data[part][k].ctx);
-                        F += PP * normal_face[qp];
+                        grad_x.zero();
+                        grad_X.zero();
+                        x.zero();
+                        X.zero();
+                        for (unsigned int i = 0; i < NDIM; ++i)
+                        {
+                            x(i) = tp_x_qp[i * n_qp + qp];
+                            X(i) = tp_X_qp[i * n_qp + qp];
+                            for (unsigned int j = 0; j < NDIM; ++j)
+                            {
+                                grad_x(i, j) = tp_grad_x_qp[(i * n_qp + qp) * NDIM + j];
+                                grad_X(i, j) = tp_grad_X_qp[(i * n_qp + qp) * NDIM + j];
+                            }
+                        }
+                        for (unsigned int i = NDIM; i < LIBMESH_DIM; ++i)
+                        {
+                            grad_x(i, i) = 1.0;
+                            grad_X(i, i) = 1.0;
+                        }
+                        const double JxW_qp = grad_X.det() * weights[qp];
+                        tensor_inverse_transpose(grad_X_inv_trans, grad_X, NDIM);
+                        FF = grad_x * grad_X_inv_trans.transpose();
+                        fcn_data.fcn(PP, FF, x, X, elem, PK1_var_data, PK1_grad_var_data, data_time, fcn_data.ctx);
+                        flux = -JxW_qp * (PP * grad_X_inv_trans);
+                        for (unsigned int i = 0; i < NDIM; ++i)
+                        {
+                            for (unsigned int j = 0; j < NDIM; ++j)
+                            {
+                                tp_flux_qp[(i * n_qp + qp) * NDIM + j] = flux(i, j);
+                            }
+                        }
                     }
-
-                    n = (FF_inv_trans * normal_face[qp]).unit();
-
-                    if (!integrate_normal_stress)
+                    for (unsigned int i = 0; i < NDIM; ++i)
                     {
-                        F -= (F * n) * n; // remove the normal component.
+                        TBOX_ASSERT(static_cast<unsigned int>(F_rhs_e[i].size()) == n_nodes);
+                        tp_fe->integrateGradient(&tp_flux_qp[i * NDIM * n_qp], F_rhs_e[i].get_values().data());
                     }
-
-                    if (!integrate_tangential_stress)
+                }
+                else
+                {
+                    fe.reinit(elem);
+                    fe.collectDataForInterpolation(elem);
+                    fe.interpolate(elem);
+                    const unsigned int n_qp = qrule->n_points();
+                    const size_t n_basis = dphi.size();
+                    for (unsigned int qp = 0; qp < n_qp; ++qp)
                     {
-                        F -= (F - (F * n) * n); // remove the tangential component.
+                        const libMesh::Point& X = q_point[qp];
+                        const std::vector<double>& x_data = fe_interp_var_data[qp][X_sys_idx];
+                        const std::vector<VectorValue<double> >& grad_x_data = fe_interp_grad_var_data[qp][X_sys_idx];
+                        get_x_and_FF(x, FF, x_data, grad_x_data);
+
+                        // Compute the value of the first Piola-Kirchhoff stress
+                        // tensor at the quadrature point and add the
+                        // corresponding forces to the right-hand-side vector.
+                        fe.setInterpolatedDataPointers(PK1_var_data, PK1_grad_var_data, PK1_fcn_system_idxs, elem, qp);
+                        fcn_data.fcn(PP, FF, x, X, elem, PK1_var_data, PK1_grad_var_data, data_time, fcn_data.ctx);
+                        for (unsigned int basis_n = 0; basis_n < n_basis; ++basis_n)
+                        {
+                            F_qp = -PP * dphi[basis_n][qp] * JxW[qp];
+                            for (unsigned int i = 0; i < NDIM; ++i)
+                            {
+                                F_rhs_e[i](basis_n) += F_qp(i);
+                            }
+                        }
                     }
+                }
 
-                    // Add the boundary forces to the right-hand-side vector.
-                    for (unsigned int basis_face_n = 0; basis_face_n < n_basis_face; ++basis_face_n)
+                // Loop over the element boundaries. Unless the interior
+                // forces were computed above with the FEDataInterpolation
+                // object, the element data has not been collected yet.
+                bool elem_data_collected = !use_batched_fcn && !use_sum_factorization;
+                for (unsigned int side = 0; side < elem->n_sides(); ++side)
+                {
+                    // Skip non-physical boundaries.
+                    if (!is_physical_bdry(elem, side, boundary_info, F_dof_map)) continue;
+
+                    // Determine if we need to integrate surface forces along this
+                    // part of the physical boundary; if not, skip the present side.
+                    const bool at_dirichlet_bdry = is_dirichlet_bdry(elem, side, boundary_info, F_dof_map);
+                    const bool integrate_normal_stress = (d_include_normal_stress_in_weak_form && !at_dirichlet_bdry) ||
+                                                         (!d_include_normal_stress_in_weak_form && at_dirichlet_bdry);
+                    const bool integrate_tangential_stress =
+                        (d_include_tangential_stress_in_weak_form && !at_dirichlet_bdry) ||
+                        (!d_include_tangential_stress_in_weak_form && at_dirichlet_bdry);
+                    if (!integrate_normal_stress && !integrate_tangential_stress) continue;
+
+                    if (!elem_data_collected)
                     {
-                        F_qp = F * phi_face[basis_face_n][qp] * JxW_face[qp];
-                        for (unsigned int i = 0; i < NDIM; ++i)
+                        fe.collectDataForInterpolation(elem);
+                        elem_data_collected = true;
+                    }
+                    fe.reinit(elem, side);
+                    fe.interpolate(elem, side);
+                    const unsigned int n_qp_face = qrule_face->n_points();
+                    const size_t n_basis_face = phi_face.size();
+                    for (unsigned int qp = 0; qp < n_qp_face; ++qp)
+                    {
+                        const libMesh::Point& X = q_point_face[qp];
+                        const std::vector<double>& x_data = fe_interp_var_data[qp][X_sys_idx];
+                        const std::vector<VectorValue<double> >& grad_x_data = fe_interp_grad_var_data[qp][X_sys_idx];
+                        get_x_and_FF(x, FF, x_data, grad_x_data);
+                        tensor_inverse_transpose(FF_inv_trans, FF, NDIM);
+
+                        F.zero();
+
+                        // Compute the value of the first Piola-Kirchhoff stress
+                        // tensor at the quadrature point and add the corresponding
+                        // traction force to the right-hand-side vector.
+                        if (fcn_data.fcn)
+                        {
+                            fe.setInterpolatedDataPointers(
+                                PK1_var_data, PK1_grad_var_data, PK1_fcn_system_idxs, elem, qp);
+                            fcn_data.fcn(
+                                PP, FF, x, X, elem, PK1_var_data, PK1_grad_var_data, data_time, fcn_data.ctx);
+                            F += PP * normal_face[qp];
+                        }
+
+                        n = (FF_inv_trans * normal_face[qp]).unit();
+
+                        if (!integrate_normal_stress)
+                        {
+                            F -= (F * n) * n; // remove the normal component.
+                        }
+
+                        if (!integrate_tangential_stress)
                         {
-                            F_rhs_e[i](basis_face_n) += F_qp(i);
+                            F -= (F - (F * n) * n); // remove the tangential component.
+                        }
+
+                        // Add the boundary forces to the right-hand-side vector.
+                        for (unsigned int basis_face_n = 0; basis_face_n < n_basis_face; ++basis_face_n)
+                        {
+                            F_qp = F * phi_face[basis_face_n][qp] * JxW_face[qp];
+                            for (unsigned int i = 0; i < NDIM; ++i)
+                            {
+                                F_rhs_e[i](basis_face_n) += F_qp(i);
+                            }
                         }
                     }
                 }
-            }
 
-            // Apply constraints (e.g., enforce periodic boundary conditions)
-            // and add the elemental contributions to the global vector.
-            for (unsigned int var_n = 0; var_n < NDIM; ++var_n)
-            {
-                copy_dof_ids_to_vector(var_n, F_dof_indices, dof_id_scratch);
-                F_dof_map.constrain_element_vector(F_rhs_e[var_n], dof_id_scratch);
-                for (unsigned int j = 0; j < dof_id_scratch.size(); ++j)
+                // Apply constraints (e.g., enforce periodic boundary conditions)
+                // and add the elemental contributions to the global vector.
+                for (unsigned int var_n = 0; var_n < NDIM; ++var_n)
                 {
-                    F_rhs_local_soln[F_rhs_vec.map_global_to_local_index(dof_id_scratch[j])] += F_rhs_e[var_n](j);
+                    copy_dof_ids_to_vector(var_n, F_dof_indices, dof_id_scratch);
+                    F_dof_map.constrain_element_vector(F_rhs_e[var_n], dof_id_scratch);
+                    for (unsigned int j = 0; j < dof_id_scratch.size(); ++j)
+                    {
+                        F_rhs_local_soln[F_rhs_vec.map_global_to_local_index(dof_id_scratch[j])] += F_rhs_e[var_n](j);
+                    }
                 }
             }
         }
@@ -1632,6 +1953,7 @@ FEMechanicsBase::getFromInput(const Pointer<Database>& db, bool /*is_from_restar
         d_use_consistent_mass_matrix = db->getBool("use_consistent_mass_matrix");
     if (db->isBool("allow_rules_with_negative_weights"))
         d_allow_rules_with_negative_weights = db->getBool("allow_rules_with_negative_weights");
+    if (db->isBool("use_sum_factorization")) d_use_sum_factorization = db->getBool("use_sum_factorization");
 
     // Pressure settings.
     if (db->isDouble("static_pressure_kappa")) d_static_pressure_kappa = db->getDouble("static_pressure_kappa");
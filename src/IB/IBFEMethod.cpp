@@ -131,6 +131,7 @@ IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <limits>
@@ -687,22 +688,62 @@ IBFEMethod::interpolateVelocity(const int u_data_idx,
     std::vector<PetscVector<double>*> U_rhs_vecs = d_U_IB_vecs->getIBGhosted("tmp");
     std::vector<PetscVector<double>*> X_IB_ghost_vecs = d_X_IB_vecs->getIBGhosted("tmp");
     batch_vec_copy(X_vecs, X_IB_ghost_vecs);
-    batch_vec_ghost_update(X_IB_ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
 
     // Build the right-hand-sides to compute the interpolated data.
     std::vector<Pointer<RefineSchedule<NDIM> > > no_fill(u_ghost_fill_scheds.size());
-    for (unsigned int part = 0; part < d_meshes.size(); ++part)
+    if (d_overlap_ghost_communication)
     {
-        if (d_part_is_active[part])
+        // Work on the elements that only need locally owned positions while
+        // the ghost values are communicated.
+        batch_vec_ghost_update_begin(X_IB_ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
+        for (unsigned int part = 0; part < d_meshes.size(); ++part)
+        {
+            if (!d_part_is_active[part]) continue;
+            FEDataManager* const fe_data_manager = d_active_fe_data_managers[part];
+            fe_data_manager->interpWeighted(u_data_idx,
+                                            *U_rhs_vecs[part],
+                                            *X_IB_ghost_vecs[part],
+                                            VELOCITY_SYSTEM_NAME,
+                                            fe_data_manager->getDefaultInterpSpec(),
+                                            no_fill,
+                                            data_time,
+                                            /*close_F*/ false,
+                                            /*close_X*/ false,
+                                            FEDataManager::PROCESSOR_INTERIOR_ELEMS);
+        }
+        batch_vec_ghost_update_end(X_IB_ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
+        for (unsigned int part = 0; part < d_meshes.size(); ++part)
         {
-            d_active_fe_data_managers[part]->interpWeighted(u_data_idx,
-                                                            *U_rhs_vecs[part],
-                                                            *X_IB_ghost_vecs[part],
-                                                            VELOCITY_SYSTEM_NAME,
-                                                            no_fill,
-                                                            data_time,
-                                                            /*close_F*/ false,
-                                                            /*close_X*/ false);
+            if (!d_part_is_active[part]) continue;
+            FEDataManager* const fe_data_manager = d_active_fe_data_managers[part];
+            fe_data_manager->interpWeighted(u_data_idx,
+                                            *U_rhs_vecs[part],
+                                            *X_IB_ghost_vecs[part],
+                                            VELOCITY_SYSTEM_NAME,
+                                            fe_data_manager->getDefaultInterpSpec(),
+                                            no_fill,
+                                            data_time,
+                                            /*close_F*/ false,
+                                            /*close_X*/ false,
+                                            FEDataManager::PROCESSOR_BOUNDARY_ELEMS);
+        }
+    }
+    else
+    {
+        batch_vec_ghost_update(X_IB_ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
+        for (unsigned int part = 0; part < d_meshes.size(); ++part)
+        {
+            if (d_part_is_active[part])
+            {
+                d_active_fe_data_managers[part]->interpWeighted(u_data_idx,
+                                                                *U_rhs_vecs[part],
+                                                                *X_IB_ghost_vecs[part],
+                                                                VELOCITY_SYSTEM_NAME,
+                                                                no_fill,
+                                                                data_time,
+                                                                /*close_F*/ false,
+                                                                /*close_X*/ false);
+            }
         }
     }
 
@@ -941,7 +982,11 @@ IBFEMethod::spreadForce(const int f_data_idx,
     std::vector<PetscVector<double>*> F_IB_ghost_vecs = d_F_IB_vecs->getIBGhosted("tmp");
     batch_vec_copy({ d_X_vecs->get(data_time_str), d_F_vecs->get(data_time_str) },
                    { X_IB_ghost_vecs, F_IB_ghost_vecs });
-    batch_vec_ghost_update({ X_IB_ghost_vecs, F_IB_ghost_vecs }, INSERT_VALUES, SCATTER_FORWARD);
+    const std::vector<std::vector<PetscVector<double>*> > ghost_vecs = { X_IB_ghost_vecs, F_IB_ghost_vecs };
+    if (d_overlap_ghost_communication)
+        batch_vec_ghost_update_begin(ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
+    else
+        batch_vec_ghost_update(ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
 
     // set up a new data index for computing forces on the active hierarchy.
     Pointer<PatchHierarchy<NDIM> > hierarchy = d_use_scratch_hierarchy ? d_scratch_hierarchy : d_hierarchy;
@@ -960,13 +1005,37 @@ IBFEMethod::spreadForce(const int f_data_idx,
                                    0.0,
                                    /*interior_only*/ false);
 
-    // Spread interior force density values.
+    // Spread interior force density values. If the ghost values are still
+    // being communicated then first spread from the elements which do not
+    // need them.
+    if (d_overlap_ghost_communication)
+    {
+        for (unsigned int part = 0; part < d_meshes.size(); ++part)
+        {
+            if (!d_part_is_active[part]) continue;
+            FEDataManager* const fe_data_manager = d_active_fe_data_managers[part];
+            fe_data_manager->spread(f_scratch_data_idx,
+                                    *F_IB_ghost_vecs[part],
+                                    *X_IB_ghost_vecs[part],
+                                    FORCE_SYSTEM_NAME,
+                                    fe_data_manager->getDefaultSpreadSpec(),
+                                    FEDataManager::PROCESSOR_INTERIOR_ELEMS);
+        }
+        batch_vec_ghost_update_end(ghost_vecs, INSERT_VALUES, SCATTER_FORWARD);
+    }
     for (unsigned int part = 0; part < d_meshes.size(); ++part)
     {
         if (!d_part_is_active[part]) continue;
         PetscVector<double>* X_ghost_vec = X_IB_ghost_vecs[part];
         PetscVector<double>* F_ghost_vec = F_IB_ghost_vecs[part];
-        d_active_fe_data_managers[part]->spread(f_scratch_data_idx, *F_ghost_vec, *X_ghost_vec, FORCE_SYSTEM_NAME);
+        FEDataManager* const fe_data_manager = d_active_fe_data_managers[part];
+        fe_data_manager->spread(f_scratch_data_idx,
+                                *F_ghost_vec,
+                                *X_ghost_vec,
+                                FORCE_SYSTEM_NAME,
+                                fe_data_manager->getDefaultSpreadSpec(),
+                                d_overlap_ghost_communication ? FEDataManager::PROCESSOR_BOUNDARY_ELEMS :
+                                                                FEDataManager::ALL_ELEMS);
     }
 
     // Handle any transmission conditions.
@@ -1767,6 +1836,7 @@ IBFEMethod::doInitializeFEEquationSystems()
         }
 
         d_active_fe_data_managers[part]->setLoggingEnabled(d_do_log);
+        d_active_fe_data_managers[part]->setElementSubsetsEnabled(d_overlap_ghost_communication);
         d_ghosts = IntVector<NDIM>::max(d_ghosts, d_active_fe_data_managers[part]->getGhostCellWidth());
 
         // Since the scratch and primary FEDataManagers use the same FEData
@@ -2161,6 +2231,8 @@ IBFEMethod::spreadTransmissionForceDensity(const int f_data_idx,
     VectorValue<double> F, F_s, n, x;
     double P;
     std::vector<double> T_bdry, x_bdry;
+    std::vector<Elem*> bdry_elems;
+    std::vector<unsigned int> bdry_qp_offsets;
     int local_patch_num = 0;
     for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++local_patch_num)
     {
@@ -2168,6 +2240,9 @@ IBFEMethod::spreadTransmissionForceDensity(const int f_data_idx,
         const std::vector<Elem*>& patch_elems = active_patch_element_map[local_patch_num];
         const size_t num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const auto patch_start_time = std::chrono::steady_clock::now();
+        bdry_elems.clear();
+        bdry_qp_offsets.assign(1, 0);
 
         Pointer<Patch<NDIM> > patch = level->getPatch(p());
         const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
@@ -2186,6 +2261,8 @@ IBFEMethod::spreadTransmissionForceDensity(const int f_data_idx,
             Elem* const elem = patch_elems[e_idx];
             const bool touches_physical_bdry = has_physical_bdry(elem, boundary_info, G_dof_map);
             if (!touches_physical_bdry) continue;
+            bdry_elems.push_back(elem);
+            bdry_qp_offsets.push_back(bdry_qp_offsets.back());
 
             fe.reinit(elem);
             fe.collectDataForInterpolation(elem);
@@ -2226,6 +2303,7 @@ IBFEMethod::spreadTransmissionForceDensity(const int f_data_idx,
                 fe.reinit(elem, side);
                 fe.interpolate(elem, side);
                 const unsigned int n_qp = side_quadrature.n_points();
+                bdry_qp_offsets.back() += n_qp;
                 T_bdry.resize(T_bdry.size() + NDIM * n_qp);
                 x_bdry.resize(x_bdry.size() + NDIM * n_qp);
                 for (unsigned int qp = 0; qp < n_qp; ++qp, ++qp_offset)
@@ -2339,6 +2417,13 @@ IBFEMethod::spreadTransmissionForceDensity(const int f_data_idx,
 
         FEDataManager::zeroExteriorValues(*patch_geom, x_bdry, T_bdry, NDIM);
         LEInteractor::spread(f_data, T_bdry, NDIM, x_bdry, NDIM, patch, spread_box, spread_kernel_fcn);
+
+        // Attribute the time spent on this patch to the boundary elements
+        // for workload estimates.
+        d_active_fe_data_managers[part]->addMeasuredSurfaceCost(
+            bdry_elems,
+            bdry_qp_offsets,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - patch_start_time).count());
     }
 
     return;
@@ -2453,6 +2538,8 @@ IBFEMethod::imposeJumpConditions(const int f_data_idx,
     Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_num);
     const IntVector<NDIM>& ratio = level->getRatio();
     const Pointer<CartesianGridGeometry<NDIM> > grid_geom = level->getGridGeometry();
+    std::vector<Elem*> bdry_elems;
+    std::vector<unsigned int> bdry_qp_offsets;
     int local_patch_num = 0;
     for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++local_patch_num)
     {
@@ -2460,6 +2547,9 @@ IBFEMethod::imposeJumpConditions(const int f_data_idx,
         const std::vector<Elem*>& patch_elems = active_patch_element_map[local_patch_num];
         const size_t num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const auto patch_start_time = std::chrono::steady_clock::now();
+        bdry_elems.clear();
+        bdry_qp_offsets.assign(1, 0);
 
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         Pointer<SideData<NDIM, double> > f_data = patch->getPatchData(f_data_idx);
@@ -2478,6 +2568,8 @@ IBFEMethod::imposeJumpConditions(const int f_data_idx,
             Elem* const elem = patch_elems[e_idx];
             const bool touches_physical_bdry = has_physical_bdry(elem, boundary_info, G_dof_map);
             if (!touches_physical_bdry) continue;
+            bdry_elems.push_back(elem);
+            bdry_qp_offsets.push_back(bdry_qp_offsets.back());
 
             fe.reinit(elem);
             fe.collectDataForInterpolation(elem);
@@ -2584,6 +2676,7 @@ IBFEMethod::imposeJumpConditions(const int f_data_idx,
                 fe.reinit(elem, side, TOL, &intersection_ref_coords);
                 fe.interpolate(elem, side);
                 const size_t n_qp = intersection_ref_coords.size();
+                bdry_qp_offsets.back() += n_qp;
                 for (unsigned int qp = 0; qp < n_qp; ++qp)
                 {
                     const SideIndex<NDIM>& i_s = intersection_indices[qp];
@@ -2723,6 +2816,13 @@ IBFEMethod::imposeJumpConditions(const int f_data_idx,
                 }
             }
         }
+
+        // Attribute the time spent on this patch to the boundary elements
+        // for workload estimates.
+        d_active_fe_data_managers[part]->addMeasuredSurfaceCost(
+            bdry_elems,
+            bdry_qp_offsets,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - patch_start_time).count());
     }
     return;
 } // imposeJumpConditions
@@ -3050,6 +3150,9 @@ IBFEMethod::getFromInput(const Pointer<Database>& db, bool /*is_from_restart*/)
     else if (db->isBool("IB_allow_rules_with_negative_weights"))
         d_default_spread_spec.allow_rules_with_negative_weights = db->getBool("IB_allow_rules_with_negative_weights");
 
+    if (db->isBool("overlap_ghost_communication"))
+        d_overlap_ghost_communication = db->getBool("overlap_ghost_communication");
+
     // Force computation settings.
     if (db->isBool("split_normal_force"))
         d_split_normal_force = db->getBool("split_normal_force");
@@ -3114,6 +3217,21 @@ IBFEMethod::getFromInput(const Pointer<Database>& db, bool /*is_from_restart*/)
     {
         d_default_workload_spec.duplicated_node_weight = db->getDouble("workload_duplicated_node_weight");
     }
+    if (db->isBool("workload_use_measured_costs"))
+    {
+        d_default_workload_spec.use_measured_costs = db->getBool("workload_use_measured_costs");
+    }
+    if (db->keyExists("workload_measured_cost_history_weight"))
+    {
+        d_default_workload_spec.measured_cost_history_weight = db->getDouble("workload_measured_cost_history_weight");
+        const double history_weight = d_default_workload_spec.measured_cost_history_weight;
+        if (!(history_weight >= 0.0 && history_weight <= 1.0))
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                                     << "workload_measured_cost_history_weight = " << history_weight
+                                     << " is not in [0, 1]." << std::endl);
+        }
+    }
 
     d_use_scratch_hierarchy = db->getBoolWithDefault("use_scratch_hierarchy", false);
     if (d_use_scratch_hierarchy)
@@ -16,6 +16,7 @@
 #include "ibamr/IBHierarchyIntegrator.h"
 #include "ibamr/IBImplicitStaggeredHierarchyIntegrator.h"
 #include "ibamr/IBImplicitStrategy.h"
+#include "ibamr/IBLinearizedCouplingOperator.h"
 #include "ibamr/IBStrategy.h"
 #include "ibamr/INSHierarchyIntegrator.h"
 #include "ibamr/INSStaggeredHierarchyIntegrator.h"
@@ -641,6 +642,21 @@ IBImplicitStaggeredHierarchyIntegrator::integrateHierarchy_velocity(const double
     }
     stokes_fac_op->setIBTimeSteppingType(d_time_stepping_type);
     d_ib_implicit_ops->constructLagrangianForceJacobian(elastic_op, MATAIJ, data_time);
+
+    // Setup the linearized coupling operator S*A*J used in the matrix-free
+    // Jacobian. It uses d_u_idx and d_f_idx as scratch data.
+    if (!d_coupling_op)
+    {
+        d_coupling_op = new IBLinearizedCouplingOperator(d_object_name + "::coupling_op", d_ib_implicit_ops);
+    }
+    d_coupling_op->setSolutionTime(data_time);
+    d_coupling_op->setScratchData(d_u_idx,
+                                  d_f_idx,
+                                  d_u_phys_bdry_op,
+                                  getCoarsenSchedules(d_object_name + "::u::CONSERVATIVE_COARSEN"),
+                                  getGhostfillRefineSchedules(d_object_name + "::u"),
+                                  getProlongRefineSchedules(d_object_name + "::f"));
+    d_coupling_op->initializeOperatorState(*eul_sol_vec, *eul_rhs_vec);
     stokes_fac_op->setIBForceJacobian(elastic_op);
     Mat interp_op = nullptr;
     if (d_jac_delta_fcn == "IB_4")
@@ -800,6 +816,7 @@ IBImplicitStaggeredHierarchyIntegrator::integrateHierarchy_velocity(const double
     // Deallocate solvers and operators.
     p_stokes_solver->deallocateSolverState();
     d_stokes_op->deallocateOperatorState();
+    d_coupling_op->deallocateOperatorState();
     stokes_fac_pc->deallocateSolverState();
     stokes_fac_op->deallocateOperatorState();
     ierr = MatDestroy(&elastic_op);
@@ -1244,59 +1261,28 @@ IBImplicitStaggeredHierarchyIntegrator::IBJacobianApply_position(Vec x, Vec f)
 PetscErrorCode
 IBImplicitStaggeredHierarchyIntegrator::IBJacobianApply_velocity(Vec x, Vec f)
 {
-    const double current_time = d_integrator_time;
-    const double new_time = current_time + d_current_dt;
-    const double half_time = current_time + 0.5 * d_current_dt;
-
     Pointer<SAMRAIVectorReal<NDIM, double> > u, f_u;
     IBTK::PETScSAMRAIVectorReal::getSAMRAIVectorRead(x, &u);
     IBTK::PETScSAMRAIVectorReal::getSAMRAIVector(f, &f_u);
 
-    const int u_idx = u->getComponentDescriptorIndex(0);
-    const int f_u_idx = f_u->getComponentDescriptorIndex(0);
-
     // Evaluate the Eulerian terms.
     d_stokes_op->setHomogeneousBc(true);
     d_stokes_op->apply(*u, *f_u);
 
-    // Compute position residual X = dt*kappa*J[u] = 0 - (-kappa)*dt*J[u].
-    double force_time = std::numeric_limits<double>::quiet_NaN();
-    double velocity_time = std::numeric_limits<double>::quiet_NaN();
+    // Add the linearized IB terms -kappa*S*A*X with X = dt*kappa*J[u].
     double kappa = std::numeric_limits<double>::quiet_NaN();
     switch (d_time_stepping_type)
     {
     case BACKWARD_EULER:
-        force_time = new_time;
-        velocity_time = new_time;
         kappa = 1.0;
         break;
     case TRAPEZOIDAL_RULE:
-        force_time = new_time;
-        velocity_time = new_time;
-        kappa = 0.5;
-        break;
     case MIDPOINT_RULE:
-        force_time = half_time;
-        velocity_time = half_time;
         kappa = 0.5;
         break;
     default:
         TBOX_ERROR("unsupported time stepping type\n");
     }
-    Vec X, X0;
-    d_ib_implicit_ops->createSolverVecs(&X, &X0);
-    d_ib_implicit_ops->setupSolverVecs(nullptr, &X0);
-    d_hier_velocity_data_ops->scale(d_u_idx, -kappa, u_idx);
-    d_u_phys_bdry_op->setPatchDataIndex(d_u_idx);
-    d_u_phys_bdry_op->setHomogeneousBc(true);
-    d_ib_implicit_ops->interpolateLinearizedVelocity(d_u_idx,
-                                                     getCoarsenSchedules(d_object_name + "::u::CONSERVATIVE_COARSEN"),
-                                                     getGhostfillRefineSchedules(d_object_name + "::u"),
-                                                     velocity_time);
-    d_ib_implicit_ops->computeLinearizedResidual(X0, X);
-
-    // Compute linearized force F = kappa*A*X.
-    d_ib_implicit_ops->computeLinearizedLagrangianForce(X, force_time);
     if (d_enable_logging)
     {
         plog << d_object_name
@@ -1304,12 +1290,8 @@ IBImplicitStaggeredHierarchyIntegrator::IBJacobianApply_velocity(Vec x, Vec f)
                 "Lagrangian force to the Eulerian grid\n";
         plog << "Spreading being done from " << d_object_name << "::IBJacobianApply_velocity().\n";
     }
-    d_hier_velocity_data_ops->setToScalar(d_f_idx, 0.0, /*interior_only*/ false);
-    d_u_phys_bdry_op->setPatchDataIndex(d_f_idx);
-    d_u_phys_bdry_op->setHomogeneousBc(true); // use homogeneous BCs to define spreading at physical boundaries
-    d_ib_implicit_ops->spreadLinearizedForce(
-        d_f_idx, d_u_phys_bdry_op, getProlongRefineSchedules(d_object_name + "::f"), force_time);
-    d_hier_velocity_data_ops->axpy(f_u_idx, -kappa, d_f_idx, f_u_idx);
+    d_coupling_op->setCouplingCoefficient(-d_current_dt * kappa * kappa);
+    d_coupling_op->applyAdd(*u, *f_u, *f_u);
     IBTK::PETScSAMRAIVectorReal::restoreSAMRAIVectorRead(x, &u);
     IBTK::PETScSAMRAIVectorReal::restoreSAMRAIVector(f, &f_u);
     return 0;
@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibamr/IBHierarchyIntegrator.h"
+#include "ibamr/IBImplicitStrategy.h"
+
+#include "ibtk/IBTK_CHKERRQ.h"
+#include "ibtk/RobinPhysBdryPatchStrategy.h"
+
+#include "CoarsenSchedule.h"
+#include "RefineSchedule.h"
+#include "tbox/Pointer.h"
+#include "tbox/Utilities.h"
+
+#include "petscvec.h"
+
+#include <vector>
+
+#include "ibamr/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBAMR
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+void
+IBImplicitStrategy::applyLinearizedCouplingOperator(
+    const int f_data_idx,
+    const int u_data_idx,
+    const double alpha,
+    RobinPhysBdryPatchStrategy* f_phys_bdry_op,
+    const std::vector<Pointer<CoarsenSchedule<NDIM> > >& u_synch_scheds,
+    const std::vector<Pointer<RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+    const std::vector<Pointer<RefineSchedule<NDIM> > >& f_prolongation_scheds,
+    const double data_time)
+{
+#if !defined(NDEBUG)
+    TBOX_ASSERT(d_ib_solver);
+#endif
+    int ierr;
+    const double dt = d_ib_solver->getCurrentTimeStepSize();
+
+    // J: interpolate u to the fixed coupling positions. With a zero position
+    // vector, the linearized residual is R = 0 - dt*J[u].
+    Vec X0, R;
+    createSolverVecs(&X0, &R);
+    ierr = VecSet(X0, 0.0);
+    IBTK_CHKERRQ(ierr);
+    interpolateLinearizedVelocity(u_data_idx, u_synch_scheds, u_ghost_fill_scheds, data_time);
+    computeLinearizedResidual(X0, R);
+
+    // A: compute the linearized force alpha*A*J[u] = A*(-alpha/dt*R).
+    ierr = VecScale(R, -alpha / dt);
+    IBTK_CHKERRQ(ierr);
+    computeLinearizedLagrangianForce(R, data_time);
+
+    // S: spread the force using the same fixed coupling positions.
+    if (f_phys_bdry_op) f_phys_bdry_op->setPatchDataIndex(f_data_idx);
+    spreadLinearizedForce(f_data_idx, f_phys_bdry_op, f_prolongation_scheds, data_time);
+
+    ierr = VecDestroy(&X0);
+    IBTK_CHKERRQ(ierr);
+    ierr = VecDestroy(&R);
+    IBTK_CHKERRQ(ierr);
+    return;
+} // applyLinearizedCouplingOperator
+
+/////////////////////////////// PROTECTED ////////////////////////////////////
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBAMR
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,194 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibamr/IBImplicitStrategy.h"
+#include "ibamr/IBLinearizedCouplingOperator.h"
+#include "ibamr/ibamr_utilities.h"
+
+#include "ibtk/LinearOperator.h"
+#include "ibtk/RobinPhysBdryPatchStrategy.h"
+
+#include "CoarsenSchedule.h"
+#include "HierarchyDataOpsManager.h"
+#include "HierarchyDataOpsReal.h"
+#include "RefineSchedule.h"
+#include "SAMRAIVectorReal.h"
+#include "tbox/Pointer.h"
+#include "tbox/Timer.h"
+#include "tbox/TimerManager.h"
+#include "tbox/Utilities.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ibamr/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBAMR
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// Timers.
+static Timer* t_apply;
+static Timer* t_initialize_operator_state;
+static Timer* t_deallocate_operator_state;
+} // namespace
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+IBLinearizedCouplingOperator::IBLinearizedCouplingOperator(std::string object_name,
+                                                           Pointer<IBImplicitStrategy> ib_implicit_ops)
+    : LinearOperator(std::move(object_name), /*homogeneous_bc*/ true), d_ib_implicit_ops(ib_implicit_ops)
+{
+#if !defined(NDEBUG)
+    TBOX_ASSERT(d_ib_implicit_ops);
+#endif
+
+    // Setup Timers.
+    IBAMR_DO_ONCE(t_apply = TimerManager::getManager()->getTimer("IBAMR::IBLinearizedCouplingOperator::apply()");
+                  t_initialize_operator_state = TimerManager::getManager()->getTimer(
+                      "IBAMR::IBLinearizedCouplingOperator::initializeOperatorState()");
+                  t_deallocate_operator_state = TimerManager::getManager()->getTimer(
+                      "IBAMR::IBLinearizedCouplingOperator::deallocateOperatorState()"););
+    return;
+} // IBLinearizedCouplingOperator
+
+IBLinearizedCouplingOperator::~IBLinearizedCouplingOperator()
+{
+    deallocateOperatorState();
+    return;
+} // ~IBLinearizedCouplingOperator
+
+void
+IBLinearizedCouplingOperator::setCouplingCoefficient(const double alpha)
+{
+    d_alpha = alpha;
+    return;
+} // setCouplingCoefficient
+
+void
+IBLinearizedCouplingOperator::setScratchData(const int u_scratch_idx,
+                                             const int f_scratch_idx,
+                                             RobinPhysBdryPatchStrategy* phys_bdry_op,
+                                             const std::vector<Pointer<CoarsenSchedule<NDIM> > >& u_synch_scheds,
+                                             const std::vector<Pointer<RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+                                             const std::vector<Pointer<RefineSchedule<NDIM> > >& f_prolongation_scheds)
+{
+    d_u_scratch_idx = u_scratch_idx;
+    d_f_scratch_idx = f_scratch_idx;
+    d_phys_bdry_op = phys_bdry_op;
+    d_u_synch_scheds = u_synch_scheds;
+    d_u_ghost_fill_scheds = u_ghost_fill_scheds;
+    d_f_prolongation_scheds = f_prolongation_scheds;
+    return;
+} // setScratchData
+
+void
+IBLinearizedCouplingOperator::apply(SAMRAIVectorReal<NDIM, double>& x, SAMRAIVectorReal<NDIM, double>& y)
+{
+    y.setToScalar(0.0, /*interior_only*/ false);
+    applyAdd(x, y, y);
+    return;
+} // apply
+
+void
+IBLinearizedCouplingOperator::applyAdd(SAMRAIVectorReal<NDIM, double>& x,
+                                       SAMRAIVectorReal<NDIM, double>& y,
+                                       SAMRAIVectorReal<NDIM, double>& z)
+{
+    IBAMR_TIMER_START(t_apply);
+#if !defined(NDEBUG)
+    TBOX_ASSERT(d_is_initialized);
+    TBOX_ASSERT(d_u_scratch_idx != IBTK::invalid_index && d_f_scratch_idx != IBTK::invalid_index);
+#endif
+
+    if (&y != &z) z.copyVector(Pointer<SAMRAIVectorReal<NDIM, double> >(&y, false));
+
+    // Copy the velocity into the scratch data, which has the ghost cells
+    // required by the interpolation and spreading operators, and accumulate
+    // alpha*S*A*J*x into the force scratch data.
+    const int x_idx = x.getComponentDescriptorIndex(0);
+    const int z_idx = z.getComponentDescriptorIndex(0);
+    d_hier_velocity_data_ops->copyData(d_u_scratch_idx, x_idx);
+    d_hier_velocity_data_ops->setToScalar(d_f_scratch_idx, 0.0, /*interior_only*/ false);
+    if (d_phys_bdry_op)
+    {
+        d_phys_bdry_op->setPatchDataIndex(d_u_scratch_idx);
+        d_phys_bdry_op->setHomogeneousBc(true);
+    }
+    d_ib_implicit_ops->applyLinearizedCouplingOperator(d_f_scratch_idx,
+                                                       d_u_scratch_idx,
+                                                       d_alpha,
+                                                       d_phys_bdry_op,
+                                                       d_u_synch_scheds,
+                                                       d_u_ghost_fill_scheds,
+                                                       d_f_prolongation_scheds,
+                                                       d_solution_time);
+    d_hier_velocity_data_ops->add(z_idx, z_idx, d_f_scratch_idx);
+
+    IBAMR_TIMER_STOP(t_apply);
+    return;
+} // applyAdd
+
+void
+IBLinearizedCouplingOperator::initializeOperatorState(const SAMRAIVectorReal<NDIM, double>& in,
+                                                      const SAMRAIVectorReal<NDIM, double>& /*out*/)
+{
+    IBAMR_TIMER_START(t_initialize_operator_state);
+
+    // Deallocate the operator state if the operator is already initialized.
+    if (d_is_initialized) deallocateOperatorState();
+
+    // Setup the data operations for the velocity component.
+    d_hier_velocity_data_ops = HierarchyDataOpsManager<NDIM>::getManager()->getOperationsDouble(
+        in.getComponentVariable(0), in.getPatchHierarchy(), true);
+    d_hier_velocity_data_ops->resetLevels(in.getCoarsestLevelNumber(), in.getFinestLevelNumber());
+
+    // Indicate the operator is initialized.
+    d_is_initialized = true;
+
+    IBAMR_TIMER_STOP(t_initialize_operator_state);
+    return;
+} // initializeOperatorState
+
+void
+IBLinearizedCouplingOperator::deallocateOperatorState()
+{
+    if (!d_is_initialized) return;
+
+    IBAMR_TIMER_START(t_deallocate_operator_state);
+
+    d_hier_velocity_data_ops.setNull();
+
+    // Indicate that the operator is NOT initialized.
+    d_is_initialized = false;
+
+    IBAMR_TIMER_STOP(t_deallocate_operator_state);
+    return;
+} // deallocateOperatorState
+
+/////////////////////////////// PROTECTED ////////////////////////////////////
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBAMR
+
+//////////////////////////////////////////////////////////////////////////////
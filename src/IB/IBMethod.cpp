@@ -35,6 +35,8 @@
 #include "ibtk/LNode.h"
 #include "ibtk/LSiloDataWriter.h"
 #include "ibtk/PETScMatUtilities.h"
+#include "ibtk/RobinPhysBdryPatchStrategy.h"
+#include "ibtk/ibtk_enums.h"
 #include "ibtk/ibtk_utilities.h"
 #include "ibtk/private/IndexUtilities-inl.h"
 #include "ibtk/private/LData-inl.h"
@@ -97,11 +99,6 @@ IBTK_ENABLE_EXTRA_WARNINGS
 #include <utility>
 #include <vector>
 
-namespace IBTK
-{
-class RobinPhysBdryPatchStrategy;
-} // namespace IBTK
-
 namespace SAMRAI
 {
 namespace xfer
@@ -174,6 +171,7 @@ IBMethod::IBMethod(std::string object_name, Pointer<Database> input_db, bool reg
                                                 d_ghosts,
                                                 d_registered_for_restart);
     d_ghosts = d_l_data_manager->getGhostCellWidth();
+    d_l_data_manager->setNodeOrdering(d_node_ordering);
 
     // Create the instrument panel object.
     d_instrument_panel =
@@ -1025,6 +1023,52 @@ IBMethod::spreadLinearizedForce(const int f_data_idx,
     return;
 } // spreadLinearizedForce
 
+void
+IBMethod::applyLinearizedCouplingOperator(const int f_data_idx,
+                                          const int u_data_idx,
+                                          const double alpha,
+                                          RobinPhysBdryPatchStrategy* f_phys_bdry_op,
+                                          const std::vector<Pointer<CoarsenSchedule<NDIM> > >& u_synch_scheds,
+                                          const std::vector<Pointer<RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
+                                          const std::vector<Pointer<RefineSchedule<NDIM> > >& f_prolongation_scheds,
+                                          const double data_time)
+{
+    int ierr;
+    const int finest_ln = d_hierarchy->getFinestLevelNumber();
+    std::vector<Pointer<LData> >*U_jac_data, *F_jac_data, *X_LE_data;
+    bool *F_jac_needs_ghost_fill, *X_LE_needs_ghost_fill;
+    getLinearizedVelocityData(&U_jac_data);
+    getLinearizedForceData(&F_jac_data, &F_jac_needs_ghost_fill);
+    getLECouplingPositionData(&X_LE_data, &X_LE_needs_ghost_fill, data_time);
+
+    // J: interpolate u to the fixed coupling positions.
+    d_l_data_manager->interp(u_data_idx, *U_jac_data, *X_LE_data, u_synch_scheds, u_ghost_fill_scheds, data_time);
+    resetAnchorPointValues(*U_jac_data, /*coarsest_ln*/ 0, finest_ln);
+
+    // A: apply the force Jacobian directly to the interpolated velocity.
+    Vec U_vec = (*U_jac_data)[finest_ln]->getVec();
+    Vec F_vec = (*F_jac_data)[finest_ln]->getVec();
+    ierr = MatMult(d_force_jac, U_vec, F_vec);
+    IBTK_CHKERRQ(ierr);
+    ierr = VecScale(F_vec, alpha);
+    IBTK_CHKERRQ(ierr);
+    resetAnchorPointValues(*F_jac_data, /*coarsest_ln*/ 0, finest_ln);
+
+    // S: spread the force using the same fixed coupling positions.
+    if (f_phys_bdry_op) f_phys_bdry_op->setPatchDataIndex(f_data_idx);
+    d_l_data_manager->spread(f_data_idx,
+                             *F_jac_data,
+                             *X_LE_data,
+                             f_phys_bdry_op,
+                             f_prolongation_scheds,
+                             data_time,
+                             /*F_needs_ghost_fill*/ true,
+                             *X_LE_needs_ghost_fill);
+    *F_jac_needs_ghost_fill = false;
+    *X_LE_needs_ghost_fill = false;
+    return;
+} // applyLinearizedCouplingOperator
+
 void
 IBMethod::constructInterpOp(Mat& J,
                             void (*spread_fnc)(const double, double*),
@@ -2030,6 +2074,16 @@ IBMethod::getFromInput(Pointer<Database> db, bool is_from_restart)
     if (db->keyExists("error_if_points_leave_domain"))
         d_error_if_points_leave_domain = db->getBool("error_if_points_leave_domain");
     if (db->keyExists("force_jac_mffd")) d_force_jac_mffd = db->getBool("force_jac_mffd");
+    if (db->keyExists("node_ordering"))
+    {
+        d_node_ordering = string_to_enum<LNodeOrderingType>(db->getString("node_ordering"));
+        if (d_node_ordering == UNKNOWN_LNODE_ORDERING_TYPE)
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                                     << "  unknown node_ordering " << db->getString("node_ordering") << "\n"
+                                     << "  valid choices are: NONE, MORTON, HILBERT" << std::endl);
+        }
+    }
     if (db->keyExists("do_log"))
         d_do_log = db->getBool("do_log");
     else if (db->keyExists("enable_logging"))
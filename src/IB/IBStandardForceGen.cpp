@@ -57,6 +57,7 @@ IBTK_ENABLE_EXTRA_WARNINGS
 #include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <ostream>
 #include <set>
 #include <string>
@@ -118,6 +119,79 @@ resetLocalOrNonlocalPETScIndices(std::vector<int>& inds,
     }
     return;
 } // resetLocalOrNonlocalPETScIndices
+
+template <class T>
+void
+apply_permutation(std::vector<T>& v, const std::vector<int>& permutation)
+{
+    std::vector<T> v_permuted(v.size());
+    for (std::size_t k = 0; k < permutation.size(); ++k)
+    {
+        v_permuted[k] = v[permutation[k]];
+    }
+    v.swap(v_permuted);
+    return;
+} // apply_permutation
+
+// Greedily color a collection of force generators (e.g., springs or beams) so
+// that no two generators of the same color act on the same node. Generator k
+// acts on the nodes (*node_idxs[i])[k] / NDIM. The generator indices are
+// returned sorted by color, keeping their original order within each color.
+void
+color_force_generators(std::vector<int>& color_offsets,
+                       std::vector<int>& colored_idxs,
+                       const std::vector<const std::vector<int>*>& node_idxs)
+{
+    const int num_generators = node_idxs.empty() ? 0 : static_cast<int>(node_idxs.front()->size());
+    int num_nodes = 0;
+    for (const auto v_ptr : node_idxs)
+    {
+        for (const int idx : *v_ptr) num_nodes = std::max(num_nodes, idx / NDIM + 1);
+    }
+
+    // Assign to each generator the smallest color not already used at any of
+    // its nodes.
+    std::vector<std::vector<int> > node_colors(num_nodes);
+    std::vector<int> generator_colors(num_generators);
+    std::vector<int> used_colors;
+    int num_colors = 0;
+    for (int k = 0; k < num_generators; ++k)
+    {
+        used_colors.clear();
+        for (const auto v_ptr : node_idxs)
+        {
+            const std::vector<int>& colors = node_colors[(*v_ptr)[k] / NDIM];
+            used_colors.insert(used_colors.end(), colors.begin(), colors.end());
+        }
+        std::sort(used_colors.begin(), used_colors.end());
+        int color = 0;
+        for (const int c : used_colors)
+        {
+            if (c == color)
+                ++color;
+            else if (c > color)
+                break;
+        }
+        generator_colors[k] = color;
+        num_colors = std::max(num_colors, color + 1);
+        for (const auto v_ptr : node_idxs)
+        {
+            node_colors[(*v_ptr)[k] / NDIM].push_back(color);
+        }
+    }
+
+    // Sort the generators by color.
+    color_offsets.assign(num_colors + 1, 0);
+    for (const int color : generator_colors) ++color_offsets[color + 1];
+    std::partial_sum(color_offsets.begin(), color_offsets.end(), color_offsets.begin());
+    std::vector<int> next_posn(color_offsets.begin(), color_offsets.end() - 1);
+    colored_idxs.resize(num_generators);
+    for (int k = 0; k < num_generators; ++k)
+    {
+        colored_idxs[next_posn[generator_colors[k]]++] = k;
+    }
+    return;
+} // color_force_generators
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -132,6 +206,8 @@ IBStandardForceGen::IBStandardForceGen(Pointer<Database> input_db)
     {
         if (input_db->keyExists("log_target_point_displacements"))
             d_log_target_point_displacements = input_db->getBool("log_target_point_displacements");
+        if (input_db->keyExists("threaded_force_accumulation"))
+            d_threaded_force_accumulation = input_db->getBool("threaded_force_accumulation");
     }
     return;
 } // IBStandardForceGen
@@ -244,6 +320,22 @@ IBStandardForceGen::initializeLevelData(const Pointer<PatchHierarchy<NDIM> > hie
         std::for_each(v_ptr->begin(), v_ptr->end(), [](int& i) { i *= NDIM; });
     }
 
+    // Color the springs and beams so that their forces can be accumulated
+    // concurrently.
+    if (d_threaded_force_accumulation)
+    {
+        SpringData& spring_data = d_spring_data[level_number];
+        color_force_generators(spring_data.color_offsets,
+                               spring_data.colored_springs,
+                               { &spring_data.petsc_mastr_node_idxs, &spring_data.petsc_slave_node_idxs });
+        BeamData& beam_data = d_beam_data[level_number];
+        color_force_generators(beam_data.color_offsets,
+                               beam_data.colored_beams,
+                               { &beam_data.petsc_mastr_node_idxs,
+                                 &beam_data.petsc_next_node_idxs,
+                                 &beam_data.petsc_prev_node_idxs });
+    }
+
     // Indicate that the level data has been initialized.
     d_is_initialized[level_number] = true;
     return;
@@ -784,6 +876,31 @@ IBStandardForceGen::initializeSpringLevelData(std::set<int>& nonlocal_petsc_idx_
         }
     }
 
+    // Group the springs that use the default force function so that their
+    // forces can be computed in a single vectorizable loop. The partition is
+    // stable so that the order of the springs is unchanged when all of them
+    // use the same force function.
+    std::vector<int> permutation(total_num_springs);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    const auto default_springs_end =
+        std::stable_partition(permutation.begin(), permutation.end(), [&](const int k) {
+            return force_fcns[k] == &default_spring_force && parameters[k] != nullptr;
+        });
+    const int num_default_springs = static_cast<int>(std::distance(permutation.begin(), default_springs_end));
+    if (num_default_springs != static_cast<int>(total_num_springs))
+    {
+        apply_permutation(lag_mastr_node_idxs, permutation);
+        apply_permutation(lag_slave_node_idxs, permutation);
+        apply_permutation(petsc_mastr_node_idxs, permutation);
+        apply_permutation(force_fcns, permutation);
+        apply_permutation(force_deriv_fcns, permutation);
+        apply_permutation(parameters, permutation);
+    }
+    d_spring_data[level_number].num_default_springs = num_default_springs;
+    d_spring_data[level_number].stiffnesses.resize(num_default_springs);
+    d_spring_data[level_number].rest_lengths.resize(num_default_springs);
+    d_spring_data[level_number].forces.resize(NDIM * total_num_springs);
+
     // Map the Lagrangian slave node indices to the PETSc indices corresponding
     // to the present data distribution.
     petsc_slave_node_idxs = lag_slave_node_idxs;
@@ -816,110 +933,137 @@ IBStandardForceGen::computeLagrangianSpringForce(Pointer<LData> F_data,
                                                  const double /*data_time*/,
                                                  LDataManager* const /*l_data_manager*/)
 {
-    const int num_springs = static_cast<int>(d_spring_data[level_number].lag_mastr_node_idxs.size());
-    const bool uses_springs = (num_springs > 0);
-    const int* const lag_mastr_node_idxs = uses_springs ? &d_spring_data[level_number].lag_mastr_node_idxs[0] : nullptr;
-    const int* const lag_slave_node_idxs = uses_springs ? &d_spring_data[level_number].lag_slave_node_idxs[0] : nullptr;
-    const int* const petsc_mastr_node_idxs =
-        uses_springs ? &d_spring_data[level_number].petsc_mastr_node_idxs[0] : nullptr;
-    const int* const petsc_slave_node_idxs =
-        uses_springs ? &d_spring_data[level_number].petsc_slave_node_idxs[0] : nullptr;
-    const SpringForceFcnPtr* const force_fcns = uses_springs ? &d_spring_data[level_number].force_fcns[0] : nullptr;
-    const double** const parameters = uses_springs ? &d_spring_data[level_number].parameters[0] : nullptr;
+    SpringData& spring_data = d_spring_data[level_number];
+    const int num_springs = static_cast<int>(spring_data.lag_mastr_node_idxs.size());
+    const int num_default_springs = spring_data.num_default_springs;
+    const int* const lag_mastr_node_idxs = spring_data.lag_mastr_node_idxs.data();
+    const int* const lag_slave_node_idxs = spring_data.lag_slave_node_idxs.data();
+    const int* const petsc_mastr_node_idxs = spring_data.petsc_mastr_node_idxs.data();
+    const int* const petsc_slave_node_idxs = spring_data.petsc_slave_node_idxs.data();
+    const SpringForceFcnPtr* const force_fcns = spring_data.force_fcns.data();
+    const double* const* const parameters = spring_data.parameters.data();
+    double* const stiffnesses = spring_data.stiffnesses.data();
+    double* const rest_lengths = spring_data.rest_lengths.data();
+    double* const F_spring = spring_data.forces.data();
     double* const F_node = F_data->getLocalFormVecArray()->data();
     const double* const X_node = X_data->getGhostedLocalFormVecArray()->data();
 
-    static const int BLOCKSIZE = 16; // this parameter needs to be tuned
-    int k, kblock, kunroll, mastr_idx, slave_idx;
-    double F[NDIM], D[NDIM], R, T_over_R;
-    kblock = 0;
-    for (; kblock < (num_springs - 1) / BLOCKSIZE;
-         ++kblock) // ensure that the last block is NOT handled by this first loop
+    // Gather the parameters of the springs that use the default force
+    // function. The parameters are not cached between calls since they may be
+    // modified through the IBSpringForceSpec objects.
+    for (int k = 0; k < num_default_springs; ++k)
     {
-        PREFETCH_READ_NTA_BLOCK(lag_mastr_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(lag_slave_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_mastr_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_slave_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(force_fcns + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(parameters + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
-        {
-            k = kblock * BLOCKSIZE + kunroll;
-            mastr_idx = petsc_mastr_node_idxs[k];
-            slave_idx = petsc_slave_node_idxs[k];
-#if !defined(NDEBUG)
-            TBOX_ASSERT(mastr_idx != slave_idx);
+        stiffnesses[k] = parameters[k][0];
+        rest_lengths[k] = parameters[k][1];
+    }
+
+    // Compute the forces generated by the springs that use the default force
+    // function. This loop does not contain any function calls or branches and
+    // can be vectorized by the compiler.
+    const bool threaded = d_threaded_force_accumulation;
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded)
 #endif
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_mastr_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_slave_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_mastr_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_slave_node_idxs[k + 1]);
-            PREFETCH_READ_NTA(parameters[k + 1]);
-            D[0] = X_node[slave_idx + 0] - X_node[mastr_idx + 0];
-            D[1] = X_node[slave_idx + 1] - X_node[mastr_idx + 1];
+    for (int k = 0; k < num_default_springs; ++k)
+    {
+        const int mastr_idx = petsc_mastr_node_idxs[k];
+        const int slave_idx = petsc_slave_node_idxs[k];
+        double D[NDIM];
+        D[0] = X_node[slave_idx + 0] - X_node[mastr_idx + 0];
+        D[1] = X_node[slave_idx + 1] - X_node[mastr_idx + 1];
 #if (NDIM == 3)
-            D[2] = X_node[slave_idx + 2] - X_node[mastr_idx + 2];
+        D[2] = X_node[slave_idx + 2] - X_node[mastr_idx + 2];
 #endif
 #if (NDIM == 2)
-            R = std::sqrt(D[0] * D[0] + D[1] * D[1]);
+        const double R = std::sqrt(D[0] * D[0] + D[1] * D[1]);
 #endif
 #if (NDIM == 3)
-            R = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
+        const double R = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
 #endif
-            if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
-            T_over_R = (force_fcns[k])(R, parameters[k], lag_mastr_node_idxs[k], lag_slave_node_idxs[k]) / R;
-            F[0] = T_over_R * D[0];
-            F[1] = T_over_R * D[1];
-#if (NDIM == 3)
-            F[2] = T_over_R * D[2];
-#endif
-            F_node[mastr_idx + 0] += F[0];
-            F_node[mastr_idx + 1] += F[1];
+        const double T_over_R =
+            R < std::numeric_limits<double>::epsilon() ? 0.0 : stiffnesses[k] * (R - rest_lengths[k]) / R;
+        F_spring[NDIM * k + 0] = T_over_R * D[0];
+        F_spring[NDIM * k + 1] = T_over_R * D[1];
 #if (NDIM == 3)
-            F_node[mastr_idx + 2] += F[2];
+        F_spring[NDIM * k + 2] = T_over_R * D[2];
 #endif
-            F_node[slave_idx + 0] -= F[0];
-            F_node[slave_idx + 1] -= F[1];
-#if (NDIM == 3)
-            F_node[slave_idx + 2] -= F[2];
-#endif
-        }
     }
-    for (k = kblock * BLOCKSIZE; k < num_springs; ++k)
+
+    // Compute the forces generated by the remaining springs by calling their
+    // force functions.
+    for (int k = num_default_springs; k < num_springs; ++k)
     {
-        mastr_idx = petsc_mastr_node_idxs[k];
-        slave_idx = petsc_slave_node_idxs[k];
-#if !defined(NDEBUG)
-        TBOX_ASSERT(mastr_idx != slave_idx);
-#endif
+        const int mastr_idx = petsc_mastr_node_idxs[k];
+        const int slave_idx = petsc_slave_node_idxs[k];
+        double D[NDIM];
         D[0] = X_node[slave_idx + 0] - X_node[mastr_idx + 0];
         D[1] = X_node[slave_idx + 1] - X_node[mastr_idx + 1];
 #if (NDIM == 3)
         D[2] = X_node[slave_idx + 2] - X_node[mastr_idx + 2];
 #endif
 #if (NDIM == 2)
-        R = std::sqrt(D[0] * D[0] + D[1] * D[1]);
+        const double R = std::sqrt(D[0] * D[0] + D[1] * D[1]);
 #endif
 #if (NDIM == 3)
-        R = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
+        const double R = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
 #endif
-        if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
-        T_over_R = (force_fcns[k])(R, parameters[k], lag_mastr_node_idxs[k], lag_slave_node_idxs[k]) / R;
-        F[0] = T_over_R * D[0];
-        F[1] = T_over_R * D[1];
+        double T_over_R = 0.0;
+        if (LIKELY(R >= std::numeric_limits<double>::epsilon()))
+        {
+            T_over_R = (force_fcns[k])(R, parameters[k], lag_mastr_node_idxs[k], lag_slave_node_idxs[k]) / R;
+        }
+        F_spring[NDIM * k + 0] = T_over_R * D[0];
+        F_spring[NDIM * k + 1] = T_over_R * D[1];
 #if (NDIM == 3)
-        F[2] = T_over_R * D[2];
+        F_spring[NDIM * k + 2] = T_over_R * D[2];
 #endif
-        F_node[mastr_idx + 0] += F[0];
-        F_node[mastr_idx + 1] += F[1];
+    }
+
+    // Accumulate the spring forces at the nodes.
+    const auto accumulate_spring_force = [=](const int k) {
+        const int mastr_idx = petsc_mastr_node_idxs[k];
+        const int slave_idx = petsc_slave_node_idxs[k];
+#if !defined(NDEBUG)
+        TBOX_ASSERT(mastr_idx != slave_idx);
+#endif
+        F_node[mastr_idx + 0] += F_spring[NDIM * k + 0];
+        F_node[mastr_idx + 1] += F_spring[NDIM * k + 1];
 #if (NDIM == 3)
-        F_node[mastr_idx + 2] += F[2];
+        F_node[mastr_idx + 2] += F_spring[NDIM * k + 2];
 #endif
-        F_node[slave_idx + 0] -= F[0];
-        F_node[slave_idx + 1] -= F[1];
+        F_node[slave_idx + 0] -= F_spring[NDIM * k + 0];
+        F_node[slave_idx + 1] -= F_spring[NDIM * k + 1];
 #if (NDIM == 3)
-        F_node[slave_idx + 2] -= F[2];
+        F_node[slave_idx + 2] -= F_spring[NDIM * k + 2];
 #endif
+    };
+    if (threaded)
+    {
+        // Springs of the same color do not share any nodes and hence may be
+        // processed concurrently. The colors are processed in a fixed order so
+        // that the result does not depend on the number of threads.
+        const std::vector<int>& color_offsets = spring_data.color_offsets;
+        const int* const colored_springs = spring_data.colored_springs.data();
+        const int num_colors = static_cast<int>(color_offsets.size()) - 1;
+        for (int color = 0; color < num_colors; ++color)
+        {
+            const int begin = color_offsets[color];
+            const int end = color_offsets[color + 1];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int j = begin; j < end; ++j)
+            {
+                accumulate_spring_force(colored_springs[j]);
+            }
+        }
+    }
+    else
+    {
+        for (int k = 0; k < num_springs; ++k)
+        {
+            accumulate_spring_force(k);
+        }
     }
 
     F_data->restoreArrays();
@@ -964,6 +1108,9 @@ IBStandardForceGen::initializeBeamLevelData(std::set<int>& nonlocal_petsc_idx_se
     petsc_global_prev_node_idxs.resize(total_num_beams);
     rigidities.resize(total_num_beams);
     curvatures.resize(total_num_beams);
+    d_beam_data[level_number].rigidity_values.resize(total_num_beams);
+    d_beam_data[level_number].curvature_values.resize(NDIM * total_num_beams);
+    d_beam_data[level_number].forces.resize(NDIM * total_num_beams);
 
     // Setup the data structures used to compute beam forces.
     int current_beam = 0;
@@ -1040,103 +1187,103 @@ IBStandardForceGen::computeLagrangianBeamForce(Pointer<LData> F_data,
                                                const double /*data_time*/,
                                                LDataManager* const /*l_data_manager*/)
 {
-    const int num_beams = static_cast<int>(d_beam_data[level_number].petsc_mastr_node_idxs.size());
-    const bool uses_beams = (num_beams > 0);
-    const int* const petsc_mastr_node_idxs = uses_beams ? &d_beam_data[level_number].petsc_mastr_node_idxs[0] : nullptr;
-    const int* const petsc_next_node_idxs = uses_beams ? &d_beam_data[level_number].petsc_next_node_idxs[0] : nullptr;
-    const int* const petsc_prev_node_idxs = uses_beams ? &d_beam_data[level_number].petsc_prev_node_idxs[0] : nullptr;
-    const double** const rigidities = uses_beams ? &d_beam_data[level_number].rigidities[0] : nullptr;
-    const Vector** const curvatures = uses_beams ? &d_beam_data[level_number].curvatures[0] : nullptr;
+    BeamData& beam_data = d_beam_data[level_number];
+    const int num_beams = static_cast<int>(beam_data.petsc_mastr_node_idxs.size());
+    const int* const petsc_mastr_node_idxs = beam_data.petsc_mastr_node_idxs.data();
+    const int* const petsc_next_node_idxs = beam_data.petsc_next_node_idxs.data();
+    const int* const petsc_prev_node_idxs = beam_data.petsc_prev_node_idxs.data();
+    const double* const* const rigidities = beam_data.rigidities.data();
+    const Vector* const* const curvatures = beam_data.curvatures.data();
+    double* const K = beam_data.rigidity_values.data();
+    double* const D2X0 = beam_data.curvature_values.data();
+    double* const F_beam = beam_data.forces.data();
     double* const F_node = F_data->getLocalFormVecArray()->data();
     const double* const X_node = X_data->getGhostedLocalFormVecArray()->data();
 
-    static const int BLOCKSIZE = 16; // This parameter needs to be tuned.
-    int k, kblock, kunroll, mastr_idx, next_idx, prev_idx;
-    double K;
-    const double* D2X0;
-    double F[NDIM];
-    kblock = 0;
-    for (; kblock < (num_beams - 1) / BLOCKSIZE;
-         ++kblock) // ensure that the last block is NOT handled by this first loop
+    // Gather the beam parameters. The parameters are not cached between calls
+    // since they may be modified through the IBBeamForceSpec objects.
+    for (int k = 0; k < num_beams; ++k)
     {
-        PREFETCH_READ_NTA_BLOCK(petsc_mastr_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_next_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_prev_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(rigidities + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(curvatures + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
-        {
-            k = kblock * BLOCKSIZE + kunroll;
-            mastr_idx = petsc_mastr_node_idxs[k];
-            next_idx = petsc_next_node_idxs[k];
-            prev_idx = petsc_prev_node_idxs[k];
-#if !defined(NDEBUG)
-            TBOX_ASSERT(mastr_idx != next_idx);
-            TBOX_ASSERT(mastr_idx != prev_idx);
-#endif
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_mastr_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_next_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_prev_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_mastr_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_next_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_prev_node_idxs[k + 1]);
-            PREFETCH_READ_NTA(rigidities[k + 1]);
-            PREFETCH_READ_NTA(curvatures[k + 1]);
-            K = *rigidities[k];
-            D2X0 = curvatures[k]->data();
-            F[0] = K * (X_node[next_idx + 0] + X_node[prev_idx + 0] - 2.0 * X_node[mastr_idx + 0] - D2X0[0]);
-            F[1] = K * (X_node[next_idx + 1] + X_node[prev_idx + 1] - 2.0 * X_node[mastr_idx + 1] - D2X0[1]);
+        K[k] = *rigidities[k];
+        D2X0[NDIM * k + 0] = (*curvatures[k])[0];
+        D2X0[NDIM * k + 1] = (*curvatures[k])[1];
 #if (NDIM == 3)
-            F[2] = K * (X_node[next_idx + 2] + X_node[prev_idx + 2] - 2.0 * X_node[mastr_idx + 2] - D2X0[2]);
+        D2X0[NDIM * k + 2] = (*curvatures[k])[2];
 #endif
-            F_node[mastr_idx + 0] += 2.0 * F[0];
-            F_node[mastr_idx + 1] += 2.0 * F[1];
-#if (NDIM == 3)
-            F_node[mastr_idx + 2] += 2.0 * F[2];
-#endif
-            F_node[next_idx + 0] -= F[0];
-            F_node[next_idx + 1] -= F[1];
-#if (NDIM == 3)
-            F_node[next_idx + 2] -= F[2];
+    }
+
+    // Compute the forces generated by the beams. This loop does not contain
+    // any function calls or branches and can be vectorized by the compiler.
+    const bool threaded = d_threaded_force_accumulation;
+#ifdef _OPENMP
+#pragma omp parallel for if (threaded)
 #endif
-            F_node[prev_idx + 0] -= F[0];
-            F_node[prev_idx + 1] -= F[1];
+    for (int k = 0; k < num_beams; ++k)
+    {
+        const int mastr_idx = petsc_mastr_node_idxs[k];
+        const int next_idx = petsc_next_node_idxs[k];
+        const int prev_idx = petsc_prev_node_idxs[k];
+        F_beam[NDIM * k + 0] =
+            K[k] * (X_node[next_idx + 0] + X_node[prev_idx + 0] - 2.0 * X_node[mastr_idx + 0] - D2X0[NDIM * k + 0]);
+        F_beam[NDIM * k + 1] =
+            K[k] * (X_node[next_idx + 1] + X_node[prev_idx + 1] - 2.0 * X_node[mastr_idx + 1] - D2X0[NDIM * k + 1]);
 #if (NDIM == 3)
-            F_node[prev_idx + 2] -= F[2];
+        F_beam[NDIM * k + 2] =
+            K[k] * (X_node[next_idx + 2] + X_node[prev_idx + 2] - 2.0 * X_node[mastr_idx + 2] - D2X0[NDIM * k + 2]);
 #endif
-        }
     }
-    for (k = kblock * BLOCKSIZE; k < num_beams; ++k)
-    {
-        mastr_idx = petsc_mastr_node_idxs[k];
-        next_idx = petsc_next_node_idxs[k];
-        prev_idx = petsc_prev_node_idxs[k];
+
+    // Accumulate the beam forces at the nodes.
+    const auto accumulate_beam_force = [=](const int k) {
+        const int mastr_idx = petsc_mastr_node_idxs[k];
+        const int next_idx = petsc_next_node_idxs[k];
+        const int prev_idx = petsc_prev_node_idxs[k];
 #if !defined(NDEBUG)
         TBOX_ASSERT(mastr_idx != next_idx);
         TBOX_ASSERT(mastr_idx != prev_idx);
 #endif
-        K = *rigidities[k];
-        D2X0 = curvatures[k]->data();
-        F[0] = K * (X_node[next_idx + 0] + X_node[prev_idx + 0] - 2.0 * X_node[mastr_idx + 0] - D2X0[0]);
-        F[1] = K * (X_node[next_idx + 1] + X_node[prev_idx + 1] - 2.0 * X_node[mastr_idx + 1] - D2X0[1]);
+        F_node[mastr_idx + 0] += 2.0 * F_beam[NDIM * k + 0];
+        F_node[mastr_idx + 1] += 2.0 * F_beam[NDIM * k + 1];
 #if (NDIM == 3)
-        F[2] = K * (X_node[next_idx + 2] + X_node[prev_idx + 2] - 2.0 * X_node[mastr_idx + 2] - D2X0[2]);
+        F_node[mastr_idx + 2] += 2.0 * F_beam[NDIM * k + 2];
 #endif
-        F_node[mastr_idx + 0] += 2.0 * F[0];
-        F_node[mastr_idx + 1] += 2.0 * F[1];
+        F_node[next_idx + 0] -= F_beam[NDIM * k + 0];
+        F_node[next_idx + 1] -= F_beam[NDIM * k + 1];
 #if (NDIM == 3)
-        F_node[mastr_idx + 2] += 2.0 * F[2];
+        F_node[next_idx + 2] -= F_beam[NDIM * k + 2];
 #endif
-        F_node[next_idx + 0] -= F[0];
-        F_node[next_idx + 1] -= F[1];
+        F_node[prev_idx + 0] -= F_beam[NDIM * k + 0];
+        F_node[prev_idx + 1] -= F_beam[NDIM * k + 1];
 #if (NDIM == 3)
-        F_node[next_idx + 2] -= F[2];
+        F_node[prev_idx + 2] -= F_beam[NDIM * k + 2];
 #endif
-        F_node[prev_idx + 0] -= F[0];
-        F_node[prev_idx + 1] -= F[1];
-#if (NDIM == 3)
-        F_node[prev_idx + 2] -= F[2];
+    };
+    if (threaded)
+    {
+        // Beams of the same color do not share any nodes and hence may be
+        // processed concurrently.
+        const std::vector<int>& color_offsets = beam_data.color_offsets;
+        const int* const colored_beams = beam_data.colored_beams.data();
+        const int num_colors = static_cast<int>(color_offsets.size()) - 1;
+        for (int color = 0; color < num_colors; ++color)
+        {
+            const int begin = color_offsets[color];
+            const int end = color_offsets[color + 1];
+#ifdef _OPENMP
+#pragma omp parallel for
 #endif
+            for (int j = begin; j < end; ++j)
+            {
+                accumulate_beam_force(colored_beams[j]);
+            }
+        }
+    }
+    else
+    {
+        for (int k = 0; k < num_beams; ++k)
+        {
+            accumulate_beam_force(k);
+        }
     }
 
     F_data->restoreArrays();
@@ -1178,6 +1325,9 @@ IBStandardForceGen::initializeTargetPointLevelData(std::set<int>& /*nonlocal_pet
     kappa.resize(total_num_target_points);
     eta.resize(total_num_target_points);
     X0.resize(total_num_target_points);
+    d_target_point_data[level_number].kappa_values.resize(total_num_target_points);
+    d_target_point_data[level_number].eta_values.resize(total_num_target_points);
+    d_target_point_data[level_number].X0_values.resize(NDIM * total_num_target_points);
 
     // Setup the data structures used to compute target point forces.
     int current_target_point = 0;
@@ -1207,80 +1357,57 @@ IBStandardForceGen::computeLagrangianTargetPointForce(Pointer<LData> F_data,
 {
     double max_displacement = 0.0;
 
-    const int num_target_points = static_cast<int>(d_target_point_data[level_number].petsc_node_idxs.size());
-    const bool uses_target_points = (num_target_points > 0);
-    const int* const petsc_node_idxs =
-        uses_target_points ? &d_target_point_data[level_number].petsc_node_idxs[0] : nullptr;
-    const double** const kappa = uses_target_points ? &d_target_point_data[level_number].kappa[0] : nullptr;
-    const double** const eta = uses_target_points ? &d_target_point_data[level_number].eta[0] : nullptr;
-    const Point** const X0 = uses_target_points ? &d_target_point_data[level_number].X0[0] : nullptr;
+    TargetPointData& target_point_data = d_target_point_data[level_number];
+    const int num_target_points = static_cast<int>(target_point_data.petsc_node_idxs.size());
+    const int* const petsc_node_idxs = target_point_data.petsc_node_idxs.data();
+    const double* const* const kappa = target_point_data.kappa.data();
+    const double* const* const eta = target_point_data.eta.data();
+    const Point* const* const X0 = target_point_data.X0.data();
+    double* const K = target_point_data.kappa_values.data();
+    double* const E = target_point_data.eta_values.data();
+    double* const X_target = target_point_data.X0_values.data();
     double* const F_node = F_data->getLocalFormVecArray()->data();
     const double* const X_node = X_data->getLocalFormVecArray()->data();
     const double* const U_node = U_data->getLocalFormVecArray()->data();
 
-    static const int BLOCKSIZE = 16; // This parameter needs to be tuned.
-    int k, kblock, kunroll, idx;
-    double K, E, dX;
-    const double* X_target;
-    kblock = 0;
-    for (; kblock < (num_target_points - 1) / BLOCKSIZE;
-         ++kblock) // ensure that the last block is NOT handled by this first loop
+    // Gather the target point parameters. The parameters are not cached
+    // between calls since they may be modified through the
+    // IBTargetPointForceSpec objects (e.g., to move the target points).
+    for (int k = 0; k < num_target_points; ++k)
     {
-        PREFETCH_READ_NTA_BLOCK(petsc_node_idxs + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(kappa + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(eta + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(X0 + BLOCKSIZE * (kblock + 1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
-        {
-            k = kblock * BLOCKSIZE + kunroll;
-            idx = petsc_node_idxs[k];
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node + petsc_node_idxs[k + 1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node + petsc_node_idxs[k + 1]);
-            PREFETCH_READ_NTA(kappa[k + 1]);
-            PREFETCH_READ_NTA(eta[k + 1]);
-            PREFETCH_READ_NTA(X0[k + 1]);
-            K = *kappa[k];
-            E = *eta[k];
-            X_target = X0[k]->data();
-            F_node[idx + 0] += K * (X_target[0] - X_node[idx + 0]) - E * U_node[idx + 0];
-            F_node[idx + 1] += K * (X_target[1] - X_node[idx + 1]) - E * U_node[idx + 1];
-#if (NDIM == 3)
-            F_node[idx + 2] += K * (X_target[2] - X_node[idx + 2]) - E * U_node[idx + 2];
-#endif
-            if (d_log_target_point_displacements)
-            {
-                dX = 0.0;
-                dX += (X_target[0] - X_node[idx + 0]) * (X_target[0] - X_node[idx + 0]);
-                dX += (X_target[1] - X_node[idx + 1]) * (X_target[1] - X_node[idx + 1]);
+        K[k] = *kappa[k];
+        E[k] = *eta[k];
+        X_target[NDIM * k + 0] = (*X0[k])[0];
+        X_target[NDIM * k + 1] = (*X0[k])[1];
 #if (NDIM == 3)
-                dX += (X_target[2] - X_node[idx + 2]) * (X_target[2] - X_node[idx + 2]);
+        X_target[NDIM * k + 2] = (*X0[k])[2];
 #endif
-                dX = std::sqrt(dX);
-                max_displacement = std::max(max_displacement, dX);
-            }
-        }
     }
-    for (k = kblock * BLOCKSIZE; k < num_target_points; ++k)
+
+    // Compute the target point forces. Each node is associated with at most
+    // one target point, so the forces can be accumulated directly.
+    for (int k = 0; k < num_target_points; ++k)
     {
-        idx = petsc_node_idxs[k];
-        K = *kappa[k];
-        E = *eta[k];
-        X_target = X0[k]->data();
-        F_node[idx + 0] += K * (X_target[0] - X_node[idx + 0]) - E * U_node[idx + 0];
-        F_node[idx + 1] += K * (X_target[1] - X_node[idx + 1]) - E * U_node[idx + 1];
+        const int idx = petsc_node_idxs[k];
+        F_node[idx + 0] += K[k] * (X_target[NDIM * k + 0] - X_node[idx + 0]) - E[k] * U_node[idx + 0];
+        F_node[idx + 1] += K[k] * (X_target[NDIM * k + 1] - X_node[idx + 1]) - E[k] * U_node[idx + 1];
 #if (NDIM == 3)
-        F_node[idx + 2] += K * (X_target[2] - X_node[idx + 2]) - E * U_node[idx + 2];
+        F_node[idx + 2] += K[k] * (X_target[NDIM * k + 2] - X_node[idx + 2]) - E[k] * U_node[idx + 2];
 #endif
-        if (d_log_target_point_displacements)
+    }
+
+    if (d_log_target_point_displacements)
+    {
+        for (int k = 0; k < num_target_points; ++k)
         {
-            dX = 0.0;
-            dX += (X_target[0] - X_node[idx + 0]) * (X_target[0] - X_node[idx + 0]);
-            dX += (X_target[1] - X_node[idx + 1]) * (X_target[1] - X_node[idx + 1]);
+            const int idx = petsc_node_idxs[k];
+            double dX = 0.0;
+            dX += (X_target[NDIM * k + 0] - X_node[idx + 0]) * (X_target[NDIM * k + 0] - X_node[idx + 0]);
+            dX += (X_target[NDIM * k + 1] - X_node[idx + 1]) * (X_target[NDIM * k + 1] - X_node[idx + 1]);
 #if (NDIM == 3)
-            dX += (X_target[2] - X_node[idx + 2]) * (X_target[2] - X_node[idx + 2]);
+            dX += (X_target[NDIM * k + 2] - X_node[idx + 2]) * (X_target[NDIM * k + 2] - X_node[idx + 2]);
 #endif
-            dX = std::sqrt(dX);
-            max_displacement = std::max(max_displacement, dX);
+            max_displacement = std::max(max_displacement, std::sqrt(dX));
         }
     }
 
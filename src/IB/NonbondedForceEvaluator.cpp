@@ -15,6 +15,8 @@
 
 #include "ibamr/NonbondedForceEvaluator.h"
 
+#include "ibtk/IBTK_CHKERRQ.h"
+#include "ibtk/IBTK_MPI.h"
 #include "ibtk/LData.h"
 #include "ibtk/LDataManager.h"
 #include "ibtk/LIndexSetData.h"
@@ -37,11 +39,18 @@
 #include "petscvec.h"
 #include <petscsys.h>
 
-#include <assert.h>
-
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "ibamr/app_namespaces.h" // IWYU pragma: keep
 
@@ -51,6 +60,105 @@ namespace IBAMR
 {
 /////////////////////////////// STATIC ///////////////////////////////////////
 
+namespace
+{
+// A cell-linked list. Points are binned into a uniform grid of bins that are
+// at least as wide as the cutoff distance, so that all of the points within the
+// cutoff distance of a given point lie in the bin that contains it or in one
+// of the neighboring bins. The points in each bin are stored as a singly
+// linked list in the flat arrays d_head and d_next.
+class CellList
+{
+public:
+    // Bin the points with positions X[NDIM * i], ..., X[NDIM * i + NDIM - 1].
+    CellList(const std::vector<double>& X, const double* const bin_width)
+    {
+        const int num_points = static_cast<int>(X.size()) / NDIM;
+        std::array<double, NDIM> X_max;
+        d_X_lower.fill(std::numeric_limits<double>::max());
+        X_max.fill(std::numeric_limits<double>::lowest());
+        for (int i = 0; i < num_points; ++i)
+        {
+            for (int d = 0; d < NDIM; ++d)
+            {
+                d_X_lower[d] = std::min(d_X_lower[d], X[NDIM * i + d]);
+                X_max[d] = std::max(X_max[d], X[NDIM * i + d]);
+            }
+        }
+        int num_bins = 1;
+        for (int d = 0; d < NDIM; ++d)
+        {
+            d_bin_width[d] = bin_width[d];
+            d_num_bins[d] = num_points > 0 ? static_cast<int>((X_max[d] - d_X_lower[d]) / bin_width[d]) + 1 : 1;
+            num_bins *= d_num_bins[d];
+        }
+
+        // Insert the points in reverse order so that each list is traversed
+        // in order of increasing point index.
+        d_head.assign(num_bins, -1);
+        d_next.resize(num_points);
+        for (int i = num_points - 1; i >= 0; --i)
+        {
+            std::array<int, NDIM> bin;
+            getBin(&X[NDIM * i], bin);
+            const int bin_idx = getBinIndex(bin);
+            d_next[i] = d_head[bin_idx];
+            d_head[bin_idx] = i;
+        }
+        return;
+    } // CellList
+
+    // Call visit(j) for each point j in the bin containing the position X and
+    // in the neighboring bins.
+    template <class Visitor>
+    void visitNeighbors(const double* const X, Visitor visit) const
+    {
+        std::array<int, NDIM> bin;
+        getBin(X, bin);
+        std::array<int, NDIM> lower, upper;
+        for (int d = 0; d < NDIM; ++d)
+        {
+            lower[d] = std::max(bin[d] - 1, 0);
+            upper[d] = std::min(bin[d] + 1, d_num_bins[d] - 1);
+        }
+        std::array<int, NDIM> nbr_bin = lower;
+        while (true)
+        {
+            for (int j = d_head[getBinIndex(nbr_bin)]; j >= 0; j = d_next[j]) visit(j);
+            int d = 0;
+            for (; d < NDIM; ++d)
+            {
+                if (++nbr_bin[d] <= upper[d]) break;
+                nbr_bin[d] = lower[d];
+            }
+            if (d == NDIM) break;
+        }
+        return;
+    } // visitNeighbors
+
+private:
+    void getBin(const double* const X, std::array<int, NDIM>& bin) const
+    {
+        for (int d = 0; d < NDIM; ++d)
+        {
+            bin[d] = std::min(static_cast<int>((X[d] - d_X_lower[d]) / d_bin_width[d]), d_num_bins[d] - 1);
+        }
+        return;
+    } // getBin
+
+    int getBinIndex(const std::array<int, NDIM>& bin) const
+    {
+        int bin_idx = 0;
+        for (int d = NDIM - 1; d >= 0; --d) bin_idx = bin_idx * d_num_bins[d] + bin[d];
+        return bin_idx;
+    } // getBinIndex
+
+    std::array<double, NDIM> d_X_lower, d_bin_width;
+    std::array<int, NDIM> d_num_bins;
+    std::vector<int> d_head, d_next;
+};
+} // namespace
+
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
 NonbondedForceEvaluator::NonbondedForceEvaluator(Pointer<Database> input_db,
@@ -77,8 +185,16 @@ NonbondedForceEvaluator::NonbondedForceEvaluator(Pointer<Database> input_db,
         TBOX_ERROR("Must specify regrid_alpha for NonbondedForceEvaluator.");
     }
 
-    // this will only work if the domain is a single box.
-    assert(d_grid_geometry->getDomainIsSingleBox());
+    // get Verlet list settings
+    if (input_db->keyExists("use_verlet_lists"))
+    {
+        d_use_verlet_lists = input_db->getBool("use_verlet_lists");
+    }
+    d_verlet_skin = input_db->getDoubleWithDefault("verlet_skin", 2.0 * d_regrid_alpha);
+    if (d_use_verlet_lists && d_verlet_skin <= 0.0)
+    {
+        TBOX_ERROR("NonbondedForceEvaluator: verlet_skin must be positive when use_verlet_lists is TRUE.");
+    }
 
     // get parameters for force function
     d_parameters = input_db->getDoubleArray("parameters");
@@ -141,6 +257,20 @@ NonbondedForceEvaluator::evaluateForces(int mstr_petsc_idx,
     return;
 } // evaluateForces
 
+void
+NonbondedForceEvaluator::initializeLevelData(const Pointer<PatchHierarchy<NDIM> > /*hierarchy*/,
+                                             const int level_number,
+                                             const double /*init_data_time*/,
+                                             const bool /*initial_time*/,
+                                             LDataManager* const /*l_data_manager*/)
+{
+    // The local PETSc indices of the nodes change when the data are
+    // redistributed, so the Verlet list must be rebuilt.
+    if (level_number >= static_cast<int>(d_verlet_lists.size())) d_verlet_lists.resize(level_number + 1);
+    d_verlet_lists[level_number].is_valid = false;
+    return;
+} // initializeLevelData
+
 void
 NonbondedForceEvaluator::computeLagrangianForce(Pointer<LData> F_data,
                                                 Pointer<LData> X_data,
@@ -150,20 +280,109 @@ NonbondedForceEvaluator::computeLagrangianForce(Pointer<LData> F_data,
                                                 const double /*data_time*/,
                                                 LDataManager* const l_data_manager)
 {
-    // Get grid geometry and relevant lower and upper limits.
-    Pointer<CartesianGridGeometry<NDIM> > grid_geom = hierarchy->getGridGeometry();
-    if (!grid_geom->getDomainIsSingleBox()) TBOX_ERROR("physical domain must be a single box...\n");
+    // The search and the force evaluation use the positions of the nonlocal
+    // nodes in the ghost cells of the local patches.
+    X_data->beginGhostUpdate();
+    X_data->endGhostUpdate();
+
+    // Without Verlet lists, the list of interacting pairs of nodes is rebuilt
+    // for each force evaluation.
+    if (!d_use_verlet_lists)
+    {
+        buildVerletList(X_data, hierarchy, level_number, l_data_manager, 0.0);
+    }
+    else if (!verletListIsValid(X_data, level_number, l_data_manager))
+    {
+        buildVerletList(X_data, hierarchy, level_number, l_data_manager, d_verlet_skin);
+    }
+    computeVerletListForces(F_data, X_data, level_number);
+    return;
+} // computeLagrangianForce
+
+void
+NonbondedForceEvaluator::registerForceFcnPtr(NonBddForceFcnPtr force_fcn_ptr)
+{
+    // set the nonbonded force function pointer to the given force function pointer
+    d_force_fcn_ptr = force_fcn_ptr;
+    return;
+} // registerForceFcnPtr
 
-    // These will only work if the domain is a single box.
-    assert(grid_geom->getDomainIsSingleBox());
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+bool
+NonbondedForceEvaluator::verletListIsValid(Pointer<LData> X_data,
+                                           const int level_number,
+                                           LDataManager* const l_data_manager)
+{
+    if (level_number >= static_cast<int>(d_verlet_lists.size())) d_verlet_lists.resize(level_number + 1);
+    const VerletList& verlet_list = d_verlet_lists[level_number];
+    if (!verlet_list.is_valid) return false;
+
+    // Determine the maximum displacement (in units of the grid spacing) of the
+    // nodes since the list was built. The list remains valid as long as no two
+    // nodes can have moved closer than interaction_radius to each other
+    // without both having been within interaction_radius + verlet_skin of each
+    // other when the list was built.
+    //
+    // NOTE: This check is collective: every process must perform the reduction
+    // even if its own nodes have not moved.
+    const int num_local_nodes = l_data_manager->getNumberOfLocalNodes(level_number);
+    double max_displacement_sq = 0.0;
+    if (verlet_list.X_ref.size() != static_cast<std::size_t>(NDIM * num_local_nodes))
+    {
+        max_displacement_sq = std::numeric_limits<double>::max();
+    }
+    else
+    {
+        const double* const X_node = X_data->getLocalFormVecArray()->data();
+        for (int i = 0; i < num_local_nodes; ++i)
+        {
+            double displacement_sq = 0.0;
+            for (int k = 0; k < NDIM; ++k)
+            {
+                const double dX = (X_node[NDIM * i + k] - verlet_list.X_ref[NDIM * i + k]) / verlet_list.dx[k];
+                displacement_sq += dX * dX;
+            }
+            max_displacement_sq = std::max(max_displacement_sq, displacement_sq);
+        }
+        X_data->restoreArrays(/*values_modified*/ false);
+    }
+    max_displacement_sq = IBTK_MPI::maxReduction(max_displacement_sq);
+    return 4.0 * max_displacement_sq <= d_verlet_skin * d_verlet_skin;
+} // verletListIsValid
+
+void
+NonbondedForceEvaluator::buildVerletList(Pointer<LData> X_data,
+                                         const Pointer<PatchHierarchy<NDIM> > hierarchy,
+                                         const int level_number,
+                                         LDataManager* const l_data_manager,
+                                         const double skin)
+{
+    if (level_number >= static_cast<int>(d_verlet_lists.size())) d_verlet_lists.resize(level_number + 1);
+    VerletList& verlet_list = d_verlet_lists[level_number];
+    verlet_list.mstr_idxs.clear();
+    verlet_list.nbr_offsets.assign(1, 0);
+    verlet_list.nbr_idxs.clear();
+    verlet_list.nbr_periodic_shifts.clear();
+
+    // Periodic images are shifted by the extent of the bounding box of the
+    // physical domain, which need not consist of a single box.
+    Pointer<CartesianGridGeometry<NDIM> > grid_geom = hierarchy->getGridGeometry();
     const double* const x_lower = grid_geom->getXLower();
     const double* const x_upper = grid_geom->getXUpper();
-
-    // we will grow the search box by interaction_radius + 2.0*regrid_alpha
-    IntVector<NDIM> grow_amount(static_cast<int>(ceil(d_interaction_radius + 2.0 * d_regrid_alpha)));
+    const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift();
+    const double cutoff = d_interaction_radius + skin;
+
+    // The nodes may have moved up to regrid_alpha cells away from the cells
+    // they were assigned to at the last regrid, so all of the nodes that
+    // interact with the nodes in a patch are within interaction_radius + skin
+    // + 2.0*regrid_alpha cells of the patch.
+    const int search_width = static_cast<int>(std::ceil(cutoff + 2.0 * d_regrid_alpha));
     const int lag_node_idx_current_idx = l_data_manager->getLNodePatchDescriptorIndex();
+    const double* const X_node = X_data->getGhostedLocalFormVecArray()->data();
 
-    // iterate through levels.
+    std::vector<int> point_petsc_idxs, point_lag_idxs, mstr_points, mstr_nbr_offsets, mstr_nbrs;
+    std::vector<double> point_X, point_periodic_shifts;
     Pointer<PatchLevel<NDIM> > level = hierarchy->getPatchLevel(level_number);
     for (PatchLevel<NDIM>::Iterator p(level); p; p++)
     {
@@ -171,76 +390,212 @@ NonbondedForceEvaluator::computeLagrangianForce(Pointer<LData> F_data,
         Pointer<LNodeSetData> current_idx_data = patch->getPatchData(lag_node_idx_current_idx);
         const Box<NDIM>& patch_box = patch->getBox();
         const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
+        const double* const patch_x_lower = patch_geom->getXLower();
         const double* const patch_dx = patch_geom->getDx();
-
-        std::vector<int> cell_offset(NDIM);
-        // Loop through cells in this processors patch. For each iteration, this
-        // is the "master" cell. Iterate through particles in the box, and add
-        // springs.
-        for (LNodeSetData::CellIterator cit(patch_box); cit; cit++)
+        for (int k = 0; k < NDIM; ++k) verlet_list.dx[k] = patch_dx[k];
+        if (current_idx_data->getGhostCellWidth().min() < search_width)
         {
-            // get list of particles in this cell
-            const hier::Index<NDIM>& first_cell_idx = *cit;
-            LNodeSet* const mstr_node_set = current_idx_data->getItem(first_cell_idx);
-            if (mstr_node_set)
+            TBOX_ERROR("NonbondedForceEvaluator::buildVerletList():\n"
+                       << "  the Lagrangian index data must have at least " << search_width << " ghost cells\n"
+                       << "  (i.e., ceil(interaction_radius + verlet_skin + 2*regrid_alpha)) but only has "
+                       << current_idx_data->getGhostCellWidth().min() << "." << std::endl);
+        }
+
+        // Collect the nodes in the patch and its ghost cells, along with the
+        // periodic shifts of the nodes in ghost cells that are images of nodes
+        // across periodic boundaries. Nodes in the patch interior are the
+        // master nodes.
+        point_petsc_idxs.clear();
+        point_lag_idxs.clear();
+        point_X.clear();
+        point_periodic_shifts.clear();
+        mstr_points.clear();
+        for (LNodeSetData::CellIterator cit(current_idx_data->getGhostBox()); cit; cit++)
+        {
+            const hier::Index<NDIM>& cell_idx = *cit;
+            LNodeSet* const node_set = current_idx_data->getItem(cell_idx);
+            if (!node_set) continue;
+            const bool is_interior = patch_box.contains(cell_idx);
+            for (const auto& node_idx : *node_set)
             {
-                Box<NDIM> search_box(first_cell_idx, first_cell_idx);
-                // loop over neighboring cells, up to interaction_radius +
-                // 2*regrid_alpha away.
-                for (LNodeSetData::CellIterator scit(Box<NDIM>::grow(search_box, grow_amount)); scit; scit++)
+                const int petsc_idx = node_idx->getLocalPETScIndex();
+                if (is_interior) mstr_points.push_back(static_cast<int>(point_petsc_idxs.size()));
+                point_petsc_idxs.push_back(petsc_idx);
+                point_lag_idxs.push_back(node_idx->getLagrangianIndex());
+                for (int k = 0; k < NDIM; ++k)
                 {
-                    // loop over particles in the neighbor cell, adding up
-                    // forces onto the particle in the "master" cell At this
-                    // point we know both cells, need to figure out periodic
-                    // additions.
-                    const hier::Index<NDIM>& search_cell_idx = *scit;
-
-                    // search across periodic boundaries.
-                    for (int k = 0; k < NDIM; ++k)
+                    double shift = 0.0;
+                    if (periodic_shift(k) != 0)
                     {
-                        // Difference between lower boundary and this search cell.
-                        double absolute_diff = search_cell_idx[k] * patch_dx[k];
-                        // Periodic offset of this cell.
-                        cell_offset[k] = floor(absolute_diff / (x_upper[k] - x_lower[k]));
+                        const double L = x_upper[k] - x_lower[k];
+                        const double x_cell =
+                            patch_x_lower[k] + (cell_idx(k) - patch_box.lower()(k) + 0.5) * patch_dx[k];
+                        shift = std::round((x_cell - X_node[NDIM * petsc_idx + k]) / L) * L;
                     }
-                    LNodeSet* search_node_set = current_idx_data->getItem(search_cell_idx);
-                    if (search_node_set)
-                    {
-                        // we have a set of nodes in the first cell and the search cell,
-                        // add up forces
-                        // and accumulate for the first cell.
-                        for (const auto& mstr_node_idx : *mstr_node_set)
-                        {
-                            // master nodes
-                            const int mstr_lag_idx = mstr_node_idx->getLagrangianIndex();
-                            const int mstr_petsc_idx = mstr_node_idx->getLocalPETScIndex();
-
-                            for (const auto& search_node_idx : *search_node_set)
-                            {
-                                const int search_lag_idx = search_node_idx->getLagrangianIndex();
-                                const int search_petsc_idx = search_node_idx->getLocalPETScIndex();
-                                if (mstr_lag_idx < search_lag_idx)
-                                {
-                                    // apply forces with the force evaluator
-                                    evaluateForces(mstr_petsc_idx, search_petsc_idx, X_data, cell_offset, F_data);
-                                }
-                            } // search node index
-                        }     // mstr node index
-                    }         // if(search node set)
-                }             // search cell loop
-            }                 // if mastr_node_idx
-        }                     // first cell
-    }                         // patches
+                    point_X.push_back(X_node[NDIM * petsc_idx + k] + shift);
+                    point_periodic_shifts.push_back(shift);
+                }
+            }
+        }
+
+        // Find the neighbors of the master nodes using a cell-linked list with
+        // bins that are cutoff cells wide. The neighbors of each master node
+        // are first counted and then stored, so that both passes may be
+        // performed concurrently while keeping the order of the neighbors
+        // independent of the number of threads.
+        double bin_width[NDIM];
+        for (int k = 0; k < NDIM; ++k) bin_width[k] = std::max(cutoff, 1.0) * patch_dx[k];
+        const CellList cell_list(point_X, bin_width);
+        const int num_mstr_points = static_cast<int>(mstr_points.size());
+        const double* const X = point_X.data();
+        const int* const lag_idxs = point_lag_idxs.data();
+        const auto is_neighbor = [=](const int i, const int j) {
+            if (lag_idxs[i] >= lag_idxs[j]) return false;
+            double r_sq = 0.0;
+            for (int k = 0; k < NDIM; ++k)
+            {
+                const double D = (X[NDIM * i + k] - X[NDIM * j + k]) / patch_dx[k];
+                r_sq += D * D;
+            }
+            return r_sq <= cutoff * cutoff;
+        };
+        mstr_nbr_offsets.assign(num_mstr_points + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (int m = 0; m < num_mstr_points; ++m)
+        {
+            const int i = mstr_points[m];
+            int num_nbrs = 0;
+            cell_list.visitNeighbors(&X[NDIM * i], [&](const int j) {
+                if (is_neighbor(i, j)) ++num_nbrs;
+            });
+            mstr_nbr_offsets[m + 1] = num_nbrs;
+        }
+        std::partial_sum(mstr_nbr_offsets.begin(), mstr_nbr_offsets.end(), mstr_nbr_offsets.begin());
+        mstr_nbrs.resize(mstr_nbr_offsets.back());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (int m = 0; m < num_mstr_points; ++m)
+        {
+            const int i = mstr_points[m];
+            int posn = mstr_nbr_offsets[m];
+            cell_list.visitNeighbors(&X[NDIM * i], [&](const int j) {
+                if (is_neighbor(i, j)) mstr_nbrs[posn++] = j;
+            });
+        }
+
+        // Append the neighbors to the list. The periodic shifts of the
+        // neighbors are relative to the master node.
+        for (int m = 0; m < num_mstr_points; ++m)
+        {
+            const int i = mstr_points[m];
+            verlet_list.mstr_idxs.push_back(point_petsc_idxs[i]);
+            for (int n = mstr_nbr_offsets[m]; n < mstr_nbr_offsets[m + 1]; ++n)
+            {
+                const int j = mstr_nbrs[n];
+                verlet_list.nbr_idxs.push_back(point_petsc_idxs[j]);
+                for (int k = 0; k < NDIM; ++k)
+                {
+                    verlet_list.nbr_periodic_shifts.push_back(point_periodic_shifts[NDIM * j + k] -
+                                                              point_periodic_shifts[NDIM * i + k]);
+                }
+            }
+            verlet_list.nbr_offsets.push_back(static_cast<int>(verlet_list.nbr_idxs.size()));
+        }
+    }
+    verlet_list.pair_forces.resize(NDIM * verlet_list.nbr_idxs.size());
+
+    // Keep the positions of the local nodes to determine when the list must be
+    // rebuilt.
+    const int num_local_nodes = l_data_manager->getNumberOfLocalNodes(level_number);
+    verlet_list.X_ref.assign(X_node, X_node + NDIM * num_local_nodes);
+    X_data->restoreArrays(/*values_modified*/ false);
+    verlet_list.is_valid = true;
     return;
-} // computeLagrangianForce
+} // buildVerletList
 
 void
-NonbondedForceEvaluator::registerForceFcnPtr(NonBddForceFcnPtr force_fcn_ptr)
+NonbondedForceEvaluator::computeVerletListForces(Pointer<LData> F_data, Pointer<LData> X_data, const int level_number)
 {
-    // set the nonbonded force function pointer to the given force function pointer
-    d_force_fcn_ptr = force_fcn_ptr;
+    VerletList& verlet_list = d_verlet_lists[level_number];
+    const int num_mstr_nodes = static_cast<int>(verlet_list.mstr_idxs.size());
+    const int* const mstr_idxs = verlet_list.mstr_idxs.data();
+    const int* const nbr_offsets = verlet_list.nbr_offsets.data();
+    const int* const nbr_idxs = verlet_list.nbr_idxs.data();
+    const double* const nbr_periodic_shifts = verlet_list.nbr_periodic_shifts.data();
+    double* const pair_forces = verlet_list.pair_forces.data();
+    const double* const X_node = X_data->getGhostedLocalFormVecArray()->data();
+    double* const F_node = F_data->getGhostedLocalFormVecArray()->data();
+
+    // The neighbors of a master node may be nonlocal nodes. Their forces are
+    // accumulated in the ghost entries of F and then added to the values on
+    // the processes that own them.
+    const int num_local_nodes = static_cast<int>(F_data->getLocalNodeCount());
+    const int num_ghost_nodes = static_cast<int>(F_data->getGhostNodeCount());
+    std::fill(F_node + NDIM * num_local_nodes, F_node + NDIM * (num_local_nodes + num_ghost_nodes), 0.0);
+
+    // The force function takes its parameters by value, and copies of a
+    // tbox::Array share a reference count that is not thread safe, so each
+    // thread passes its own deep copy of the parameters.
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    std::vector<tbox::Array<double> > thread_parameters(num_threads);
+    for (auto& parameters : thread_parameters)
+    {
+        parameters.resizeArray(d_parameters.size());
+        for (int k = 0; k < d_parameters.size(); ++k) parameters[k] = d_parameters[k];
+    }
+
+    // Compute the force generated by each pair of nodes. Different pairs may
+    // share nodes, so the forces are accumulated at the nodes afterwards in a
+    // fixed order.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int i = 0; i < num_mstr_nodes; ++i)
+    {
+        int thread_num = 0;
+#ifdef _OPENMP
+        thread_num = omp_get_thread_num();
+#endif
+        const tbox::Array<double>& parameters = thread_parameters[thread_num];
+        const int mstr_idx = mstr_idxs[i];
+        double D[NDIM];
+        for (int j = nbr_offsets[i]; j < nbr_offsets[i + 1]; ++j)
+        {
+            const int nbr_idx = nbr_idxs[j];
+            for (int k = 0; k < NDIM; ++k)
+            {
+                D[k] = X_node[mstr_idx * NDIM + k] - X_node[nbr_idx * NDIM + k] - nbr_periodic_shifts[NDIM * j + k];
+            }
+            (d_force_fcn_ptr)(D, parameters, &pair_forces[NDIM * j]);
+        }
+    }
+    for (int i = 0; i < num_mstr_nodes; ++i)
+    {
+        const int mstr_idx = mstr_idxs[i];
+        for (int j = nbr_offsets[i]; j < nbr_offsets[i + 1]; ++j)
+        {
+            const int nbr_idx = nbr_idxs[j];
+            for (int k = 0; k < NDIM; ++k)
+            {
+                F_node[mstr_idx * NDIM + k] += pair_forces[NDIM * j + k];
+                F_node[nbr_idx * NDIM + k] -= pair_forces[NDIM * j + k];
+            }
+        }
+    }
+    F_data->restoreArrays();
+    X_data->restoreArrays(/*values_modified*/ false);
+    int ierr = VecGhostUpdateBegin(F_data->getVec(), ADD_VALUES, SCATTER_REVERSE);
+    IBTK_CHKERRQ(ierr);
+    ierr = VecGhostUpdateEnd(F_data->getVec(), ADD_VALUES, SCATTER_REVERSE);
+    IBTK_CHKERRQ(ierr);
     return;
-} // registerForceFcnPtr
+} // computeVerletListForces
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -17,7 +17,6 @@
 #include "ibamr/StaggeredStokesFACPreconditionerStrategy.h"
 
 #include "ibtk/CoarseFineBoundaryRefinePatchStrategy.h"
-#include "ibtk/IBTK_CHKERRQ.h"
 
 #include "ArrayData.h"
 #include "BasePatchLevel.h"
@@ -43,15 +42,12 @@
 #include "tbox/Pointer.h"
 #include "tbox/Utilities.h"
 
-#include "petscksp.h"
-#include "petscmat.h"
-#include "petscpc.h"
-#include "petscsys.h"
-#include "petscvec.h"
+IBTK_DISABLE_EXTRA_WARNINGS
+#include <Eigen/LU>
+IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <algorithm>
 #include <array>
-#include <limits>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -70,363 +66,187 @@ namespace
 // Number of ghosts cells used for each variable quantity.
 static const int GHOSTS = 1;
 
-inline int
-compute_side_index(const hier::Index<NDIM>& i, const Box<NDIM>& box, const unsigned int axis)
-{
-    const Box<NDIM> side_box = SideGeometry<NDIM>::toSideBox(box, axis);
-    if (!side_box.contains(i)) return -1;
-    int offset = 0;
-    for (unsigned int d = 0; d < axis; ++d)
-    {
-        offset += SideGeometry<NDIM>::toSideBox(box, d).size();
-    }
-    return offset + side_box.offset(i);
-} // compute_side_index
+// Number of unknowns in each box: the normal velocities on the sides of a cell
+// and the pressure at its center. The velocity on side "side" (0 for the lower
+// side, 1 for the upper side) normal to direction "axis" is unknown 2 * axis +
+// side and the pressure is the last unknown.
+static const int BOX_SIZE = 2 * NDIM + 1;
+static const int BOX_P_INDEX = 2 * NDIM;
+
+// Number of colors used by the multicolor ordering. The box solve for a cell
+// reads values up to two cells away, so cells are colored by their indices
+// modulo three in each direction.
+static const int NUM_COLORS = NDIM == 2 ? 9 : 27;
+
+// Number of boxes solved at once by applyBoxOperatorInverse().
+static const int BATCH_SIZE = 64;
+
+// Colors with fewer cells than this are smoothed by a single thread, since
+// starting a parallel region costs more than the box solves themselves.
+static const int MIN_THREADED_COLOR_SIZE = 1024;
+
+// Under-relaxation parameter.
+static const double OMEGA = 0.65;
 
 inline int
-compute_cell_index(const hier::Index<NDIM>& i, const Box<NDIM>& box)
+compute_color(const hier::Index<NDIM>& i)
 {
-    if (!box.contains(i)) return -1;
-    int offset = 0;
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    int color = 0;
+    for (int d = NDIM - 1; d >= 0; --d)
     {
-        offset += SideGeometry<NDIM>::toSideBox(box, axis).size();
+        color = 3 * color + ((i(d) % 3) + 3) % 3;
     }
-    return box.offset(i) + offset;
-} // compute_cell_index
+    return color;
+} // compute_color
 
 void
-buildBoxOperator(Mat& A,
-                 const PoissonSpecifications& U_problem_coefs,
-                 const Box<NDIM>& box,
-                 const Box<NDIM>& ghost_box,
-                 const std::array<double, NDIM>& dx)
+buildBoxOperatorInverse(std::vector<double>& A_inv,
+                        const PoissonSpecifications& U_problem_coefs,
+                        const std::array<double, NDIM>& dx)
 {
-    int ierr;
-
     const double C = U_problem_coefs.getCConstant();
     const double D = U_problem_coefs.getDConstant();
 
-    // Allocate a PETSc matrix for the box operator.
-    std::array<Box<NDIM>, NDIM> side_boxes;
-    std::array<BoxList<NDIM>, NDIM> side_ghost_boxes;
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
-    {
-        side_boxes[axis] = SideGeometry<NDIM>::toSideBox(box, axis);
-        side_ghost_boxes[axis] = SideGeometry<NDIM>::toSideBox(ghost_box, axis);
-        side_ghost_boxes[axis].removeIntersections(side_boxes[axis]);
-    }
-    BoxList<NDIM> cell_ghost_boxes(ghost_box);
-    cell_ghost_boxes.removeIntersections(box);
-
-    int size = 0;
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
-    {
-        size += SideGeometry<NDIM>::toSideBox(ghost_box, axis).size();
-    }
-    size += ghost_box.size();
-
-    static const int U_stencil_sz = 2 * NDIM + 3;
-    static const int P_stencil_sz = 2 * NDIM + 1;
-    std::vector<int> nnz(size, 0);
-
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
-    {
-        for (Box<NDIM>::Iterator b(side_boxes[axis]); b; b++)
-        {
-            nnz[compute_side_index(b(), ghost_box, axis)] = std::min(size, U_stencil_sz);
-        }
-        for (BoxList<NDIM>::Iterator bl(side_ghost_boxes[axis]); bl; bl++)
-        {
-            for (Box<NDIM>::Iterator b(bl()); b; b++)
-            {
-                nnz[compute_side_index(b(), ghost_box, axis)] = 1;
-            }
-        }
-    }
-
-    for (Box<NDIM>::Iterator b(box); b; b++)
-    {
-        nnz[compute_cell_index(b(), ghost_box)] = std::min(size, P_stencil_sz);
-    }
-    for (BoxList<NDIM>::Iterator bl(cell_ghost_boxes); bl; bl++)
-    {
-        for (Box<NDIM>::Iterator b(bl()); b; b++)
-        {
-            nnz[compute_cell_index(b(), ghost_box)] = 1;
-        }
-    }
-
-    ierr = MatCreateSeqAIJ(PETSC_COMM_SELF, size, size, 0, size ? &nnz[0] : nullptr, &A);
-    IBTK_CHKERRQ(ierr);
-
-// Set some general matrix options.
-#if !defined(NDEBUG)
-    ierr = MatSetOption(A, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE);
-    IBTK_CHKERRQ(ierr);
-    ierr = MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
-    IBTK_CHKERRQ(ierr);
-#endif
-
     // Set the matrix coefficients to correspond to the standard finite
     // difference approximation to the time-dependent incompressible Stokes
-    // operator.
+    // operator restricted to a single cell.
     //
     // Note that boundary conditions at both physical boundaries and at
     // coarse-fine interfaces are implicitly treated by setting ghost cell
     // values appropriately.  Thus the matrix coefficients are independent of
-    // any boundary conditions.
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    // any boundary conditions, and the operator is the same for every cell on
+    // a level.
+    Eigen::Matrix<double, BOX_SIZE, BOX_SIZE> A(Eigen::Matrix<double, BOX_SIZE, BOX_SIZE>::Zero());
+    double diag = C;
+    for (unsigned int d = 0; d < NDIM; ++d)
     {
-        for (Box<NDIM>::Iterator b(side_boxes[axis]); b; b++)
-        {
-            hier::Index<NDIM> i = b();
-            const int mat_row = compute_side_index(i, ghost_box, axis);
-
-            std::vector<int> mat_cols(U_stencil_sz, -1);
-            std::vector<double> mat_vals(U_stencil_sz, 0.0);
-
-            mat_cols[0] = mat_row;
-            mat_vals[0] = C;
-
-            for (unsigned int d = 0; d < NDIM; ++d)
-            {
-                hier::Index<NDIM> shift = 0;
-                shift(d) = 1;
-                const hier::Index<NDIM> u_left = i - shift;
-                const hier::Index<NDIM> u_rght = i + shift;
-                mat_cols[2 * d + 1] = compute_side_index(u_left, ghost_box, axis);
-                mat_cols[2 * d + 2] = compute_side_index(u_rght, ghost_box, axis);
-
-                mat_vals[0] -= 2.0 * D / (dx[d] * dx[d]);
-                mat_vals[2 * d + 1] = D / (dx[d] * dx[d]);
-                mat_vals[2 * d + 2] = D / (dx[d] * dx[d]);
-            }
-
-            hier::Index<NDIM> shift = 0;
-            shift(axis) = 1;
-            const hier::Index<NDIM> p_left = i - shift;
-            const hier::Index<NDIM> p_rght = i;
-            mat_cols[2 * NDIM + 1] = compute_cell_index(p_left, ghost_box);
-            mat_cols[2 * NDIM + 2] = compute_cell_index(p_rght, ghost_box);
-
-            mat_vals[2 * NDIM + 1] = -1.0 / dx[axis];
-            mat_vals[2 * NDIM + 2] = 1.0 / dx[axis];
-
-            static const int m = 1;
-            static const int n = U_stencil_sz;
-            ierr = MatSetValues(A, m, &mat_row, n, &mat_cols[0], &mat_vals[0], INSERT_VALUES);
-            IBTK_CHKERRQ(ierr);
-        }
+        diag -= 2.0 * D / (dx[d] * dx[d]);
     }
-
-    for (Box<NDIM>::Iterator b(box); b; b++)
+    for (unsigned int axis = 0; axis < NDIM; ++axis)
     {
-        hier::Index<NDIM> i = b();
-        const int mat_row = compute_cell_index(i, ghost_box);
-
-        std::vector<int> mat_cols(P_stencil_sz, -1);
-        std::vector<double> mat_vals(P_stencil_sz, 0.0);
-
-        mat_cols[0] = mat_row;
-        mat_vals[0] = 0.0;
-
-        for (unsigned int axis = 0; axis < NDIM; ++axis)
-        {
-            hier::Index<NDIM> shift = 0;
-            shift(axis) = 1;
-            const hier::Index<NDIM> u_left = i;
-            const hier::Index<NDIM> u_rght = i + shift;
-            mat_cols[2 * axis + 1] = compute_side_index(u_left, ghost_box, axis);
-            mat_cols[2 * axis + 2] = compute_side_index(u_rght, ghost_box, axis);
-
-            mat_vals[2 * axis + 1] = 1.0 / dx[axis];
-            mat_vals[2 * axis + 2] = -1.0 / dx[axis];
-        }
-
-        static const int m = 1;
-        static const int n = P_stencil_sz;
-        ierr = MatSetValues(A, m, &mat_row, n, &mat_cols[0], &mat_vals[0], INSERT_VALUES);
-        IBTK_CHKERRQ(ierr);
+        const int lower = 2 * axis, upper = 2 * axis + 1;
+        A(lower, lower) = diag;
+        A(upper, upper) = diag;
+        A(lower, upper) = D / (dx[axis] * dx[axis]);
+        A(upper, lower) = D / (dx[axis] * dx[axis]);
+        A(lower, BOX_P_INDEX) = 1.0 / dx[axis];
+        A(upper, BOX_P_INDEX) = -1.0 / dx[axis];
+        A(BOX_P_INDEX, lower) = 1.0 / dx[axis];
+        A(BOX_P_INDEX, upper) = -1.0 / dx[axis];
     }
 
-    // Set the entries in the ghost cell region so that ghost cell values are
-    // not modified by the smoother.
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    const Eigen::FullPivLU<Eigen::Matrix<double, BOX_SIZE, BOX_SIZE> > lu(A);
+    if (!lu.isInvertible())
     {
-        for (BoxList<NDIM>::Iterator bl(side_ghost_boxes[axis]); bl; bl++)
-        {
-            for (Box<NDIM>::Iterator b(bl()); b; b++)
-            {
-                const int i = compute_side_index(b(), ghost_box, axis);
-                ierr = MatSetValue(A, i, i, 1.0, INSERT_VALUES);
-                IBTK_CHKERRQ(ierr);
-            }
-        }
+        TBOX_ERROR("StaggeredStokesBoxRelaxationFACOperator::initializeOperatorStateSpecialized():\n"
+                   << "  box operator is singular" << std::endl);
     }
-
-    for (BoxList<NDIM>::Iterator bl(cell_ghost_boxes); bl; bl++)
+    const Eigen::Matrix<double, BOX_SIZE, BOX_SIZE> A_inv_mat = lu.inverse();
+    A_inv.resize(BOX_SIZE * BOX_SIZE);
+    for (int k = 0; k < BOX_SIZE; ++k)
     {
-        for (Box<NDIM>::Iterator b(bl()); b; b++)
+        for (int l = 0; l < BOX_SIZE; ++l)
         {
-            const int i = compute_cell_index(b(), ghost_box);
-            ierr = MatSetValue(A, i, i, 1.0, INSERT_VALUES);
-            IBTK_CHKERRQ(ierr);
+            A_inv[k * BOX_SIZE + l] = A_inv_mat(k, l);
         }
     }
-
-    // Assemble the matrices.
-    ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
-    IBTK_CHKERRQ(ierr);
-    ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
-    IBTK_CHKERRQ(ierr);
     return;
-} // buildBoxOperator
+} // buildBoxOperatorInverse
 
-void
-modifyRhsForBcs(Vec& v,
-                const SideData<NDIM, double>& U_data,
-                const CellData<NDIM, double>& P_data,
-                const PoissonSpecifications& U_problem_coefs,
-                const Box<NDIM>& box,
-                const Box<NDIM>& ghost_box,
-                const double* const dx)
+// Compute the right-hand side of the box system for cell i, i.e., the residual
+// with the couplings to values outside of the box moved to the right-hand side,
+// and store component k in r[k * stride].
+inline void
+copyToBoxRhs(double* const r,
+             const int stride,
+             const hier::Index<NDIM>& i,
+             const SideData<NDIM, double>& U_error_data,
+             const CellData<NDIM, double>& P_error_data,
+             const SideData<NDIM, double>& U_residual_data,
+             const CellData<NDIM, double>& P_residual_data,
+             const double D,
+             const double* const dx)
 {
-    int ierr;
-
-    const double D = U_problem_coefs.getDConstant();
     for (unsigned int axis = 0; axis < NDIM; ++axis)
     {
-        const Box<NDIM> side_box = SideGeometry<NDIM>::toSideBox(box, axis);
-        for (Box<NDIM>::Iterator b(side_box); b; b++)
+        hier::Index<NDIM> axis_shift = 0;
+        axis_shift(axis) = 1;
+        for (int side = 0; side <= 1; ++side)
         {
-            hier::Index<NDIM> i = b();
-            const int idx = compute_side_index(i, ghost_box, axis);
-
+            const hier::Index<NDIM> f = side == 0 ? i : i + axis_shift;
+            double rhs = U_residual_data(SideIndex<NDIM>(f, axis, SideIndex<NDIM>::Lower));
             for (unsigned int d = 0; d < NDIM; ++d)
             {
                 hier::Index<NDIM> shift = 0;
                 shift(d) = 1;
-                const hier::Index<NDIM> u_left = i - shift;
-                const hier::Index<NDIM> u_rght = i + shift;
-                if (!side_box.contains(u_left))
+                const double D_over_dx_sq = D / (dx[d] * dx[d]);
+                if (d != axis || side == 0)
                 {
-                    ierr = VecSetValue(v,
-                                       idx,
-                                       +D * U_data(SideIndex<NDIM>(u_left, axis, SideIndex<NDIM>::Lower)) /
-                                           (dx[d] * dx[d]),
-                                       ADD_VALUES);
-                    IBTK_CHKERRQ(ierr);
+                    rhs += D_over_dx_sq * U_error_data(SideIndex<NDIM>(f - shift, axis, SideIndex<NDIM>::Lower));
                 }
-                if (!side_box.contains(u_rght))
+                if (d != axis || side == 1)
                 {
-                    ierr = VecSetValue(v,
-                                       idx,
-                                       +D * U_data(SideIndex<NDIM>(u_rght, axis, SideIndex<NDIM>::Lower)) /
-                                           (dx[d] * dx[d]),
-                                       ADD_VALUES);
-                    IBTK_CHKERRQ(ierr);
+                    rhs += D_over_dx_sq * U_error_data(SideIndex<NDIM>(f + shift, axis, SideIndex<NDIM>::Lower));
                 }
             }
-
-            hier::Index<NDIM> shift = 0;
-            shift(axis) = 1;
-            const hier::Index<NDIM> p_left = i - shift;
-            const hier::Index<NDIM> p_rght = i;
-            if (!box.contains(p_left))
+            if (side == 0)
             {
-                ierr = VecSetValue(v, idx, +P_data(p_left) / dx[axis], ADD_VALUES);
-                IBTK_CHKERRQ(ierr);
+                rhs += P_error_data(i - axis_shift) / dx[axis];
             }
-            if (!box.contains(p_rght))
+            else
             {
-                ierr = VecSetValue(v, idx, -P_data(p_rght) / dx[axis], ADD_VALUES);
-                IBTK_CHKERRQ(ierr);
+                rhs -= P_error_data(i + axis_shift) / dx[axis];
             }
+            r[(2 * axis + side) * stride] = rhs;
         }
     }
-
-    ierr = VecAssemblyBegin(v);
-    IBTK_CHKERRQ(ierr);
-    ierr = VecAssemblyEnd(v);
-    IBTK_CHKERRQ(ierr);
+    r[BOX_P_INDEX * stride] = P_residual_data(i);
     return;
-} // modifyRhsForBcs
+} // copyToBoxRhs
 
+// Update the values in cell i with the solution of the box system, whose
+// component k is stored in x[k * stride].
 inline void
-copyToVec(Vec& v,
-          const SideData<NDIM, double>& U_data,
-          const CellData<NDIM, double>& P_data,
-          const Box<NDIM>& box,
-          const Box<NDIM>& ghost_box)
+copyFromBoxSolution(const double* const x,
+                    const int stride,
+                    const hier::Index<NDIM>& i,
+                    SideData<NDIM, double>& U_error_data,
+                    CellData<NDIM, double>& P_error_data)
 {
-    int ierr;
-
     for (unsigned int axis = 0; axis < NDIM; ++axis)
     {
-        const Box<NDIM> side_box = SideGeometry<NDIM>::toSideBox(box, axis);
-        for (Box<NDIM>::Iterator b(side_box); b; b++)
+        for (int side = 0; side <= 1; ++side)
         {
-            const hier::Index<NDIM>& i = b();
-            const SideIndex<NDIM> s_i(i, axis, 0);
-            const int idx = compute_side_index(i, ghost_box, axis);
-            ierr = VecSetValue(v, idx, U_data(s_i), INSERT_VALUES);
-            IBTK_CHKERRQ(ierr);
+            const SideIndex<NDIM> s_i(i, axis, side);
+            U_error_data(s_i) = (1.0 - OMEGA) * U_error_data(s_i) + OMEGA * x[(2 * axis + side) * stride];
         }
     }
-
-    for (Box<NDIM>::Iterator b(box); b; b++)
-    {
-        const hier::Index<NDIM>& i = b();
-        const int idx = compute_cell_index(i, ghost_box);
-        ierr = VecSetValue(v, idx, P_data(i), INSERT_VALUES);
-        IBTK_CHKERRQ(ierr);
-    }
-
-    ierr = VecAssemblyBegin(v);
-    IBTK_CHKERRQ(ierr);
-    ierr = VecAssemblyEnd(v);
-    IBTK_CHKERRQ(ierr);
+    P_error_data(i) = (1.0 - OMEGA) * P_error_data(i) + OMEGA * x[BOX_P_INDEX * stride];
     return;
-} // copyToVec
+} // copyFromBoxSolution
 
+// Compute x = A_inv r for n_boxes right-hand sides stored component by
+// component, i.e., component k of box b is entry k * n_boxes + b. The inner
+// loop runs over the boxes and is vectorized by the compiler.
 inline void
-copyFromVec(Vec& v,
-            SideData<NDIM, double>& U_data,
-            CellData<NDIM, double>& P_data,
-            const Box<NDIM>& box,
-            const Box<NDIM>& ghost_box)
+applyBoxOperatorInverse(const std::vector<double>& A_inv, const double* const r, double* const x, const int n_boxes)
 {
-    int ierr;
-
-    const double omega = 0.65;
-
-    double U;
-    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    std::fill(x, x + BOX_SIZE * n_boxes, 0.0);
+    for (int k = 0; k < BOX_SIZE; ++k)
     {
-        const Box<NDIM> side_box = SideGeometry<NDIM>::toSideBox(box, axis);
-        for (Box<NDIM>::Iterator b(side_box); b; b++)
+        double* const x_k = x + k * n_boxes;
+        for (int l = 0; l < BOX_SIZE; ++l)
         {
-            const hier::Index<NDIM>& i = b();
-            const SideIndex<NDIM> s_i(i, axis, SideIndex<NDIM>::Lower);
-            const int idx = compute_side_index(i, ghost_box, axis);
-            ierr = VecGetValues(v, 1, &idx, &U);
-            IBTK_CHKERRQ(ierr);
-            U_data(s_i) = (1.0 - omega) * U_data(s_i) + omega * U;
+            const double a = A_inv[k * BOX_SIZE + l];
+            const double* const r_l = r + l * n_boxes;
+            for (int b = 0; b < n_boxes; ++b)
+            {
+                x_k[b] += a * r_l[b];
+            }
         }
     }
-
-    double P;
-    for (Box<NDIM>::Iterator b(box); b; b++)
-    {
-        const hier::Index<NDIM>& i = b();
-        const int idx = compute_cell_index(i, ghost_box);
-        ierr = VecGetValues(v, 1, &idx, &P);
-        IBTK_CHKERRQ(ierr);
-        P_data(i) = (1.0 - omega) * P_data(i) + omega * P;
-    }
     return;
-} // copyFromVec
+} // applyBoxOperatorInverse
 } // namespace
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -437,7 +257,11 @@ StaggeredStokesBoxRelaxationFACOperator::StaggeredStokesBoxRelaxationFACOperator
     const std::string& default_options_prefix)
     : StaggeredStokesFACPreconditionerStrategy(object_name, GHOSTS, input_db, default_options_prefix)
 {
-    // intentionally blank
+    if (input_db)
+    {
+        if (input_db->keyExists("use_multicolor_ordering"))
+            d_use_multicolor_ordering = input_db->getBool("use_multicolor_ordering");
+    }
     return;
 } // StaggeredStokesBoxRelaxationFACOperator
 
@@ -457,7 +281,6 @@ StaggeredStokesBoxRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, doub
 {
     if (num_sweeps == 0) return;
 
-    int ierr;
     Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_num);
     const int U_error_idx = error.getComponentDescriptorIndex(0);
     const int P_error_idx = error.getComponentDescriptorIndex(1);
@@ -570,9 +393,8 @@ StaggeredStokesBoxRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, doub
         }
 
         // Smooth the error on the patches.
-        Vec& e = d_box_e[level_num];
-        Vec& r = d_box_r[level_num];
-        KSP& ksp = d_box_ksp[level_num];
+        const std::vector<double>& A_inv = d_box_op_inv[level_num];
+        const double D = d_U_problem_coefs.getDConstant();
         int patch_counter = 0;
         for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++patch_counter)
         {
@@ -597,16 +419,51 @@ StaggeredStokesBoxRelaxationFACOperator::smoothError(SAMRAIVectorReal<NDIM, doub
             const Box<NDIM>& patch_box = patch->getBox();
             const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
             const double* const dx = pgeom->getDx();
-            for (Box<NDIM>::Iterator b(patch_box); b; b++)
+            SideData<NDIM, double>& U_error = *U_error_data;
+            CellData<NDIM, double>& P_error = *P_error_data;
+            const SideData<NDIM, double>& U_residual = *U_residual_data;
+            const CellData<NDIM, double>& P_residual = *P_residual_data;
+            if (d_use_multicolor_ordering)
             {
-                const hier::Index<NDIM>& i = b();
-                const Box<NDIM> box(i, i);
-                copyToVec(e, *U_error_data, *P_error_data, box, box);
-                copyToVec(r, *U_residual_data, *P_residual_data, box, box);
-                modifyRhsForBcs(r, *U_error_data, *P_error_data, d_U_problem_coefs, box, box, dx);
-                ierr = KSPSolve(ksp, r, e);
-                IBTK_CHKERRQ(ierr);
-                copyFromVec(e, *U_error_data, *P_error_data, box, box);
+                // Cells of the same color do not share any of the values read
+                // or written by their box solves, so the cells of each color
+                // may be processed in batches and concurrently.
+                for (const std::vector<hier::Index<NDIM> >& cells : d_patch_colored_cells[level_num][patch_counter])
+                {
+                    const int n_cells = static_cast<int>(cells.size());
+                    const int n_batches = (n_cells + BATCH_SIZE - 1) / BATCH_SIZE;
+                    const bool threaded = n_cells >= MIN_THREADED_COLOR_SIZE;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (threaded)
+#endif
+                    for (int batch = 0; batch < n_batches; ++batch)
+                    {
+                        std::array<double, BOX_SIZE * BATCH_SIZE> r, x;
+                        const int first_cell = batch * BATCH_SIZE;
+                        const int n_boxes = std::min(BATCH_SIZE, n_cells - first_cell);
+                        for (int b = 0; b < n_boxes; ++b)
+                        {
+                            copyToBoxRhs(
+                                &r[b], n_boxes, cells[first_cell + b], U_error, P_error, U_residual, P_residual, D, dx);
+                        }
+                        applyBoxOperatorInverse(A_inv, r.data(), x.data(), n_boxes);
+                        for (int b = 0; b < n_boxes; ++b)
+                        {
+                            copyFromBoxSolution(&x[b], n_boxes, cells[first_cell + b], U_error, P_error);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                std::array<double, BOX_SIZE> r, x;
+                for (Box<NDIM>::Iterator b(patch_box); b; b++)
+                {
+                    const hier::Index<NDIM>& i = b();
+                    copyToBoxRhs(r.data(), 1, i, U_error, P_error, U_residual, P_residual, D, dx);
+                    applyBoxOperatorInverse(A_inv, r.data(), x.data(), 1);
+                    copyFromBoxSolution(x.data(), 1, i, U_error, P_error);
+                }
             }
         }
     }
@@ -627,11 +484,7 @@ StaggeredStokesBoxRelaxationFACOperator::initializeOperatorStateSpecialized(cons
                                                                             const int finest_reset_ln)
 {
     // Initialize the box relaxation data on each level of the patch hierarchy.
-    d_box_op.resize(d_finest_ln + 1);
-    d_box_e.resize(d_finest_ln + 1);
-    d_box_r.resize(d_finest_ln + 1);
-    d_box_ksp.resize(d_finest_ln + 1);
-    const Box<NDIM> box(hier::Index<NDIM>(0), hier::Index<NDIM>(0));
+    d_box_op_inv.resize(d_finest_ln + 1);
     Pointer<CartesianGridGeometry<NDIM> > geometry = d_hierarchy->getGridGeometry();
     const double* const dx_coarsest = geometry->getDx();
     std::array<double, NDIM> dx;
@@ -642,27 +495,31 @@ StaggeredStokesBoxRelaxationFACOperator::initializeOperatorStateSpecialized(cons
         {
             dx[d] = dx_coarsest[d] / static_cast<double>(ratio(d));
         }
-        buildBoxOperator(d_box_op[ln], d_U_problem_coefs, box, box, dx);
-        int ierr;
-        ierr = MatCreateVecs(d_box_op[ln], &d_box_e[ln], &d_box_r[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPCreate(PETSC_COMM_SELF, &d_box_ksp[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPSetOperators(d_box_ksp[ln], d_box_op[ln], d_box_op[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPSetReusePreconditioner(d_box_ksp[ln], PETSC_TRUE);
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPSetType(d_box_ksp[ln], KSPPREONLY);
-        IBTK_CHKERRQ(ierr);
-        PC box_pc;
-        ierr = KSPGetPC(d_box_ksp[ln], &box_pc);
-        IBTK_CHKERRQ(ierr);
-        ierr = PCSetType(box_pc, PCLU);
-        IBTK_CHKERRQ(ierr);
-        ierr = PCFactorReorderForNonzeroDiagonal(box_pc, std::numeric_limits<double>::epsilon());
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPSetUp(d_box_ksp[ln]);
-        IBTK_CHKERRQ(ierr);
+        buildBoxOperatorInverse(d_box_op_inv[ln], d_U_problem_coefs, dx);
+    }
+
+    // Sort the cells of each patch by color for the multicolor ordering.
+    d_patch_colored_cells.resize(d_finest_ln + 1);
+    if (d_use_multicolor_ordering)
+    {
+        for (int ln = coarsest_reset_ln; ln <= finest_reset_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
+            const int num_local_patches = level->getProcessorMapping().getLocalIndices().getSize();
+            d_patch_colored_cells[ln].clear();
+            d_patch_colored_cells[ln].resize(num_local_patches);
+            int patch_counter = 0;
+            for (PatchLevel<NDIM>::Iterator p(level); p; p++, ++patch_counter)
+            {
+                Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                auto& colored_cells = d_patch_colored_cells[ln][patch_counter];
+                colored_cells.resize(NUM_COLORS);
+                for (Box<NDIM>::Iterator b(patch->getBox()); b; b++)
+                {
+                    colored_cells[compute_color(b())].push_back(b());
+                }
+            }
+        }
     }
 
     // Get overlap information for setting patch boundary conditions.
@@ -716,15 +573,8 @@ StaggeredStokesBoxRelaxationFACOperator::deallocateOperatorStateSpecialized(cons
     if (!d_is_initialized) return;
     for (int ln = coarsest_reset_ln; ln <= std::min(d_finest_ln, finest_reset_ln); ++ln)
     {
-        int ierr;
-        ierr = MatDestroy(&d_box_op[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = VecDestroy(&d_box_e[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = VecDestroy(&d_box_r[ln]);
-        IBTK_CHKERRQ(ierr);
-        ierr = KSPDestroy(&d_box_ksp[ln]);
-        IBTK_CHKERRQ(ierr);
+        d_box_op_inv[ln].clear();
+        d_patch_colored_cells[ln].clear();
         d_patch_side_bc_box_overlap[ln].resize(0);
         d_patch_cell_bc_box_overlap[ln].resize(0);
     }
@@ -38,6 +38,7 @@
 #include <ibtk/IBTK_MPI.h>
 #include <ibtk/LData.h>
 #include <ibtk/LDataManager.h>
+#include <ibtk/LEInteractor.h>
 #include <ibtk/muParserCartGridFunction.h>
 #include <ibtk/muParserRobinBcCoefs.h>
 
@@ -237,6 +238,10 @@ main(int argc, char* argv[])
         // and enable file logging.
         Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "IB.log");
         Pointer<Database> input_db = app_initializer->getInputDatabase();
+        if (input_db->keyExists("LEInteractor"))
+        {
+            LEInteractor::setFromDatabase(app_initializer->getComponentDatabase("LEInteractor"));
+        }
 
         const bool dump_restart_data = app_initializer->dumpRestartData();
         const int restart_dump_interval = app_initializer->getRestartDumpInterval();
@@ -304,7 +309,10 @@ main(int argc, char* argv[])
         ib_initializer->registerInitStructureFunction(generate_structure);
         ib_initializer->registerInitSpringDataFunction(generate_springs);
         ib_method_ops->registerLInitStrategy(ib_initializer);
-        Pointer<IBStandardForceGen> ib_force_fcn = new IBStandardForceGen();
+        Pointer<Database> force_gen_db = input_db->isDatabase("IBStandardForceGen") ?
+                                             input_db->getDatabase("IBStandardForceGen") :
+                                             Pointer<Database>(nullptr);
+        Pointer<IBStandardForceGen> ib_force_fcn = new IBStandardForceGen(force_gen_db);
         ib_method_ops->registerIBLagrangianForceFunction(ib_force_fcn);
 
         // Create Eulerian initial condition specification objects.  These
@@ -0,0 +1,257 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+#include <petscvec.h>
+
+// Headers for basic SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <RefineAlgorithm.h>
+#include <SAMRAIVectorReal.h>
+#include <SideVariable.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/IBLinearizedCouplingOperator.h>
+#include <ibamr/IBMethod.h>
+#include <ibamr/IBStandardForceGen.h>
+#include <ibamr/IBStandardInitializer.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <fstream>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// Apply IBLinearizedCouplingOperator, which evaluates f = alpha*S*A*J*u with
+// IBMethod::applyLinearizedCouplingOperator(), to a smooth velocity field and
+// compare the result to the sequence of IBImplicitStrategy calls that
+// IBImplicitStaggeredHierarchyIntegrator::IBJacobianApply_velocity() used
+// before the operator was introduced. The structure is the elastic curve used
+// by explicit_ex1, and the coefficients are those of the midpoint rule.
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // IBStandardInitializer reads the structure from the working directory.
+    if (IBTK_MPI::getRank() == 0)
+    {
+        std::ifstream structure_vertex_stream(SOURCE_DIR "/curve2d_64.vertex");
+        std::ofstream structure_vertex_cwd("curve2d_64.vertex");
+        structure_vertex_cwd << structure_vertex_stream.rdbuf();
+        std::ifstream structure_spring_stream(SOURCE_DIR "/curve2d_64.spring");
+        std::ofstream structure_spring_cwd("curve2d_64.spring");
+        structure_spring_cwd << structure_spring_stream.rdbuf();
+    }
+    IBTK_MPI::barrier();
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "IB.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<INSHierarchyIntegrator> navier_stokes_integrator = new INSStaggeredHierarchyIntegrator(
+            "INSStaggeredHierarchyIntegrator",
+            app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+        Pointer<IBMethod> ib_method_ops = new IBMethod("IBMethod", app_initializer->getComponentDatabase("IBMethod"));
+        Pointer<IBHierarchyIntegrator> time_integrator =
+            new IBExplicitHierarchyIntegrator("IBHierarchyIntegrator",
+                                              app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+                                              ib_method_ops,
+                                              navier_stokes_integrator);
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector =
+            new StandardTagAndInitialize<NDIM>("StandardTagAndInitialize",
+                                               time_integrator,
+                                               app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+
+        // Configure the IB solver.
+        Pointer<IBStandardInitializer> ib_initializer = new IBStandardInitializer(
+            "IBStandardInitializer", app_initializer->getComponentDatabase("IBStandardInitializer"));
+        ib_method_ops->registerLInitStrategy(ib_initializer);
+        Pointer<IBStandardForceGen> ib_force_fcn = new IBStandardForceGen();
+        ib_method_ops->registerIBLagrangianForceFunction(ib_force_fcn);
+
+        // Create Eulerian initial condition specification objects. The fluid
+        // is never advanced, but they are needed to initialize the patch
+        // hierarchy. The domain is periodic, so no boundary conditions are
+        // required.
+        Pointer<CartGridFunction> u_init = new muParserCartGridFunction(
+            "u_init", app_initializer->getComponentDatabase("VelocityInitialConditions"), grid_geometry);
+        navier_stokes_integrator->registerVelocityInitialConditions(u_init);
+
+        // Initialize hierarchy configuration and data on all patches.
+        time_integrator->initializePatchHierarchy(patch_hierarchy, gridding_algorithm);
+        ib_method_ops->freeLInitStrategy();
+        ib_initializer.setNull();
+
+        // Set up the Eulerian velocity and force data. The scratch data have
+        // the ghost cells required by the interpolation and spreading
+        // operators.
+        const int coarsest_ln = 0;
+        const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+        TBOX_ASSERT(finest_ln == coarsest_ln);
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("linearized_coupling_01");
+        Pointer<VariableContext> scratch_ctx = var_db->getContext("linearized_coupling_01::scratch");
+        Pointer<SideVariable<NDIM, double> > u_var = new SideVariable<NDIM, double>("linearized_coupling_01::u");
+        Pointer<SideVariable<NDIM, double> > f_var = new SideVariable<NDIM, double>("linearized_coupling_01::f");
+        const IntVector<NDIM>& ghost_width = ib_method_ops->getMinimumGhostCellWidth();
+        const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(0));
+        const int u_scratch_idx = var_db->registerVariableAndContext(u_var, scratch_ctx, ghost_width);
+        const int f_idx = var_db->registerVariableAndContext(f_var, ctx, IntVector<NDIM>(0));
+        const int f_scratch_idx = var_db->registerVariableAndContext(f_var, scratch_ctx, ghost_width);
+        const int f_inline_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+        const int f_repeat_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+        for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->allocatePatchData(u_idx, 0.0);
+            level->allocatePatchData(u_scratch_idx, 0.0);
+            level->allocatePatchData(f_idx, 0.0);
+            level->allocatePatchData(f_scratch_idx, 0.0);
+            level->allocatePatchData(f_inline_idx, 0.0);
+            level->allocatePatchData(f_repeat_idx, 0.0);
+        }
+        muParserCartGridFunction u_fcn("u_fcn", app_initializer->getComponentDatabase("VelocityFunction"), grid_geometry);
+        u_fcn.setDataOnPatchHierarchy(u_idx, u_var, patch_hierarchy, 0.0);
+        HierarchySideDataOpsReal<NDIM, double> hier_sc_data_ops(patch_hierarchy, coarsest_ln, finest_ln);
+
+        // Set up the schedules that fill the ghost cells of the velocity
+        // scratch data.
+        RefineAlgorithm<NDIM> ghost_fill_alg;
+        ghost_fill_alg.registerRefine(u_scratch_idx, u_scratch_idx, u_scratch_idx, nullptr);
+        std::vector<Pointer<RefineSchedule<NDIM> > > u_ghost_fill_scheds(finest_ln + 1);
+        for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+        {
+            u_ghost_fill_scheds[ln] = ghost_fill_alg.createSchedule(patch_hierarchy->getPatchLevel(ln));
+        }
+        const std::vector<Pointer<CoarsenSchedule<NDIM> > > u_synch_scheds;
+        const std::vector<Pointer<RefineSchedule<NDIM> > > f_prolongation_scheds;
+
+        // Set up the linearized IB problem at the beginning of the first time
+        // step, using the midpoint rule.
+        const double current_time = time_integrator->getIntegratorTime();
+        const double dt = input_db->getDouble("DT");
+        const double new_time = current_time + dt;
+        const double half_time = current_time + 0.5 * dt;
+        const double kappa = 0.5;
+        ib_method_ops->preprocessIntegrateData(current_time, new_time, /*num_cycles*/ 1);
+        Vec X_current;
+        ib_method_ops->createSolverVecs(&X_current, nullptr);
+        ib_method_ops->setupSolverVecs(&X_current, nullptr);
+        ib_method_ops->setLinearizedPosition(X_current, half_time);
+        VecDestroy(&X_current);
+
+        // Compute f = -kappa*S*A*X with X = dt*kappa*J*u as
+        // IBJacobianApply_velocity() used to.
+        {
+            Vec X, X0;
+            ib_method_ops->createSolverVecs(&X, &X0);
+            ib_method_ops->setupSolverVecs(nullptr, &X0);
+            hier_sc_data_ops.scale(u_scratch_idx, -kappa, u_idx);
+            ib_method_ops->interpolateLinearizedVelocity(
+                u_scratch_idx, u_synch_scheds, u_ghost_fill_scheds, half_time);
+            ib_method_ops->computeLinearizedResidual(X0, X);
+            ib_method_ops->computeLinearizedLagrangianForce(X, half_time);
+            hier_sc_data_ops.setToScalar(f_scratch_idx, 0.0, /*interior_only*/ false);
+            ib_method_ops->spreadLinearizedForce(f_scratch_idx, nullptr, f_prolongation_scheds, half_time);
+            hier_sc_data_ops.scale(f_inline_idx, -kappa, f_scratch_idx);
+            VecDestroy(&X);
+            VecDestroy(&X0);
+        }
+
+        // Compute the same quantity with the linearized coupling operator.
+        // The second application checks that reusing the operator, and hence
+        // any cached interaction weights, gives the same result.
+        SAMRAIVectorReal<NDIM, double> u_vec("u_vec", patch_hierarchy, coarsest_ln, finest_ln);
+        u_vec.addComponent(u_var, u_idx);
+        SAMRAIVectorReal<NDIM, double> f_vec("f_vec", patch_hierarchy, coarsest_ln, finest_ln);
+        f_vec.addComponent(f_var, f_idx);
+        SAMRAIVectorReal<NDIM, double> f_repeat_vec("f_repeat_vec", patch_hierarchy, coarsest_ln, finest_ln);
+        f_repeat_vec.addComponent(f_var, f_repeat_idx);
+        IBLinearizedCouplingOperator coupling_op("coupling_op", ib_method_ops);
+        coupling_op.setSolutionTime(half_time);
+        coupling_op.setScratchData(
+            u_scratch_idx, f_scratch_idx, nullptr, u_synch_scheds, u_ghost_fill_scheds, f_prolongation_scheds);
+        coupling_op.initializeOperatorState(u_vec, f_vec);
+        coupling_op.setCouplingCoefficient(-dt * kappa * kappa);
+        coupling_op.apply(u_vec, f_vec);
+        coupling_op.apply(u_vec, f_repeat_vec);
+        coupling_op.deallocateOperatorState();
+
+        const double f_inline_norm = hier_sc_data_ops.maxNorm(f_inline_idx);
+        hier_sc_data_ops.subtract(f_repeat_idx, f_repeat_idx, f_idx);
+        const double repeat_diff_norm = hier_sc_data_ops.maxNorm(f_repeat_idx);
+        hier_sc_data_ops.subtract(f_idx, f_idx, f_inline_idx);
+        const double diff_norm = hier_sc_data_ops.maxNorm(f_idx);
+        plog << "max norm of the inline result: " << f_inline_norm << '\n';
+        plog << "max norm of the difference: " << diff_norm << '\n';
+        plog << "max norm of the difference between applications: " << repeat_diff_norm << '\n';
+
+        if (IBTK_MPI::getRank() == 0)
+        {
+            std::ofstream output("output");
+            output << "inline result is nonzero: " << (f_inline_norm > 0.0) << '\n';
+            output << "operator agrees with the inline computation: " << (diff_norm <= 1.0e-12 * f_inline_norm)
+                   << '\n';
+            output << "repeated applications agree: " << (repeat_diff_norm == 0.0) << '\n';
+        }
+
+        for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->deallocatePatchData(u_idx);
+            level->deallocatePatchData(u_scratch_idx);
+            level->deallocatePatchData(f_idx);
+            level->deallocatePatchData(f_scratch_idx);
+            level->deallocatePatchData(f_inline_idx);
+            level->deallocatePatchData(f_repeat_idx);
+        }
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
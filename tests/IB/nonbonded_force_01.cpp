@@ -0,0 +1,358 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+#include <petscvec.h>
+
+// Headers for basic SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/IBMethod.h>
+#include <ibamr/IBRedundantInitializer.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+#include <ibamr/NonbondedForceEvaluator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/LData.h>
+#include <ibtk/LDataManager.h>
+#include <ibtk/muParserCartGridFunction.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// test stuff
+#include "../tests.h"
+
+// Compute the forces between a cloud of Lagrangian nodes with
+// NonbondedForceEvaluator, with and without Verlet lists, and check that they
+// agree with a sum over all pairs of nodes. The Verlet list is also checked
+// after moving the nodes by less than half of the skin, in which case the list
+// is reused. The hierarchy has a single level.
+//
+// If NUM_THREADS is larger than one, the forces are computed with both one
+// and NUM_THREADS OpenMP threads and compared. attest sets OMP_THREAD_LIMIT to
+// one, so this comparison is only meaningful when the test is run by hand.
+
+namespace
+{
+int finest_ln;
+int num_nodes;
+double x_node_lower, x_node_upper;
+
+void
+generate_structure(const unsigned int& /*strct_num*/,
+                   const int& ln,
+                   int& num_vertices,
+                   std::vector<IBTK::Point>& vertex_posn)
+{
+    if (ln != finest_ln)
+    {
+        num_vertices = 0;
+        vertex_posn.resize(num_vertices);
+        return;
+    }
+    num_vertices = num_nodes;
+    vertex_posn.resize(num_vertices);
+    std::uint64_t state = 42;
+    for (IBTK::Point& X : vertex_posn)
+    {
+        for (unsigned int d = 0; d < NDIM; ++d) X(d) = lcg_uniform(state, x_node_lower, x_node_upper);
+    }
+    return;
+}
+
+// A repulsive force with magnitude kappa*(1 - r/r_c)^2 that vanishes for r >=
+// r_c, in which kappa = params[0] and r_c = params[1].
+void
+repulsive_force(double* D, const SAMRAI::tbox::Array<double> params, double* out_force)
+{
+    double r = 0.0;
+    for (unsigned int d = 0; d < NDIM; ++d) r += D[d] * D[d];
+    r = std::sqrt(r);
+    const double kappa = params[0];
+    const double r_c = params[1];
+    const double fac = (r > 0.0 && r < r_c) ? kappa * (1.0 - r / r_c) * (1.0 - r / r_c) / r : 0.0;
+    for (unsigned int d = 0; d < NDIM; ++d) out_force[d] = fac * D[d];
+    return;
+}
+
+// Copy all entries of the given Lagrangian data to every process.
+std::vector<double>
+gather_all(Pointer<LData> data)
+{
+    Vec all_vec;
+    VecScatter ctx;
+    VecScatterCreateToAll(data->getVec(), &ctx, &all_vec);
+    VecScatterBegin(ctx, data->getVec(), all_vec, INSERT_VALUES, SCATTER_FORWARD);
+    VecScatterEnd(ctx, data->getVec(), all_vec, INSERT_VALUES, SCATTER_FORWARD);
+    PetscInt size;
+    VecGetSize(all_vec, &size);
+    const double* all_values;
+    VecGetArrayRead(all_vec, &all_values);
+    std::vector<double> values(all_values, all_values + size);
+    VecRestoreArrayRead(all_vec, &all_values);
+    VecScatterDestroy(&ctx);
+    VecDestroy(&all_vec);
+    return values;
+}
+
+// Sum the forces between all pairs of nodes, using the nearest periodic image
+// of each node in periodic directions. Returns the number of interacting
+// pairs.
+int
+compute_all_pairs_forces(const std::vector<double>& X,
+                         std::vector<double>& F,
+                         const SAMRAI::tbox::Array<double>& params,
+                         Pointer<CartesianGridGeometry<NDIM> > grid_geometry)
+{
+    const double* const x_lower = grid_geometry->getXLower();
+    const double* const x_upper = grid_geometry->getXUpper();
+    const IntVector<NDIM>& periodic_shift = grid_geometry->getPeriodicShift();
+    const int n_nodes = static_cast<int>(X.size()) / NDIM;
+    F.assign(X.size(), 0.0);
+    int num_pairs = 0;
+    for (int i = 0; i < n_nodes; ++i)
+    {
+        for (int j = i + 1; j < n_nodes; ++j)
+        {
+            double D[NDIM], pair_force[NDIM];
+            double r_sq = 0.0;
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                D[d] = X[NDIM * i + d] - X[NDIM * j + d];
+                if (periodic_shift(d) != 0)
+                {
+                    const double L = x_upper[d] - x_lower[d];
+                    D[d] -= std::round(D[d] / L) * L;
+                }
+                r_sq += D[d] * D[d];
+            }
+            if (r_sq < params[1] * params[1]) ++num_pairs;
+            repulsive_force(D, params, pair_force);
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                F[NDIM * i + d] += pair_force[d];
+                F[NDIM * j + d] -= pair_force[d];
+            }
+        }
+    }
+    return num_pairs;
+}
+
+bool
+forces_agree(const std::vector<double>& F, const std::vector<double>& F_exact)
+{
+    double max_F = 0.0, max_diff = 0.0;
+    for (std::size_t k = 0; k < F.size(); ++k)
+    {
+        max_F = std::max(max_F, std::abs(F_exact[k]));
+        max_diff = std::max(max_diff, std::abs(F[k] - F_exact[k]));
+    }
+    plog << "  maximum relative difference: " << max_diff / max_F << '\n';
+    return max_F > 0.0 && max_diff <= 1.0e-12 * max_F;
+}
+} // namespace
+
+// Compute the forces with a new NonbondedForceEvaluator.
+std::vector<double>
+compute_forces(Pointer<Database> evaluator_db,
+               Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+               Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+               LDataManager* l_data_manager,
+               Pointer<LData> X_data,
+               Pointer<LData> F_data,
+               const int num_threads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(num_threads);
+#else
+    (void)num_threads;
+#endif
+    const int ln = patch_hierarchy->getFinestLevelNumber();
+    NonbondedForceEvaluator evaluator(evaluator_db, grid_geometry);
+    evaluator.registerForceFcnPtr(repulsive_force);
+    evaluator.initializeLevelData(patch_hierarchy, ln, 0.0, true, l_data_manager);
+    VecSet(F_data->getVec(), 0.0);
+    evaluator.computeLagrangianForce(F_data, X_data, nullptr, patch_hierarchy, ln, 0.0, l_data_manager);
+    return gather_all(F_data);
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "IB.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+        finest_ln = input_db->getInteger("MAX_LEVELS") - 1;
+        num_nodes = input_db->getInteger("NUM_NODES");
+        x_node_lower = input_db->getDouble("X_NODE_LOWER");
+        x_node_upper = input_db->getDouble("X_NODE_UPPER");
+        const int num_threads = input_db->getIntegerWithDefault("NUM_THREADS", 1);
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<INSHierarchyIntegrator> navier_stokes_integrator = new INSStaggeredHierarchyIntegrator(
+            "INSStaggeredHierarchyIntegrator",
+            app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+        Pointer<IBMethod> ib_method_ops = new IBMethod("IBMethod", app_initializer->getComponentDatabase("IBMethod"));
+        Pointer<IBHierarchyIntegrator> time_integrator =
+            new IBExplicitHierarchyIntegrator("IBHierarchyIntegrator",
+                                              app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+                                              ib_method_ops,
+                                              navier_stokes_integrator);
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector =
+            new StandardTagAndInitialize<NDIM>("StandardTagAndInitialize",
+                                               time_integrator,
+                                               app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+
+        // Configure the IB solver.
+        Pointer<IBRedundantInitializer> ib_initializer = new IBRedundantInitializer(
+            "IBRedundantInitializer", app_initializer->getComponentDatabase("IBRedundantInitializer"));
+        ib_initializer->setStructureNamesOnLevel(finest_ln, { "cloud" });
+        ib_initializer->registerInitStructureFunction(generate_structure);
+        ib_method_ops->registerLInitStrategy(ib_initializer);
+
+        // Create Eulerian initial and boundary condition specification
+        // objects. The fluid is never advanced, but they are needed to
+        // initialize the patch hierarchy.
+        Pointer<CartGridFunction> u_init = new muParserCartGridFunction(
+            "u_init", app_initializer->getComponentDatabase("VelocityInitialConditions"), grid_geometry);
+        navier_stokes_integrator->registerVelocityInitialConditions(u_init);
+        std::vector<RobinBcCoefStrategy<NDIM>*> u_bc_coefs(NDIM, nullptr);
+        if (grid_geometry->getPeriodicShift().min() == 0)
+        {
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                u_bc_coefs[d] = new muParserRobinBcCoefs("u_bc_coefs_" + std::to_string(d),
+                                                         app_initializer->getComponentDatabase("VelocityBcCoefs"),
+                                                         grid_geometry);
+            }
+            navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+        }
+
+        // Initialize hierarchy configuration and data on all patches.
+        time_integrator->initializePatchHierarchy(patch_hierarchy, gridding_algorithm);
+        ib_method_ops->freeLInitStrategy();
+        ib_initializer.setNull();
+
+        LDataManager* l_data_manager = ib_method_ops->getLDataManager();
+        const int ln = patch_hierarchy->getFinestLevelNumber();
+        Pointer<LData> X_data = l_data_manager->getLData(LDataManager::POSN_DATA_NAME, ln);
+        Pointer<LData> F_data = l_data_manager->createLData("F_nonbonded", ln, NDIM);
+        Pointer<Database> evaluator_db = app_initializer->getComponentDatabase("NonbondedForceEvaluator");
+        const SAMRAI::tbox::Array<double> params = evaluator_db->getDoubleArray("parameters");
+
+        std::vector<double> F_exact;
+        const int num_pairs = compute_all_pairs_forces(gather_all(X_data), F_exact, params, grid_geometry);
+
+        plog << "without Verlet lists:\n";
+        evaluator_db->putBool("use_verlet_lists", false);
+        const std::vector<double> F =
+            compute_forces(evaluator_db, grid_geometry, patch_hierarchy, l_data_manager, X_data, F_data, num_threads);
+        const bool agree = forces_agree(F, F_exact);
+        const std::vector<double> F_serial =
+            compute_forces(evaluator_db, grid_geometry, patch_hierarchy, l_data_manager, X_data, F_data, 1);
+        const bool same_with_threads = F == F_serial;
+
+        plog << "with Verlet lists:\n";
+        evaluator_db->putBool("use_verlet_lists", true);
+        const int num_steps = 2;
+        std::vector<bool> verlet_agree;
+        {
+#ifdef _OPENMP
+            omp_set_num_threads(num_threads);
+#endif
+            NonbondedForceEvaluator evaluator(evaluator_db, grid_geometry);
+            evaluator.registerForceFcnPtr(repulsive_force);
+            evaluator.initializeLevelData(patch_hierarchy, ln, 0.0, true, l_data_manager);
+            const double dx = grid_geometry->getDx()[0];
+            std::uint64_t state = 1234;
+            for (int step = 0; step < num_steps; ++step)
+            {
+                if (step > 0)
+                {
+                    // Move each node by at most 0.2 grid cells in each direction.
+                    // This is less than half of the skin, so the list is reused.
+                    boost::multi_array_ref<double, 2>& X = *X_data->getLocalFormVecArray();
+                    for (unsigned int i = 0; i < X.shape()[0]; ++i)
+                    {
+                        for (unsigned int d = 0; d < NDIM; ++d) X[i][d] += lcg_uniform(state, -0.2 * dx, 0.2 * dx);
+                    }
+                    X_data->restoreArrays();
+                }
+                VecSet(F_data->getVec(), 0.0);
+                evaluator.computeLagrangianForce(F_data, X_data, nullptr, patch_hierarchy, ln, 0.0, l_data_manager);
+                compute_all_pairs_forces(gather_all(X_data), F_exact, params, grid_geometry);
+                verlet_agree.push_back(forces_agree(gather_all(F_data), F_exact));
+            }
+        }
+
+        if (IBTK_MPI::getRank() == 0)
+        {
+            std::ofstream output("output");
+            output << "number of nodes: " << num_nodes << '\n';
+            output << "number of interacting pairs: " << num_pairs << '\n';
+            output << "without Verlet lists:\n";
+            output << "  forces agree with all-pairs sum: " << agree << '\n';
+            output << "  forces do not depend on the number of threads: " << same_with_threads << '\n';
+            output << "with Verlet lists:\n";
+            output << "  forces agree with all-pairs sum: " << verlet_agree[0] << '\n';
+            output << "  forces agree after moving the nodes: " << verlet_agree[1] << '\n';
+        }
+
+        for (RobinBcCoefStrategy<NDIM>* u_bc_coef : u_bc_coefs) delete u_bc_coef;
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
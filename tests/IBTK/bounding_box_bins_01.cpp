@@ -0,0 +1,193 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Check that BoundingBoxBins finds the same element-patch intersections as a
+// linear search over all elements, which is what
+// FEDataManager::collectActivePatchElements() used to do. The element boxes
+// are clustered near a sphere (as they are for a typical immersed structure)
+// and the patches tile the unit square or cube. The run times of both
+// searches are written to the log file, and not to the output file, since
+// they are not reproducible.
+
+#include <ibtk/BoundingBoxBins.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/libmesh_utilities.h>
+
+#include <tbox/PIO.h>
+#include <tbox/SAMRAIManager.h>
+
+#include <libmesh/point.h>
+
+#include <SAMRAI_config.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+// test stuff
+#include "../tests.h"
+
+using namespace SAMRAI;
+
+namespace
+{
+bool
+intersects(const IBTK::libMeshWrappers::BoundingBox& a, const IBTK::libMeshWrappers::BoundingBox& b)
+{
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        if (a.second(d) < b.first(d) || b.second(d) < a.first(d)) return false;
+    }
+    return true;
+}
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    std::ofstream out("output");
+
+    using IBTK::libMeshWrappers::BoundingBox;
+#if (NDIM == 2)
+    const int n_elems = 40000;
+    const int n_patches_per_dim = 32;
+#endif
+#if (NDIM == 3)
+    const int n_elems = 100000;
+    const int n_patches_per_dim = 10;
+#endif
+    const double elem_h = std::pow(1.0 / n_elems, 1.0 / NDIM);
+    const double patch_h = 1.0 / n_patches_per_dim;
+    const double dx = patch_h / 8.0;
+
+    // Set up boxes for the elements of a thick spherical shell. Every tenth
+    // element is left empty and every seventh element is excluded from the
+    // index, which mimics elements that are assigned to another level.
+    std::uint64_t state = 42;
+    std::vector<BoundingBox> elem_bboxes(n_elems);
+    std::vector<int> indexed_elems;
+    for (int e = 0; e < n_elems; ++e)
+    {
+        if (e % 7 != 0) indexed_elems.push_back(e);
+        BoundingBox& bbox = elem_bboxes[e];
+        if (e % 10 == 0)
+        {
+            for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+            {
+                bbox.first(d) = 1.0;
+                bbox.second(d) = 0.0;
+            }
+            continue;
+        }
+
+        libMesh::Point normal;
+        double norm = 0.0;
+        while (norm < 1.0e-3 || norm > 1.0)
+        {
+            for (unsigned int d = 0; d < NDIM; ++d) normal(d) = 2.0 * lcg_uniform(state) - 1.0;
+            norm = normal.norm();
+        }
+        const double radius = 0.3 + 0.1 * lcg_uniform(state);
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            const double center = 0.5 + radius * normal(d) / norm;
+            const double width = (0.5 + lcg_uniform(state)) * elem_h;
+            bbox.first(d) = center - 0.5 * width;
+            bbox.second(d) = center + 0.5 * width;
+        }
+    }
+
+    // Set up boxes for the patches, grown by one grid cell.
+    std::vector<BoundingBox> patch_bboxes;
+    for (int p = 0; p < static_cast<int>(std::pow(n_patches_per_dim, NDIM)); ++p)
+    {
+        BoundingBox patch_bbox;
+        for (unsigned int d = 0, r = p; d < NDIM; ++d, r /= n_patches_per_dim)
+        {
+            patch_bbox.first(d) = (r % n_patches_per_dim) * patch_h - dx;
+            patch_bbox.second(d) = (r % n_patches_per_dim + 1) * patch_h + dx;
+        }
+        for (unsigned int d = NDIM; d < LIBMESH_DIM; ++d)
+        {
+            patch_bbox.first(d) = 0.0;
+            patch_bbox.second(d) = 0.0;
+        }
+        patch_bboxes.push_back(patch_bbox);
+    }
+
+    // Find the intersections with a linear search.
+    const auto linear_start = std::chrono::steady_clock::now();
+    std::vector<std::vector<int> > linear_patch_elems(patch_bboxes.size());
+    for (std::size_t p = 0; p < patch_bboxes.size(); ++p)
+    {
+        for (const int e : indexed_elems)
+        {
+            if (intersects(elem_bboxes[e], patch_bboxes[p])) linear_patch_elems[p].push_back(e);
+        }
+    }
+    const auto linear_end = std::chrono::steady_clock::now();
+
+    // Find the intersections with the index.
+    const auto bins_start = std::chrono::steady_clock::now();
+    const IBTK::BoundingBoxBins bins(elem_bboxes, indexed_elems);
+    std::vector<std::vector<int> > bins_patch_elems(patch_bboxes.size());
+    for (std::size_t p = 0; p < patch_bboxes.size(); ++p)
+    {
+        bins.getIntersectingBoxes(patch_bboxes[p], bins_patch_elems[p]);
+    }
+    const auto bins_end = std::chrono::steady_clock::now();
+
+    std::size_t n_pairs = 0;
+    std::size_t n_nonempty_patches = 0;
+    for (const std::vector<int>& elems : bins_patch_elems)
+    {
+        n_pairs += elems.size();
+        if (!elems.empty()) ++n_nonempty_patches;
+    }
+    out << "number of elements: " << n_elems << '\n';
+    out << "number of patches: " << patch_bboxes.size() << '\n';
+    out << "number of patches with elements: " << n_nonempty_patches << '\n';
+    out << "number of element-patch pairs: " << n_pairs << '\n';
+    out << "index agrees with linear search: " << (bins_patch_elems == linear_patch_elems) << '\n';
+
+    // Boxes outside of the indexed region or empty index sets should not
+    // cause any problems.
+    std::vector<int> found(1, -1);
+    BoundingBox far_bbox;
+    for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+    {
+        far_bbox.first(d) = 1.0e10;
+        far_bbox.second(d) = 2.0e10;
+    }
+    bins.getIntersectingBoxes(far_bbox, found);
+    out << "boxes found far away: " << found.size() << '\n';
+    const IBTK::BoundingBoxBins empty_bins(elem_bboxes, std::vector<int>());
+    empty_bins.getIntersectingBoxes(patch_bboxes[0], found);
+    out << "boxes found with an empty index: " << found.size() << '\n';
+
+    using seconds = std::chrono::duration<double>;
+    const double linear_time = std::chrono::duration_cast<seconds>(linear_end - linear_start).count();
+    const double bins_time = std::chrono::duration_cast<seconds>(bins_end - bins_start).count();
+    tbox::plog << "linear search time: " << linear_time << " s\n";
+    tbox::plog << "indexed search time (including setup): " << bins_time << " s\n";
+    tbox::plog << "speedup: " << linear_time / std::max(bins_time, 1.0e-12) << '\n';
+} // main
@@ -0,0 +1,287 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+
+// Headers for basic SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <CellVariable.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for basic libMesh objects
+#include <libmesh/equation_systems.h>
+#include <libmesh/explicit_system.h>
+#include <libmesh/mesh.h>
+#include <libmesh/mesh_generation.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/FEDataManager.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+// Check the workload estimates of FEDataManager that are based on measured
+// element costs (see FEDataManager::WorkloadSpec::use_measured_costs). Instead
+// of timing spread() and interpWeighted(), prescribed costs are recorded with
+// addMeasuredCost() for the elements of each local patch:
+//
+// 1. If every element has the same cost per quadrature point then the
+//    workload estimate is the same as without measured costs.
+//
+// 2. Each quadrature point is weighted by the cost per quadrature point of its
+//    element divided by the average cost per quadrature point of all
+//    processors, so the workload estimate times the average cost is linear in
+//    the element costs. This is checked with the costs 1 + (id % 2) and
+//    (id % 2).
+//
+// 3. Surface costs recorded with addMeasuredSurfaceCost() are charged to
+//    whole elements and do not change the average cost per quadrature point,
+//    so a surface cost equal to the cost of one quadrature point adds one to
+//    the workload estimate for each such element.
+
+// Set up a system for the deformed coordinates of the mesh that matches the
+// reference coordinates.
+System&
+setup_deformation_system(ReplicatedMesh& mesh, EquationSystems& equation_systems)
+{
+    auto& X_system = equation_systems.add_system<ExplicitSystem>("X");
+    const auto X_sys_num = X_system.number();
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        X_system.add_variable("X_" + std::to_string(d), FIRST, LAGRANGE);
+    }
+    equation_systems.init();
+
+    auto& X_solution = *X_system.solution;
+    const auto el_end = mesh.active_local_elements_end();
+    for (auto el_it = mesh.active_local_elements_begin(); el_it != el_end; ++el_it)
+    {
+        const Elem* const elem = *el_it;
+        for (unsigned int k = 0; k < elem->n_nodes(); ++k)
+        {
+            const Node* const node = elem->node_ptr(k);
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                X_solution.set(node->dof_number(X_sys_num, d, 0), (*node)(d));
+            }
+        }
+    }
+    X_solution.close();
+    return X_system;
+}
+
+// Compute the sum of the workload estimate of the given manager over the patch
+// hierarchy.
+double
+compute_total_workload(FEDataManager* fe_data_manager,
+                       Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+                       const int workload_idx)
+{
+    HierarchyCellDataOpsReal<NDIM, double> hier_cc_data_ops(
+        patch_hierarchy, 0, patch_hierarchy->getFinestLevelNumber());
+    hier_cc_data_ops.setToScalar(workload_idx, 0.0);
+    fe_data_manager->addWorkloadEstimate(patch_hierarchy, workload_idx);
+    return hier_cc_data_ops.L1Norm(workload_idx);
+}
+
+// Record the cost per quadrature point given by cost_fcn for each element on
+// each local patch, assuming that each element has two quadrature points, and
+// return the average cost per quadrature point of all processors.
+double
+record_costs(FEDataManager* fe_data_manager, const std::function<double(const Elem*)>& cost_fcn)
+{
+    const unsigned int n_qp = 2;
+    const std::vector<unsigned int> qp_offsets = { 0, n_qp };
+    std::array<double, 2> totals = { { 0.0, 0.0 } };
+    for (const std::vector<Elem*>& patch_elems : fe_data_manager->getActivePatchElementMap())
+    {
+        for (Elem* const elem : patch_elems)
+        {
+            const double seconds = n_qp * cost_fcn(elem);
+            fe_data_manager->addMeasuredCost({ elem }, qp_offsets, seconds);
+            totals[0] += seconds;
+            totals[1] += n_qp;
+        }
+    }
+    IBTK_MPI::sumReduction(totals.data(), 2);
+    return totals[0] / totals[1];
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+    const LibMeshInit& init = ibtk_init.getLibMeshInit();
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "fe_measured_costs_01.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+            "StandardTagAndInitialize", nullptr, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+        gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+
+        // Set up the FE mesh.
+        const double R = input_db->getDouble("R");
+        const int N_ELEMS = input_db->getInteger("N_ELEMS");
+        ReplicatedMesh mesh(init.comm(), NDIM);
+#if (NDIM == 2)
+        MeshTools::Generation::build_square(mesh, N_ELEMS, N_ELEMS, 0.5 - R, 0.5 + R, 0.5 - R, 0.5 + R, TRI3);
+#endif
+#if (NDIM == 3)
+        MeshTools::Generation::build_cube(
+            mesh, N_ELEMS, N_ELEMS, N_ELEMS, 0.5 - R, 0.5 + R, 0.5 - R, 0.5 + R, 0.5 - R, 0.5 + R, TET4);
+#endif
+        EquationSystems equation_systems(mesh);
+        System& X_system = setup_deformation_system(mesh, equation_systems);
+        auto fe_data = std::make_shared<FEData>("fe_data", equation_systems, true);
+
+        // Set up one manager that does not use measured costs and one that
+        // does. The latter does not keep older measurements, so each workload
+        // estimate only uses the costs recorded since the previous one.
+        FEDataManager::InterpSpec interp_spec("IB_4", QGAUSS, THIRD, false, 1.0, true, false);
+        FEDataManager::SpreadSpec spread_spec("IB_4", QGAUSS, THIRD, false, 1.0, false);
+        FEDataManager::WorkloadSpec workload_spec;
+        FEDataManager::WorkloadSpec measured_workload_spec;
+        measured_workload_spec.use_measured_costs = true;
+        measured_workload_spec.measured_cost_history_weight = 0.0;
+        const int max_levels = app_initializer->getComponentDatabase("GriddingAlgorithm")->getInteger("max_levels");
+        FEDataManager* fe_data_manager = FEDataManager::getManager(fe_data,
+                                                                   "fe_data_manager",
+                                                                   input_db->getDatabase("FEDataManager"),
+                                                                   max_levels,
+                                                                   interp_spec,
+                                                                   spread_spec,
+                                                                   workload_spec);
+        FEDataManager* measured_fe_data_manager = FEDataManager::getManager(fe_data,
+                                                                            "measured_fe_data_manager",
+                                                                            input_db->getDatabase("FEDataManager"),
+                                                                            max_levels,
+                                                                            interp_spec,
+                                                                            spread_spec,
+                                                                            measured_workload_spec);
+        for (FEDataManager* manager : { fe_data_manager, measured_fe_data_manager })
+        {
+            manager->COORDINATES_SYSTEM_NAME = X_system.name();
+            manager->setPatchHierarchy(patch_hierarchy);
+            manager->reinitElementMappings();
+        }
+
+        // Set up the workload data.
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("context");
+        Pointer<CellVariable<NDIM, double> > workload_var = new CellVariable<NDIM, double>("workload");
+        const int workload_idx = var_db->registerVariableAndContext(workload_var, ctx, IntVector<NDIM>(0));
+        for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+        {
+            patch_hierarchy->getPatchLevel(ln)->allocatePatchData(workload_idx, 0.0);
+        }
+
+        const double workload = compute_total_workload(fe_data_manager, patch_hierarchy, workload_idx);
+
+        record_costs(measured_fe_data_manager, [](const Elem*) { return 1.0e-3; });
+        const double uniform_workload = compute_total_workload(measured_fe_data_manager, patch_hierarchy, workload_idx);
+
+        const double average_cost_a =
+            record_costs(measured_fe_data_manager, [](const Elem* elem) { return 1.0 + elem->id() % 2; });
+        const double workload_a = compute_total_workload(measured_fe_data_manager, patch_hierarchy, workload_idx);
+
+        const double average_cost_b =
+            record_costs(measured_fe_data_manager, [](const Elem* elem) { return 1.0 * (elem->id() % 2); });
+        const double workload_b = compute_total_workload(measured_fe_data_manager, patch_hierarchy, workload_idx);
+
+        // Each processor charges every element with an odd id on its patches
+        // once: the surface cost of an element which is on the patches of
+        // several processors is split between the processors since each one
+        // only counts the quadrature points on its own patches.
+        const double uniform_cost = 1.0e-3;
+        std::unordered_set<dof_id_type> surface_elem_ids;
+        for (const std::vector<Elem*>& patch_elems : measured_fe_data_manager->getActivePatchElementMap())
+        {
+            for (Elem* const elem : patch_elems)
+            {
+                if (elem->id() % 2 && surface_elem_ids.insert(elem->id()).second)
+                {
+                    measured_fe_data_manager->addMeasuredSurfaceCost({ elem }, { 0, 1 }, uniform_cost);
+                }
+            }
+        }
+        record_costs(measured_fe_data_manager, [&](const Elem*) { return uniform_cost; });
+        const double surface_workload = compute_total_workload(measured_fe_data_manager, patch_hierarchy, workload_idx);
+        unsigned int n_surface_elems = 0;
+        for (const Elem* const elem : mesh.active_element_ptr_range()) n_surface_elems += elem->id() % 2;
+
+        plog << "workload without measured costs: " << workload << '\n';
+        plog << "workload with uniform measured costs: " << uniform_workload << '\n';
+        plog << "workload with costs 1 + (id % 2): " << workload_a << " (average cost: " << average_cost_a << ")\n";
+        plog << "workload with costs (id % 2): " << workload_b << " (average cost: " << average_cost_b << ")\n";
+        plog << "workload with surface costs: " << surface_workload << " (elements with surface costs: "
+             << n_surface_elems << ")\n";
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        output << "uniform measured costs do not change the workload: "
+               << (std::abs(uniform_workload - workload) <= 1.0e-12 * workload) << '\n';
+        output << "workload is linear in the measured costs: "
+               << (std::abs(workload_a * average_cost_a - (workload + workload_b * average_cost_b)) <=
+                   1.0e-12 * workload_a * average_cost_a)
+               << '\n';
+        output << "surface costs are charged to whole elements: "
+               << (std::abs(surface_workload - (uniform_workload + n_surface_elems)) <= 1.0e-12 * surface_workload)
+               << '\n';
+
+        for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+        {
+            patch_hierarchy->getPatchLevel(ln)->deallocatePatchData(workload_idx);
+        }
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
@@ -0,0 +1,244 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc objects
+#include <petscvec.h>
+
+// Headers for major SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/HierarchyMathOps.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_CHKERRQ.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/PETScSAMRAIVectorReal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+// Check that the fused multi-vector operations of PETScSAMRAIVectorReal
+// (VecMDot, VecMAXPY, and VecDotNorm2, as well as the split-phase reductions
+// VecMDotBegin/End and VecNormBegin/End) agree with the corresponding
+// sequences of single-vector operations for a vector with a cell-centered and
+// a side-centered component. The times of the fused and unfused operations
+// are written to the log file, and not to the output file, since they are not
+// reproducible.
+
+namespace
+{
+double
+seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool
+agree(const double a, const double b)
+{
+    return std::abs(a - b) <= 1.0e-12 * std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "fused_vector_ops_01.log");
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+            "StandardTagAndInitialize", nullptr, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+
+        // Initialize the AMR patch hierarchy.
+        gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+        int tag_buffer = 1;
+        int level_number = 0;
+        bool done = false;
+        while (!done && (gridding_algorithm->levelCanBeRefined(level_number)))
+        {
+            gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, 0.0, tag_buffer);
+            done = !patch_hierarchy->finerLevelExists(level_number);
+            ++level_number;
+        }
+        const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+
+        HierarchyMathOps hier_math_ops("hier_math_ops", patch_hierarchy);
+        const int h_cc_idx = hier_math_ops.getCellWeightPatchDescriptorIndex();
+        const int h_sc_idx = hier_math_ops.getSideWeightPatchDescriptorIndex();
+
+        // Set up a vector with a cell-centered and a side-centered component,
+        // as in the staggered Stokes solvers.
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("context");
+        Pointer<SideVariable<NDIM, double> > u_var = new SideVariable<NDIM, double>("u");
+        Pointer<CellVariable<NDIM, double> > p_var = new CellVariable<NDIM, double>("p");
+        const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(1));
+        const int p_idx = var_db->registerVariableAndContext(p_var, ctx, IntVector<NDIM>(1));
+        Pointer<SAMRAIVectorReal<NDIM, double> > x =
+            new SAMRAIVectorReal<NDIM, double>("x", patch_hierarchy, 0, finest_ln);
+        x->addComponent(u_var, u_idx, h_sc_idx);
+        x->addComponent(p_var, p_idx, h_cc_idx);
+        x->allocateVectorData();
+        x->setRandomValues(1.0, -0.5);
+
+        const int num_vecs = app_initializer->getInputDatabase()->getInteger("num_vecs");
+        std::vector<Pointer<SAMRAIVectorReal<NDIM, double> > > ys(num_vecs);
+        std::vector<Vec> petsc_ys(num_vecs);
+        std::vector<PetscScalar> alphas(num_vecs);
+        for (int j = 0; j < num_vecs; ++j)
+        {
+            ys[j] = x->cloneVector("y_" + std::to_string(j));
+            ys[j]->allocateVectorData();
+            ys[j]->setRandomValues(1.0, -0.5);
+            petsc_ys[j] = PETScSAMRAIVectorReal::createPETScVector(ys[j]);
+            alphas[j] = (j % 3 == 0 ? 1.0 : (j % 3 == 1 ? -1.0 : 0.25 * (j + 1)));
+        }
+        Vec petsc_x = PETScSAMRAIVectorReal::createPETScVector(x);
+        int ierr;
+
+        // Dot products.
+        std::vector<PetscScalar> dots(num_vecs), mdots(num_vecs), split_mdots(num_vecs);
+        auto start = std::chrono::steady_clock::now();
+        for (int j = 0; j < num_vecs; ++j)
+        {
+            ierr = VecDot(petsc_x, petsc_ys[j], &dots[j]);
+            IBTK_CHKERRQ(ierr);
+        }
+        const double dot_time = seconds_since(start);
+        start = std::chrono::steady_clock::now();
+        ierr = VecMDot(petsc_x, num_vecs, petsc_ys.data(), mdots.data());
+        IBTK_CHKERRQ(ierr);
+        const double mdot_time = seconds_since(start);
+        PetscReal norm, split_norm;
+        ierr = VecNorm(petsc_x, NORM_2, &norm);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecMDotBegin(petsc_x, num_vecs, petsc_ys.data(), split_mdots.data());
+        IBTK_CHKERRQ(ierr);
+        ierr = VecNormBegin(petsc_ys[0], NORM_2, &split_norm);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecMDotEnd(petsc_x, num_vecs, petsc_ys.data(), split_mdots.data());
+        IBTK_CHKERRQ(ierr);
+        ierr = VecNormEnd(petsc_ys[0], NORM_2, &split_norm);
+        IBTK_CHKERRQ(ierr);
+        bool same_mdots = true, same_split_mdots = true;
+        for (int j = 0; j < num_vecs; ++j)
+        {
+            same_mdots = same_mdots && agree(dots[j], mdots[j]);
+            same_split_mdots = same_split_mdots && agree(dots[j], split_mdots[j]);
+        }
+        const bool same_split_norm = agree(split_norm, std::sqrt(ys[0]->dot(ys[0])));
+
+        // Fused and unfused dot product and norm.
+        PetscScalar dp;
+        PetscReal nm;
+        ierr = VecDotNorm2(petsc_ys[0], petsc_ys[1], &dp, &nm);
+        IBTK_CHKERRQ(ierr);
+        const bool same_dot_norm2 = agree(dp, ys[0]->dot(ys[1])) && agree(nm, ys[1]->dot(ys[1]));
+
+        // Linear combinations.
+        Vec petsc_z, petsc_w;
+        ierr = VecDuplicate(petsc_x, &petsc_z);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecDuplicate(petsc_x, &petsc_w);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecCopy(petsc_x, petsc_z);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecCopy(petsc_x, petsc_w);
+        IBTK_CHKERRQ(ierr);
+        start = std::chrono::steady_clock::now();
+        for (int j = 0; j < num_vecs; ++j)
+        {
+            ierr = VecAXPY(petsc_z, alphas[j], petsc_ys[j]);
+            IBTK_CHKERRQ(ierr);
+        }
+        const double axpy_time = seconds_since(start);
+        start = std::chrono::steady_clock::now();
+        ierr = VecMAXPY(petsc_w, num_vecs, alphas.data(), petsc_ys.data());
+        IBTK_CHKERRQ(ierr);
+        const double maxpy_time = seconds_since(start);
+        PetscReal z_norm, diff_norm;
+        ierr = VecNorm(petsc_z, NORM_INFINITY, &z_norm);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecAXPY(petsc_w, -1.0, petsc_z);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecNorm(petsc_w, NORM_INFINITY, &diff_norm);
+        IBTK_CHKERRQ(ierr);
+        const bool same_maxpy = diff_norm <= 1.0e-12 * z_norm;
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        output << "norm of x agrees with VecNorm: " << agree(norm, std::sqrt(x->dot(x))) << '\n';
+        output << "VecMDot agrees with VecDot: " << same_mdots << '\n';
+        output << "VecMDotBegin/End agrees with VecDot: " << same_split_mdots << '\n';
+        output << "VecNormBegin/End agrees with VecNorm: " << same_split_norm << '\n';
+        output << "VecDotNorm2 agrees with VecDot: " << same_dot_norm2 << '\n';
+        output << "VecMAXPY agrees with VecAXPY: " << same_maxpy << '\n';
+
+        plog << "number of vectors: " << num_vecs << '\n';
+        plog << "VecDot time: " << dot_time << " s\n";
+        plog << "VecMDot time: " << mdot_time << " s\n";
+        plog << "VecAXPY time: " << axpy_time << " s\n";
+        plog << "VecMAXPY time: " << maxpy_time << " s\n";
+
+        ierr = VecDestroy(&petsc_z);
+        IBTK_CHKERRQ(ierr);
+        ierr = VecDestroy(&petsc_w);
+        IBTK_CHKERRQ(ierr);
+        PETScSAMRAIVectorReal::destroyPETScVector(petsc_x);
+        for (int j = 0; j < num_vecs; ++j)
+        {
+            PETScSAMRAIVectorReal::destroyPETScVector(petsc_ys[j]);
+            ys[j]->deallocateVectorData();
+            ys[j]->freeVectorComponents();
+        }
+        x->deallocateVectorData();
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
@@ -0,0 +1,171 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc objects
+#include <petscksp.h>
+#include <petscsys.h>
+
+// Headers for major SAMRAI objects
+#include <CartesianGridGeometry.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/CCPoissonSolverManager.h>
+#include <ibtk/HierarchyMathOps.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/PETScKrylovLinearSolver.h>
+
+#include <fstream>
+#include <string>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+#include "poisson_smoothers.h"
+
+// Solve a cell-centered Poisson problem with homogeneous Dirichlet boundary
+// conditions using the Krylov method given by the input database entry
+// solver_db::ksp_type, once with use_pipelined_krylov = TRUE (as set in the
+// input file) and once after disabling the pipelined variant with
+// setPipelinedKrylovEnabled(false). Check that both solves converge to the
+// same solution, that the first solve uses the pipelined variant of the
+// method, and that the second solve uses the standard method again.
+
+// Return the KSP type of the KSP object currently used by the solver.
+std::string
+get_ksp_type(const PETScKrylovLinearSolver& krylov_solver)
+{
+    const char* ksp_type;
+    int ierr = KSPGetType(krylov_solver.getPETScKSP(), &ksp_type);
+    IBTK_CHKERRQ(ierr);
+    return ksp_type;
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "pipelined_krylov_01.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = build_patch_hierarchy(app_initializer, grid_geometry);
+        const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+
+        // Create variables and register them with the variable database.
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("context");
+        Pointer<CellVariable<NDIM, double> > u_var = new CellVariable<NDIM, double>("u");
+        Pointer<CellVariable<NDIM, double> > f_var = new CellVariable<NDIM, double>("f");
+        const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(1));
+        const int f_idx = var_db->registerVariableAndContext(f_var, ctx, IntVector<NDIM>(1));
+        for (int ln = 0; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->allocatePatchData(u_idx, 0.0);
+            level->allocatePatchData(f_idx, 0.0);
+        }
+
+        // Setup vector objects.
+        HierarchyMathOps hier_math_ops("hier_math_ops", patch_hierarchy);
+        const int h_cc_idx = hier_math_ops.getCellWeightPatchDescriptorIndex();
+        SAMRAIVectorReal<NDIM, double> u_vec("u", patch_hierarchy, 0, finest_ln);
+        SAMRAIVectorReal<NDIM, double> f_vec("f", patch_hierarchy, 0, finest_ln);
+        u_vec.addComponent(u_var, u_idx, h_cc_idx);
+        f_vec.addComponent(f_var, f_idx, h_cc_idx);
+
+        muParserCartGridFunction f_fcn("f", app_initializer->getComponentDatabase("f"), grid_geometry);
+        f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+        // Setup the Poisson solver.
+        PoissonSpecifications poisson_spec("poisson_spec");
+        poisson_spec.setCZero();
+        poisson_spec.setDConstant(-1.0);
+        Pointer<Database> solver_db = input_db->getDatabase("solver_db");
+        const std::string ksp_type = solver_db->getString("ksp_type");
+        Pointer<PoissonSolver> poisson_solver =
+            CCPoissonSolverManager::getManager()->allocateSolver(input_db->getString("solver_type"),
+                                                                 "poisson_solver",
+                                                                 solver_db,
+                                                                 "",
+                                                                 input_db->getString("precond_type"),
+                                                                 "poisson_precond",
+                                                                 input_db->getDatabase("precond_db"),
+                                                                 "");
+        poisson_solver->setPoissonSpecifications(poisson_spec);
+        Pointer<PETScKrylovLinearSolver> krylov_solver = poisson_solver;
+        TBOX_ASSERT(krylov_solver);
+
+        // Solve -L*u = f with the pipelined variant of the Krylov method.
+        poisson_solver->initializeSolverState(u_vec, f_vec);
+        const std::string pipelined_ksp_type = get_ksp_type(*krylov_solver);
+        u_vec.setToScalar(0.0);
+        const bool pipelined_converged = poisson_solver->solveSystem(u_vec, f_vec);
+        const int pipelined_num_iterations = poisson_solver->getNumIterations();
+        Pointer<SAMRAIVectorReal<NDIM, double> > pipelined_u_vec = u_vec.cloneVector("pipelined_u");
+        pipelined_u_vec->allocateVectorData();
+        pipelined_u_vec->copyVector(Pointer<SAMRAIVectorReal<NDIM, double> >(&u_vec, false));
+
+        // Solve the same system again with the standard Krylov method.
+        krylov_solver->setPipelinedKrylovEnabled(false);
+        poisson_solver->initializeSolverState(u_vec, f_vec);
+        const std::string standard_ksp_type = get_ksp_type(*krylov_solver);
+        u_vec.setToScalar(0.0);
+        const bool standard_converged = poisson_solver->solveSystem(u_vec, f_vec);
+        const int standard_num_iterations = poisson_solver->getNumIterations();
+        poisson_solver->deallocateSolverState();
+
+        // Both solves use the same tolerance, so the solutions should agree up
+        // to the accuracy of the solves.
+        pipelined_u_vec->subtract(pipelined_u_vec, Pointer<SAMRAIVectorReal<NDIM, double> >(&u_vec, false));
+        const double relative_difference = pipelined_u_vec->maxNorm() / u_vec.maxNorm();
+        pipelined_u_vec->deallocateVectorData();
+        pipelined_u_vec->freeVectorComponents();
+
+        plog << pipelined_ksp_type << " number of iterations: " << pipelined_num_iterations << '\n';
+        plog << standard_ksp_type << " number of iterations: " << standard_num_iterations << '\n';
+        plog << "relative difference between solutions: " << relative_difference << '\n';
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        output << "ksp_type: " << ksp_type << '\n';
+        output << "uses a pipelined variant: " << (pipelined_ksp_type != ksp_type) << '\n';
+        output << "converged with the pipelined variant: " << pipelined_converged << '\n';
+        output << "uses the standard method after disabling the pipelined variant: "
+               << (standard_ksp_type == ksp_type) << '\n';
+        output << "converged with the standard method: " << standard_converged << '\n';
+        output << "same solution: " << (relative_difference < 1.0e-6) << '\n';
+
+        for (int ln = 0; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->deallocatePatchData(u_idx);
+            level->deallocatePatchData(f_idx);
+        }
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
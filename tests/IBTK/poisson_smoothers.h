@@ -0,0 +1,207 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Utility functions for the tests of the smoothers of the point
+// relaxation FAC preconditioners.
+
+#ifndef included_ibtk_tests_poisson_smoothers_h
+#define included_ibtk_tests_poisson_smoothers_h
+
+#include <SAMRAI_config.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <PatchHierarchy.h>
+#include <SAMRAIVectorReal.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/PoissonSolver.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <tbox/PIO.h>
+
+#include <PoissonSpecifications.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ibtk/app_namespaces.h>
+
+// The outcome of a solve with one of the smoother types.
+struct SmootherSolveResult
+{
+    std::string smoother_type;
+    bool converged;
+    int num_iterations;
+    Pointer<SAMRAIVectorReal<NDIM, double> > solution;
+};
+
+// Set up the patch hierarchy described by the GriddingAlgorithm, LoadBalancer,
+// and StandardTagAndInitialize entries of the input database.
+inline Pointer<PatchHierarchy<NDIM> >
+build_patch_hierarchy(Pointer<AppInitializer> app_initializer, Pointer<CartesianGridGeometry<NDIM> > grid_geometry)
+{
+    Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+    Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+        "StandardTagAndInitialize", nullptr, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+    Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+    Pointer<LoadBalancer<NDIM> > load_balancer =
+        new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+    Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+        new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                    app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                    error_detector,
+                                    box_generator,
+                                    load_balancer);
+
+    gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+    int tag_buffer = 1;
+    int level_number = 0;
+    bool done = false;
+    while (!done && (gridding_algorithm->levelCanBeRefined(level_number)))
+    {
+        gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, 0.0, tag_buffer);
+        done = !patch_hierarchy->finerLevelExists(level_number);
+        ++level_number;
+    }
+    return patch_hierarchy;
+}
+
+// Solve -L*u = f with homogeneous Dirichlet boundary conditions, in which f is
+// given by the input database entry "f", once for each of the given smoother
+// types. The solver is described by the solver_type, solver_db, precond_type,
+// and precond_db input database entries, and the smoother is also used as the
+// coarse level solver. The iteration counts and solve times are written to the
+// log file, and not to the output file, since the timings are not
+// reproducible.
+template <class VariableType, class SolverManagerType>
+std::vector<SmootherSolveResult>
+solve_with_smoothers(const std::string& label,
+                     Pointer<AppInitializer> app_initializer,
+                     Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+                     Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+                     const int h_idx,
+                     const std::vector<std::string>& smoother_types)
+{
+    const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+    VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+    Pointer<VariableContext> ctx = var_db->getContext(label + "::context");
+    Pointer<VariableType> u_var = new VariableType(label + "::u");
+    Pointer<VariableType> f_var = new VariableType(label + "::f");
+    const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(1));
+    const int f_idx = var_db->registerVariableAndContext(f_var, ctx, IntVector<NDIM>(1));
+    for (int ln = 0; ln <= finest_ln; ++ln)
+    {
+        Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+        level->allocatePatchData(u_idx, 0.0);
+        level->allocatePatchData(f_idx, 0.0);
+    }
+
+    SAMRAIVectorReal<NDIM, double> u_vec("u", patch_hierarchy, 0, finest_ln);
+    SAMRAIVectorReal<NDIM, double> f_vec("f", patch_hierarchy, 0, finest_ln);
+    u_vec.addComponent(u_var, u_idx, h_idx);
+    f_vec.addComponent(f_var, f_idx, h_idx);
+
+    muParserCartGridFunction f_fcn("f", app_initializer->getComponentDatabase("f"), grid_geometry);
+    f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+    Pointer<Database> input_db = app_initializer->getInputDatabase();
+    const std::string solver_type = input_db->getString("solver_type");
+    Pointer<Database> solver_db = input_db->getDatabase("solver_db");
+    const std::string precond_type = input_db->getString("precond_type");
+    Pointer<Database> precond_db = input_db->getDatabase("precond_db");
+
+    PoissonSpecifications poisson_spec("poisson_spec");
+    poisson_spec.setCZero();
+    poisson_spec.setDConstant(-1.0);
+
+    std::vector<SmootherSolveResult> results;
+    for (const std::string& smoother_type : smoother_types)
+    {
+        precond_db->putString("smoother_type", smoother_type);
+        precond_db->putString("coarse_solver_type", smoother_type);
+        Pointer<PoissonSolver> poisson_solver =
+            SolverManagerType::getManager()->allocateSolver(solver_type,
+                                                            label + "::poisson_solver",
+                                                            solver_db,
+                                                            "",
+                                                            precond_type,
+                                                            label + "::poisson_precond",
+                                                            precond_db,
+                                                            "");
+        poisson_solver->setPoissonSpecifications(poisson_spec);
+        poisson_solver->initializeSolverState(u_vec, f_vec);
+
+        SmootherSolveResult result;
+        result.smoother_type = smoother_type;
+        u_vec.setToScalar(0.0);
+        const auto start = std::chrono::steady_clock::now();
+        result.converged = poisson_solver->solveSystem(u_vec, f_vec);
+        const double solve_time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.num_iterations = poisson_solver->getNumIterations();
+        const double residual_norm = poisson_solver->getResidualNorm();
+        poisson_solver->deallocateSolverState();
+
+        result.solution = u_vec.cloneVector(label + "::" + smoother_type);
+        result.solution->allocateVectorData();
+        result.solution->copyVector(Pointer<SAMRAIVectorReal<NDIM, double> >(&u_vec, false));
+        results.push_back(result);
+
+        plog << label << " " << smoother_type << ":\n";
+        plog << "  number of iterations: " << result.num_iterations << '\n';
+        plog << "  residual norm: " << residual_norm << '\n';
+        plog << "  solve time: " << solve_time << " s\n";
+    }
+
+    for (int ln = 0; ln <= finest_ln; ++ln)
+    {
+        Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+        level->deallocatePatchData(u_idx);
+        level->deallocatePatchData(f_idx);
+    }
+    return results;
+}
+
+// Compute the maximum norm of the difference between the solutions computed
+// with the smoother types k and 0, relative to the latter.
+inline double
+relative_solution_difference(std::vector<SmootherSolveResult>& results, const unsigned int k)
+{
+    Pointer<SAMRAIVectorReal<NDIM, double> > difference = results[k].solution->cloneVector("difference");
+    difference->allocateVectorData();
+    difference->subtract(results[k].solution, results[0].solution);
+    const double relative_difference = difference->maxNorm() / results[0].solution->maxNorm();
+    difference->deallocateVectorData();
+    difference->freeVectorComponents();
+    return relative_difference;
+}
+
+// Free the solutions stored by solve_with_smoothers().
+inline void
+free_solutions(std::vector<SmootherSolveResult>& results)
+{
+    for (SmootherSolveResult& result : results)
+    {
+        result.solution->deallocateVectorData();
+        result.solution->freeVectorComponents();
+    }
+    results.clear();
+}
+
+#endif // included_ibtk_tests_poisson_smoothers_h
@@ -0,0 +1,202 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc objects
+#include <petscsys.h>
+
+// Headers for major SAMRAI objects
+#include <CartesianGridGeometry.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/CCPoissonPointRelaxationFACOperator.h>
+#include <ibtk/CCPoissonSolverManager.h>
+#include <ibtk/HierarchyMathOps.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SCPoissonPointRelaxationFACOperator.h>
+#include <ibtk/SCPoissonSolverManager.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+#include "poisson_smoothers.h"
+
+// Check the "L1_JACOBI" and "CHEBYSHEV" smoothers of the cell-centered and
+// side-centered point relaxation FAC operators in two ways:
+//
+// 1. Apply the smoothers to a high-frequency error on the coarsest level,
+//    which is an eigenfunction of the discrete Laplacian with homogeneous
+//    Dirichlet boundary conditions, and check that the error is reduced by
+//    the expected amount. With three sweeps, l1-Jacobi reduces this error by
+//    a factor of about 0.15^3 and Chebyshev by a factor of about 0.3, so
+//    requiring a reduction by at least one half catches a smoother that does
+//    almost nothing.
+//
+// 2. Solve Poisson problems with homogeneous Dirichlet boundary conditions
+//    using FAC preconditioners with these smoothers, and check that the solves
+//    converge to the solution computed with the "RED_BLACK_GAUSS_SEIDEL"
+//    smoother and that they require fewer iterations than a preconditioner
+//    that does not smooth on the finer levels, i.e., with num_post_sweeps = 0.
+
+// Compute the factor by which num_sweeps sweeps of the given smoother reduce
+// the maximum norm of the error given by the input database entry
+// "high_frequency_error" on the coarsest level of the hierarchy.
+template <class VariableType, class FACOperatorType>
+double
+compute_error_reduction(const std::string& label,
+                        const std::string& smoother_type,
+                        const int num_sweeps,
+                        Pointer<AppInitializer> app_initializer,
+                        Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+                        Pointer<PatchHierarchy<NDIM> > patch_hierarchy)
+{
+    const int ln = 0;
+    VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+    Pointer<VariableContext> ctx = var_db->getContext(label + "::" + smoother_type + "::smoothing_context");
+    Pointer<VariableType> e_var = new VariableType(label + "::" + smoother_type + "::e");
+    Pointer<VariableType> r_var = new VariableType(label + "::" + smoother_type + "::r");
+    const int e_idx = var_db->registerVariableAndContext(e_var, ctx, IntVector<NDIM>(1));
+    const int r_idx = var_db->registerVariableAndContext(r_var, ctx, IntVector<NDIM>(1));
+    Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+    level->allocatePatchData(e_idx, 0.0);
+    level->allocatePatchData(r_idx, 0.0);
+
+    SAMRAIVectorReal<NDIM, double> e_vec("e", patch_hierarchy, ln, ln);
+    SAMRAIVectorReal<NDIM, double> r_vec("r", patch_hierarchy, ln, ln);
+    e_vec.addComponent(e_var, e_idx);
+    r_vec.addComponent(r_var, r_idx);
+
+    muParserCartGridFunction e_fcn(
+        "e", app_initializer->getComponentDatabase("high_frequency_error"), grid_geometry);
+    e_fcn.setDataOnPatchHierarchy(e_idx, e_var, patch_hierarchy, 0.0, false, ln, ln);
+    r_vec.setToScalar(0.0);
+
+    PoissonSpecifications poisson_spec("poisson_spec");
+    poisson_spec.setCZero();
+    poisson_spec.setDConstant(-1.0);
+    Pointer<Database> precond_db = app_initializer->getInputDatabase()->getDatabase("precond_db");
+    FACOperatorType fac_op(label + "::" + smoother_type + "::fac_op", precond_db, "");
+    fac_op.setPoissonSpecifications(poisson_spec);
+    fac_op.setSmootherType(smoother_type);
+    fac_op.initializeOperatorState(e_vec, r_vec);
+
+    // Since the residual vanishes, the smoother only acts on the error.
+    const double e_norm = e_vec.maxNorm();
+    fac_op.smoothError(e_vec, r_vec, ln, num_sweeps, false, true);
+    const double reduction = e_vec.maxNorm() / e_norm;
+    fac_op.deallocateOperatorState();
+
+    level->deallocatePatchData(e_idx);
+    level->deallocatePatchData(r_idx);
+    return reduction;
+}
+
+template <class VariableType, class SolverManagerType, class FACOperatorType>
+void
+test(const std::string& label,
+     Pointer<AppInitializer> app_initializer,
+     Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+     Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+     const int h_idx,
+     std::ofstream& output)
+{
+    output << label << ":\n";
+
+    Pointer<Database> precond_db = app_initializer->getInputDatabase()->getDatabase("precond_db");
+    const int num_sweeps = precond_db->getInteger("num_post_sweeps");
+    const std::vector<std::string> smoother_types = { "RED_BLACK_GAUSS_SEIDEL", "L1_JACOBI", "CHEBYSHEV" };
+    for (const std::string& smoother_type : smoother_types)
+    {
+        const double reduction = compute_error_reduction<VariableType, FACOperatorType>(
+            label, smoother_type, num_sweeps, app_initializer, grid_geometry, patch_hierarchy);
+        plog << label << " " << smoother_type << " high-frequency error reduction with " << num_sweeps
+             << " sweeps: " << reduction << '\n';
+        if (smoother_type != smoother_types[0])
+        {
+            output << "  " << smoother_type << " reduces the high-frequency error: " << (reduction <= 0.5)
+                   << '\n';
+        }
+    }
+
+    // Solve without smoothing on the finer levels to obtain a bound for the
+    // number of iterations with smoothing.
+    precond_db->putInteger("num_post_sweeps", 0);
+    std::vector<SmootherSolveResult> unsmoothed_results = solve_with_smoothers<VariableType, SolverManagerType>(
+        label + "::unsmoothed", app_initializer, grid_geometry, patch_hierarchy, h_idx, { smoother_types[0] });
+    precond_db->putInteger("num_post_sweeps", num_sweeps);
+    const int unsmoothed_num_iterations = unsmoothed_results[0].num_iterations;
+    free_solutions(unsmoothed_results);
+
+    std::vector<SmootherSolveResult> results = solve_with_smoothers<VariableType, SolverManagerType>(
+        label, app_initializer, grid_geometry, patch_hierarchy, h_idx, smoother_types);
+    for (const SmootherSolveResult& result : results)
+    {
+        output << "  converged with " << result.smoother_type << ": " << result.converged << '\n';
+    }
+
+    // All solves use the same tolerance, so the solutions should agree up to
+    // the accuracy of the solves.
+    for (unsigned int k = 1; k < results.size(); ++k)
+    {
+        const double relative_difference = relative_solution_difference(results, k);
+        plog << label << " relative difference between the " << results[k].smoother_type << " and "
+             << results[0].smoother_type << " solutions: " << relative_difference << '\n';
+        output << "  same solution with " << results[k].smoother_type << ": " << (relative_difference < 1.0e-6)
+               << '\n';
+        output << "  fewer iterations with " << results[k].smoother_type
+               << " than without smoothing: " << (results[k].num_iterations < unsmoothed_num_iterations) << '\n';
+    }
+
+    free_solutions(results);
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "polynomial_smoothers_01.log");
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = build_patch_hierarchy(app_initializer, grid_geometry);
+
+        HierarchyMathOps hier_math_ops("hier_math_ops", patch_hierarchy);
+        const int h_cc_idx = hier_math_ops.getCellWeightPatchDescriptorIndex();
+        const int h_sc_idx = hier_math_ops.getSideWeightPatchDescriptorIndex();
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        test<CellVariable<NDIM, double>, CCPoissonSolverManager, CCPoissonPointRelaxationFACOperator>(
+            "cc", app_initializer, grid_geometry, patch_hierarchy, h_cc_idx, output);
+        test<SideVariable<NDIM, double>, SCPoissonSolverManager, SCPoissonPointRelaxationFACOperator>(
+            "sc", app_initializer, grid_geometry, patch_hierarchy, h_sc_idx, output);
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic libMesh objects
+#include <libmesh/mesh.h>
+#include <libmesh/mesh_generation.h>
+#include <libmesh/quadrature.h>
+#include <libmesh/string_to_enum.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/FECache.h>
+#include <ibtk/FEMappingCache.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/QuadratureCache.h>
+#include <ibtk/libmesh_utilities.h>
+
+#include <tbox/PIO.h>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// test stuff
+#include "../tests.h"
+
+// Check that QuadratureCache, FECache, and FEMappingCache return the same
+// objects as a lookup in a std::map (which is how these caches used to store
+// their values) for a sequence of quadrature keys like the one generated by
+// adaptive quadrature, and measure the cost per element of each lookup. The
+// timings are written to the log file, and not to the output file, since they
+// are not reproducible.
+
+namespace
+{
+// The previous storage of QuadratureCache.
+class MapQuadratureCache
+{
+public:
+    MapQuadratureCache(const unsigned int dim) : d_dim(dim)
+    {
+    }
+
+    libMesh::QBase& operator[](const quadrature_key_type& quad_key)
+    {
+        auto it = d_quadratures.find(quad_key);
+        if (it == d_quadratures.end())
+        {
+            std::unique_ptr<libMesh::QBase> quad =
+                libMesh::QBase::build(std::get<1>(quad_key), d_dim, std::get<2>(quad_key));
+            quad->allow_rules_with_negative_weights = std::get<3>(quad_key);
+            quad->init(std::get<0>(quad_key));
+            it = d_quadratures.emplace(quad_key, std::move(quad)).first;
+        }
+        return *it->second;
+    }
+
+private:
+    const unsigned int d_dim;
+    std::map<quadrature_key_type, std::unique_ptr<libMesh::QBase> > d_quadratures;
+};
+
+double
+seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+template <int dim>
+void
+test(LibMeshInit& init, const ElemType elem_type, std::ofstream& output)
+{
+    ReplicatedMesh mesh(init.comm(), dim);
+    if (dim == 2)
+        MeshTools::Generation::build_square(mesh, 2, 2, 0.0, 1.0, 0.0, 1.0, elem_type);
+    else
+        MeshTools::Generation::build_cube(mesh, 2, 2, 2, 0.0, 1.0, 0.0, 1.0, 0.0, 1.0, elem_type);
+    const Elem* const elem = *mesh.active_local_elements_begin();
+
+    // Generate keys in the same way as adaptive quadrature does on a
+    // deforming structure: consecutive elements usually, but not always, use
+    // the same rule.
+    const int n_elems = 1000000;
+    const std::vector<Order> orders = { THIRD, FOURTH, FIFTH, SIXTH, SEVENTH, EIGHTH };
+    std::vector<quadrature_key_type> keys(n_elems);
+    std::uint64_t state = 42;
+    std::size_t current = 0;
+    for (int e = 0; e < n_elems; ++e)
+    {
+        if (lcg(state) % 10 == 0) current = lcg(state) % orders.size();
+        keys[e] = std::make_tuple(elem_type, QGAUSS, orders[current], false);
+    }
+
+    MapQuadratureCache map_quad_cache(dim);
+    QuadratureCache quad_cache(dim);
+    FEMappingCache<dim> mapping_cache(update_JxW);
+    FECache fe_cache(dim, FEType(FIRST, LAGRANGE), update_phi);
+
+    // Set up all the objects before timing anything.
+    for (const quadrature_key_type& key : keys)
+    {
+        map_quad_cache[key];
+        quad_cache[key];
+        mapping_cache[key];
+        fe_cache(key, elem);
+    }
+
+    // Check that both caches return the same rules.
+    bool same_rules = true;
+    std::size_t n_map_points = 0;
+    for (const quadrature_key_type& key : keys)
+    {
+        const QBase& map_quad = map_quad_cache[key];
+        const QBase& quad = quad_cache[key];
+        same_rules = same_rules && quad.get_order() == map_quad.get_order() && quad.n_points() == map_quad.n_points();
+        same_rules = same_rules && fe_cache(key, elem).get_fe_type() == FEType(FIRST, LAGRANGE);
+        n_map_points += map_quad.n_points();
+    }
+
+    // Time the lookups. Sum the numbers of points so that the loops cannot
+    // be optimized away.
+    std::size_t n_points = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const quadrature_key_type& key : keys) n_points += map_quad_cache[key].n_points();
+    const double map_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const quadrature_key_type& key : keys) n_points += quad_cache[key].n_points();
+    const double quad_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const quadrature_key_type& key : keys) n_points += mapping_cache[key].getJxW().size();
+    const double mapping_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const quadrature_key_type& key : keys) n_points += fe_cache(key, elem).get_phi()[0].size();
+    const double fe_time = seconds_since(start);
+
+    output << Utility::enum_to_string(elem_type) << ":\n";
+    output << "  number of lookups: " << n_elems << '\n';
+    output << "  number of quadrature points: " << n_map_points << '\n';
+    output << "  caches agree with std::map: " << (same_rules && n_points == 4 * n_map_points) << '\n';
+
+    const double ns_per_elem = 1.0e9 / n_elems;
+    tbox::plog << Utility::enum_to_string(elem_type) << ":\n";
+    tbox::plog << "  std::map lookup time per element: " << map_time * ns_per_elem << " ns\n";
+    tbox::plog << "  QuadratureCache lookup time per element: " << quad_time * ns_per_elem << " ns\n";
+    tbox::plog << "  FEMappingCache lookup time per element: " << mapping_time * ns_per_elem << " ns\n";
+    tbox::plog << "  FECache lookup time per element: " << fe_time * ns_per_elem << " ns\n";
+}
+
+int
+main(int argc, char** argv)
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+    LibMeshInit& init = ibtk_init.getLibMeshInit();
+
+    std::ofstream output("output");
+    test<2>(init, QUAD9, output);
+    test<3>(init, HEX27, output);
+} // main
@@ -0,0 +1,225 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc objects
+#include <petscsys.h>
+
+// Headers for major SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/CCPoissonSolverManager.h>
+#include <ibtk/HierarchyMathOps.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SCPoissonSolverManager.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+// Solve the same cell-centered and side-centered Poisson problems with
+// homogeneous Dirichlet boundary conditions using FAC preconditioners with the
+// "RED_BLACK_GAUSS_SEIDEL" (Fortran) and "RED_BLACK_GAUSS_SEIDEL_THREADED"
+// (C++) smoothers and check that the convergence histories and solutions
+// agree. The side-centered problem uses the masked kernel at the Dirichlet
+// boundaries. The iteration counts and solve times are written to the log
+// file, and not to the output file, since the timings are not reproducible.
+
+namespace
+{
+double
+seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+template <class VariableType, class SolverManagerType>
+void
+test(const std::string& label,
+     Pointer<AppInitializer> app_initializer,
+     Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+     Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+     const int h_idx,
+     std::ofstream& output)
+{
+    VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+    Pointer<VariableContext> ctx = var_db->getContext(label + "::context");
+    Pointer<VariableType> u_var = new VariableType(label + "::u");
+    Pointer<VariableType> f_var = new VariableType(label + "::f");
+    const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(1));
+    const int f_idx = var_db->registerVariableAndContext(f_var, ctx, IntVector<NDIM>(1));
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+        Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+        level->allocatePatchData(u_idx, 0.0);
+        level->allocatePatchData(f_idx, 0.0);
+    }
+
+    SAMRAIVectorReal<NDIM, double> u_vec("u", patch_hierarchy, 0, patch_hierarchy->getFinestLevelNumber());
+    SAMRAIVectorReal<NDIM, double> f_vec("f", patch_hierarchy, 0, patch_hierarchy->getFinestLevelNumber());
+    u_vec.addComponent(u_var, u_idx, h_idx);
+    f_vec.addComponent(f_var, f_idx, h_idx);
+
+    muParserCartGridFunction f_fcn("f", app_initializer->getComponentDatabase("f"), grid_geometry);
+    f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+    PoissonSpecifications poisson_spec("poisson_spec");
+    poisson_spec.setCZero();
+    poisson_spec.setDConstant(-1.0);
+
+    Pointer<Database> input_db = app_initializer->getInputDatabase();
+    const std::string solver_type = input_db->getString("solver_type");
+    Pointer<Database> solver_db = input_db->getDatabase("solver_db");
+    const std::string precond_type = input_db->getString("precond_type");
+    Pointer<Database> precond_db = input_db->getDatabase("precond_db");
+
+    // Solve -L*u = f with each smoother type, using the smoother on the
+    // coarsest level as well.
+    const std::vector<std::string> smoother_types = { "RED_BLACK_GAUSS_SEIDEL", "RED_BLACK_GAUSS_SEIDEL_THREADED" };
+    std::vector<Pointer<SAMRAIVectorReal<NDIM, double> > > solutions;
+    std::vector<bool> converged;
+    std::vector<int> num_iterations;
+    std::vector<double> residual_norms;
+    for (const std::string& smoother_type : smoother_types)
+    {
+        precond_db->putString("smoother_type", smoother_type);
+        precond_db->putString("coarse_solver_type", smoother_type);
+        Pointer<PoissonSolver> poisson_solver =
+            SolverManagerType::getManager()->allocateSolver(solver_type,
+                                                            label + "::poisson_solver",
+                                                            solver_db,
+                                                            "",
+                                                            precond_type,
+                                                            label + "::poisson_precond",
+                                                            precond_db,
+                                                            "");
+        poisson_solver->setPoissonSpecifications(poisson_spec);
+        poisson_solver->initializeSolverState(u_vec, f_vec);
+
+        u_vec.setToScalar(0.0);
+        const auto start = std::chrono::steady_clock::now();
+        converged.push_back(poisson_solver->solveSystem(u_vec, f_vec));
+        const double solve_time = seconds_since(start);
+        num_iterations.push_back(poisson_solver->getNumIterations());
+        residual_norms.push_back(poisson_solver->getResidualNorm());
+        poisson_solver->deallocateSolverState();
+
+        Pointer<SAMRAIVectorReal<NDIM, double> > solution = u_vec.cloneVector(label + "::" + smoother_type);
+        solution->allocateVectorData();
+        solution->copyVector(Pointer<SAMRAIVectorReal<NDIM, double> >(&u_vec, false));
+        solutions.push_back(solution);
+
+        plog << label << " " << smoother_type << ":\n";
+        plog << "  number of iterations: " << num_iterations.back() << '\n';
+        plog << "  residual norm: " << residual_norms.back() << '\n';
+        plog << "  solve time: " << solve_time << " s\n";
+    }
+
+    // The two smoothers perform the same arithmetic, so the solutions should
+    // agree to roundoff.
+    const double u_norm = solutions[0]->maxNorm();
+    solutions[1]->subtract(solutions[1], solutions[0]);
+    const double relative_difference = solutions[1]->maxNorm() / u_norm;
+    plog << label << " relative difference between solutions: " << relative_difference << '\n';
+
+    output << label << ":\n";
+    for (unsigned int k = 0; k < smoother_types.size(); ++k)
+    {
+        output << "  converged with " << smoother_types[k] << ": " << converged[k] << '\n';
+    }
+    output << "  same number of iterations: " << (num_iterations[0] == num_iterations[1]) << '\n';
+    output << "  same solution: " << (relative_difference < 1.0e-10) << '\n';
+
+    for (const Pointer<SAMRAIVectorReal<NDIM, double> >& solution : solutions)
+    {
+        solution->deallocateVectorData();
+        solution->freeVectorComponents();
+    }
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+        Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+        level->deallocatePatchData(u_idx);
+        level->deallocatePatchData(f_idx);
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "red_black_gauss_seidel_01.log");
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+            "StandardTagAndInitialize", nullptr, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+
+        // Initialize the AMR patch hierarchy.
+        gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+        int tag_buffer = 1;
+        int level_number = 0;
+        bool done = false;
+        while (!done && (gridding_algorithm->levelCanBeRefined(level_number)))
+        {
+            gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, 0.0, tag_buffer);
+            done = !patch_hierarchy->finerLevelExists(level_number);
+            ++level_number;
+        }
+
+        HierarchyMathOps hier_math_ops("hier_math_ops", patch_hierarchy);
+        const int h_cc_idx = hier_math_ops.getCellWeightPatchDescriptorIndex();
+        const int h_sc_idx = hier_math_ops.getSideWeightPatchDescriptorIndex();
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        test<CellVariable<NDIM, double>, CCPoissonSolverManager>(
+            "cc", app_initializer, grid_geometry, patch_hierarchy, h_cc_idx, output);
+        test<SideVariable<NDIM, double>, SCPoissonSolverManager>(
+            "sc", app_initializer, grid_geometry, patch_hierarchy, h_sc_idx, output);
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
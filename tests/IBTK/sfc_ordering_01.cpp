@@ -0,0 +1,223 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Check the space-filling curve keys computed by IndexUtilities and estimate
+// how much ordering Lagrangian points along those curves improves the cache
+// behavior of spreading and interpolation. Since hardware counters are not
+// portable, the cache is modeled as a fully-associative LRU cache of 64-byte
+// lines and the number of misses incurred by visiting the IB_4 stencils of a
+// cloud of random points is reported for several cache sizes.
+
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IndexUtilities.h>
+
+#include <tbox/SAMRAIManager.h>
+
+#include <SAMRAI_config.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <list>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibtk/app_namespaces.h>
+
+// test stuff
+#include "../tests.h"
+
+using namespace SAMRAI;
+
+namespace
+{
+// A simple fully-associative LRU cache that only keeps track of misses.
+class LRUCache
+{
+public:
+    LRUCache(const std::size_t n_lines) : d_n_lines(n_lines)
+    {
+    }
+
+    void access(const std::size_t line)
+    {
+        const auto it = d_map.find(line);
+        if (it != d_map.end())
+        {
+            d_lines.splice(d_lines.begin(), d_lines, it->second);
+            return;
+        }
+        ++d_n_misses;
+        d_lines.push_front(line);
+        d_map[line] = d_lines.begin();
+        if (d_lines.size() > d_n_lines)
+        {
+            d_map.erase(d_lines.back());
+            d_lines.pop_back();
+        }
+    }
+
+    std::size_t getNumberOfMisses() const
+    {
+        return d_n_misses;
+    }
+
+private:
+    std::size_t d_n_lines;
+    std::size_t d_n_misses = 0;
+    std::list<std::size_t> d_lines;
+    std::unordered_map<std::size_t, std::list<std::size_t>::iterator> d_map;
+};
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    std::ofstream out("output");
+
+    // Check that the curves visit every cell of a small box exactly once and
+    // that consecutive cells along the Hilbert curve are face neighbors.
+    {
+        const int n = 8;
+        const hier::Index<NDIM> lower(0);
+        std::vector<std::pair<std::uint64_t, hier::Index<NDIM> > > morton_keys, hilbert_keys;
+        int n_total = 1;
+        for (unsigned int d = 0; d < NDIM; ++d) n_total *= n;
+        for (int k = 0; k < n_total; ++k)
+        {
+            hier::Index<NDIM> i;
+            for (unsigned int d = 0, r = k; d < NDIM; ++d, r /= n) i(d) = r % n;
+            morton_keys.emplace_back(IBTK::IndexUtilities::getMortonKey(i, lower), i);
+            hilbert_keys.emplace_back(IBTK::IndexUtilities::getHilbertKey(i, lower), i);
+        }
+        const auto key_less = [](const std::pair<std::uint64_t, hier::Index<NDIM> >& a,
+                                 const std::pair<std::uint64_t, hier::Index<NDIM> >& b) { return a.first < b.first; };
+        const auto key_equal = [](const std::pair<std::uint64_t, hier::Index<NDIM> >& a,
+                                  const std::pair<std::uint64_t, hier::Index<NDIM> >& b) { return a.first == b.first; };
+        std::sort(morton_keys.begin(), morton_keys.end(), key_less);
+        std::sort(hilbert_keys.begin(), hilbert_keys.end(), key_less);
+        out << "Morton keys are distinct: "
+            << (std::adjacent_find(morton_keys.begin(), morton_keys.end(), key_equal) == morton_keys.end()) << '\n';
+        out << "Hilbert keys are distinct: "
+            << (std::adjacent_find(hilbert_keys.begin(), hilbert_keys.end(), key_equal) == hilbert_keys.end())
+            << '\n';
+        bool hilbert_is_continuous = true;
+        for (std::size_t k = 1; k < hilbert_keys.size(); ++k)
+        {
+            int dist = 0;
+            for (unsigned int d = 0; d < NDIM; ++d)
+                dist += std::abs(hilbert_keys[k].second(d) - hilbert_keys[k - 1].second(d));
+            hilbert_is_continuous = hilbert_is_continuous && dist == 1;
+        }
+        out << "Hilbert curve is continuous: " << hilbert_is_continuous << '\n';
+        out << "First cells along the Morton curve:";
+        for (std::size_t k = 0; k < 8; ++k) out << ' ' << morton_keys[k].second;
+        out << '\n';
+        out << "First cells along the Hilbert curve:";
+        for (std::size_t k = 0; k < 8; ++k) out << ' ' << hilbert_keys[k].second;
+        out << "\n\n";
+    }
+
+    // Set up a cloud of random points in a patch and count the number of
+    // cache misses incurred by visiting the stencils of the points in
+    // different orders.
+    {
+#if (NDIM == 2)
+        const int n_cells = 512;
+        const std::size_t n_points = 100000;
+#endif
+#if (NDIM == 3)
+        const int n_cells = 64;
+        const std::size_t n_points = 100000;
+#endif
+        const int stencil_width = 4;
+        const int ghost_width = stencil_width / 2 + 1;
+        const int n_ghosted = n_cells + 2 * ghost_width;
+        int n_stencil = 1;
+        for (unsigned int d = 0; d < NDIM; ++d) n_stencil *= stencil_width;
+        const std::size_t doubles_per_line = 64 / sizeof(double);
+
+        std::uint64_t state = 42;
+        std::vector<hier::Index<NDIM> > stencil_lower(n_points);
+        std::vector<hier::Index<NDIM> > cells(n_points);
+        for (std::size_t k = 0; k < n_points; ++k)
+        {
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                const double x = static_cast<double>(lcg(state) % (1 << 20)) / static_cast<double>(1 << 20);
+                const double X = x * n_cells;
+                cells[k](d) = static_cast<int>(X);
+                stencil_lower[k](d) = static_cast<int>(X + 0.5) - stencil_width / 2;
+            }
+        }
+
+        const hier::Index<NDIM> lower(0);
+        const std::vector<std::string> orderings = { "NONE", "MORTON", "HILBERT" };
+        const std::vector<std::size_t> cache_sizes = { 32 * 1024, 256 * 1024, 1024 * 1024 };
+        for (const std::string& ordering : orderings)
+        {
+            std::vector<std::pair<std::uint64_t, std::size_t> > keys(n_points);
+            for (std::size_t k = 0; k < n_points; ++k)
+            {
+                std::uint64_t key = k;
+                if (ordering == "MORTON") key = IBTK::IndexUtilities::getMortonKey(cells[k], lower);
+                if (ordering == "HILBERT") key = IBTK::IndexUtilities::getHilbertKey(cells[k], lower);
+                keys[k] = std::make_pair(key, k);
+            }
+            std::stable_sort(keys.begin(),
+                             keys.end(),
+                             [](const std::pair<std::uint64_t, std::size_t>& a,
+                                const std::pair<std::uint64_t, std::size_t>& b) { return a.first < b.first; });
+
+            std::vector<std::size_t> permutation(n_points);
+            std::transform(keys.begin(),
+                           keys.end(),
+                           permutation.begin(),
+                           [](const std::pair<std::uint64_t, std::size_t>& p) { return p.second; });
+            std::sort(permutation.begin(), permutation.end());
+            std::vector<std::size_t> identity(n_points);
+            std::iota(identity.begin(), identity.end(), 0);
+
+            out << "Ordering: " << ordering << '\n';
+            out << "  ordering is a permutation: " << (permutation == identity) << '\n';
+            for (const std::size_t cache_size : cache_sizes)
+            {
+                LRUCache cache(cache_size / 64);
+                for (const auto& key : keys)
+                {
+                    const hier::Index<NDIM>& ic_lower = stencil_lower[key.second];
+                    for (int s = 0; s < n_stencil; ++s)
+                    {
+                        std::size_t offset = 0;
+                        for (int d = NDIM - 1, r = s; d >= 0; --d)
+                        {
+                            offset = offset * n_ghosted + ic_lower(d) + ghost_width + r % stencil_width;
+                            r /= stencil_width;
+                        }
+                        cache.access(offset / doubles_per_line);
+                    }
+                }
+                out << "  cache misses (" << cache_size / 1024 << " KiB): " << cache.getNumberOfMisses() << '\n';
+            }
+        }
+    }
+} // main
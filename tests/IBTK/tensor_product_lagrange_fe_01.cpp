@@ -0,0 +1,152 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2020 - 2020 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic libMesh objects
+#include <libmesh/fe_base.h>
+#include <libmesh/mesh.h>
+#include <libmesh/mesh_generation.h>
+#include <libmesh/quadrature.h>
+#include <libmesh/string_to_enum.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/IBTKInit.h>
+#include <ibtk/TensorProductLagrangeFE.h>
+#include <ibtk/libmesh_utilities.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// Test that the sum-factorized values, gradients, and gradient integrals
+// computed by TensorProductLagrangeFE match those computed with libMesh's
+// shape function tables on the elements of a mapped sphere.
+
+template <int dim, libMesh::Order order, libMesh::ElemType elem_type>
+void
+test(LibMeshInit& init, std::ofstream& output)
+{
+    ReplicatedMesh mesh(init.comm(), dim);
+    MeshTools::Generation::build_sphere(mesh, 1.0, 2, elem_type);
+
+    // libMesh values:
+    const FEType fe_type(order, LAGRANGE);
+    std::unique_ptr<QBase> quad = QBase::build(QGAUSS, dim, FOURTH);
+    std::unique_ptr<FEBase> libmesh_fe = FEBase::build(dim, fe_type);
+    libmesh_fe->attach_quadrature_rule(quad.get());
+    const std::vector<double>& JxW = libmesh_fe->get_JxW();
+    const std::vector<std::vector<double> >& phi = libmesh_fe->get_phi();
+    const std::vector<std::vector<libMesh::VectorValue<double> > >& dphi = libmesh_fe->get_dphi();
+
+    // Sum factorization values:
+    TBOX_ASSERT(IBTK::TensorProductLagrangeFE::isSupported(elem_type, fe_type, QGAUSS));
+    IBTK::TensorProductLagrangeFE tp_fe(elem_type, FOURTH);
+    const unsigned int n_nodes = tp_fe.getNumberOfNodes();
+    const unsigned int n_qp = tp_fe.getNumberOfQuadraturePoints();
+    const std::vector<double>& weights = tp_fe.getQuadratureWeights();
+    std::vector<double> u(n_nodes), u_qp(n_qp), grad_u_qp(dim * n_qp), X_node(n_nodes), grad_X_qp(dim * dim * n_qp),
+        flux_qp(dim * n_qp), rhs(n_nodes);
+
+    double max_value_error = 0.0, max_JxW_error = 0.0, max_gradient_error = 0.0, max_integral_error = 0.0;
+    for (auto elem_iter = mesh.active_local_elements_begin(); elem_iter != mesh.active_local_elements_end();
+         ++elem_iter)
+    {
+        const Elem* const elem = *elem_iter;
+        libmesh_fe->reinit(elem);
+        TBOX_ASSERT(phi.size() == n_nodes && JxW.size() == n_qp);
+
+        // Use a smooth field and the reference gradients of the coordinates.
+        for (unsigned int n = 0; n < n_nodes; ++n)
+        {
+            const libMesh::Point& p = elem->point(n);
+            u[n] = std::sin(p(0)) * std::cos(2.0 * p(1)) + (dim == 3 ? p(2) * p(2) : 0.0);
+        }
+        for (unsigned int d = 0; d < dim; ++d)
+        {
+            for (unsigned int n = 0; n < n_nodes; ++n) X_node[n] = elem->point(n)(d);
+            tp_fe.interpolateGradient(X_node.data(), &grad_X_qp[d * dim * n_qp]);
+        }
+        tp_fe.interpolate(u.data(), u_qp.data());
+        tp_fe.interpolateGradient(u.data(), grad_u_qp.data());
+
+        std::fill(rhs.begin(), rhs.end(), 0.0);
+        std::vector<double> libmesh_rhs(n_nodes, 0.0);
+        for (unsigned int qp = 0; qp < n_qp; ++qp)
+        {
+            TensorValue<double> grad_X;
+            for (unsigned int i = 0; i < LIBMESH_DIM; ++i)
+            {
+                for (unsigned int j = 0; j < LIBMESH_DIM; ++j)
+                {
+                    grad_X(i, j) = i < dim && j < dim ? grad_X_qp[(i * n_qp + qp) * dim + j] : (i == j ? 1.0 : 0.0);
+                }
+            }
+            TensorValue<double> grad_X_inv_trans;
+            IBTK::tensor_inverse_transpose(grad_X_inv_trans, grad_X, dim);
+            const double tp_JxW = grad_X.det() * weights[qp];
+            max_JxW_error = std::max(max_JxW_error, std::abs(tp_JxW - JxW[qp]));
+
+            double libmesh_u = 0.0;
+            libMesh::VectorValue<double> libmesh_grad_u;
+            for (unsigned int n = 0; n < n_nodes; ++n)
+            {
+                libmesh_u += u[n] * phi[n][qp];
+                libmesh_grad_u += u[n] * dphi[n][qp];
+            }
+            max_value_error = std::max(max_value_error, std::abs(libmesh_u - u_qp[qp]));
+
+            libMesh::VectorValue<double> ref_grad_u, ref_flux, flux;
+            for (unsigned int k = 0; k < dim; ++k) ref_grad_u(k) = grad_u_qp[qp * dim + k];
+            const libMesh::VectorValue<double> grad_u = grad_X_inv_trans * ref_grad_u;
+            max_gradient_error = std::max(max_gradient_error, (grad_u - libmesh_grad_u).norm());
+
+            // Integrate a smooth flux against the shape function gradients.
+            for (unsigned int j = 0; j < dim; ++j) flux(j) = std::cos(u_qp[qp] + j);
+            ref_flux = tp_JxW * (grad_X_inv_trans.transpose() * flux);
+            for (unsigned int k = 0; k < dim; ++k) flux_qp[qp * dim + k] = ref_flux(k);
+            for (unsigned int n = 0; n < n_nodes; ++n) libmesh_rhs[n] += flux * dphi[n][qp] * JxW[qp];
+        }
+        tp_fe.integrateGradient(flux_qp.data(), rhs.data());
+        for (unsigned int n = 0; n < n_nodes; ++n)
+        {
+            max_integral_error = std::max(max_integral_error, std::abs(rhs[n] - libmesh_rhs[n]));
+        }
+    }
+
+    TBOX_ASSERT(max_value_error < 1e-13);
+    TBOX_ASSERT(max_JxW_error < 1e-13);
+    TBOX_ASSERT(max_gradient_error < 1e-11);
+    TBOX_ASSERT(max_integral_error < 1e-12);
+    output << Utility::enum_to_string(elem_type) << ": " << tp_fe.getNumberOfNodes() << " nodes, "
+           << tp_fe.getNumberOfQuadraturePoints() << " quadrature points, OK\n";
+}
+
+int
+main(int argc, char** argv)
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+    LibMeshInit& init = ibtk_init.getLibMeshInit();
+
+    std::ofstream output("output");
+    test<2, FIRST, QUAD4>(init, output);
+    test<2, SECOND, QUAD9>(init, output);
+    test<3, FIRST, HEX8>(init, output);
+    test<3, SECOND, HEX27>(init, output);
+}
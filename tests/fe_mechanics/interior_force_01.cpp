@@ -0,0 +1,203 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+
+// Headers for basic libMesh objects
+#include <libmesh/equation_systems.h>
+#include <libmesh/mesh_generation.h>
+#include <libmesh/replicated_mesh.h>
+#include <libmesh/string_to_enum.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibamr/FEMechanicsExplicitIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/libmesh_utilities.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// Compute the Lagrangian force of a deformed structure with two
+// FEMechanicsExplicitIntegrator objects and check that they agree. The
+// reference integrator evaluates a per-point compressible neo-Hookean PK1
+// stress function. The second one evaluates the same stress function, through
+// a batched version of it if USE_BATCHED_PK1_STRESS_FUNCTION is TRUE, and
+// assembles the force by sum factorization if its input database sets
+// use_sum_factorization. Both integrators use lumped mass matrices, so the
+// forces only differ if the assembled right-hand sides do.
+
+namespace
+{
+double shear_mod, bulk_mod;
+
+// A smooth deformation of the reference configuration.
+void
+coordinate_mapping_function(libMesh::Point& x, const libMesh::Point& X, void* /*ctx*/)
+{
+    x(0) = X(0) + 0.1 * std::sin(M_PI * X(1));
+    x(1) = X(1) + 0.1 * std::sin(M_PI * X(0)) * X(0);
+#if (NDIM == 3)
+    x(2) = X(2) + 0.05 * std::cos(M_PI * X(0)) * X(1);
+#endif
+    return;
+} // coordinate_mapping_function
+
+TensorValue<double>
+neo_hookean_stress(const TensorValue<double>& FF)
+{
+    const TensorValue<double> FF_inv_trans = tensor_inverse_transpose(FF, NDIM);
+    return shear_mod * (FF - FF_inv_trans) + bulk_mod * std::log(FF.det()) * FF_inv_trans;
+} // neo_hookean_stress
+
+void
+PK1_stress_function(TensorValue<double>& PP,
+                    const TensorValue<double>& FF,
+                    const libMesh::Point& /*x*/,
+                    const libMesh::Point& /*X*/,
+                    Elem* const /*elem*/,
+                    const std::vector<const std::vector<double>*>& /*var_data*/,
+                    const std::vector<const std::vector<VectorValue<double> >*>& /*grad_var_data*/,
+                    double /*time*/,
+                    void* /*ctx*/)
+{
+    PP = neo_hookean_stress(FF);
+    return;
+} // PK1_stress_function
+
+void
+batched_PK1_stress_function(FEMechanicsBase::PK1StressBatch& batch, double /*time*/, void* /*ctx*/)
+{
+    const unsigned int n_points = batch.n_points;
+    for (unsigned int p = 0; p < n_points; ++p)
+    {
+        // In 2D, the out-of-plane component of the deformation gradient is one.
+        TensorValue<double> FF(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0);
+        for (unsigned int i = 0; i < NDIM; ++i)
+        {
+            for (unsigned int j = 0; j < NDIM; ++j) FF(i, j) = batch.FF[(i * NDIM + j) * n_points + p];
+        }
+        const TensorValue<double> PP = neo_hookean_stress(FF);
+        for (unsigned int i = 0; i < NDIM; ++i)
+        {
+            for (unsigned int j = 0; j < NDIM; ++j) batch.PP[(i * NDIM + j) * n_points + p] = PP(i, j);
+        }
+    }
+    return;
+} // batched_PK1_stress_function
+
+// Compute the Lagrangian force at the initial time and copy it to every
+// process.
+std::vector<double>
+compute_force(FEMechanicsExplicitIntegrator& integrator)
+{
+    integrator.preprocessIntegrateData(0.0, 1.0, 1);
+    integrator.computeLagrangianForce(0.0);
+    System& F_system = integrator.getEquationSystems()->get_system(FEMechanicsBase::FORCE_SYSTEM_NAME);
+    std::vector<double> F;
+    F_system.solution->localize(F);
+    return F;
+} // compute_force
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+    const LibMeshInit& init = ibtk_init.getLibMeshInit();
+
+    // prevent a warning about timer initializations
+    TimerManager::createManager(nullptr);
+    { // cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "interior_force_01.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+        shear_mod = input_db->getDouble("SHEAR_MOD");
+        bulk_mod = input_db->getDouble("BULK_MOD");
+
+        // Set up two copies of the same mesh of the unit square or cube, one
+        // for each integrator.
+        const int n_elems = input_db->getInteger("N_ELEMS");
+        const ElemType elem_type = Utility::string_to_enum<ElemType>(input_db->getString("ELEM_TYPE"));
+        ReplicatedMesh reference_mesh(init.comm(), NDIM), mesh(init.comm(), NDIM);
+        for (ReplicatedMesh* m : { &reference_mesh, &mesh })
+        {
+#if (NDIM == 2)
+            MeshTools::Generation::build_square(*m, n_elems, n_elems, 0.0, 1.0, 0.0, 1.0, elem_type);
+#endif
+#if (NDIM == 3)
+            MeshTools::Generation::build_cube(*m, n_elems, n_elems, n_elems, 0.0, 1.0, 0.0, 1.0, 0.0, 1.0, elem_type);
+#endif
+        }
+
+        // Set up the integrators.
+        const QuadratureType quad_type = Utility::string_to_enum<QuadratureType>(input_db->getString("QUAD_TYPE"));
+        const Order quad_order = Utility::string_to_enum<Order>(input_db->getString("QUAD_ORDER"));
+        FEMechanicsExplicitIntegrator reference_integrator(
+            "ReferenceIntegrator", app_initializer->getComponentDatabase("ReferenceIntegrator"), &reference_mesh, false);
+        FEMechanicsExplicitIntegrator integrator(
+            "Integrator", app_initializer->getComponentDatabase("Integrator"), &mesh, false);
+        reference_integrator.registerPK1StressFunction(
+            FEMechanicsBase::PK1StressFcnData(PK1_stress_function, {}, nullptr, quad_type, quad_order));
+        if (input_db->getBoolWithDefault("USE_BATCHED_PK1_STRESS_FUNCTION", false))
+        {
+            integrator.registerPK1StressFunction(
+                FEMechanicsBase::PK1StressFcnData(batched_PK1_stress_function, {}, nullptr, quad_type, quad_order));
+        }
+        else
+        {
+            integrator.registerPK1StressFunction(
+                FEMechanicsBase::PK1StressFcnData(PK1_stress_function, {}, nullptr, quad_type, quad_order));
+        }
+        for (FEMechanicsExplicitIntegrator* fem_solver : { &reference_integrator, &integrator })
+        {
+            fem_solver->registerInitialCoordinateMappingFunction(
+                FEMechanicsBase::CoordinateMappingFcnData(coordinate_mapping_function));
+            fem_solver->initializeFEEquationSystems();
+            fem_solver->initializeFEData();
+        }
+
+        // Both meshes and their systems are set up in the same way, so the
+        // force vectors use the same degree of freedom numbering.
+        const std::vector<double> F_reference = compute_force(reference_integrator);
+        const std::vector<double> F = compute_force(integrator);
+        double max_F = 0.0, max_diff = 0.0;
+        for (std::size_t k = 0; k < F.size(); ++k)
+        {
+            max_F = std::max(max_F, std::abs(F_reference[k]));
+            max_diff = std::max(max_diff, std::abs(F[k] - F_reference[k]));
+        }
+        plog << "maximum force: " << max_F << '\n';
+        plog << "maximum relative difference: " << max_diff / max_F << '\n';
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+        output << "same number of degrees of freedom: " << (F.size() == F_reference.size()) << '\n';
+        output << "forces agree: " << (max_F > 0.0 && max_diff <= 1.0e-10 * max_F) << '\n';
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
@@ -69,6 +69,10 @@ main(int argc, char** argv)
         // file, and enable file logging.
         Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "cc_laplace.log");
         Pointer<Database> input_db = app_initializer->getInputDatabase();
+        if (input_db->keyExists("LEInteractor"))
+        {
+            LEInteractor::setFromDatabase(app_initializer->getComponentDatabase("LEInteractor"));
+        }
 
         // Create major algorithm and data objects that comprise the
         // application.  These objects are configured from the input database.
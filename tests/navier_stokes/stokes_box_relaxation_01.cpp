@@ -0,0 +1,587 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2021 - 2021 by the IBAMR developers
+// All rights reserved.
+//
+// This file is part of IBAMR.
+//
+// IBAMR is free software and is distributed under the 3-clause BSD
+// license. The full text of the license can be found in the file
+// COPYRIGHT at the top level directory of IBAMR.
+//
+// ---------------------------------------------------------------------
+
+// Config files
+
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+
+// Headers for basic SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <SideData.h>
+#include <SideGeometry.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibamr/StaggeredStokesBoxRelaxationFACOperator.h>
+#include <ibamr/StaggeredStokesFACPreconditioner.h>
+#include <ibamr/StaggeredStokesPhysicalBoundaryHelper.h>
+#include <ibamr/StaggeredStokesSolverManager.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/HierarchyMathOps.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IBTK_MPI.h>
+#include <ibtk/KrylovLinearSolver.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Set up application namespace declarations
+#include <ibamr/app_namespaces.h>
+
+// Check the box relaxation (Vanka-type) smoother of
+// StaggeredStokesBoxRelaxationFACOperator in two ways:
+//
+// 1. Apply one sweep of the smoother with the lexicographic ordering on the
+//    coarsest level and compare the result with a reference implementation
+//    that follows the previous implementation of the smoother, which assembled
+//    the box system of each cell and solved it directly. If the results agree
+//    up to roundoff, the iteration counts of the solvers that use the smoother
+//    with the lexicographic ordering are unchanged.
+//
+// 2. Solve a periodic staggered Stokes problem with FGMRES preconditioned by
+//    the FAC preconditioner with the lexicographic and multicolor orderings
+//    and check that the solves converge. The multicolor solve is done with
+//    one and with NUM_THREADS OpenMP threads and the results are compared.
+//    attest sets OMP_THREAD_LIMIT to one, so this comparison is only
+//    meaningful when the test is run by hand.
+
+// Number of unknowns in each box and the position of the pressure unknown.
+static const int BOX_SIZE = 2 * NDIM + 1;
+static const int BOX_P_INDEX = 2 * NDIM;
+
+// Under-relaxation parameter used by the smoother.
+static const double OMEGA = 0.65;
+
+// Deterministic, nonsmooth values for component "axis" at index i.
+double
+test_value(const hier::Index<NDIM>& i, const int axis, const double phase)
+{
+    double arg = phase + 0.37 * axis;
+    for (unsigned int d = 0; d < NDIM; ++d) arg += (0.29 + 0.17 * d) * i(d) * i(d);
+    return std::sin(arg);
+}
+
+// Set all values, including ghost values, of the data on the given level.
+void
+fill_level_data(Pointer<PatchLevel<NDIM> > level, const int U_idx, const int P_idx, const double phase)
+{
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        Pointer<SideData<NDIM, double> > U_data = patch->getPatchData(U_idx);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            for (Box<NDIM>::Iterator b(SideGeometry<NDIM>::toSideBox(U_data->getGhostBox(), axis)); b; b++)
+            {
+                (*U_data)(SideIndex<NDIM>(b(), axis, SideIndex<NDIM>::Lower)) = test_value(b(), axis, phase);
+            }
+        }
+        Pointer<CellData<NDIM, double> > P_data = patch->getPatchData(P_idx);
+        for (Box<NDIM>::Iterator b(P_data->getGhostBox()); b; b++)
+        {
+            (*P_data)(b()) = test_value(b(), NDIM, phase);
+        }
+    }
+}
+
+// Solve the dense system A x = b of size BOX_SIZE by Gaussian elimination with
+// partial pivoting. A and b are overwritten.
+void
+solve_dense_system(std::array<std::array<double, BOX_SIZE>, BOX_SIZE>& A,
+                   std::array<double, BOX_SIZE>& b,
+                   std::array<double, BOX_SIZE>& x)
+{
+    for (int k = 0; k < BOX_SIZE; ++k)
+    {
+        int pivot = k;
+        for (int l = k + 1; l < BOX_SIZE; ++l)
+        {
+            if (std::abs(A[l][k]) > std::abs(A[pivot][k])) pivot = l;
+        }
+        std::swap(A[k], A[pivot]);
+        std::swap(b[k], b[pivot]);
+        for (int l = k + 1; l < BOX_SIZE; ++l)
+        {
+            const double factor = A[l][k] / A[k][k];
+            for (int m = k; m < BOX_SIZE; ++m) A[l][m] -= factor * A[k][m];
+            b[l] -= factor * b[k];
+        }
+    }
+    for (int k = BOX_SIZE - 1; k >= 0; --k)
+    {
+        double sum = b[k];
+        for (int m = k + 1; m < BOX_SIZE; ++m) sum -= A[k][m] * x[m];
+        x[k] = sum / A[k][k];
+    }
+}
+
+// Apply one sweep of the box relaxation smoother with the lexicographic
+// ordering to the error on the patch in the way the smoother was originally
+// implemented: for each cell, move the couplings to values outside of the cell
+// to the right-hand side of the box system, solve the box system with Gaussian
+// elimination, and under-relax the update.
+void
+reference_smooth_error(Patch<NDIM>& patch,
+                       SideData<NDIM, double>& U_error,
+                       CellData<NDIM, double>& P_error,
+                       const SideData<NDIM, double>& U_residual,
+                       const CellData<NDIM, double>& P_residual,
+                       const double C,
+                       const double D)
+{
+    const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch.getPatchGeometry();
+    const double* const dx = pgeom->getDx();
+    for (Box<NDIM>::Iterator b(patch.getBox()); b; b++)
+    {
+        const hier::Index<NDIM>& i = b();
+        const Box<NDIM> box(i, i);
+
+        // Set up the box system. Velocity unknown 2 * axis + side is the
+        // normal velocity on the lower (side = 0) or upper (side = 1) side of
+        // the cell.
+        std::array<double, BOX_SIZE> r, x;
+        std::array<std::array<double, BOX_SIZE>, BOX_SIZE> A;
+        for (auto& row : A) row.fill(0.0);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            const Box<NDIM> side_box = SideGeometry<NDIM>::toSideBox(box, axis);
+            for (int side = 0; side <= 1; ++side)
+            {
+                const int k = 2 * axis + side;
+                hier::Index<NDIM> axis_shift = 0;
+                axis_shift(axis) = 1;
+                const hier::Index<NDIM> f = side == 0 ? i : i + axis_shift;
+                r[k] = U_residual(SideIndex<NDIM>(f, axis, SideIndex<NDIM>::Lower));
+                A[k][k] = C;
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    hier::Index<NDIM> shift = 0;
+                    shift(d) = 1;
+                    A[k][k] -= 2.0 * D / (dx[d] * dx[d]);
+                    for (const hier::Index<NDIM>& u_nbr : { f - shift, f + shift })
+                    {
+                        if (side_box.contains(u_nbr))
+                        {
+                            A[k][2 * axis + (u_nbr(axis) == i(axis) ? 0 : 1)] = D / (dx[d] * dx[d]);
+                        }
+                        else
+                        {
+                            const SideIndex<NDIM> s_nbr(u_nbr, axis, SideIndex<NDIM>::Lower);
+                            r[k] += D * U_error(s_nbr) / (dx[d] * dx[d]);
+                        }
+                    }
+                }
+                const hier::Index<NDIM> p_left = f - axis_shift;
+                const hier::Index<NDIM> p_rght = f;
+                if (box.contains(p_left))
+                {
+                    A[k][BOX_P_INDEX] = -1.0 / dx[axis];
+                }
+                else
+                {
+                    r[k] += P_error(p_left) / dx[axis];
+                }
+                if (box.contains(p_rght))
+                {
+                    A[k][BOX_P_INDEX] = 1.0 / dx[axis];
+                }
+                else
+                {
+                    r[k] -= P_error(p_rght) / dx[axis];
+                }
+                A[BOX_P_INDEX][k] = side == 0 ? 1.0 / dx[axis] : -1.0 / dx[axis];
+            }
+        }
+        r[BOX_P_INDEX] = P_residual(i);
+
+        // Solve the box system and apply the under-relaxed update.
+        solve_dense_system(A, r, x);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            for (int side = 0; side <= 1; ++side)
+            {
+                const SideIndex<NDIM> s(i, axis, side);
+                U_error(s) = (1.0 - OMEGA) * U_error(s) + OMEGA * x[2 * axis + side];
+            }
+        }
+        P_error(i) = (1.0 - OMEGA) * P_error(i) + OMEGA * x[BOX_P_INDEX];
+    }
+}
+
+// Compute the maximum difference between the values computed by the smoother
+// and the reference implementation relative to the maximum reference value.
+// The smoother synchronizes the velocity values on patch boundaries after the
+// sweep, so velocities on patch boundaries are not compared.
+double
+relative_smoother_difference(Pointer<PatchLevel<NDIM> > level,
+                             const int U_idx,
+                             const int P_idx,
+                             const int U_ref_idx,
+                             const int P_ref_idx)
+{
+    double max_difference = 0.0, max_value = 0.0;
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        const Box<NDIM>& patch_box = patch->getBox();
+        Pointer<SideData<NDIM, double> > U_data = patch->getPatchData(U_idx);
+        Pointer<SideData<NDIM, double> > U_ref_data = patch->getPatchData(U_ref_idx);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            Box<NDIM> interior_side_box = SideGeometry<NDIM>::toSideBox(patch_box, axis);
+            interior_side_box.lower()(axis) += 1;
+            interior_side_box.upper()(axis) -= 1;
+            for (Box<NDIM>::Iterator b(interior_side_box); b; b++)
+            {
+                const SideIndex<NDIM> s(b(), axis, SideIndex<NDIM>::Lower);
+                max_difference = std::max(max_difference, std::abs((*U_data)(s) - (*U_ref_data)(s)));
+                max_value = std::max(max_value, std::abs((*U_ref_data)(s)));
+            }
+        }
+        Pointer<CellData<NDIM, double> > P_data = patch->getPatchData(P_idx);
+        Pointer<CellData<NDIM, double> > P_ref_data = patch->getPatchData(P_ref_idx);
+        for (Box<NDIM>::Iterator b(patch_box); b; b++)
+        {
+            max_difference = std::max(max_difference, std::abs((*P_data)(b()) - (*P_ref_data)(b())));
+            max_value = std::max(max_value, std::abs((*P_ref_data)(b())));
+        }
+    }
+    return IBTK_MPI::maxReduction(max_difference) / IBTK_MPI::maxReduction(max_value);
+}
+
+// Compare one sweep of the lexicographic smoother on the coarsest level with
+// the reference implementation.
+double
+test_lexicographic_smoother(Pointer<AppInitializer> app_initializer,
+                            Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+                            const PoissonSpecifications& U_problem_coefs)
+{
+    const int ln = 0;
+    VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+    Pointer<VariableContext> ctx = var_db->getContext("smoother_context");
+    Pointer<SideVariable<NDIM, double> > U_var = new SideVariable<NDIM, double>("smoother::U");
+    Pointer<CellVariable<NDIM, double> > P_var = new CellVariable<NDIM, double>("smoother::P");
+    Pointer<SideVariable<NDIM, double> > U_res_var = new SideVariable<NDIM, double>("smoother::U_res");
+    Pointer<CellVariable<NDIM, double> > P_res_var = new CellVariable<NDIM, double>("smoother::P_res");
+    Pointer<SideVariable<NDIM, double> > U_ref_var = new SideVariable<NDIM, double>("smoother::U_ref");
+    Pointer<CellVariable<NDIM, double> > P_ref_var = new CellVariable<NDIM, double>("smoother::P_ref");
+    const IntVector<NDIM> ghosts = 1;
+    const int U_idx = var_db->registerVariableAndContext(U_var, ctx, ghosts);
+    const int P_idx = var_db->registerVariableAndContext(P_var, ctx, ghosts);
+    const int U_res_idx = var_db->registerVariableAndContext(U_res_var, ctx, ghosts);
+    const int P_res_idx = var_db->registerVariableAndContext(P_res_var, ctx, ghosts);
+    const int U_ref_idx = var_db->registerVariableAndContext(U_ref_var, ctx, ghosts);
+    const int P_ref_idx = var_db->registerVariableAndContext(P_ref_var, ctx, ghosts);
+    Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+    for (const int idx : { U_idx, P_idx, U_res_idx, P_res_idx, U_ref_idx, P_ref_idx })
+    {
+        level->allocatePatchData(idx, 0.0);
+    }
+
+    SAMRAIVectorReal<NDIM, double> e_vec("e", patch_hierarchy, ln, ln);
+    SAMRAIVectorReal<NDIM, double> r_vec("r", patch_hierarchy, ln, ln);
+    e_vec.addComponent(U_var, U_idx);
+    e_vec.addComponent(P_var, P_idx);
+    r_vec.addComponent(U_res_var, U_res_idx);
+    r_vec.addComponent(P_res_var, P_res_idx);
+
+    Pointer<Database> precond_db = app_initializer->getInputDatabase()->getDatabase("precond_db");
+    precond_db->putBool("use_multicolor_ordering", false);
+    StaggeredStokesBoxRelaxationFACOperator fac_op("smoother::fac_op", precond_db, "");
+    fac_op.setVelocityPoissonSpecifications(U_problem_coefs);
+    fac_op.setCoarseSolverType("LEVEL_SMOOTHER");
+    fac_op.initializeOperatorState(e_vec, r_vec);
+
+    fill_level_data(level, U_idx, P_idx, 0.0);
+    fill_level_data(level, U_ref_idx, P_ref_idx, 0.0);
+    fill_level_data(level, U_res_idx, P_res_idx, 1.0);
+    fac_op.smoothError(e_vec, r_vec, ln, 1, false, true);
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        Pointer<SideData<NDIM, double> > U_ref_data = patch->getPatchData(U_ref_idx);
+        Pointer<CellData<NDIM, double> > P_ref_data = patch->getPatchData(P_ref_idx);
+        Pointer<SideData<NDIM, double> > U_res_data = patch->getPatchData(U_res_idx);
+        Pointer<CellData<NDIM, double> > P_res_data = patch->getPatchData(P_res_idx);
+        reference_smooth_error(*patch,
+                               *U_ref_data,
+                               *P_ref_data,
+                               *U_res_data,
+                               *P_res_data,
+                               U_problem_coefs.getCConstant(),
+                               U_problem_coefs.getDConstant());
+    }
+    const double relative_difference = relative_smoother_difference(level, U_idx, P_idx, U_ref_idx, P_ref_idx);
+    fac_op.deallocateOperatorState();
+
+    for (const int idx : { U_idx, P_idx, U_res_idx, P_res_idx, U_ref_idx, P_ref_idx })
+    {
+        level->deallocatePatchData(idx);
+    }
+    return relative_difference;
+}
+
+// The outcome of a Stokes solve.
+struct StokesSolveResult
+{
+    bool converged;
+    int num_iterations;
+    Pointer<SAMRAIVectorReal<NDIM, double> > solution;
+};
+
+// Solve the Stokes system with the box relaxation FAC preconditioner and the
+// given ordering and number of threads.
+StokesSolveResult
+solve_stokes_system(Pointer<AppInitializer> app_initializer,
+                    Pointer<PatchHierarchy<NDIM> > patch_hierarchy,
+                    const PoissonSpecifications& U_problem_coefs,
+                    SAMRAIVectorReal<NDIM, double>& u_vec,
+                    SAMRAIVectorReal<NDIM, double>& f_vec,
+                    Pointer<SAMRAIVectorReal<NDIM, double> > nul_vec,
+                    Pointer<StaggeredStokesPhysicalBoundaryHelper> bc_helper,
+                    const bool use_multicolor_ordering,
+                    const int num_threads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(num_threads);
+#else
+    (void)num_threads;
+#endif
+    Pointer<Database> input_db = app_initializer->getInputDatabase();
+    Pointer<Database> precond_db = input_db->getDatabase("precond_db");
+    precond_db->putBool("use_multicolor_ordering", use_multicolor_ordering);
+    Pointer<StaggeredStokesSolver> stokes_solver = StaggeredStokesSolverManager::getManager()->allocateSolver(
+        input_db->getString("solver_type"), "stokes_solver", input_db->getDatabase("solver_db"), "stokes_");
+    Pointer<StaggeredStokesFACPreconditionerStrategy> fac_op =
+        new StaggeredStokesBoxRelaxationFACOperator("stokes_precond::fac_op", precond_db, "stokes_pc_");
+    Pointer<StaggeredStokesSolver> stokes_precond =
+        new StaggeredStokesFACPreconditioner("stokes_precond", fac_op, precond_db, "stokes_pc_");
+    Pointer<KrylovLinearSolver> krylov_solver = stokes_solver;
+    TBOX_ASSERT(krylov_solver);
+    krylov_solver->setPreconditioner(stokes_precond);
+    krylov_solver->setNullspace(false, { nul_vec });
+    stokes_solver->setVelocityPoissonSpecifications(U_problem_coefs);
+    stokes_solver->setComponentsHaveNullspace(false, true);
+    stokes_solver->setPhysicalBoundaryHelper(bc_helper);
+    stokes_solver->initializeSolverState(u_vec, f_vec);
+
+    StokesSolveResult result;
+    u_vec.setToScalar(0.0);
+    result.converged = stokes_solver->solveSystem(u_vec, f_vec);
+    result.num_iterations = krylov_solver->getNumIterations();
+    stokes_solver->deallocateSolverState();
+
+    result.solution = u_vec.cloneVector("solution");
+    result.solution->allocateVectorData();
+    result.solution->copyVector(Pointer<SAMRAIVectorReal<NDIM, double> >(&u_vec, false));
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    // Initialize IBAMR and libraries. Deinitialization is handled by this object as well.
+    IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+    { // cleanup dynamically allocated objects prior to shutdown
+        // prevent a warning about timer initializations
+        TimerManager::createManager(nullptr);
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "stokes_box_relaxation_01.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+        const int num_threads = input_db->getIntegerWithDefault("NUM_THREADS", 1);
+
+        // Create major algorithm and data objects that comprise the
+        // application.  These objects are configured from the input database.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+        Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+            "StandardTagAndInitialize", nullptr, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+        Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+        Pointer<LoadBalancer<NDIM> > load_balancer =
+            new LoadBalancer<NDIM>("LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+        Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm =
+            new GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                        app_initializer->getComponentDatabase("GriddingAlgorithm"),
+                                        error_detector,
+                                        box_generator,
+                                        load_balancer);
+
+        // Initialize the AMR patch hierarchy.
+        gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+        int tag_buffer = 1;
+        int level_number = 0;
+        bool done = false;
+        while (!done && (gridding_algorithm->levelCanBeRefined(level_number)))
+        {
+            gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, 0.0, tag_buffer);
+            done = !patch_hierarchy->finerLevelExists(level_number);
+            ++level_number;
+        }
+        const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+
+        // Set up the coefficients of the time-dependent Stokes operator.
+        PoissonSpecifications U_problem_coefs("U_problem_coefs");
+        U_problem_coefs.setCConstant(input_db->getDouble("RHO") / input_db->getDouble("DT"));
+        U_problem_coefs.setDConstant(-input_db->getDouble("MU"));
+
+        std::ofstream output;
+        if (IBTK_MPI::getRank() == 0) output.open("output");
+
+        const double smoother_difference =
+            test_lexicographic_smoother(app_initializer, patch_hierarchy, U_problem_coefs);
+        plog << "relative difference between the lexicographic smoother and the reference implementation: "
+             << smoother_difference << '\n';
+        output << "lexicographic smoother agrees with the reference implementation: "
+               << (smoother_difference < 1.0e-10) << '\n';
+
+        // Create variables and register them with the variable database.
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("context");
+        Pointer<SideVariable<NDIM, double> > u_var = new SideVariable<NDIM, double>("u");
+        Pointer<CellVariable<NDIM, double> > p_var = new CellVariable<NDIM, double>("p");
+        Pointer<SideVariable<NDIM, double> > f_var = new SideVariable<NDIM, double>("f");
+        Pointer<CellVariable<NDIM, double> > g_var = new CellVariable<NDIM, double>("g");
+        const int u_idx = var_db->registerVariableAndContext(u_var, ctx, IntVector<NDIM>(1));
+        const int p_idx = var_db->registerVariableAndContext(p_var, ctx, IntVector<NDIM>(1));
+        const int f_idx = var_db->registerVariableAndContext(f_var, ctx, IntVector<NDIM>(1));
+        const int g_idx = var_db->registerVariableAndContext(g_var, ctx, IntVector<NDIM>(1));
+        for (int ln = 0; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->allocatePatchData(u_idx, 0.0);
+            level->allocatePatchData(p_idx, 0.0);
+            level->allocatePatchData(f_idx, 0.0);
+            level->allocatePatchData(g_idx, 0.0);
+        }
+
+        // Setup vector objects.
+        HierarchyMathOps hier_math_ops("hier_math_ops", patch_hierarchy);
+        const int h_sc_idx = hier_math_ops.getSideWeightPatchDescriptorIndex();
+        const int h_cc_idx = hier_math_ops.getCellWeightPatchDescriptorIndex();
+        SAMRAIVectorReal<NDIM, double> u_vec("u", patch_hierarchy, 0, finest_ln);
+        SAMRAIVectorReal<NDIM, double> f_vec("f", patch_hierarchy, 0, finest_ln);
+        u_vec.addComponent(u_var, u_idx, h_sc_idx);
+        u_vec.addComponent(p_var, p_idx, h_cc_idx);
+        f_vec.addComponent(f_var, f_idx, h_sc_idx);
+        f_vec.addComponent(g_var, g_idx, h_cc_idx);
+
+        // The right-hand side of the continuity equation vanishes, so the
+        // system is consistent.
+        muParserCartGridFunction f_fcn("f", app_initializer->getComponentDatabase("f"), grid_geometry);
+        f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+        // The pressure is determined up to a constant.
+        Pointer<SAMRAIVectorReal<NDIM, double> > nul_vec = u_vec.cloneVector("nul_vec");
+        nul_vec->allocateVectorData();
+        nul_vec->setToScalar(0.0);
+        HierarchyCellDataOpsReal<NDIM, double> hier_cc_data_ops(patch_hierarchy, 0, finest_ln);
+        hier_cc_data_ops.setToScalar(nul_vec->getComponentDescriptorIndex(1), 1.0);
+
+        Pointer<StaggeredStokesPhysicalBoundaryHelper> bc_helper = new StaggeredStokesPhysicalBoundaryHelper();
+        const std::vector<RobinBcCoefStrategy<NDIM>*> U_bc_coefs(NDIM, nullptr);
+        bc_helper->cacheBcCoefData(U_bc_coefs, 0.0, patch_hierarchy);
+
+        // Solve with the lexicographic ordering and with the multicolor
+        // ordering with one and several threads.
+        StokesSolveResult lexicographic_result = solve_stokes_system(app_initializer,
+                                                                     patch_hierarchy,
+                                                                     U_problem_coefs,
+                                                                     u_vec,
+                                                                     f_vec,
+                                                                     nul_vec,
+                                                                     bc_helper,
+                                                                     /*use_multicolor_ordering*/ false,
+                                                                     num_threads);
+        StokesSolveResult multicolor_result = solve_stokes_system(app_initializer,
+                                                                  patch_hierarchy,
+                                                                  U_problem_coefs,
+                                                                  u_vec,
+                                                                  f_vec,
+                                                                  nul_vec,
+                                                                  bc_helper,
+                                                                  /*use_multicolor_ordering*/ true,
+                                                                  1);
+        StokesSolveResult threaded_multicolor_result = solve_stokes_system(app_initializer,
+                                                                           patch_hierarchy,
+                                                                           U_problem_coefs,
+                                                                           u_vec,
+                                                                           f_vec,
+                                                                           nul_vec,
+                                                                           bc_helper,
+                                                                           /*use_multicolor_ordering*/ true,
+                                                                           num_threads);
+
+        // The multicolor smoother performs the same arithmetic for any number
+        // of threads, so the solutions should agree to roundoff.
+        Pointer<SAMRAIVectorReal<NDIM, double> > difference = u_vec.cloneVector("difference");
+        difference->allocateVectorData();
+        difference->subtract(threaded_multicolor_result.solution, multicolor_result.solution);
+        const double relative_difference = difference->maxNorm() / multicolor_result.solution->maxNorm();
+
+        plog << "lexicographic ordering number of iterations: " << lexicographic_result.num_iterations << '\n';
+        plog << "multicolor ordering number of iterations with 1 thread: " << multicolor_result.num_iterations
+             << '\n';
+        plog << "multicolor ordering number of iterations with " << num_threads
+             << " threads: " << threaded_multicolor_result.num_iterations << '\n';
+        plog << "relative difference between the multicolor solutions: " << relative_difference << '\n';
+
+        output << "converged with the lexicographic ordering: " << lexicographic_result.converged << '\n';
+        output << "converged with the multicolor ordering: " << multicolor_result.converged << '\n';
+        output << "converged with the multicolor ordering and several threads: "
+               << threaded_multicolor_result.converged << '\n';
+        output << "same number of iterations with several threads: "
+               << (threaded_multicolor_result.num_iterations == multicolor_result.num_iterations) << '\n';
+        output << "same solution with several threads: " << (relative_difference < 1.0e-12) << '\n';
+
+        for (StokesSolveResult* result : { &lexicographic_result, &multicolor_result, &threaded_multicolor_result })
+        {
+            result->solution->deallocateVectorData();
+            result->solution->freeVectorComponents();
+        }
+        for (Pointer<SAMRAIVectorReal<NDIM, double> > vec : { difference, nul_vec })
+        {
+            vec->deallocateVectorData();
+            vec->freeVectorComponents();
+        }
+        for (int ln = 0; ln <= finest_ln; ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+            level->deallocatePatchData(u_idx);
+            level->deallocatePatchData(p_idx);
+            level->deallocatePatchData(f_idx);
+            level->deallocatePatchData(g_idx);
+        }
+    } // cleanup dynamically allocated objects prior to shutdown
+} // main
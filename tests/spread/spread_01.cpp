@@ -59,7 +59,8 @@
 
 // This file is the main driver for force spreading tests (i.e.,
 // IBFEmethod::spreadForce). At the moment it simply prints out the force
-// values.
+// values, unless compare_element_subsets is TRUE, in which case it checks
+// spreading by FEDataManager::ElementSubset instead.
 
 // Coordinate mapping function.
 void
@@ -96,6 +97,86 @@ periodic_coordinate_mapping_function(libMesh::Point& X, const libMesh::Point& s,
     return;
 } // periodic_coordinate_mapping_function
 
+// Check that spreading from the processor interior elements while the ghost
+// values of the force and position vectors are being updated, and then from
+// the processor boundary elements, gives the same values as spreading from
+// all elements at once. This requires that element subsets are enabled (see
+// IBFEMethod's overlap_ghost_communication option).
+bool
+element_subsets_agree(const Pointer<PatchHierarchy<NDIM> >& patch_hierarchy,
+                      FEDataManager& fe_data_manager,
+                      const int f_all_idx,
+                      const int f_subsets_idx)
+{
+    auto& equation_systems = *fe_data_manager.getEquationSystems();
+    auto& F_vec = dynamic_cast<libMesh::PetscVector<double>&>(
+        equation_systems.get_system(IBFEMethod::FORCE_SYSTEM_NAME).get_vector("half"));
+    auto& X_vec = dynamic_cast<libMesh::PetscVector<double>&>(
+        *equation_systems.get_system(IBFEMethod::COORDS_SYSTEM_NAME).solution);
+    const FEDataManager::SpreadSpec& spread_spec = fe_data_manager.getDefaultSpreadSpec();
+
+    // Spread from all elements with up to date ghost values.
+    std::unique_ptr<libMesh::PetscVector<double> > F_all_vec =
+        fe_data_manager.buildIBGhostedVector(IBFEMethod::FORCE_SYSTEM_NAME);
+    std::unique_ptr<libMesh::PetscVector<double> > X_all_vec =
+        fe_data_manager.buildIBGhostedVector(IBFEMethod::COORDS_SYSTEM_NAME);
+    batch_vec_copy({ &F_vec, &X_vec }, { F_all_vec.get(), X_all_vec.get() });
+    batch_vec_ghost_update({ F_all_vec.get(), X_all_vec.get() }, INSERT_VALUES, SCATTER_FORWARD);
+    fe_data_manager.spread(f_all_idx, *F_all_vec, *X_all_vec, IBFEMethod::FORCE_SYSTEM_NAME, spread_spec);
+
+    // Spread from the two subsets. The ghost values of the new vectors are
+    // zero until the update completes.
+    std::unique_ptr<libMesh::PetscVector<double> > F_subsets_vec =
+        fe_data_manager.buildIBGhostedVector(IBFEMethod::FORCE_SYSTEM_NAME);
+    std::unique_ptr<libMesh::PetscVector<double> > X_subsets_vec =
+        fe_data_manager.buildIBGhostedVector(IBFEMethod::COORDS_SYSTEM_NAME);
+    const std::vector<libMesh::PetscVector<double>*> subsets_vecs = { F_subsets_vec.get(), X_subsets_vec.get() };
+    batch_vec_copy({ &F_vec, &X_vec }, subsets_vecs);
+    batch_vec_ghost_update_begin(subsets_vecs, INSERT_VALUES, SCATTER_FORWARD);
+    fe_data_manager.spread(f_subsets_idx,
+                           *F_subsets_vec,
+                           *X_subsets_vec,
+                           IBFEMethod::FORCE_SYSTEM_NAME,
+                           spread_spec,
+                           FEDataManager::PROCESSOR_INTERIOR_ELEMS);
+    batch_vec_ghost_update_end(subsets_vecs, INSERT_VALUES, SCATTER_FORWARD);
+    fe_data_manager.spread(f_subsets_idx,
+                           *F_subsets_vec,
+                           *X_subsets_vec,
+                           IBFEMethod::FORCE_SYSTEM_NAME,
+                           spread_spec,
+                           FEDataManager::PROCESSOR_BOUNDARY_ELEMS);
+
+    // Compare the values, including those spread into ghost cells. The
+    // elements are processed in a different order, so the values may differ
+    // by roundoff.
+    double max_f = 0.0, max_diff = 0.0;
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+        Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+        for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+        {
+            Pointer<Patch<NDIM> > patch = level->getPatch(p());
+            Pointer<SideData<NDIM, double> > f_all_data = patch->getPatchData(f_all_idx);
+            Pointer<SideData<NDIM, double> > f_subsets_data = patch->getPatchData(f_subsets_idx);
+            for (int axis = 0; axis < NDIM; ++axis)
+            {
+                for (SideIterator<NDIM> i(f_all_data->getGhostBox(), axis); i; i++)
+                {
+                    for (int d = 0; d < f_all_data->getDepth(); ++d)
+                    {
+                        max_f = std::max(max_f, std::abs((*f_all_data)(i(), d)));
+                        max_diff = std::max(max_diff, std::abs((*f_all_data)(i(), d) - (*f_subsets_data)(i(), d)));
+                    }
+                }
+            }
+        }
+    }
+    max_f = IBTK_MPI::maxReduction(max_f);
+    max_diff = IBTK_MPI::maxReduction(max_diff);
+    return max_f > 0.0 && max_diff <= 1.0e-12 * max_f;
+} // element_subsets_agree
+
 int
 main(int argc, char** argv)
 {
@@ -115,6 +196,10 @@ main(int argc, char** argv)
         Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "IB.log");
 
         Pointer<Database> input_db = app_initializer->getInputDatabase();
+        if (input_db->keyExists("LEInteractor"))
+        {
+            LEInteractor::setFromDatabase(app_initializer->getComponentDatabase("LEInteractor"));
+        }
 
         // Create a simple FE mesh.
         std::vector<std::unique_ptr<ReplicatedMesh> > meshes;
@@ -385,6 +470,27 @@ main(int argc, char** argv)
         // Test the accumulation code when we have meshes that are against the
         // boundary (i.e., the cube and composite cube geometries)
         const double data_time = time_integrator->getIntegratorTime() + dt / 2;
+        if (input_db->getBoolWithDefault("compare_element_subsets", false))
+        {
+            TBOX_ASSERT(meshes.size() == 1); // not implemented for multiple parts
+            const int f_subsets_idx =
+                var_db->registerVariableAndContext(f_var, var_db->getContext("f_subsets"), n_ghosts);
+            for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+            {
+                Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(ln);
+                level->allocatePatchData(f_subsets_idx);
+                for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+                {
+                    Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                    Pointer<SideData<NDIM, double> > f_data = patch->getPatchData(f_subsets_idx);
+                    f_data->fillAll(0.0);
+                }
+            }
+            const bool agree =
+                element_subsets_agree(patch_hierarchy, *ib_method_ops->getFEDataManager(0), f_ghost_idx, f_subsets_idx);
+            plog << "\nspreading by element subset agrees with spreading from all elements: " << agree << '\n';
+            return 0;
+        }
         RobinPhysBdryPatchStrategy* bdry_op = geometry == "sphere" ? nullptr : time_integrator->getVelocityPhysBdryOp();
         if (input_db->getBoolWithDefault("spread_with_ibfemethod", true))
             ib_method_ops->spreadForce(f_ghost_idx, bdry_op, {}, data_time);
@@ -23,6 +23,9 @@
 #include <tbox/Logger.h>
 #include <tbox/PIO.h>
 
+#include <PatchHierarchy.h>
+#include <PatchLevel.h>
+
 #ifdef IBAMR_HAVE_LIBMESH
 #include <ibtk/QuadratureCache.h>
 #include <ibtk/libmesh_utilities.h>
@@ -36,6 +39,8 @@
 
 #include <mpi.h>
 
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -71,6 +76,24 @@ print_strings_on_plog_0(const std::string& out)
         MPI_Send(out.data(), size, MPI_CHAR, 0, 0, IBTK_MPI::getCommunicator());
 }
 
+// A small linear congruential generator, so that pseudorandom test data do
+// not depend on the standard library implementation. Returns the high 31
+// bits of the updated @p state.
+inline std::uint64_t
+lcg(std::uint64_t& state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+// Same as lcg(), but returns a value uniformly distributed in [lower, upper).
+inline double
+lcg_uniform(std::uint64_t& state, const double lower = 0.0, const double upper = 1.0)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return lower + (upper - lower) * static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+}
+
 /**
  * Print the parallel partitioning (i.e., the boxes) on all processes to plog
  * stream on processor 0.